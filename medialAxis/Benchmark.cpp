@@ -0,0 +1,1470 @@
+/* Description: Benchmark driver for the medial axis modes. Runs on
+ *              synthetic noisy star shaped polygons (always simple) so
+ *              sizes can be scaled freely, and prints one line per run.
+ *
+ *              Prompt > ./MedialAxisBench [section ...]
+ *
+ *              With no argument every section is run.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MedialBalls.h"
+#include "RasterAxis.h"
+#include "CompactAxis.h"
+#include "PolygonSanitizer.h"
+#include "SurfaceAxis.h"
+
+#include <CGAL/Indexed_triangulation_data_structure_2.h>
+#include <CGAL/Delaunay_triangulation_3.h>
+#include <CGAL/Triangulation_hierarchy_2.h>
+#include <CGAL/Triangulation_hierarchy_vertex_base_2.h>
+#include <CGAL/Triangulation_hierarchy_3.h>
+#include <CGAL/Regular_triangulation_2.h>
+#include <CGAL/Regular_triangulation_euclidean_traits_2.h>
+#include <CGAL/Triangulation_grid_locator_2.h>
+#include <CGAL/Constrained_triangulation_plus_2.h>
+#include <CGAL/Delaunay_mesher_2.h>
+#include <CGAL/Delaunay_mesh_face_base_2.h>
+#include <CGAL/Delaunay_mesh_size_criteria_2.h>
+#include <CGAL/lloyd_optimize_mesh_2.h>
+#include <CGAL/odt_optimize_mesh_2.h>
+#include <CGAL/Triangulation_vertex_base_with_info_2.h>
+#include <CGAL/natural_neighbor_interpolation_2.h>
+#include <CGAL/Apollonius_graph_2.h>
+#include <CGAL/Apollonius_graph_hierarchy_2.h>
+#include <CGAL/Apollonius_graph_filtered_traits_2.h>
+#include <CGAL/Voronoi_diagram_2.h>
+#include <CGAL/Delaunay_triangulation_adaptation_traits_2.h>
+#include <CGAL/Delaunay_triangulation_adaptation_policies_2.h>
+#include <CGAL/Segment_Delaunay_graph_2.h>
+#include <CGAL/Segment_Delaunay_graph_filtered_traits_2.h>
+#include <CGAL/Periodic_2_triangulation_traits_2.h>
+#include <CGAL/Periodic_2_Delaunay_triangulation_2.h>
+#include <CGAL/Periodic_3_triangulation_traits_3.h>
+#include <CGAL/Periodic_3_Delaunay_triangulation_3.h>
+#include <CGAL/Alpha_shape_2.h>
+#include <CGAL/Straight_skeleton_builder_2.h>
+#include <CGAL/create_offset_polygons_2.h>
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Boolean_set_operations_2.h>
+#include <CGAL/Arr_segment_traits_2.h>
+#include <CGAL/Arrangement_2.h>
+#include <CGAL/Arr_batched_point_location.h>
+#include <CGAL/Arr_landmarks_point_location.h>
+#ifdef CGAL_LINKED_WITH_TBB
+#include <tbb/task_arena.h>
+#endif
+#include <malloc.h>
+#include <unistd.h>
+
+typedef std::chrono::steady_clock Clock;
+
+typedef CGAL::Delaunay_triangulation_2<K> PointerTriangulation;
+typedef CGAL::Delaunay_triangulation_2<K, CGAL::Indexed_triangulation_data_structure_2<K> > IndexedTriangulation;
+typedef CGAL::Delaunay_triangulation_3<K> Triangulation3;
+typedef CGAL::Triangulation_data_structure_2<CGAL::Triangulation_hierarchy_vertex_base_2<CGAL::Triangulation_vertex_base_2<K> > >
+  HierarchyTds;
+typedef CGAL::Triangulation_hierarchy_2<CGAL::Delaunay_triangulation_2<K, HierarchyTds> > HierarchyTriangulation;
+typedef CGAL::Triangulation_grid_locator_2<PointerTriangulation> GridTriangulation;
+typedef CGAL::Triangulation_hierarchy_3<CGAL::Delaunay_triangulation_3<K, CGAL::Triangulation_data_structure_3<
+  CGAL::Triangulation_hierarchy_vertex_base_3<CGAL::Triangulation_vertex_base_3<K> > > > > HierarchyTriangulation3;
+typedef CGAL::Regular_triangulation_2<CGAL::Regular_triangulation_euclidean_traits_2<K> > RegularTriangulation;
+typedef CGAL::Constrained_Delaunay_triangulation_2<K, CGAL::Triangulation_data_structure_2<
+  CGAL::Triangulation_vertex_base_2<K>, CGAL::Constrained_triangulation_face_base_2<K> >,
+  CGAL::Exact_predicates_tag> ConstrainedTriangulation;
+typedef CGAL::Constrained_triangulation_plus_2<ConstrainedTriangulation> ConstrainedTriangulationPlus;
+typedef CGAL::Constrained_Delaunay_triangulation_2<K, CGAL::Triangulation_data_structure_2<
+  CGAL::Triangulation_vertex_base_2<K>, CGAL::Delaunay_mesh_face_base_2<K> > > MeshTriangulation;
+typedef CGAL::Delaunay_mesh_size_criteria_2<MeshTriangulation> MeshCriteria;
+typedef CGAL::Delaunay_triangulation_2<K, CGAL::Triangulation_data_structure_2<
+  CGAL::Triangulation_vertex_base_with_info_2<double, K> > > TerrainTriangulation;
+typedef CGAL::Apollonius_graph_filtered_traits_2<K> ApolloniusTraits;
+typedef CGAL::Apollonius_graph_2<ApolloniusTraits> ApolloniusGraph;
+typedef CGAL::Apollonius_graph_hierarchy_2<ApolloniusTraits> ApolloniusGraphHierarchy;
+typedef CGAL::Voronoi_diagram_2<PointerTriangulation,
+  CGAL::Delaunay_triangulation_adaptation_traits_2<PointerTriangulation>,
+  CGAL::Delaunay_triangulation_caching_degeneracy_removal_policy_2<PointerTriangulation> > VoronoiDiagram;
+typedef CGAL::Segment_Delaunay_graph_filtered_traits_without_intersections_2<K, CGAL::Field_with_sqrt_tag> SdgTraits;
+typedef CGAL::Segment_Delaunay_graph_2<SdgTraits> SegmentDelaunayGraph;
+typedef CGAL::Periodic_2_Delaunay_triangulation_2<CGAL::Periodic_2_triangulation_traits_2<K> > PeriodicTriangulation2;
+typedef CGAL::Periodic_3_Delaunay_triangulation_3<CGAL::Periodic_3_triangulation_traits_3<K> > PeriodicTriangulation3;
+typedef CGAL::Alpha_shape_2<CGAL::Delaunay_triangulation_2<K, CGAL::Triangulation_data_structure_2<
+  CGAL::Alpha_shape_vertex_base_2<K>, CGAL::Alpha_shape_face_base_2<K> > > > AlphaShape;
+typedef CGAL::Cartesian<CGAL::Gmpq> ExactK;
+typedef CGAL::Polygon_2<ExactK> ExactPolygon;
+typedef CGAL::Polygon_with_holes_2<ExactK> ExactPolygonWithHoles;
+typedef CGAL::Arr_segment_traits_2<K> SegmentTraits;
+typedef CGAL::Arrangement_2<SegmentTraits> SegmentArrangement;
+typedef std::pair<K::Point_2, CGAL::Arr_point_location_result<SegmentArrangement>::Type> ArrLocation;
+typedef CGAL::Straight_skeleton_2<K> StraightSkeleton;
+typedef CGAL::Straight_skeleton_builder_2<CGAL::Straight_skeleton_builder_traits_2<K>, StraightSkeleton>
+  SkeletonBuilder;
+
+static double seconds(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//n vertices at increasing angles around the origin, radius modulated by
+//a few lobes plus noise, so the outline is simple but far from convex
+static Polygon_2 noisyStar(int n, double noise, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> jitter(-noise, noise);
+  Polygon_2 p;
+  for (int i = 0; i < n; i++) {
+    double a = 2 * M_PI * i / n;
+    double r = 100 * (1 + 0.35 * std::sin(5 * a) + 0.1 * std::sin(17 * a)) * (1 + jitter(gen));
+    p.push_back(Point(r * std::cos(a), r * std::sin(a)));
+  }
+  return p;
+}
+
+//Delaunay path against the raster path on the same polygons
+static void benchRaster() {
+  printf("== raster: Delaunay medial balls vs raster distance transform\n");
+  int sizes[] = {1000, 2000, 4000};
+  int resolutions[] = {512, 1024, 2048};
+  for (int s = 0; s < 3; s++) {
+    Polygon_2 p = noisyStar(sizes[s], 0.02, 1);
+    Clock::time_point start = Clock::now();
+    MedialGraph exact = medialBalls(p);
+    printf("  n=%6d delaunay            %9.3f s  %7zu balls\n", sizes[s], seconds(start),
+           exact.balls.size());
+
+    for (int r = 0; r < 3; r++) {
+      start = Clock::now();
+      RasterImage img = rasterizePolygon(p, resolutions[r]);
+      double tRaster = seconds(start);
+      Clock::time_point t0 = Clock::now();
+      DistanceTransform dt = distanceTransform(img);
+      double tEdt = seconds(t0);
+      t0 = Clock::now();
+      std::vector<unsigned char> ridge = rasterRidge(img, dt, 4.0);
+      MedialGraph approx = vectorizeRidge(img, dt, ridge, 1.0);
+      double tVector = seconds(t0);
+      double total = seconds(start);
+      double pixels = (double) img.width * img.height;
+      printf("  n=%6d raster %4dx%-4d  %9.3f s  %7zu balls  (scan %.3f, edt %.3f, ridge %.3f; %.1f Mpix/s)\n",
+             sizes[s], img.width, img.height, total, approx.balls.size(), tRaster, tEdt, tVector,
+             pixels / total * 1e-6);
+    }
+  }
+}
+
+//one axis in text, raw doubles and the compact format at a few grid sizes
+static void benchCompactAxis(const char *label, const MedialGraph &g, const CGAL::Bbox_2 &box) {
+  std::ostringstream text;
+  writeMedialGraph(text, g);
+  size_t raw = g.balls.size() * 3 * sizeof(double) + g.edges.size() * 2 * sizeof(int);
+  printf("  %-16s %8zu balls  text %9zu B  doubles %9zu B\n", label, g.balls.size(),
+         text.str().size(), raw);
+
+  std::vector<std::vector<int> > branches = medialBranches(g);
+  int bits[] = {12, 16, 20};
+  for (int k = 0; k < 3; k++) {
+    const int rounds = 20;
+    std::string encoded;
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+      std::ostringstream out;
+      CompactAxisWriter writer(out, box, bits[k]);
+      for (size_t b = 0; b < branches.size(); b++) writer.writeBranch(g, branches[b]);
+      writer.finish();
+      encoded = out.str();
+    }
+    double tEncode = seconds(start) / rounds;
+
+    std::vector<double> xyr;
+    double maxError = 0;
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+      CompactAxisReader reader((const unsigned char *) encoded.data(), encoded.size());
+      size_t b = 0;
+      while (reader.nextBranch(xyr)) {
+        if (r == 0) {
+          for (size_t i = 0; i < branches[b].size(); i++) {
+            const MedialBall &ball = g.balls[branches[b][i]];
+            maxError = std::max(maxError, std::fabs(xyr[3 * i] - ball.center.x()));
+            maxError = std::max(maxError, std::fabs(xyr[3 * i + 1] - ball.center.y()));
+            maxError = std::max(maxError, std::fabs(xyr[3 * i + 2] - ball.radius));
+          }
+        }
+        b++;
+      }
+    }
+    double tDecode = seconds(start) / rounds;
+    printf("    %2d bits %9zu B (%5.1f%% of doubles)  encode %7.1f MB/s  decode %7.1f MB/s  max error %.2g\n",
+           bits[k], encoded.size(), 100.0 * encoded.size() / raw, raw / tEncode * 1e-6,
+           raw / tDecode * 1e-6, maxError);
+  }
+}
+
+//a branch cut short by the end of the file and a branch claiming 2^28
+//points in 7 bytes must both stop the reader without allocating
+static bool compactRejectsCorrupt(const MedialGraph &g, const CGAL::Bbox_2 &box) {
+  std::ostringstream out;
+  CompactAxisWriter writer(out, box, 16);
+  std::vector<std::vector<int> > branches = medialBranches(g);
+  for (size_t b = 0; b < branches.size(); b++) writer.writeBranch(g, branches[b]);
+  writer.finish();
+  std::string encoded = out.str();
+  std::ostringstream empty;
+  CompactAxisWriter(empty, box, 16).finish();
+  std::string header = empty.str().substr(0, empty.str().size() - 1);
+  std::string corrupt[] = {encoded.substr(0, encoded.size() - 2),
+                           header + std::string("\x07\x80\x80\x80\x80\x01\x00\x00", 8)};
+  std::vector<double> xyr;
+  for (int c = 0; c < 2; c++) {
+    CompactAxisReader reader((const unsigned char *) corrupt[c].data(), corrupt[c].size());
+    while (reader.nextBranch(xyr)) {
+    }
+    if (reader.valid()) return false;
+  }
+  return true;
+}
+
+//size and throughput of the compact format; MB/s are in raw double bytes
+static void benchCompact() {
+  printf("== compact: quantized delta encoded axis output\n");
+  Polygon_2 p = noisyStar(2000, 0.02, 1);
+  benchCompactAxis("delaunay n=2000", medialBalls(p), p.bbox());
+  printf("  corrupt input %s\n", compactRejectsCorrupt(medialBalls(p), p.bbox()) ? "rejected" : "ACCEPTED");
+  Polygon_2 big = noisyStar(20000, 0.01, 2);
+  benchCompactAxis("raster 4096", rasterMedialAxis(big, 4096), big.bbox());
+}
+
+//validation against Polygon_2::is_simple(), on valid inputs and on inputs
+//with a crossing, which should be rejected quickly. The noise is kept to
+//a few vertex spacings, like a digitized outline, whatever the size
+static void benchSanitize() {
+  printf("== sanitize: polygon validation and repair\n");
+  int sizes[] = {10001, 100001, 1000001};
+  for (int s = 0; s < 3; s++) {
+    Polygon_2 p = noisyStar(sizes[s], 20.0 / sizes[s], 3);
+    Clock::time_point start = Clock::now();
+    bool simple = p.is_simple();
+    double tSimple = seconds(start);
+    start = Clock::now();
+    PolygonReport report = validatePolygon(p);
+    double tValidate = seconds(start);
+
+    //swap two vertices half way round, which makes the boundary cross
+    std::vector<Point> v(p.vertices_begin(), p.vertices_end());
+    std::swap(v[v.size() / 2], v[v.size() / 2 + 2]);
+    Polygon_2 bad(v.begin(), v.end());
+    start = Clock::now();
+    PolygonReport badReport = validatePolygon(bad, 1);
+    double tReject = seconds(start);
+    start = Clock::now();
+    bool repaired = repairPolygon(bad);
+    double tRepair = seconds(start);
+
+    printf("  n=%8d is_simple %8.3f s (%d)  validate %8.3f s (%d)  reject %8.3f s (%d)  repair %8.3f s (%d, %zu vertices)\n",
+           sizes[s], tSimple, simple, tValidate, report.valid(), tReject, badReport.valid(), tRepair,
+           repaired, bad.size());
+  }
+}
+
+//torus around the z axis sampled on a jittered nu x nv grid, as a quad
+//mesh or as points with outward normals
+static SurfaceSample noisyTorus(int nu, int nv, bool mesh, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> jitter(-0.25, 0.25);
+  SurfaceSample s;
+  for (int i = 0; i < nu; i++) {
+    for (int j = 0; j < nv; j++) {
+      double u = 2 * M_PI * (i + jitter(gen)) / nu, v = 2 * M_PI * (j + jitter(gen)) / nv;
+      s.points.push_back(Point_3((3 + std::cos(v)) * std::cos(u), (3 + std::cos(v)) * std::sin(u), std::sin(v)));
+      if (!mesh) s.normals.push_back(Vector_3(std::cos(v) * std::cos(u), std::cos(v) * std::sin(u), std::sin(v)));
+    }
+  }
+  for (int i = 0; mesh && i < nu; i++) {
+    for (int j = 0; j < nv; j++) {
+      int a = i * nv + j, b = (i + 1) % nu * nv + j, c = (i + 1) % nu * nv + (j + 1) % nv, d = i * nv + (j + 1) % nv;
+      int quad[6] = {a, b, c, a, c, d};
+      s.triangles.insert(s.triangles.end(), quad, quad + 6);
+    }
+  }
+  return s;
+}
+
+//3D mode on tori, the poles should sit on the core circle with radius 1
+static void benchSurface() {
+  printf("== surface: 3D medial axis from Delaunay_triangulation_3\n");
+  int sizes[][2] = {{96, 32}, {192, 64}, {384, 128}};
+  for (int s = 0; s < 3; s++) {
+    for (int mesh = 1; mesh >= 0; mesh--) {
+      SurfaceSample sample = noisyTorus(sizes[s][0], sizes[s][1], mesh != 0, 4);
+      Clock::time_point start = Clock::now();
+      SurfaceAxis axis = surfaceMedialAxis(sample);
+      double t = seconds(start);
+      size_t poles = 0;
+      double error = 0;
+      for (size_t i = 0; i < axis.balls.size(); i++) {
+        const MedialBall3 &b = axis.balls[i];
+        if (!b.pole) continue;
+        double d = std::sqrt(b.center.x() * b.center.x() + b.center.y() * b.center.y()) - 3;
+        error += std::sqrt(d * d + b.center.z() * b.center.z());
+        poles++;
+      }
+      printf("  n=%7zu %-7s %9.3f s  %7zu balls  %7zu faces  %6zu poles, mean distance to core %.4f\n",
+             sample.points.size(), mesh ? "mesh" : "normals", t, axis.balls.size(), axis.faces.size(),
+             poles, poles ? error / poles : 0.0);
+    }
+  }
+}
+
+//resident set size in bytes, freed heap given back first so runs in a row
+//do not hide each other
+static double residentBytes() {
+  malloc_trim(0);
+  std::ifstream statm("/proc/self/statm");
+  double pages = 0, resident = 0;
+  statm >> pages >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+//range insertion (spatially sorted) of n random points, then locate of n
+//queries in the same order, each walk starting from the previous answer
+template <class Triangulation>
+static void benchTdsRun(const char *label, const std::vector<Point> &points,
+                        const std::vector<Point> &queries) {
+  double before = residentBytes();
+  Clock::time_point start = Clock::now();
+  {
+    Triangulation t;
+    t.insert(points.begin(), points.end());
+    double tInsert = seconds(start);
+    double bytes = residentBytes() - before;
+
+    start = Clock::now();
+    typename Triangulation::Face_handle f;
+    for (size_t i = 0; i < queries.size(); i++) f = t.locate(queries[i], f);
+    double tLocate = seconds(start);
+    printf("  n=%8zu %-8s insert %7.3f s (%6.2f Mpts/s)  %6.1f B/vertex  locate %6.2f Mq/s\n",
+           points.size(), label, tInsert, points.size() / tInsert * 1e-6, bytes / points.size(),
+           queries.size() / tLocate * 1e-6);
+  }
+}
+
+//Delaunay_triangulation_2 over the default Tds against the index based one
+static void benchTds() {
+  printf("== tds: pointer based vs index based triangulation data structure\n");
+  size_t sizes[] = {100000, 1000000, 4000000};
+  for (int s = 0; s < 3; s++) {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<Point> points(sizes[s]), queries(sizes[s]);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+    for (size_t i = 0; i < queries.size(); i++) queries[i] = Point(coordinate(gen), coordinate(gen));
+    CGAL::spatial_sort(queries.begin(), queries.end());
+    benchTdsRun<PointerTriangulation>("pointer", points, queries);
+    benchTdsRun<IndexedTriangulation>("indexed", points, queries);
+  }
+}
+
+//queries in random order located one by one from the previous answer,
+//against the batched locate that sorts them first
+static void benchLocate() {
+  printf("== locate: one by one vs batched locate(range, out)\n");
+  size_t sizes[] = {100000, 1000000};
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<Point> points(sizes[s]), queries(1000000);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+    for (size_t i = 0; i < queries.size(); i++) queries[i] = Point(coordinate(gen), coordinate(gen));
+    PointerTriangulation t;
+    t.insert(points.begin(), points.end());
+
+    //the unsorted walks are long, a tenth of the queries is enough
+    size_t sample = queries.size() / 10;
+    Clock::time_point start = Clock::now();
+    PointerTriangulation::Face_handle f;
+    for (size_t i = 0; i < sample; i++) f = t.locate(queries[i], f);
+    double tSingle = seconds(start);
+
+    std::vector<PointerTriangulation::Face_handle> faces;
+    faces.reserve(queries.size());
+    start = Clock::now();
+    t.locate(queries.begin(), queries.end(), std::back_inserter(faces));
+    double tBatch = seconds(start);
+
+    faces.clear();
+    start = Clock::now();
+    t.locate(queries.begin(), queries.end(), std::back_inserter(faces), PointerTriangulation::Face_handle(),
+             CGAL::Parallel_tag());
+    double tParallel = seconds(start);
+    printf("  n=%8zu  one by one %6.2f Mq/s  batched %6.2f Mq/s  batched parallel %6.2f Mq/s\n", points.size(),
+           sample / tSingle * 1e-6, queries.size() / tBatch * 1e-6, queries.size() / tParallel * 1e-6);
+  }
+}
+
+//points inserted one by one in random order, then random queries, each
+//located without a start face
+template <class Triangulation>
+static void benchLocatorRun(const char *label, const std::vector<Point> &points,
+                            const std::vector<Point> &queries) {
+  double before = residentBytes();
+  Clock::time_point start = Clock::now();
+  {
+    Triangulation t;
+    for (size_t i = 0; i < points.size(); i++) t.insert(points[i]);
+    double tInsert = seconds(start);
+    double bytes = residentBytes() - before;
+
+    start = Clock::now();
+    size_t found = 0;
+    for (size_t i = 0; i < queries.size(); i++) found += !t.is_infinite(t.locate(queries[i]));
+    double tLocate = seconds(start);
+    printf("  n=%8zu %-9s insert %7.3f s (%6.2f Mpts/s)  %6.1f B/vertex  locate %6.2f Mq/s (%zu inside)\n",
+           points.size(), label, tInsert, points.size() / tInsert * 1e-6, bytes / points.size(),
+           queries.size() / tLocate * 1e-6, found);
+  }
+}
+
+//Triangulation_hierarchy_2 against the grid locator on uniform points,
+//the plain triangulation (walks from an arbitrary face) for reference
+static void benchLocator() {
+  printf("== locator: Triangulation_hierarchy_2 vs Triangulation_grid_locator_2\n");
+  size_t sizes[] = {100000, 1000000};
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(8);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<Point> points(sizes[s]), queries(1000000);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+    for (size_t i = 0; i < queries.size(); i++) queries[i] = Point(coordinate(gen), coordinate(gen));
+    if (s == 0) {
+      std::vector<Point> sample(queries.begin(), queries.begin() + queries.size() / 10);
+      benchLocatorRun<PointerTriangulation>("plain", points, sample);
+    }
+    benchLocatorRun<HierarchyTriangulation>("hierarchy", points, queries);
+    benchLocatorRun<GridTriangulation>("grid", points, queries);
+  }
+}
+
+//the heights stored at the vertices, for the interpolations
+struct TerrainHeight {
+  typedef std::pair<double, bool> result_type;
+  result_type operator()(TerrainTriangulation::Vertex_handle v) const { return std::make_pair(v->info(), true); }
+};
+
+//a terrain of scattered samples resampled on a regular grid given row by
+//row: natural_neighbor_coordinates_vertex_2 and linear_interpolation per
+//point, then natural_neighbor_interpolation_2 on the whole grid
+static void benchInterpolate() {
+  printf("== interpolate: one by one vs natural_neighbor_interpolation_2\n");
+  size_t sizes[] = {100000, 1000000};
+  const int side = 1000;
+  std::vector<Point> grid;
+  grid.reserve(side * side);
+  for (int j = 0; j < side; j++) {
+    for (int i = 0; i < side; i++) grid.push_back(Point(i + 0.5, j + 0.5));
+  }
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(10);
+    std::uniform_real_distribution<double> coordinate(0, side);
+    TerrainTriangulation t;
+    for (size_t i = 0; i < sizes[s]; i++) {
+      Point p(coordinate(gen), coordinate(gen));
+      t.insert(p)->info() = std::sin(p.x() * 0.01) * std::cos(p.y() * 0.013) * 100;
+    }
+
+    //a tenth of the grid is enough one by one
+    size_t sample = grid.size() / 10;
+    std::vector<double> heights(grid.size());
+    std::vector<std::pair<TerrainTriangulation::Vertex_handle, double> > coordinates;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < sample; i++) {
+      coordinates.clear();
+      double norm = CGAL::natural_neighbor_coordinates_vertex_2(t, grid[i], std::back_inserter(coordinates)).second;
+      heights[i] = CGAL::linear_interpolation(coordinates.begin(), coordinates.end(), norm, TerrainHeight());
+    }
+    double tSingle = seconds(start);
+
+    start = Clock::now();
+    size_t inside = CGAL::natural_neighbor_interpolation_2(t, grid.begin(), grid.end(), heights.begin(),
+                                                           TerrainHeight(), 0.0);
+    double tBatch = seconds(start);
+
+    start = Clock::now();
+    CGAL::natural_neighbor_interpolation_2(t, grid.begin(), grid.end(), heights.begin(), TerrainHeight(), 0.0,
+                                           CGAL::Parallel_tag());
+    double tParallel = seconds(start);
+    printf("  n=%8zu  one by one %6.3f Mq/s  batched %6.3f Mq/s  batched parallel %6.3f Mq/s (%zu inside)\n",
+           sizes[s], sample / tSingle * 1e-6, grid.size() / tBatch * 1e-6, grid.size() / tParallel * 1e-6, inside);
+  }
+}
+
+//a random fraction of the vertices removed one by one in random order,
+//then with remove(first, beyond)
+static void benchRemove() {
+  printf("== remove: one by one vs remove(first, beyond)\n");
+  double fractions[] = {0.1, 0.3, 0.5, 0.7};
+  std::mt19937 gen(9);
+  std::uniform_real_distribution<double> coordinate(0, 1000);
+  std::vector<Point> points(1000000);
+  for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+  for (int f = 0; f < 4; f++) {
+    double t[2];
+    for (int bulk = 0; bulk < 2; bulk++) {
+      PointerTriangulation dt;
+      dt.insert(points.begin(), points.end());
+      std::vector<PointerTriangulation::Vertex_handle> vertices;
+      for (PointerTriangulation::Finite_vertices_iterator v = dt.finite_vertices_begin();
+           v != dt.finite_vertices_end(); ++v) {
+        vertices.push_back(v);
+      }
+      std::shuffle(vertices.begin(), vertices.end(), gen);
+      vertices.resize((size_t) (fractions[f] * vertices.size()));
+      Clock::time_point start = Clock::now();
+      if (bulk) {
+        dt.remove(vertices.begin(), vertices.end());
+      } else {
+        for (size_t i = 0; i < vertices.size(); i++) dt.remove(vertices[i]);
+      }
+      t[bulk] = seconds(start);
+    }
+    printf("  n=%8zu remove %2.0f%%  one by one %7.3f s  bulk %7.3f s\n", points.size(), fractions[f] * 100, t[0], t[1]);
+  }
+}
+
+//the edges of a layer of small disjoint polygons, one per cell of a grid,
+//the polygons in random order as in a shapefile
+static std::vector<Segment> polygonLayer(int cells, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> unit(0, 1);
+  std::uniform_int_distribution<int> sides(5, 12);
+  std::vector<std::vector<Segment> > polygons;
+  for (int x = 0; x < cells; x++) {
+    for (int y = 0; y < cells; y++) {
+      int n = sides(gen);
+      std::vector<Point> p;
+      for (int i = 0; i < n; i++) {
+        double a = 2 * M_PI * (i + 0.8 * unit(gen)) / n;
+        double r = 0.2 + 0.25 * unit(gen);
+        p.push_back(Point(x + 0.5 + r * std::cos(a), y + 0.5 + r * std::sin(a)));
+      }
+      polygons.push_back(std::vector<Segment>());
+      for (int i = 0; i < n; i++) polygons.back().push_back(Segment(p[i], p[(i + 1) % n]));
+    }
+  }
+  std::shuffle(polygons.begin(), polygons.end(), gen);
+  std::vector<Segment> segments;
+  for (size_t i = 0; i < polygons.size(); i++) {
+    segments.insert(segments.end(), polygons[i].begin(), polygons[i].end());
+  }
+  return segments;
+}
+
+template <class Tr>
+static void benchConstraintsRun(const char *label, const std::vector<Segment> &segments) {
+  double t[2];
+  size_t vertices = 0;
+  for (int bulk = 0; bulk < 2; bulk++) {
+    Tr tr;
+    Clock::time_point start = Clock::now();
+    if (bulk) {
+      tr.insert_constraints(segments.begin(), segments.end());
+    } else {
+      for (size_t i = 0; i < segments.size(); i++) tr.insert_constraint(segments[i].source(), segments[i].target());
+    }
+    t[bulk] = seconds(start);
+    vertices = tr.number_of_vertices();
+  }
+  printf("  %-10s edges=%8zu vertices=%8zu  one by one %7.3f s  insert_constraints %7.3f s\n", label,
+         segments.size(), vertices, t[0], t[1]);
+}
+
+//constraints inserted one by one against insert_constraints()
+static void benchConstraints() {
+  printf("== constraints: insert_constraint loop vs insert_constraints\n");
+  int cells[] = {100, 200, 300};
+  for (int c = 0; c < 3; c++) {
+    std::vector<Segment> segments = polygonLayer(cells[c], 10);
+    benchConstraintsRun<ConstrainedTriangulation>("cdt", segments);
+    benchConstraintsRun<ConstrainedTriangulationPlus>("cdt plus", segments);
+  }
+}
+
+//the noisy star meshed with refine_mesh() and refine_mesh(Parallel_tag)
+static void benchMesh() {
+  printf("== mesh: Delaunay_mesher_2 sequential vs parallel\n");
+  double sizes[] = {4, 2, 1};
+  Polygon_2 p = noisyStar(200, 0.02, 11);
+  for (int s = 0; s < 3; s++) {
+    double t[2];
+    size_t vertices[2];
+    for (int parallel = 0; parallel < 2; parallel++) {
+      MeshTriangulation cdt;
+      for (size_t i = 0; i < p.size(); i++) cdt.insert_constraint(p.vertex(i), p.vertex((i + 1) % p.size()));
+      CGAL::Delaunay_mesher_2<MeshTriangulation, MeshCriteria> mesher(cdt, MeshCriteria(0.125, sizes[s]));
+      Clock::time_point start = Clock::now();
+      if (parallel) {
+        mesher.refine_mesh(CGAL::Parallel_tag());
+      } else {
+        mesher.refine_mesh();
+      }
+      t[parallel] = seconds(start);
+      vertices[parallel] = cdt.number_of_vertices();
+    }
+    printf("  size %4.1f  sequential %7.3f s %8zu vertices  parallel %7.3f s %8zu vertices\n", sizes[s], t[0],
+           vertices[0], t[1], vertices[1]);
+  }
+}
+
+//faces in the domain of a mesh, its smallest angle in degrees and the share
+//of angles under minDegrees
+static void meshQuality(const MeshTriangulation &cdt, double minDegrees, size_t &faces, double &smallest,
+                        double &under) {
+  faces = 0;
+  smallest = 180;
+  size_t below = 0;
+  for (MeshTriangulation::Finite_faces_iterator f = cdt.finite_faces_begin(); f != cdt.finite_faces_end(); ++f) {
+    if (!f->is_in_domain()) continue;
+    faces++;
+    for (int i = 0; i < 3; i++) {
+      K::Vector_2 u = f->vertex((i + 1) % 3)->point() - f->vertex(i)->point();
+      K::Vector_2 v = f->vertex((i + 2) % 3)->point() - f->vertex(i)->point();
+      double angle = std::acos(u * v / std::sqrt(u.squared_length() * v.squared_length())) * 180 / M_PI;
+      smallest = std::min(smallest, angle);
+      if (angle < minDegrees) below++;
+    }
+  }
+  under = faces ? 100.0 * below / (3 * faces) : 0;
+}
+
+//the noisy star meshed with the 20.7 degree bound of the mesh section and
+//optimized by lloyd_optimize_mesh_2() or odt_optimize_mesh_2(), against
+//meshing it with a 25.8 degree bound
+static void benchOptimize() {
+  printf("== optimize: refine_mesh with a tighter bound vs lloyd/odt_optimize_mesh_2\n");
+  double sizes[] = {0, 8, 2};
+  double bounds[] = {0.125, 0.19, 0.125, 0.125};
+  const char *labels[] = {"B=0.125", "B=0.19", "B=0.125+lloyd", "B=0.125+odt"};
+  Polygon_2 p = noisyStar(200, 0.02, 11);
+  for (int s = 0; s < 3; s++) {
+    for (int run = 0; run < 4; run++) {
+      MeshTriangulation cdt;
+      for (size_t i = 0; i < p.size(); i++) cdt.insert_constraint(p.vertex(i), p.vertex((i + 1) % p.size()));
+      Clock::time_point start = Clock::now();
+      CGAL::refine_Delaunay_mesh_2(cdt, MeshCriteria(bounds[run], sizes[s]));
+      double tMesh = seconds(start);
+      start = Clock::now();
+      if (run == 2) CGAL::lloyd_optimize_mesh_2(cdt, CGAL::parameters::max_iteration_number = 100);
+      if (run == 3) CGAL::odt_optimize_mesh_2(cdt, CGAL::parameters::max_iteration_number = 100);
+      double tOptimize = seconds(start);
+      size_t faces;
+      double smallest, under;
+      meshQuality(cdt, 25.8, faces, smallest, under);
+      printf("  size %4.1f %-13s %8zu faces  smallest angle %5.2f  under 25.8 %5.2f%%  mesh %7.3f s  optimize %7.3f s\n",
+             sizes[s], labels[run], faces, smallest, under, tMesh, tOptimize);
+    }
+  }
+}
+
+//faces of a 2D data structure, cells of a 3D one
+static PointerTriangulation::Triangulation_data_structure::Face_range &faceContainer(
+    PointerTriangulation::Triangulation_data_structure &tds) { return tds.faces(); }
+static Triangulation3::Triangulation_data_structure::Cell_range &faceContainer(
+    Triangulation3::Triangulation_data_structure &tds) { return tds.cells(); }
+
+//rounds of building the triangulation of the same points, emptied between
+//rounds by clear() (every block freed) or reset() after a reserve() (the
+//blocks are kept)
+template <class Triangulation, class Points>
+static void benchRebuildRun(const char *label, const Points &points, size_t faces, int rounds) {
+  for (int keep = 0; keep < 2; keep++) {
+    Triangulation t;
+    if (keep) {
+      t.tds().vertices().reserve(points.size() + 1);
+      faceContainer(t.tds()).reserve(faces);
+    }
+    double first = 0;
+    Clock::time_point start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+      if (keep) t.reset();
+      else t.clear();
+      t.insert(points.begin(), points.end());
+      if (r == 0) first = seconds(start);
+    }
+    double total = seconds(start);
+    printf("  n=%8zu %-4s %-7s first %7.3f s  then %7.3f s/round\n", points.size(), label,
+           keep ? "reset" : "clear", first, (total - first) / (rounds - 1));
+  }
+}
+
+//what must be the same after a refill: the vertices, plus the hidden
+//vertices of a regular triangulation and the constraints of CT+
+template <class Triangulation>
+static std::vector<size_t> refillState(Triangulation &t) {
+  return std::vector<size_t>(1, t.number_of_vertices());
+}
+static std::vector<size_t> refillState(RegularTriangulation &t) {
+  size_t state[] = {t.number_of_vertices(), t.number_of_hidden_vertices()};
+  return std::vector<size_t>(state, state + 2);
+}
+static std::vector<size_t> refillState(ConstrainedTriangulationPlus &t) {
+  size_t state[] = {t.number_of_vertices(), t.number_of_constraints(), t.number_of_subconstraints()};
+  return std::vector<size_t>(state, state + 3);
+}
+
+template <class Triangulation, class Input>
+static void refill(Triangulation &t, const Input &input) {
+  t.insert(input.begin(), input.end());
+}
+//the points, and a polyline through the first 200 of them as constraints
+static void refill(ConstrainedTriangulationPlus &t, const std::vector<Point> &input) {
+  t.insert(input.begin(), input.end());
+  for (size_t i = 1; i < 200 && i < input.size(); i++) t.insert_constraint(input[i - 1], input[i]);
+}
+
+//a triangulation filled, emptied by reset() and filled again must match a
+//fresh one; the classes here keep state beside the data structure
+template <class Triangulation, class Input>
+static void benchRefillRun(const char *label, const Input &input) {
+  Triangulation fresh, t;
+  refill(fresh, input);
+  refill(t, input);
+  t.reset();
+  refill(t, input);
+  bool same = t.is_valid() && refillState(t) == refillState(fresh);
+  printf("  %-12s %8zu vertices  refilled after reset() %s\n", label, (size_t) t.number_of_vertices(),
+         same ? "ok" : "MISMATCH");
+}
+
+//Delaunay_triangulation_2 and _3 built again and again, as an interactive
+//tool does when the input moves; then the classes overriding reset()
+//refilled after one
+static void benchRebuild() {
+#ifdef CGAL_USE_HUGE_PAGES
+  printf("== rebuild: clear() vs reserve() + reset(), huge page allocator\n");
+#else
+  printf("== rebuild: clear() vs reserve() + reset(), std::allocator\n");
+#endif
+  size_t sizes[] = {100000, 1000000};
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(6);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<Point> points(sizes[s]);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+    benchRebuildRun<PointerTriangulation>("2D", points, 2 * points.size() + 2, 5);
+  }
+  size_t sizes3[] = {100000, 500000};
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(6);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<Point_3> points(sizes3[s]);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point_3(coordinate(gen), coordinate(gen), coordinate(gen));
+    benchRebuildRun<Triangulation3>("3D", points, 7 * points.size(), 5);
+  }
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> coordinate(0, 1000), weight(0, 100);
+  std::vector<Point> points(20000);
+  std::vector<Point_3> points3(20000);
+  std::vector<RegularTriangulation::Weighted_point> weighted(20000);
+  for (size_t i = 0; i < points.size(); i++) {
+    points[i] = Point(coordinate(gen), coordinate(gen));
+    points3[i] = Point_3(coordinate(gen), coordinate(gen), coordinate(gen));
+    weighted[i] = RegularTriangulation::Weighted_point(points[i], weight(gen));
+  }
+  benchRefillRun<HierarchyTriangulation>("hierarchy 2D", points);
+  benchRefillRun<HierarchyTriangulation3>("hierarchy 3D", points3);
+  benchRefillRun<GridTriangulation>("grid locator", points);
+  benchRefillRun<RegularTriangulation>("regular", weighted);
+  benchRefillRun<ConstrainedTriangulationPlus>("CT+", points);
+}
+
+//a triangulation written with binary_output() to memory and read back with
+//binary_input(), with and without is_valid(); building it again from the
+//points with the spatially sorted insert(first, last) for reference, and
+//corrupt copies of the file that must be rejected
+template <class Triangulation>
+static void benchSerializeRun(const char *label, const std::vector<Point> &points) {
+  Triangulation t;
+  t.insert(points.begin(), points.end());
+  Clock::time_point start = Clock::now();
+  Triangulation built;
+  built.insert(points.begin(), points.end());
+  double tInsert = seconds(start);
+
+  std::stringstream stream;
+  start = Clock::now();
+  t.binary_output(stream);
+  double tWrite = seconds(start);
+
+  Triangulation read;
+  start = Clock::now();
+  bool ok = read.binary_input(stream);
+  double tRead = seconds(start);
+
+  stream.clear();
+  stream.seekg(0);
+  start = Clock::now();
+  ok = read.binary_input(stream, true) && ok;
+  double tChecked = seconds(start);
+  //the points are found again, through the grid of the grid locator
+  for (size_t i = 0; i < points.size(); i += points.size() / 16)
+    ok = read.nearest_vertex(points[i])->point() == points[i] && ok;
+
+  //a header claiming 2^40 vertices, one claiming 2^32 - 16 faces and a file
+  //cut in half must all be rejected, without allocating what they claim;
+  //the vertex and face counts follow the 20 byte file header and the
+  //dimension
+  std::string bytes = stream.str();
+  std::string manyVertices = bytes, manyFaces = bytes;
+  uint64_t count = uint64_t(1) << 40;
+  memcpy(&manyVertices[24], &count, sizeof(count));
+  count = 0xFFFFFFF0u;
+  memcpy(&manyFaces[32], &count, sizeof(count));
+  std::string corrupt[] = {manyVertices, manyFaces, bytes.substr(0, bytes.size() / 2)};
+  for (int c = 0; c < 3; c++) {
+    std::istringstream in(corrupt[c]);
+    ok = !read.binary_input(in) && ok;
+  }
+  printf("  n=%8zu %-7s insert %6.3f s  write %6.3f s  read %6.3f s  read+check %6.3f s  (%.1f MB%s)\n",
+         points.size(), label, tInsert, tWrite, tRead, tChecked, bytes.size() * 1e-6, ok ? "" : ", FAILED");
+}
+
+static void benchSerialize() {
+  printf("== serialize: binary_output()/binary_input() vs insert(first, last)\n");
+  size_t sizes[] = {100000, 1000000};
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<Point> points(sizes[s]);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+    benchSerializeRun<PointerTriangulation>("pointer", points);
+    benchSerializeRun<IndexedTriangulation>("indexed", points);
+    benchSerializeRun<GridTriangulation>("grid", points);
+  }
+}
+
+//sites inserted one by one by decreasing weight (the order insert(first,
+//last) used) against the range insert; the visible and hidden counts must
+//agree
+struct HeavierSite {
+  bool operator()(const ApolloniusTraits::Site_2 &a, const ApolloniusTraits::Site_2 &b) const {
+    return a.weight() > b.weight();
+  }
+};
+
+template <class Graph>
+static void benchApolloniusRun(const char *label, const std::vector<ApolloniusTraits::Site_2> &sites,
+                               double maxWeight) {
+  Clock::time_point start = Clock::now();
+  std::vector<ApolloniusTraits::Site_2> sorted(sites);
+  std::sort(sorted.begin(), sorted.end(), HeavierSite());
+  Graph byWeight;
+  for (size_t i = 0; i < sorted.size(); i++) byWeight.insert(sorted[i]);
+  double tByWeight = seconds(start);
+
+  start = Clock::now();
+  Graph range;
+  range.insert(sites.begin(), sites.end());
+  double tRange = seconds(start);
+  bool same = byWeight.number_of_vertices() == range.number_of_vertices() &&
+              byWeight.number_of_hidden_sites() == range.number_of_hidden_sites();
+  printf("  n=%8zu w<%-3g %-9s by weight %6.3f s  insert(first, last) %6.3f s  (%zu visible, %zu hidden%s)\n",
+         sites.size(), maxWeight, label, tByWeight, tRange, size_t(range.number_of_vertices()),
+         size_t(range.number_of_hidden_sites()), same ? "" : ", MISMATCH");
+}
+
+static void benchApollonius() {
+  printf("== apollonius: insert() by decreasing weight vs insert(first, last)\n");
+  double weights[] = {1, 20};
+  for (int w = 0; w < 2; w++) {
+    std::mt19937 gen(13);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::uniform_real_distribution<double> weight(0, weights[w]);
+    std::vector<ApolloniusTraits::Site_2> sites(100000);
+    for (size_t i = 0; i < sites.size(); i++)
+      sites[i] = ApolloniusTraits::Site_2(Point(coordinate(gen), coordinate(gen)), weight(gen));
+    benchApolloniusRun<ApolloniusGraph>("graph", sites, weights[w]);
+    benchApolloniusRun<ApolloniusGraphHierarchy>("hierarchy", sites, weights[w]);
+  }
+}
+
+//total length of the bounded Voronoi edges, three times through the
+//Voronoi_diagram_2 adaptor (each time constructing the circumcenters)
+//against materialize() once and three times through the flat arrays
+static double voronoiLength(const VoronoiDiagram &vd) {
+  double length = 0;
+  for (VoronoiDiagram::Edge_iterator e = vd.edges_begin(); e != vd.edges_end(); ++e) {
+    if (e->has_source() && e->has_target())
+      length += std::sqrt(CGAL::squared_distance(e->source()->point(), e->target()->point()));
+  }
+  return length;
+}
+
+static double voronoiLength(const CGAL::Flat_voronoi_diagram_2 &flat) {
+  double length = 0;
+  for (size_t h = 0; h < flat.number_of_halfedges(); h += 2) {
+    if (flat.is_on_boundary(int(h))) continue;
+    int s = flat.source(int(h)), t = flat.target(int(h));
+    length += std::hypot(flat.points[2 * t] - flat.points[2 * s], flat.points[2 * t + 1] - flat.points[2 * s + 1]);
+  }
+  return length;
+}
+
+//every face of a flat diagram closes with a positive area, no half-edge
+//has zero length, and the areas of the faces add up to the box
+static bool flatDiagramValid(const CGAL::Flat_voronoi_diagram_2 &flat) {
+  const std::vector<double> &p = flat.points;
+  for (size_t h = 0; h < flat.number_of_halfedges(); h++) {
+    int s = flat.source(int(h)), t = flat.target(int(h));
+    if (p[2 * s] == p[2 * t] && p[2 * s + 1] == p[2 * t + 1]) return false;
+  }
+  double total = 0;
+  for (size_t f = 0; f < flat.number_of_faces(); f++) {
+    int first = flat.face_halfedge[f], h = first;
+    if (first < 0) continue;
+    double area = 0;
+    size_t steps = 0;
+    do {
+      if (flat.face(h) != int(f) || ++steps > flat.number_of_halfedges()) return false;
+      int s = flat.source(h), t = flat.target(h);
+      area += p[2 * s] * p[2 * t + 1] - p[2 * t] * p[2 * s + 1];
+      h = flat.next(h);
+    } while (h != first);
+    if (area <= 0) return false;
+    total += area / 2;
+  }
+  const CGAL::Bbox_2 &box = flat.bbox;
+  double boxArea = (box.xmax() - box.xmin()) * (box.ymax() - box.ymin());
+  return std::fabs(total - boxArea) <= 1e-9 * boxArea;
+}
+
+static void benchVoronoi() {
+  printf("== voronoi: Voronoi_diagram_2 traversals vs materialize()\n");
+  size_t sizes[] = {100000, 1000000};
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(14);
+    std::uniform_real_distribution<double> coordinate(0, 1000);
+    std::vector<Point> points(sizes[s]);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+    PointerTriangulation t;
+    t.insert(points.begin(), points.end());
+    VoronoiDiagram vd(t, true);
+
+    Clock::time_point start = Clock::now();
+    double length = 0;
+    for (int pass = 0; pass < 3; pass++) length = voronoiLength(vd);
+    double tAdaptor = seconds(start);
+
+    CGAL::Bbox_2 box(-1000, -1000, 2000, 2000);
+    CGAL::Flat_voronoi_diagram_2 flat;
+    start = Clock::now();
+    vd.materialize(flat, box);
+    double tMaterialize = seconds(start);
+    start = Clock::now();
+    double flatLength = 0;
+    for (int pass = 0; pass < 3; pass++) flatLength = voronoiLength(flat);
+    double tFlat = seconds(start);
+
+    start = Clock::now();
+    vd.materialize(flat, box, CGAL::Parallel_tag());
+    double tParallel = seconds(start);
+    printf("  n=%8zu  adaptor 3 passes %6.3f s  materialize %6.3f s (parallel %6.3f s) + 3 passes %6.3f s"
+           "  (edge lengths %.3g, %.3g in the box%s)\n", points.size(), tAdaptor, tMaterialize, tParallel, tFlat,
+           length, flatLength, flatDiagramValid(flat) ? "" : ", INVALID");
+  }
+
+  //sites on the integer grid: the Voronoi edges lie on the lines x = i + 1/2
+  //and y = j + 1/2, so a box on those lines has a Voronoi edge along each
+  //side, Voronoi vertices on its sides and corners, and edges clipped to a
+  //point there; a box through the sites has none of these
+  PointerTriangulation grid;
+  for (int i = 0; i < 20; i++)
+    for (int j = 0; j < 20; j++) grid.insert(Point(i, j));
+  VoronoiDiagram gridVd(grid, true);
+  CGAL::Bbox_2 boxes[] = {CGAL::Bbox_2(2.5, 2.5, 12.5, 8.5), CGAL::Bbox_2(3, 3, 13, 9)};
+  bool valid[2];
+  for (int b = 0; b < 2; b++) {
+    CGAL::Flat_voronoi_diagram_2 flat;
+    gridVd.materialize(flat, boxes[b]);
+    valid[b] = flatDiagramValid(flat);
+    gridVd.materialize(flat, boxes[b], CGAL::Parallel_tag());
+    valid[b] = flatDiagramValid(flat) && valid[b];
+  }
+  printf("  grid 20x20  box on the Voronoi edges %s  box through the sites %s\n",
+         valid[0] ? "valid" : "INVALID", valid[1] ? "valid" : "INVALID");
+}
+
+//the polygon layers of the constraints section, inserted with
+//insert_segments() one site after the other against Parallel_tag; the
+//diagrams must have the same sites and edges
+static void benchSdg() {
+  printf("== sdg: Segment_Delaunay_graph_2 insert_segments() sequential vs parallel\n");
+  int cells[] = {100, 200};
+  for (int c = 0; c < 2; c++) {
+    std::vector<Segment> segments = polygonLayer(cells[c], 10);
+    Clock::time_point start = Clock::now();
+    SegmentDelaunayGraph sequential;
+    sequential.insert_segments(segments.begin(), segments.end());
+    double tSequential = seconds(start);
+
+    start = Clock::now();
+    SegmentDelaunayGraph parallel;
+    parallel.insert_segments(segments.begin(), segments.end(), CGAL::Parallel_tag());
+    double tParallel = seconds(start);
+    bool same = sequential.number_of_vertices() == parallel.number_of_vertices() &&
+                sequential.number_of_input_sites() == parallel.number_of_input_sites() &&
+                sequential.tds().number_of_edges() == parallel.tds().number_of_edges();
+    printf("  n=%8zu  sequential %7.3f s  parallel %7.3f s  (%zu vertices%s)\n", segments.size(), tSequential,
+           tParallel, size_t(parallel.number_of_vertices()), same ? "" : ", MISMATCH");
+  }
+}
+
+static double wrapped(double x) { return x - std::floor(x); }
+
+static K::Point_2 moved(const K::Point_2 &p, double dx, double dy, double) {
+  return K::Point_2(wrapped(p.x() + dx), wrapped(p.y() + dy));
+}
+
+static K::Point_3 moved(const K::Point_3 &p, double dx, double dy, double dz) {
+  return K::Point_3(wrapped(p.x() + dx), wrapped(p.y() + dy), wrapped(p.z() + dz));
+}
+
+//particles in the unit square or cube, moved by a small random step and
+//wrapped around at every timestep; the triangulation is rebuilt from
+//scratch each time, one point at a time (the covering-space start the
+//range insert used before it checked for the 1-cover), with the range
+//insert and with Parallel_tag; with duplicateEvery > 0, every such point
+//is a copy of the one before it
+template <class PT>
+static void benchPeriodicRun(const char *label, std::vector<typename PT::Point> &points,
+                             size_t duplicateEvery = 0) {
+  const int STEPS = 5;
+  std::mt19937 gen(15);
+  std::uniform_real_distribution<double> step(-0.002, 0.002);
+  double tOne = 0, tRange = 0, tParallel = 0;
+  bool same = true;
+  PT one, range, parallel;
+  for (int t = 0; t < STEPS; t++) {
+    for (size_t i = 0; i < points.size(); i++) {
+      double dx = step(gen), dy = step(gen), dz = step(gen);
+      points[i] = moved(points[i], dx, dy, dz);
+    }
+    for (size_t i = duplicateEvery; duplicateEvery > 0 && i < points.size(); i += duplicateEvery)
+      points[i] = points[i - 1];
+    Clock::time_point start = Clock::now();
+    one.clear();
+    for (size_t i = 0; i < points.size(); i++) one.insert(points[i]);
+    tOne += seconds(start);
+    start = Clock::now();
+    range.clear();
+    range.insert(points.begin(), points.end());
+    tRange += seconds(start);
+    start = Clock::now();
+    parallel.clear();
+    parallel.insert(points.begin(), points.end(), CGAL::Parallel_tag());
+    tParallel += seconds(start);
+    same = same && one.number_of_vertices() == parallel.number_of_vertices() &&
+           range.number_of_vertices() == parallel.number_of_vertices() && parallel.is_1_cover();
+  }
+  printf("  %s n=%7zu  per timestep: one at a time %7.3f s  range %7.3f s  parallel %7.3f s%s\n", label,
+         points.size(), tOne / STEPS, tRange / STEPS, tParallel / STEPS, same ? "" : "  MISMATCH");
+}
+
+static void benchPeriodic() {
+  printf("== periodic: per-timestep rebuild of periodic Delaunay triangulations\n");
+  std::mt19937 gen(16);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  size_t sizes2[] = {10000, 100000};
+  for (int s = 0; s < 2; s++) {
+    std::vector<PeriodicTriangulation2::Point> points(sizes2[s]);
+    for (size_t i = 0; i < points.size(); i++)
+      points[i] = PeriodicTriangulation2::Point(coordinate(gen), coordinate(gen));
+    benchPeriodicRun<PeriodicTriangulation2>("P2", points);
+  }
+  std::vector<PeriodicTriangulation2::Point> duplicated(10000);
+  for (size_t i = 0; i < duplicated.size(); i++)
+    duplicated[i] = PeriodicTriangulation2::Point(coordinate(gen), coordinate(gen));
+  benchPeriodicRun<PeriodicTriangulation2>("P2 dup", duplicated, 10);
+  size_t sizes3[] = {5000, 20000};
+  for (int s = 0; s < 2; s++) {
+    std::vector<PeriodicTriangulation3::Point> points(sizes3[s]);
+    for (size_t i = 0; i < points.size(); i++)
+      points[i] = PeriodicTriangulation3::Point(coordinate(gen), coordinate(gen), coordinate(gen));
+    benchPeriodicRun<PeriodicTriangulation3>("P3", points);
+  }
+  std::vector<PeriodicTriangulation3::Point> duplicated3(5000);
+  for (size_t i = 0; i < duplicated3.size(); i++)
+    duplicated3[i] = PeriodicTriangulation3::Point(coordinate(gen), coordinate(gen), coordinate(gen));
+  benchPeriodicRun<PeriodicTriangulation3>("P3 dup", duplicated3, 10);
+}
+
+//random points; the edges of the regularized alpha shape are listed for
+//200 alpha-values spread over the spectrum, then followed from each value
+//of the spectrum to the next one, and find_optimal_alpha() is asked for
+//1 to 4 components
+static void benchAlpha() {
+  printf("== alpha: Alpha_shape_2 sweeps over the alpha spectrum\n");
+  size_t sizes[] = {100000, 300000};
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(17);
+    std::uniform_real_distribution<double> coordinate(0, 1);
+    std::vector<Point> points(sizes[s]);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+
+    Clock::time_point start = Clock::now();
+    AlphaShape shape(points.begin(), points.end(), 0, AlphaShape::REGULARIZED);
+    double tBuild = seconds(start);
+
+    start = Clock::now();
+    size_t listed = 0;
+    size_t step = shape.number_of_alphas() / 200 + 1;
+    for (size_t i = 0; i < shape.number_of_alphas(); i += step) {
+      shape.set_alpha(shape.get_nth_alpha(i));
+      listed += std::distance(shape.alpha_shape_edges_begin(), shape.alpha_shape_edges_end());
+    }
+    double tList = seconds(start);
+
+    start = Clock::now();
+    size_t changed = 0;
+    std::vector<AlphaShape::Edge> added, removed;
+    for (AlphaShape::Alpha_iterator it = shape.alpha_begin(); it + 1 < shape.alpha_end(); ++it) {
+      added.clear();
+      removed.clear();
+      shape.alpha_shape_edges_change(*it, *(it + 1), std::back_inserter(added), std::back_inserter(removed));
+      changed += added.size() + removed.size();
+    }
+    double tChange = seconds(start);
+
+    start = Clock::now();
+    for (size_t c = 1; c <= 4; c++) shape.find_optimal_alpha(c);
+    double tOptimal = seconds(start);
+    printf("  n=%8zu  build %6.3f s  200 lists %6.3f s (%zu edges)  %zu steps %6.3f s (%zu changes)"
+           "  4 optimal alphas %6.3f s\n", points.size(), tBuild, tList, listed, shape.number_of_alphas() - 1,
+           tChange, changed, tOptimal);
+  }
+}
+
+//rectilinear outline of n unit wide steps of random height, closed by one
+//long bottom edge, so half the vertices are reflex
+static Polygon_2 skyline(int n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> height(1, 20);
+  Polygon_2 p;
+  p.push_back(Point(0, 0));
+  p.push_back(Point(n, 0));
+  for (int i = n; i > 0; i--) {
+    double h = height(gen);
+    p.push_back(Point(i, h));
+    p.push_back(Point(i - 1, h));
+  }
+  return p;
+}
+
+//m x m notched rectangular holes (clockwise) in a square of side 10 m
+static void notchedBlocks(int m, unsigned seed, Polygon_2 &outer, std::vector<Polygon_2> &holes) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> unit(0, 1);
+  outer.clear();
+  outer.push_back(Point(0, 0));
+  outer.push_back(Point(10 * m, 0));
+  outer.push_back(Point(10 * m, 10 * m));
+  outer.push_back(Point(0, 10 * m));
+  holes.clear();
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) {
+      double x = 10 * i + 2 + unit(gen), y = 10 * j + 2 + unit(gen);
+      double w = 4 + 2 * unit(gen), h = 4 + 2 * unit(gen);
+      Polygon_2 hole;
+      hole.push_back(Point(x, y));
+      hole.push_back(Point(x, y + h));
+      hole.push_back(Point(x + w, y + h));
+      hole.push_back(Point(x + w, y + h / 2));
+      hole.push_back(Point(x + w / 2, y + h / 2));
+      hole.push_back(Point(x + w / 2, y));
+      holes.push_back(hole);
+    }
+  }
+}
+
+//interior straight skeleton of a star, a skyline and an m x m block of
+//notched rectangular holes in a square
+static void benchSkeletonRun(const char *label, const Polygon_2 &outer, const std::vector<Polygon_2> &holes) {
+  SkeletonBuilder builder;
+  builder.enter_contour(outer.vertices_begin(), outer.vertices_end());
+  size_t n = outer.size();
+  for (size_t i = 0; i < holes.size(); i++) {
+    builder.enter_contour(holes[i].vertices_begin(), holes[i].vertices_end());
+    n += holes[i].size();
+  }
+  Clock::time_point start = Clock::now();
+  boost::shared_ptr<StraightSkeleton> skeleton = builder.construct_skeleton();
+  double t = seconds(start);
+  if (skeleton)
+    printf("  %-8s n=%6zu  %7.3f s  %zu skeleton vertices\n", label, n, t, skeleton->size_of_vertices());
+  else
+    printf("  %-8s n=%6zu  %7.3f s  FAILED\n", label, n, t);
+}
+
+static void benchSkeleton() {
+  printf("== skeleton: Straight_skeleton_builder_2 on polygons with many reflex vertices\n");
+  std::vector<Polygon_2> none;
+  benchSkeletonRun("star", noisyStar(2000, 0.05, 18), none);
+  benchSkeletonRun("skyline", skyline(3000, 18), none);
+  Polygon_2 outer;
+  std::vector<Polygon_2> holes;
+  notchedBlocks(20, 18, outer, holes);
+  benchSkeletonRun("blocks", outer, holes);
+}
+
+//toolpath-like offsets: levels evenly spaced up to maxOffset, as one
+//create_interior_skeleton_and_offset_polygons_2() per level (a skeleton
+//each), as construct_offset_contours() per level on one skeleton, and as
+//one batch on that skeleton, sequential and with Parallel_tag
+static void benchOffsetRun(const char *label, const Polygon_2 &outer, const std::vector<Polygon_2> &holes,
+                           int levels, double maxOffset) {
+  typedef boost::shared_ptr<Polygon_2> PolygonPtr;
+  typedef CGAL::Polygon_offset_builder_2<StraightSkeleton, CGAL::Polygon_offset_builder_traits_2<K>, Polygon_2>
+    OffsetBuilder;
+  std::vector<double> offsets;
+  for (int i = 1; i <= levels; i++) offsets.push_back(maxOffset * i / levels);
+
+  Clock::time_point start = Clock::now();
+  size_t points = 0;
+  for (int i = 0; i < levels; i++) {
+    std::vector<PolygonPtr> contours =
+      CGAL::create_interior_skeleton_and_offset_polygons_2(offsets[i], outer, holes.begin(), holes.end(), K());
+    for (size_t c = 0; c < contours.size(); c++) points += contours[c]->size();
+  }
+  double tEach = seconds(start);
+
+  start = Clock::now();
+  boost::shared_ptr<StraightSkeleton> skeleton = CGAL::CGAL_SS_i::create_partial_interior_straight_skeleton_2(
+    maxOffset, outer.vertices_begin(), outer.vertices_end(), holes.begin(), holes.end(), K());
+  double tSkeleton = seconds(start);
+  OffsetBuilder builder(*skeleton);
+
+  start = Clock::now();
+  std::vector<std::vector<PolygonPtr> > single(levels);
+  for (int i = 0; i < levels; i++) builder.construct_offset_contours(offsets[i], std::back_inserter(single[i]));
+  double tSingle = seconds(start);
+
+  start = Clock::now();
+  std::vector<std::vector<PolygonPtr> > batch(levels);
+  builder.construct_offset_contours(offsets.begin(), offsets.end(), batch.begin());
+  double tBatch = seconds(start);
+
+  start = Clock::now();
+  std::vector<std::vector<PolygonPtr> > parallel(levels);
+  builder.construct_offset_contours(offsets.begin(), offsets.end(), parallel.begin(), CGAL::Parallel_tag());
+  double tParallel = seconds(start);
+
+  bool same = true;
+  for (int i = 0; i < levels; i++) {
+    same = same && single[i].size() == batch[i].size() && single[i].size() == parallel[i].size();
+    for (size_t c = 0; same && c < single[i].size(); c++)
+      same = *single[i][c] == *batch[i][c] && *single[i][c] == *parallel[i][c];
+  }
+  printf("  %-8s %3d levels  skeleton each %7.3f s (%zu points)  skeleton once %6.3f s + per level %6.3f s"
+         "  batch %6.3f s  parallel %6.3f s%s\n", label, levels, tEach, points, tSkeleton, tSingle, tBatch,
+         tParallel, same ? "" : "  MISMATCH");
+}
+
+static void benchOffset() {
+  printf("== offset: many offset levels of one polygon\n");
+  std::vector<Polygon_2> none;
+  benchOffsetRun("star", noisyStar(300, 0.05, 19), none, 50, 40);
+  Polygon_2 outer;
+  std::vector<Polygon_2> holes;
+  notchedBlocks(6, 19, outer, holes);
+  benchOffsetRun("blocks", outer, holes, 200, 2.5);
+}
+
+//building footprints: rectangles scattered over the blocks of a grid of
+//streets, overlapping inside a block but never across a street
+static std::vector<ExactPolygon> footprints(int blocks, int perBlock, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> unit(0, 1);
+  std::vector<ExactPolygon> result;
+  for (int bx = 0; bx < blocks; bx++) {
+    for (int by = 0; by < blocks; by++) {
+      for (int i = 0; i < perBlock; i++) {
+        double w = 1 + 3 * unit(gen), h = 1 + 3 * unit(gen);
+        double x = 14 * bx + (10 - w) * unit(gen), y = 14 * by + (10 - h) * unit(gen);
+        ExactPolygon p;
+        p.push_back(ExactK::Point_2(x, y));
+        p.push_back(ExactK::Point_2(x + w, y));
+        p.push_back(ExactK::Point_2(x + w, y + h));
+        p.push_back(ExactK::Point_2(x, y + h));
+        result.push_back(p);
+      }
+    }
+  }
+  return result;
+}
+
+//a polygon boundary as a vertex cycle that starts at its smallest vertex,
+//keeping its orientation
+static std::vector<ExactK::Point_2> boundaryCycle(const ExactPolygon &p) {
+  std::vector<ExactK::Point_2> cycle(p.vertices_begin(), p.vertices_end());
+  std::rotate(cycle.begin(), std::min_element(cycle.begin(), cycle.end()), cycle.end());
+  return cycle;
+}
+
+//the polygons of a union, each as its outer cycle followed by its sorted hole
+//cycles, all sorted: two joins that output the same polygons, but in another
+//order or from other start vertices, give the same list
+static std::vector<std::vector<std::vector<ExactK::Point_2> > >
+unionPolygons(const std::vector<ExactPolygonWithHoles> &pwhs) {
+  std::vector<std::vector<std::vector<ExactK::Point_2> > > polygons(pwhs.size());
+  for (size_t i = 0; i < pwhs.size(); i++) {
+    for (ExactPolygonWithHoles::Hole_const_iterator h = pwhs[i].holes_begin(); h != pwhs[i].holes_end(); ++h)
+      polygons[i].push_back(boundaryCycle(*h));
+    std::sort(polygons[i].begin(), polygons[i].end());
+    polygons[i].insert(polygons[i].begin(), boundaryCycle(pwhs[i].outer_boundary()));
+  }
+  std::sort(polygons.begin(), polygons.end());
+  return polygons;
+}
+
+//aggregated join of many footprints: one sweep tree against the clustered
+//join, the latter with 1, 2, 4, ... TBB threads
+static void benchJoin() {
+  printf("== join: union of many footprints\n");
+  int blocks[] = {10, 20, 40};
+  for (int b = 0; b < 3; b++) {
+    std::vector<ExactPolygon> pgns = footprints(blocks[b], 8, 23);
+    Clock::time_point start = Clock::now();
+    std::vector<ExactPolygonWithHoles> sequential;
+    CGAL::join(pgns.begin(), pgns.end(), std::back_inserter(sequential));
+    printf("  %6zu footprints  sequential %7.3f s (%zu polygons)\n", pgns.size(), seconds(start), sequential.size());
+    std::vector<std::vector<std::vector<ExactK::Point_2> > > expected = unionPolygons(sequential);
+#ifdef CGAL_LINKED_WITH_TBB
+    int maxThreads = std::max(1, (int) std::thread::hardware_concurrency());
+#else
+    int maxThreads = 1;
+#endif
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+      std::vector<ExactPolygonWithHoles> parallel;
+      start = Clock::now();
+#ifdef CGAL_LINKED_WITH_TBB
+      tbb::task_arena arena(threads);
+      arena.execute([&] {
+        CGAL::join(pgns.begin(), pgns.end(), std::back_inserter(parallel), CGAL::Parallel_tag());
+      });
+#else
+      CGAL::join(pgns.begin(), pgns.end(), std::back_inserter(parallel), CGAL::Parallel_tag());
+#endif
+      double t = seconds(start);
+      bool same = unionPolygons(parallel) == expected;
+      printf("  %6zu footprints  clustered  %7.3f s  %2d thread(s)%s\n", pgns.size(), t, threads,
+             same ? "" : "  MISMATCH");
+    }
+  }
+}
+
+//point location in the arrangement of the edges of a Delaunay triangulation:
+//batched sweep and landmarks, each one by one (or one sweep) and through the
+//Parallel_tag batch; queries are random points plus some of the vertices
+static void benchArrLocate() {
+  printf("== arrlocate: batched point location in an arrangement\n");
+  int sizes[] = {20000, 100000};
+  for (int s = 0; s < 2; s++) {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> coordinate(0, 1000), query(-10, 1010);
+    std::vector<Point> points(sizes[s]), queries(10 * sizes[s]);
+    for (size_t i = 0; i < points.size(); i++) points[i] = Point(coordinate(gen), coordinate(gen));
+    for (size_t i = 0; i < queries.size(); i++) queries[i] = Point(query(gen), query(gen));
+    for (size_t i = 0; i < points.size(); i += 100) queries.push_back(points[i]);
+    PointerTriangulation t(points.begin(), points.end());
+    std::vector<SegmentTraits::X_monotone_curve_2> segments;
+    for (PointerTriangulation::Finite_edges_iterator e = t.finite_edges_begin(); e != t.finite_edges_end(); ++e) {
+      K::Segment_2 segment = t.segment(*e);
+      segments.push_back(SegmentTraits::X_monotone_curve_2(segment.source(), segment.target()));
+    }
+    SegmentArrangement arr;
+    CGAL::insert_non_intersecting_curves(arr, segments.begin(), segments.end());
+
+    std::vector<ArrLocation> swept, slabs, marked;
+    Clock::time_point start = Clock::now();
+    CGAL::locate(arr, queries.begin(), queries.end(), std::back_inserter(swept));
+    double tSweep = seconds(start);
+    start = Clock::now();
+    CGAL::locate(arr, queries.begin(), queries.end(), std::back_inserter(slabs), CGAL::Parallel_tag());
+    double tSlabs = seconds(start);
+    bool same = swept.size() == slabs.size();
+    for (size_t i = 0; same && i < swept.size(); i++) {
+      same = swept[i].first == slabs[i].first && swept[i].second == slabs[i].second;
+    }
+    printf("  %7zu edges  %8zu queries  sweep %6.3f s  parallel sweep %6.3f s%s\n", arr.number_of_edges(),
+           queries.size(), tSweep, tSlabs, same ? "" : "  MISMATCH");
+
+    start = Clock::now();
+    CGAL::Arr_landmarks_point_location<SegmentArrangement> landmarks(arr);
+    double tBuild = seconds(start);
+    start = Clock::now();
+    std::vector<ArrLocation::second_type> single(queries.size());
+    for (size_t i = 0; i < queries.size(); i++) single[i] = landmarks.locate(queries[i]);
+    double tSingle = seconds(start);
+    start = Clock::now();
+    landmarks.locate(queries.begin(), queries.end(), std::back_inserter(marked), CGAL::Parallel_tag());
+    double tMarked = seconds(start);
+    same = marked.size() == single.size();
+    for (size_t i = 0; same && i < single.size(); i++) same = marked[i].second == single[i];
+    printf("  %7zu edges  landmarks %6.3f s  one by one %6.3f s  parallel batch %6.3f s%s\n",
+           arr.number_of_edges(), tBuild, tSingle, tMarked, same ? "" : "  MISMATCH");
+  }
+}
+
+struct Section {
+  const char *name;
+  void (*run)();
+};
+
+static const Section SECTIONS[] = {
+  {"raster", benchRaster},
+  {"compact", benchCompact},
+  {"sanitize", benchSanitize},
+  {"surface", benchSurface},
+  {"tds", benchTds},
+  {"rebuild", benchRebuild},
+  {"locate", benchLocate},
+  {"locator", benchLocator},
+  {"remove", benchRemove},
+  {"constraints", benchConstraints},
+  {"mesh", benchMesh},
+  {"optimize", benchOptimize},
+  {"interpolate", benchInterpolate},
+  {"serialize", benchSerialize},
+  {"apollonius", benchApollonius},
+  {"voronoi", benchVoronoi},
+  {"sdg", benchSdg},
+  {"periodic", benchPeriodic},
+  {"alpha", benchAlpha},
+  {"skeleton", benchSkeleton},
+  {"offset", benchOffset},
+  {"join", benchJoin},
+  {"arrlocate", benchArrLocate},
+};
+
+int main(int argc, char **argv) {
+  setvbuf(stdout, NULL, _IOLBF, 0);
+  size_t count = sizeof(SECTIONS) / sizeof(SECTIONS[0]);
+  for (size_t i = 0; i < count; i++) {
+    bool selected = argc < 2;
+    for (int a = 1; a < argc; a++) {
+      if (strcmp(argv[a], SECTIONS[i].name) == 0) selected = true;
+    }
+    if (selected) SECTIONS[i].run();
+  }
+  return 0;
+}
@@ -0,0 +1,224 @@
+/* Description: Split medial axes into branches and wrote them in the
+ *              quantized, delta and varint encoded format described in
+ *              CompactAxis.h, plus the matching streaming reader.
+*/
+
+#include "CompactAxis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const unsigned char MAGIC[4] = {'M', 'A', 'X', 'C'};
+static const unsigned char VERSION = 1;
+static const size_t HEADER_SIZE = 4 + 1 + 1 + 3 * sizeof(double);
+
+std::vector<std::vector<int> > medialBranches(const MedialGraph &g) {
+  size_t n = g.balls.size(), m = g.edges.size();
+  std::vector<int> offset(n + 1, 0), incident(2 * m);
+  for (size_t e = 0; e < m; e++) {
+    offset[g.edges[e].first + 1]++;
+    offset[g.edges[e].second + 1]++;
+  }
+  for (size_t i = 0; i < n; i++) offset[i + 1] += offset[i];
+  std::vector<int> fill(offset.begin(), offset.end() - 1);
+  for (size_t e = 0; e < m; e++) {
+    incident[fill[g.edges[e].first]++] = (int) e;
+    incident[fill[g.edges[e].second]++] = (int) e;
+  }
+
+  std::vector<std::vector<int> > branches;
+  std::vector<bool> used(m, false);
+  //follows unused edges from ball start through plain chain balls
+  struct Walker {
+    const MedialGraph &g;
+    const std::vector<int> &offset, &incident;
+    std::vector<bool> &used;
+    std::vector<int> walk(int start, int e) {
+      std::vector<int> branch(1, start);
+      int cur = start;
+      while (true) {
+        used[e] = true;
+        cur = g.edges[e].first == cur ? g.edges[e].second : g.edges[e].first;
+        branch.push_back(cur);
+        if (offset[cur + 1] - offset[cur] != 2) break;
+        int next = -1;
+        for (int a = offset[cur]; a < offset[cur + 1]; a++) {
+          if (!used[incident[a]]) next = incident[a];
+        }
+        if (next < 0) break;
+        e = next;
+      }
+      return branch;
+    }
+  } walker = {g, offset, incident, used};
+
+  for (size_t i = 0; i < n; i++) {
+    if (offset[i + 1] - offset[i] == 2) continue;
+    if (offset[i + 1] == offset[i]) {
+      branches.push_back(std::vector<int>(1, (int) i));
+      continue;
+    }
+    for (int a = offset[i]; a < offset[i + 1]; a++) {
+      if (!used[incident[a]]) branches.push_back(walker.walk((int) i, incident[a]));
+    }
+  }
+  //cycles made only of chain balls
+  for (size_t e = 0; e < m; e++) {
+    if (!used[e]) branches.push_back(walker.walk(g.edges[e].first, (int) e));
+  }
+  return branches;
+}
+
+static void putVarint(std::vector<unsigned char> &buf, unsigned long long v) {
+  while (v >= 0x80) {
+    buf.push_back((unsigned char) (v | 0x80));
+    v >>= 7;
+  }
+  buf.push_back((unsigned char) v);
+}
+
+static void putSigned(std::vector<unsigned char> &buf, long long v) {
+  putVarint(buf, ((unsigned long long) v << 1) ^ (unsigned long long) (v >> 63));
+}
+
+//false on a truncated or overlong varint
+static bool getVarint(const unsigned char *&p, const unsigned char *end, unsigned long long &v) {
+  v = 0;
+  for (int shift = 0; shift < 64 && p < end; shift += 7) {
+    unsigned char b = *p++;
+    v |= (unsigned long long) (b & 0x7f) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+static bool getSigned(const unsigned char *&p, const unsigned char *end, long long &v) {
+  unsigned long long u;
+  if (!getVarint(p, end, u)) return false;
+  v = (long long) (u >> 1) ^ -(long long) (u & 1);
+  return true;
+}
+
+CompactAxisWriter::CompactAxisWriter(std::ostream &out, const CGAL::Bbox_2 &box, int bits)
+  : out(out), xmin(box.xmin()), ymin(box.ymin()), written(0)
+{
+  bits = std::max(1, std::min(bits, 31));
+  double span = std::max(box.xmax() - box.xmin(), box.ymax() - box.ymin());
+  gridStep = span > 0 ? span / (double) ((1u << bits) - 1) : 1.0;
+
+  unsigned char header[HEADER_SIZE];
+  memcpy(header, MAGIC, 4);
+  header[4] = VERSION;
+  header[5] = (unsigned char) bits;
+  memcpy(header + 6, &xmin, sizeof(double));
+  memcpy(header + 6 + sizeof(double), &ymin, sizeof(double));
+  memcpy(header + 6 + 2 * sizeof(double), &gridStep, sizeof(double));
+  out.write((const char *) header, HEADER_SIZE);
+  written += HEADER_SIZE;
+}
+
+void CompactAxisWriter::writeBranch(const MedialGraph &g, const std::vector<int> &branch) {
+  if (branch.empty()) return;
+  buffer.clear();
+  putVarint(buffer, branch.size());
+  long long last[3] = {0, 0, 0};
+  for (size_t k = 0; k < branch.size(); k++) {
+    const MedialBall &b = g.balls[branch[k]];
+    long long q[3] = {std::llround((b.center.x() - xmin) / gridStep),
+                      std::llround((b.center.y() - ymin) / gridStep),
+                      std::llround(b.radius / gridStep)};
+    for (int c = 0; c < 3; c++) {
+      putSigned(buffer, q[c] - last[c]);
+      last[c] = q[c];
+    }
+  }
+  std::vector<unsigned char> length;
+  putVarint(length, buffer.size());
+  out.write((const char *) &length[0], length.size());
+  out.write((const char *) &buffer[0], buffer.size());
+  written += length.size() + buffer.size();
+}
+
+void CompactAxisWriter::finish() {
+  out.put(0);
+  written++;
+  out.flush();
+}
+
+CompactAxisReader::CompactAxisReader(const unsigned char *data, size_t size)
+  : cursor(data), end(data + size), xmin(0), ymin(0), gridStep(1), ok(false)
+{
+  if (size < HEADER_SIZE || memcmp(data, MAGIC, 4) != 0 || data[4] != VERSION) return;
+  memcpy(&xmin, data + 6, sizeof(double));
+  memcpy(&ymin, data + 6 + sizeof(double), sizeof(double));
+  memcpy(&gridStep, data + 6 + 2 * sizeof(double), sizeof(double));
+  cursor = data + HEADER_SIZE;
+  ok = true;
+}
+
+bool CompactAxisReader::nextBranch(std::vector<double> &xyr) {
+  xyr.clear();
+  unsigned long long bytes, count;
+  if (!ok || !getVarint(cursor, end, bytes) || bytes == 0) return false;
+  if (bytes > (unsigned long long) (end - cursor)) return ok = false;
+  const unsigned char *branchEnd = cursor + bytes;
+  if (!getVarint(cursor, branchEnd, count)) return ok = false;
+  //every point takes at least one byte per coordinate
+  if (count > (unsigned long long) (branchEnd - cursor) / 3) return ok = false;
+  xyr.reserve(3 * count);
+  long long q[3] = {0, 0, 0};
+  for (unsigned long long k = 0; k < count; k++) {
+    for (int c = 0; c < 3; c++) {
+      long long d;
+      if (!getSigned(cursor, branchEnd, d)) return ok = false;
+      q[c] += d;
+    }
+    xyr.push_back(xmin + q[0] * gridStep);
+    xyr.push_back(ymin + q[1] * gridStep);
+    xyr.push_back(q[2] * gridStep);
+  }
+  cursor = branchEnd;
+  return true;
+}
+
+bool CompactAxisReader::skipBranch() {
+  unsigned long long bytes;
+  if (!ok || !getVarint(cursor, end, bytes) || bytes == 0) return false;
+  if (bytes > (unsigned long long) (end - cursor)) return ok = false;
+  cursor += bytes;
+  return true;
+}
+
+MappedFile::MappedFile(const std::string &fileName) : bytes(0), length(0) {
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) return;
+  struct stat info;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    void *map = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED) {
+      bytes = (const unsigned char *) map;
+      length = info.st_size;
+    }
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (bytes) munmap((void *) bytes, length);
+}
+
+size_t writeCompactAxis(std::ostream &out, const MedialGraph &g, const CGAL::Bbox_2 &box, int bits) {
+  CompactAxisWriter writer(out, box, bits);
+  std::vector<std::vector<int> > branches = medialBranches(g);
+  for (size_t b = 0; b < branches.size(); b++) {
+    writer.writeBranch(g, branches[b]);
+  }
+  writer.finish();
+  return writer.bytesWritten();
+}
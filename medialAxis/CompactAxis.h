@@ -0,0 +1,78 @@
+/* Description: Header file for CompactAxis.cpp. Compact binary format
+ *              for medial axes. The axis is split into branches (paths
+ *              between junctions and leaves), coordinates and radii are
+ *              quantized to a grid relative to the polygon bbox and every
+ *              point after the first of a branch is stored as a zigzag
+ *              varint delta from the previous one. Branches are length
+ *              prefixed, so a reader can decode or skip one at a time
+ *              straight from a memory mapped file.
+ *
+ *              Layout: "MAXC", version byte, bits byte, xmin, ymin, step
+ *              (raw doubles), then per branch: byte length, point count,
+ *              first (x, y, r) and the deltas, all varints; a zero byte
+ *              length ends the stream.
+*/
+
+#ifndef COMPACTAXIS_H
+#define COMPACTAXIS_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "MedialBalls.h"
+
+//ball indices along every branch; junction balls start or end several
+std::vector<std::vector<int> > medialBranches(const MedialGraph &g);
+
+class CompactAxisWriter {
+public:
+  //grid step is the larger bbox side over 2^bits - 1
+  CompactAxisWriter(std::ostream &out, const CGAL::Bbox_2 &box, int bits);
+  void writeBranch(const MedialGraph &g, const std::vector<int> &branch);
+  void finish();
+  size_t bytesWritten() const { return written; }
+  double step() const { return gridStep; }
+
+private:
+  std::ostream &out;
+  double xmin, ymin, gridStep;
+  size_t written;
+  std::vector<unsigned char> buffer;
+};
+
+//decodes in place from caller owned memory, nothing is copied
+class CompactAxisReader {
+public:
+  CompactAxisReader(const unsigned char *data, size_t size);
+  bool valid() const { return ok; }
+  double step() const { return gridStep; }
+  //x, y, radius per point; false at the end of the stream, or on a corrupt
+  //or truncated branch, after which valid() is false
+  bool nextBranch(std::vector<double> &xyr);
+  bool skipBranch();
+
+private:
+  const unsigned char *cursor, *end;
+  double xmin, ymin, gridStep;
+  bool ok;
+};
+
+//read only memory mapping of a whole file, for zero copy readback
+class MappedFile {
+public:
+  MappedFile(const std::string &fileName);
+  ~MappedFile();
+  const unsigned char *data() const { return bytes; }
+  size_t size() const { return length; }
+
+private:
+  MappedFile(const MappedFile &);
+  MappedFile &operator=(const MappedFile &);
+  const unsigned char *bytes;
+  size_t length;
+};
+
+size_t writeCompactAxis(std::ostream &out, const MedialGraph &g, const CGAL::Bbox_2 &box, int bits);
+
+#endif
@@ -13,14 +13,14 @@
 
 #include "MedialAxis.h"
 
-void createCGALPolygon(Polygon_2 &p, int n, GLfloat vertices[MAX_N][2]) {
+void createCGALPolygon(Polygon_2 &p, int n, const std::vector<GLfloat> &vertices) {
   assert(polyInitialized != false);
 
   printf("\nSetting up 2D Polygon Vertices:\n");
 
   for (int i = 0; i < n; i++)
   {
-    p.push_back(Point(vertices[i][0], vertices[i][1]));
+    p.push_back(Point(vertices[2 * i], vertices[2 * i + 1]));
   }
   /*
   CGAL::set_pretty_mode(cout);
@@ -34,19 +34,14 @@ Polygon_2 inputPolygonFile(std::string infileName) {
 
   Polygon_2 poly;
   int n = 0;
-  GLfloat vertices[MAX_N][2];
 
   // Open input file
   std::ifstream inFile(infileName);
   assert(inFile.is_open());
   inFile >> n;
 
-  if (n > MAX_N)
-  {
-    cout << "Polygon vertices beyond max allowed: " << MAX_N << endl;
-    inFile.close();
-    assert(n > MAX_N);
-  }
+  //no upper bound on n, the raster mode is meant for huge outlines
+  std::vector<GLfloat> vertices(2 * std::max(n, 0));
   for (int i = 0; i < n; i++)
   {
     for (int j = 0; j < 2; j++)
@@ -56,7 +51,7 @@ Polygon_2 inputPolygonFile(std::string infileName) {
         inFile.close();
         assert(!inFile.eof());
       }
-    inFile >> vertices[i][j];
+    inFile >> vertices[2 * i + j];
     }
   } 
 
@@ -164,6 +159,19 @@ void displayPolygonEdge(Polygon_2 p) {
   glFlush();
 }
 
+std::vector<double> parseScales(std::string list) {
+  std::vector<double> scales;
+  size_t start = 0;
+  while (start < list.size())
+  {
+    size_t end = list.find(',', start);
+    if (end == std::string::npos) end = list.size();
+    scales.push_back(atof(list.substr(start, end - start).c_str()));
+    start = end + 1;
+  }
+  return scales;
+}
+
 void glfwDisplay(Polygon_2 p, std::string infileName) {
   //glfw window display
   GLFWwindow* window;
@@ -236,22 +244,126 @@ void glfwDisplay(Polygon_2 p, std::string infileName) {
 int main(int argc, char **argv)
 {
   std::string infileName = argv[1];
+  std::string scaleList, outfileName;
+  int rasterResolution = 0, compactBits = 0;
+  bool repair = false, surface = false;
+  //optional: -scales 1.1,1.5,2.0 [-o file] writes the scale axis levels,
+  //-raster N [-o file] writes the raster axis at N pixels across,
+  //-compact B writes the axis in the compact format on a 2^B grid,
+  //-repair fixes an invalid polygon instead of giving up on it,
+  //-surface [-o file] reads an OFF mesh or sample and writes its 3D axis
+  for (int i = 2; i < argc; i++)
+  {
+    std::string option = argv[i];
+    if (option == "-repair") repair = true;
+    else if (option == "-surface") surface = true;
+    else if (i + 1 < argc)
+    {
+      if (option == "-scales") scaleList = argv[++i];
+      else if (option == "-raster") rasterResolution = atoi(argv[++i]);
+      else if (option == "-compact") compactBits = atoi(argv[++i]);
+      else if (option == "-o") outfileName = argv[++i];
+    }
+  }
+  //3D mode, there is no window for it
+  if (surface)
+  {
+    SurfaceSample sample;
+    if (!readOFF(infileName, sample))
+    {
+      cout << "could not read OFF file " << infileName << "." << endl;
+      return EXIT_FAILURE;
+    }
+    SurfaceAxis axis = surfaceMedialAxis(sample);
+    if (axis.balls.empty())
+    {
+      cout << "no medial axis: the OFF file needs faces or vertex normals (NOFF)." << endl;
+      return EXIT_FAILURE;
+    }
+    if (outfileName.empty()) outfileName = infileName + ".surfaceaxis";
+    std::ofstream outFile(outfileName);
+    writeSurfaceAxis(outFile, axis);
+    outFile.close();
+    cout << "surface axis: " << axis.balls.size() << " balls, " << axis.faces.size()
+         << " faces written to " << outfileName << endl;
+    return EXIT_SUCCESS;
+  }
+
   //load polygon from file that contains vertices
   Polygon_2 p = inputPolygonFile(infileName);
-  std::vector<Point> points = internalVoronoiPoints(p);
+
+  //validate before anything is triangulated, a bad polygon only gives a
+  //garbage axis after the full run
+  PolygonReport report = validatePolygon(p);
+  printPolygonReport(cout, report);
+  if (!report.valid())
+  {
+    if (!repair)
+    {
+      cout << "polygon p is not simple, rerun with -repair to fix it." << endl;
+      return EXIT_FAILURE;
+    }
+    if (!repairPolygon(p))
+    {
+      cout << "polygon p could not be repaired." << endl;
+      return EXIT_FAILURE;
+    }
+    cout << "polygon p repaired: " << p.size() << " vertices." << endl;
+  }
+  else if (repair && report.clockwise)
+  {
+    p.reverse_orientation();
+  }
 
   // display polygon info based on CGAL Example polygon code.
-  bool IsSimple    = p.is_simple();
   bool IsConvex    = p.is_convex();
 
-  cout << "polygon p is";
-  if (!IsSimple) cout << " not";
-  cout << " simple." << endl;
+  cout << "polygon p is simple." << endl;
 
   cout << "polygon p is";
   if (!IsConvex) cout << " not";
   cout << " convex." << endl;
 
+  if (!scaleList.empty())
+  {
+    MultiscaleAxis axis = multiscaleMedialAxis(p, parseScales(scaleList));
+    if (outfileName.empty()) outfileName = infileName + ".scaleaxis";
+    std::ofstream outFile(outfileName);
+    writeMultiscaleAxis(outFile, axis);
+    outFile.close();
+
+    cout << axis.graph.balls.size() << " medial balls written to " << outfileName << endl;
+    for (size_t l = 0; l < axis.scales.size(); l++)
+    {
+      cout << "scale " << axis.scales[l] << ": " << axis.levelBalls[l] << " balls, "
+           << axis.levelEdges[l] << " edges" << endl;
+    }
+  }
+
+  if (rasterResolution > 0 || compactBits > 0)
+  {
+    //raster axis when asked for, the internal Voronoi axis otherwise
+    MedialGraph axis = rasterResolution > 0 ? rasterMedialAxis(p, rasterResolution) : medialBalls(p);
+    if (compactBits > 0)
+    {
+      if (outfileName.empty()) outfileName = infileName + ".maxc";
+      std::ofstream outFile(outfileName, std::ios::binary);
+      size_t bytes = writeCompactAxis(outFile, axis, p.bbox(), compactBits);
+      outFile.close();
+      cout << "compact axis (" << compactBits << " bits): " << axis.balls.size() << " balls in "
+           << bytes << " bytes written to " << outfileName << endl;
+    }
+    else
+    {
+      if (outfileName.empty()) outfileName = infileName + ".rasteraxis";
+      std::ofstream outFile(outfileName);
+      writeMedialGraph(outFile, axis);
+      outFile.close();
+      cout << "raster axis (" << rasterResolution << " pixels across): " << axis.balls.size()
+           << " balls, " << axis.edges.size() << " edges written to " << outfileName << endl;
+    }
+  }
+
   //print out boundary
   /*
   int n=0;
@@ -9,6 +9,7 @@
 #include <iostream>
 #include <fstream>
 #include <list>
+#include <vector>
 #include <cassert>
 
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
@@ -17,6 +18,12 @@
 #include <CGAL/Triangulation_face_base_with_info_2.h>
 #include <GLFW/glfw3.h>
 
+#include "MedialBalls.h"
+#include "RasterAxis.h"
+#include "CompactAxis.h"
+#include "PolygonSanitizer.h"
+#include "SurfaceAxis.h"
+
 typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
 typedef CGAL::Point_2<K> Point;
 typedef CGAL::Segment_2<K> Segment;
@@ -32,7 +39,6 @@ using std::cout;
 using std::cin;
 using std::endl;
 
-#define MAX_N 300
 bool polyInitialized = false;
 
 //GLFW functions
@@ -51,12 +57,13 @@ static void key_callback(GLFWwindow* window, int key, int scancode, int action,
 void glfwDisplay(std::string infileName);
 
 //My functions
-void createCGALPolygon(Polygon_2 &p, int n, GLfloat vertices[MAX_N][2]);
+void createCGALPolygon(Polygon_2 &p, int n, const std::vector<GLfloat> &vertices);
 Polygon_2 inputPolygonFile(std::string infileName);
 std::vector<Segment> internalVoronoiEdges(Polygon_2 p);
 std::vector<Segment> internalVoronoiEdges(Polygon_2 p);
 void displayMedialAxis(Polygon_2 p);
 void displayPolygonVert(Polygon_2 p);
 void displayPolygonEdge(Polygon_2 p);
+std::vector<double> parseScales(std::string list);
 
 
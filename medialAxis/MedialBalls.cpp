@@ -0,0 +1,265 @@
+/* Description: Computed the medial balls of a polygon once from the
+ *              Delaunay triangulation of its vertices: every finite face
+ *              whose circumcenter lies inside the polygon gives a ball,
+ *              and every Delaunay edge between two such faces gives an
+ *              internal Voronoi edge. The multiscale axis scales every
+ *              ball by s and prunes, leaf first, the balls covered by a
+ *              bigger scaled ball. Each ball stores the scale at which it
+ *              goes, so extra scales only cost a prefix count.
+*/
+
+#include "MedialBalls.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+typedef BallTriangulation::Face_handle BallFaceHandle;
+typedef BallTriangulation::All_faces_iterator BallAllFaceIterator;
+typedef BallTriangulation::Finite_faces_iterator BallFaceIterator;
+typedef BallTriangulation::Finite_edges_iterator BallEdgeIterator;
+
+static const double NEVER_REMOVED = std::numeric_limits<double>::infinity();
+
+MedialGraph medialBalls(const Polygon_2 &p) {
+  BallTriangulation t;
+  MedialGraph g;
+  t.tds().reserve(p.size());
+  t.insert(p.vertices_begin(), p.vertices_end());
+
+  for(BallAllFaceIterator fi = t.all_faces_begin(); fi != t.all_faces_end(); ++fi) {
+    fi->info() = -1;
+  }
+  for(BallFaceIterator fi = t.finite_faces_begin(); fi != t.finite_faces_end(); ++fi) {
+    Point c = t.dual(fi);
+    if(p.bounded_side(c) == CGAL::ON_BOUNDED_SIDE)
+    {
+      MedialBall b;
+      b.center = c;
+      b.radius = std::sqrt(CGAL::squared_distance(c, fi->vertex(0)->point()));
+      b.removalScale = NEVER_REMOVED;
+      fi->info() = (int) g.balls.size();
+      g.balls.push_back(b);
+    }
+  }
+  //same edges internalVoronoiEdges() keeps: both dual endpoints inside
+  for(BallEdgeIterator ei = t.finite_edges_begin(); ei != t.finite_edges_end(); ++ei) {
+    BallFaceHandle f = ei->first;
+    BallFaceHandle n = f->neighbor(ei->second);
+    if(f->info() >= 0 && n->info() >= 0) {
+      g.edges.push_back(std::make_pair(f->info(), n->info()));
+      g.edgeRemovalScale.push_back(NEVER_REMOVED);
+    }
+  }
+  return g;
+}
+
+//smallest s <= maxScale for which some bigger ball j scaled by s contains
+//ball i scaled by s, i.e. |ci - cj| + s*ri <= s*rj. Ball centers are
+//bucketed in a uniform grid so each ball j only visits its neighborhood.
+static std::vector<double> coverScales(const MedialGraph &g, double maxScale) {
+  size_t n = g.balls.size();
+  std::vector<double> cover(n, NEVER_REMOVED);
+  if(n < 2) {
+    return cover;
+  }
+
+  double xmin = g.balls[0].center.x(), xmax = xmin;
+  double ymin = g.balls[0].center.y(), ymax = ymin;
+  std::vector<double> radii(n);
+  for(size_t i = 0; i < n; i++) {
+    const Point &c = g.balls[i].center;
+    xmin = std::min(xmin, c.x()); xmax = std::max(xmax, c.x());
+    ymin = std::min(ymin, c.y()); ymax = std::max(ymax, c.y());
+    radii[i] = g.balls[i].radius;
+  }
+  std::nth_element(radii.begin(), radii.begin() + n / 2, radii.end());
+  double w = std::max(xmax - xmin, 1e-12), h = std::max(ymax - ymin, 1e-12);
+  double cell = std::max(maxScale * radii[n / 2], std::sqrt(w * h / (4.0 * n)));
+  int gx = (int) (w / cell) + 1, gy = (int) (h / cell) + 1;
+
+  std::vector<std::vector<int> > grid((size_t) gx * gy);
+  for(size_t i = 0; i < n; i++) {
+    int cx = (int) ((g.balls[i].center.x() - xmin) / cell);
+    int cy = (int) ((g.balls[i].center.y() - ymin) / cell);
+    grid[(size_t) cy * gx + cx].push_back((int) i);
+  }
+
+  for(size_t j = 0; j < n; j++) {
+    const MedialBall &bj = g.balls[j];
+    double reach = maxScale * bj.radius;
+    int x0 = std::max(0, (int) ((bj.center.x() - reach - xmin) / cell));
+    int x1 = std::min(gx - 1, (int) ((bj.center.x() + reach - xmin) / cell));
+    int y0 = std::max(0, (int) ((bj.center.y() - reach - ymin) / cell));
+    int y1 = std::min(gy - 1, (int) ((bj.center.y() + reach - ymin) / cell));
+    for(int cy = y0; cy <= y1; cy++) {
+      for(int cx = x0; cx <= x1; cx++) {
+        const std::vector<int> &bucket = grid[(size_t) cy * gx + cx];
+        for(size_t k = 0; k < bucket.size(); k++) {
+          const MedialBall &bi = g.balls[bucket[k]];
+          if(bi.radius >= bj.radius) {
+            continue;
+          }
+          double d = std::sqrt(CGAL::squared_distance(bi.center, bj.center));
+          double s = d / (bj.radius - bi.radius);
+          if(s <= maxScale && s < cover[bucket[k]]) {
+            cover[bucket[k]] = s;
+          }
+        }
+      }
+    }
+  }
+  return cover;
+}
+
+void computeRemovalScales(MedialGraph &g, double maxScale) {
+  size_t n = g.balls.size();
+  std::vector<double> cover = coverScales(g, maxScale);
+
+  //adjacency in compressed rows
+  std::vector<int> offset(n + 1, 0), adjacent(2 * g.edges.size());
+  for(size_t e = 0; e < g.edges.size(); e++) {
+    offset[g.edges[e].first + 1]++;
+    offset[g.edges[e].second + 1]++;
+  }
+  for(size_t i = 0; i < n; i++) {
+    offset[i + 1] += offset[i];
+  }
+  std::vector<int> fill(offset.begin(), offset.end() - 1);
+  for(size_t e = 0; e < g.edges.size(); e++) {
+    adjacent[fill[g.edges[e].first]++] = g.edges[e].second;
+    adjacent[fill[g.edges[e].second]++] = g.edges[e].first;
+  }
+
+  //prune from the leaves: a ball goes once it is covered and all but one
+  //of its neighbors are gone, which keeps the pruned axis connected
+  typedef std::pair<double, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+  std::vector<int> degree(n);
+  for(size_t i = 0; i < n; i++) {
+    g.balls[i].removalScale = NEVER_REMOVED;
+    degree[i] = offset[i + 1] - offset[i];
+    if(degree[i] <= 1 && cover[i] != NEVER_REMOVED) {
+      queue.push(Entry(cover[i], (int) i));
+    }
+  }
+  while(!queue.empty()) {
+    Entry top = queue.top();
+    queue.pop();
+    int i = top.second;
+    if(g.balls[i].removalScale != NEVER_REMOVED) {
+      continue;
+    }
+    g.balls[i].removalScale = top.first;
+    for(int a = offset[i]; a < offset[i + 1]; a++) {
+      int k = adjacent[a];
+      if(g.balls[k].removalScale != NEVER_REMOVED) {
+        continue;
+      }
+      if(--degree[k] <= 1 && cover[k] != NEVER_REMOVED) {
+        queue.push(Entry(std::max(cover[k], top.first), k));
+      }
+    }
+  }
+
+  for(size_t e = 0; e < g.edges.size(); e++) {
+    g.edgeRemovalScale[e] = std::min(g.balls[g.edges[e].first].removalScale,
+                                     g.balls[g.edges[e].second].removalScale);
+  }
+}
+
+struct ByDecreasingScale {
+  const std::vector<double> &scale;
+  ByDecreasingScale(const std::vector<double> &s) : scale(s) {}
+  bool operator()(int a, int b) const { return scale[a] > scale[b]; }
+};
+
+MultiscaleAxis multiscaleMedialAxis(const Polygon_2 &p, std::vector<double> scales) {
+  MultiscaleAxis axis;
+  std::sort(scales.begin(), scales.end());
+  axis.scales = scales;
+  MedialGraph g = medialBalls(p);
+  computeRemovalScales(g, scales.empty() ? 1.0 : scales.back());
+
+  //reorder balls and edges so that every level is a prefix
+  size_t n = g.balls.size(), m = g.edges.size();
+  std::vector<double> ballScale(n);
+  std::vector<int> order(n), rank(n);
+  for(size_t i = 0; i < n; i++) {
+    ballScale[i] = g.balls[i].removalScale;
+    order[i] = (int) i;
+  }
+  std::stable_sort(order.begin(), order.end(), ByDecreasingScale(ballScale));
+  axis.graph.balls.resize(n);
+  for(size_t i = 0; i < n; i++) {
+    axis.graph.balls[i] = g.balls[order[i]];
+    rank[order[i]] = (int) i;
+  }
+
+  std::vector<int> edgeOrder(m);
+  for(size_t e = 0; e < m; e++) {
+    edgeOrder[e] = (int) e;
+  }
+  std::stable_sort(edgeOrder.begin(), edgeOrder.end(), ByDecreasingScale(g.edgeRemovalScale));
+  axis.graph.edges.resize(m);
+  axis.graph.edgeRemovalScale.resize(m);
+  for(size_t e = 0; e < m; e++) {
+    const std::pair<int, int> &edge = g.edges[edgeOrder[e]];
+    axis.graph.edges[e] = std::make_pair(rank[edge.first], rank[edge.second]);
+    axis.graph.edgeRemovalScale[e] = g.edgeRemovalScale[edgeOrder[e]];
+  }
+
+  //a ball survives scale s while s < removalScale
+  for(size_t l = 0; l < scales.size(); l++) {
+    size_t b = 0, e = 0;
+    while(b < n && axis.graph.balls[b].removalScale > scales[l]) b++;
+    while(e < m && axis.graph.edgeRemovalScale[e] > scales[l]) e++;
+    axis.levelBalls.push_back(b);
+    axis.levelEdges.push_back(e);
+  }
+  return axis;
+}
+
+std::vector<Segment> levelSegments(const MultiscaleAxis &axis, size_t level) {
+  std::vector<Segment> segments;
+  size_t m = level < axis.levelEdges.size() ? axis.levelEdges[level] : axis.graph.edges.size();
+  segments.reserve(m);
+  for(size_t e = 0; e < m; e++) {
+    segments.push_back(Segment(axis.graph.balls[axis.graph.edges[e].first].center,
+                               axis.graph.balls[axis.graph.edges[e].second].center));
+  }
+  return segments;
+}
+
+//first line: #balls #edges #levels, then one line per level with its
+//scale and prefix sizes, then x y radius removalScale per ball (-1 when
+//never removed) and the two ball indices per edge
+void writeMultiscaleAxis(std::ostream &out, const MultiscaleAxis &axis) {
+  const MedialGraph &g = axis.graph;
+  out << g.balls.size() << " " << g.edges.size() << " " << axis.scales.size() << "\n";
+  for(size_t l = 0; l < axis.scales.size(); l++) {
+    out << axis.scales[l] << " " << axis.levelBalls[l] << " " << axis.levelEdges[l] << "\n";
+  }
+  for(size_t i = 0; i < g.balls.size(); i++) {
+    const MedialBall &b = g.balls[i];
+    out << b.center.x() << " " << b.center.y() << " " << b.radius << " "
+        << (b.removalScale == NEVER_REMOVED ? -1.0 : b.removalScale) << "\n";
+  }
+  for(size_t e = 0; e < g.edges.size(); e++) {
+    out << g.edges[e].first << " " << g.edges[e].second << "\n";
+  }
+}
+
+//first line: #balls #edges, then x y radius per ball and the two ball
+//indices per edge
+void writeMedialGraph(std::ostream &out, const MedialGraph &g) {
+  out << g.balls.size() << " " << g.edges.size() << "\n";
+  for(size_t i = 0; i < g.balls.size(); i++) {
+    out << g.balls[i].center.x() << " " << g.balls[i].center.y() << " " << g.balls[i].radius << "\n";
+  }
+  for(size_t e = 0; e < g.edges.size(); e++) {
+    out << g.edges[e].first << " " << g.edges[e].second << "\n";
+  }
+}
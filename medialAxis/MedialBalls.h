@@ -0,0 +1,63 @@
+/* Description: Header file for MedialBalls.cpp. Medial balls of a
+ *              polygon (the internal Voronoi vertices with the radius of
+ *              their empty circle) and the internal Voronoi edges joining
+ *              them, computed once from the Delaunay triangulation. A
+ *              multiscale (scale axis) axis is derived from the same balls:
+ *              every ball gets the scale at which it is pruned, so all
+ *              levels share one ball/edge array and a level is a prefix.
+*/
+
+#ifndef MEDIALBALLS_H
+#define MEDIALBALLS_H
+
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+#include <CGAL/Polygon_2.h>
+#include <CGAL/Delaunay_triangulation_2.h>
+#include <CGAL/Indexed_triangulation_data_structure_2.h>
+
+typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
+typedef CGAL::Point_2<K> Point;
+typedef CGAL::Segment_2<K> Segment;
+typedef CGAL::Polygon_2<K> Polygon_2;
+
+//face info holds the index of the face's medial ball, -1 if outside.
+//Index based storage, about half the memory of the default Tds
+typedef CGAL::Indexed_triangulation_data_structure_2<K, void, int> BallTds;
+typedef CGAL::Delaunay_triangulation_2<K, BallTds> BallTriangulation;
+
+struct MedialBall {
+  Point center;
+  double radius;
+  //smallest scale at which the ball is pruned, infinity if it never is
+  double removalScale;
+};
+
+//internal Voronoi vertices and the internal Voronoi edges between them,
+//edges are pairs of indices into balls
+struct MedialGraph {
+  std::vector<MedialBall> balls;
+  std::vector<std::pair<int, int> > edges;
+  std::vector<double> edgeRemovalScale;
+};
+
+//balls and edges are sorted by decreasing removal scale, so the axis at
+//scales[l] is balls[0, levelBalls[l]) and edges[0, levelEdges[l])
+struct MultiscaleAxis {
+  MedialGraph graph;
+  std::vector<double> scales;
+  std::vector<size_t> levelBalls;
+  std::vector<size_t> levelEdges;
+};
+
+MedialGraph medialBalls(const Polygon_2 &p);
+void computeRemovalScales(MedialGraph &g, double maxScale);
+MultiscaleAxis multiscaleMedialAxis(const Polygon_2 &p, std::vector<double> scales);
+std::vector<Segment> levelSegments(const MultiscaleAxis &axis, size_t level);
+void writeMultiscaleAxis(std::ostream &out, const MultiscaleAxis &axis);
+void writeMedialGraph(std::ostream &out, const MedialGraph &g);
+
+#endif
@@ -0,0 +1,33 @@
+/* Description: Splits an index range over the hardware threads. Used by
+ *              the modes whose passes work on independent rows, columns
+ *              or slabs.
+*/
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+//runs body(begin, end) over [0, n) split into one range per hardware thread
+template <class Body>
+void parallelFor(int n, const Body &body) {
+  int threads = std::max(1, (int) std::thread::hardware_concurrency());
+  threads = std::min(threads, n);
+  if (threads <= 1) {
+    body(0, n);
+    return;
+  }
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; t++) {
+    pool.push_back(std::thread(std::cref(body), (int) ((long long) n * t / threads),
+                               (int) ((long long) n * (t + 1) / threads)));
+  }
+  for (size_t t = 0; t < pool.size(); t++) {
+    pool[t].join();
+  }
+}
+
+#endif
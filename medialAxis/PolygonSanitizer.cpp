@@ -0,0 +1,367 @@
+/* Description: Validated input polygons before triangulation: duplicate
+ *              and collinear vertices, spikes and orientation in one pass
+ *              over the vertices, then self intersections with sweeps in
+ *              x over thin horizontal slabs of the edges. Slabs of large
+ *              inputs are swept on separate threads; every pair is only
+ *              reported by the slab holding the bottom of the pair's y
+ *              overlap, and all threads stop once enough pairs are found.
+ *              Repair drops duplicates and spikes, snap rounds the edges
+ *              around the crossings (Snap_rounding_2) and keeps the outer
+ *              boundary of the union of the faces they enclose.
+*/
+
+#include "PolygonSanitizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <list>
+#include <map>
+
+#include <CGAL/Cartesian.h>
+#include <CGAL/Gmpq.h>
+#include <CGAL/Snap_rounding_traits_2.h>
+#include <CGAL/Snap_rounding_2.h>
+#include <CGAL/Arr_segment_traits_2.h>
+#include <CGAL/Arrangement_2.h>
+
+#include "ParallelFor.h"
+
+typedef CGAL::Cartesian<CGAL::Gmpq> ExactKernel;
+typedef CGAL::Snap_rounding_traits_2<ExactKernel> SnapTraits;
+typedef CGAL::Arr_segment_traits_2<ExactKernel> ArrTraits;
+typedef CGAL::Arrangement_2<ArrTraits> Arrangement;
+
+//below this many edges the slabs are swept in turn, threads do not pay off
+static const size_t SLAB_THRESHOLD = 50000;
+//with more crossings than this every edge is snap rounded, not just the
+//ones around the crossings
+static const size_t REPAIR_LOCAL_LIMIT = 256;
+//largest outline cleaned up through an arrangement
+static const size_t ARRANGEMENT_LIMIT = 20000;
+
+//b is collinear with its neighbors and the boundary turns back at b
+static bool isSpike(const Point &a, const Point &b, const Point &c) {
+  return CGAL::collinear(a, b, c) && CGAL::angle(a, b, c) == CGAL::ACUTE;
+}
+
+struct SweepEdge {
+  Segment segment;
+  double xmin, xmax, ymin, ymax;
+  int source;
+};
+
+PolygonReport validatePolygon(const Polygon_2 &p, size_t maxIntersections) {
+  PolygonReport report;
+  report.vertices = 0;
+  report.duplicateVertices = report.collinearVertices = report.spikes = 0;
+  report.clockwise = false;
+
+  const std::vector<Point> &v = p.container();
+  std::vector<int> distinct;
+  for (size_t i = 0; i < v.size(); i++) {
+    if (!distinct.empty() && v[i] == v[distinct.back()]) report.duplicateVertices++;
+    else distinct.push_back((int) i);
+  }
+  while (distinct.size() > 1 && v[distinct.back()] == v[distinct.front()]) {
+    distinct.pop_back();
+    report.duplicateVertices++;
+  }
+  size_t m = distinct.size();
+  report.vertices = m;
+  if (m < 3) return report;
+
+  double area = 0;
+  for (size_t k = 0; k < m; k++) {
+    const Point &a = v[distinct[(k + m - 1) % m]], &b = v[distinct[k]], &c = v[distinct[(k + 1) % m]];
+    area += b.x() * c.y() - c.x() * b.y();
+    if (CGAL::collinear(a, b, c)) {
+      report.collinearVertices++;
+      if (CGAL::angle(a, b, c) == CGAL::ACUTE) report.spikes++;
+    }
+  }
+  report.clockwise = area < 0;
+
+  std::vector<SweepEdge> edges(m);
+  for (size_t k = 0; k < m; k++) {
+    const Point &a = v[distinct[k]], &b = v[distinct[(k + 1) % m]];
+    SweepEdge &e = edges[k];
+    e.segment = Segment(a, b);
+    e.xmin = std::min(a.x(), b.x()); e.xmax = std::max(a.x(), b.x());
+    e.ymin = std::min(a.y(), b.y()); e.ymax = std::max(a.y(), b.y());
+    e.source = distinct[k];
+  }
+
+  //horizontal slabs about as tall as the edges, so a sweep in x inside a
+  //slab only keeps the few edges crossing it nearby; a long spiky outline
+  //would leave hundreds of edges active in a single sweep over the bbox
+  double ymin = edges[0].ymin, ymax = edges[0].ymax, extent = 0;
+  for (size_t k = 0; k < m; k++) {
+    ymin = std::min(ymin, edges[k].ymin);
+    ymax = std::max(ymax, edges[k].ymax);
+    extent += edges[k].ymax - edges[k].ymin;
+  }
+  double height = std::max(2 * extent / m, (ymax - ymin) / std::sqrt((double) m));
+  int slabs = height > 0 ? (int) std::min((ymax - ymin) / height, std::sqrt((double) m)) + 1 : 1;
+  struct SlabOf {
+    double ymin, height;
+    int slabs;
+    int operator()(double y) const {
+      return height > 0 ? std::min(slabs - 1, (int) ((y - ymin) / height)) : 0;
+    }
+  } slabOf = {ymin, height, slabs};
+
+  std::vector<std::vector<int> > slabEdges(slabs);
+  for (size_t k = 0; k < m; k++) {
+    for (int s = slabOf(edges[k].ymin); s <= slabOf(edges[k].ymax); s++) {
+      slabEdges[s].push_back((int) k);
+    }
+  }
+
+  std::vector<std::vector<std::pair<int, int> > > found(slabs);
+  std::atomic<size_t> total(0);
+  auto sweep = [&](int s0, int s1) {
+    std::vector<int> active;
+    for (int s = s0; s < s1 && total < maxIntersections; s++) {
+      std::vector<int> &order = slabEdges[s];
+      std::sort(order.begin(), order.end(), [&](int a, int b) { return edges[a].xmin < edges[b].xmin; });
+      active.clear();
+      for (size_t i = 0; i < order.size() && total < maxIntersections; i++) {
+        const SweepEdge &e = edges[order[i]];
+        size_t kept = 0;
+        for (size_t j = 0; j < active.size(); j++) {
+          if (edges[active[j]].xmax >= e.xmin) active[kept++] = active[j];
+        }
+        active.resize(kept);
+        for (size_t j = 0; j < active.size(); j++) {
+          const SweepEdge &a = edges[active[j]];
+          size_t gap = (size_t) std::abs(active[j] - order[i]);
+          if (gap == 1 || gap == m - 1) continue;
+          if (a.ymax < e.ymin || e.ymax < a.ymin) continue;
+          if (slabOf(std::max(a.ymin, e.ymin)) != s) continue;
+          if (CGAL::do_intersect(a.segment, e.segment)) {
+            found[s].push_back(std::make_pair(std::min(a.source, e.source), std::max(a.source, e.source)));
+            total++;
+          }
+        }
+        active.push_back(order[i]);
+      }
+    }
+  };
+  if (m >= SLAB_THRESHOLD) parallelFor(slabs, sweep);
+  else sweep(0, slabs);
+
+  for (int s = 0; s < slabs; s++) {
+    report.intersections.insert(report.intersections.end(), found[s].begin(), found[s].end());
+  }
+  std::sort(report.intersections.begin(), report.intersections.end());
+  if (report.intersections.size() > maxIntersections) report.intersections.resize(maxIntersections);
+  return report;
+}
+
+static std::vector<Point> dropDuplicatesAndSpikes(std::vector<Point> v) {
+  bool changed = true;
+  while (changed && v.size() >= 3) {
+    changed = false;
+    std::vector<Point> out;
+    for (size_t i = 0; i < v.size(); i++) {
+      while (out.size() >= 2 && isSpike(out[out.size() - 2], out.back(), v[i])) {
+        out.pop_back();
+        changed = true;
+      }
+      if (!out.empty() && out.back() == v[i]) {
+        changed = true;
+        continue;
+      }
+      out.push_back(v[i]);
+    }
+    if (out.size() >= 2 && out.back() == out.front()) {
+      out.pop_back();
+      changed = true;
+    }
+    //a spike across the seam becomes an inner vertex on the next pass
+    size_t n = out.size();
+    if (n >= 3 && (isSpike(out[n - 2], out[n - 1], out[0]) || isSpike(out[n - 1], out[0], out[1]))) {
+      std::rotate(out.begin(), out.begin() + n / 2, out.end());
+      changed = true;
+    }
+    v.swap(out);
+  }
+  return v;
+}
+
+static double loopArea(const std::vector<Point> &loop) {
+  double area = 0;
+  for (size_t k = 0; k < loop.size(); k++) {
+    const Point &b = loop[k], &c = loop[(k + 1) % loop.size()];
+    area += b.x() * c.y() - c.x() * b.y();
+  }
+  return area / 2;
+}
+
+struct LessXY {
+  bool operator()(const ExactKernel::Point_2 &a, const ExactKernel::Point_2 &b) const {
+    return CGAL::compare_xy(a, b) == CGAL::SMALLER;
+  }
+};
+
+//splits a closed walk into simple loops wherever it comes back to a
+//vertex marked shared and returns the loop enclosing the largest area
+static std::vector<Point> largestLoop(const std::vector<ExactKernel::Point_2> &walk,
+                                      const std::vector<bool> &shared) {
+  typedef std::map<ExactKernel::Point_2, size_t, LessXY> Positions;
+  std::vector<Point> best, stack;
+  std::vector<Positions::iterator> keys;
+  Positions position;
+  double bestArea = 0;
+  for (size_t k = 0; k <= walk.size(); k++) {
+    size_t i = k % walk.size();
+    Positions::iterator seen = shared[i] ? position.find(walk[i]) : position.end();
+    if (seen == position.end()) {
+      if (k == walk.size()) break;
+      keys.push_back(shared[i] ? position.insert(std::make_pair(walk[i], stack.size())).first : position.end());
+      stack.push_back(Point(CGAL::to_double(walk[i].x()), CGAL::to_double(walk[i].y())));
+      continue;
+    }
+    size_t start = seen->second;
+    std::vector<Point> loop(stack.begin() + start, stack.end());
+    for (size_t s = start + 1; s < keys.size(); s++) {
+      if (keys[s] != position.end()) position.erase(keys[s]);
+    }
+    stack.resize(start + 1);
+    keys.resize(start + 1);
+    double area = std::fabs(loopArea(loop));
+    if (loop.size() >= 3 && area > bestArea) {
+      bestArea = area;
+      best.swap(loop);
+    }
+  }
+  //what is left on the stack is the loop through the first vertex
+  if (stack.size() >= 3 && std::fabs(loopArea(stack)) > bestArea) best.swap(stack);
+  return best;
+}
+
+//outer boundary of the union of the faces the walk encloses: every
+//component of the arrangement is walked around from the unbounded face
+static std::vector<Point> outerBoundary(const std::vector<ExactKernel::Point_2> &walk) {
+  std::list<ArrTraits::X_monotone_curve_2> curves;
+  for (size_t k = 0; k < walk.size(); k++) {
+    const ExactKernel::Point_2 &a = walk[k], &b = walk[(k + 1) % walk.size()];
+    if (a != b) curves.push_back(ArrTraits::X_monotone_curve_2(a, b));
+  }
+  Arrangement arr;
+  CGAL::insert(arr, curves.begin(), curves.end());
+
+  std::vector<Point> best;
+  double bestArea = 0;
+  Arrangement::Face_const_handle outside = arr.unbounded_face();
+  for (Arrangement::Hole_const_iterator hi = outside->holes_begin(); hi != outside->holes_end(); ++hi) {
+    std::vector<ExactKernel::Point_2> ccb;
+    Arrangement::Ccb_halfedge_const_circulator first = *hi, he = first;
+    do {
+      ccb.push_back(he->source()->point());
+    } while (++he != first);
+    std::vector<Point> loop = largestLoop(ccb, std::vector<bool>(ccb.size(), true));
+    double area = std::fabs(loopArea(loop));
+    if (area > bestArea) {
+      bestArea = area;
+      best.swap(loop);
+    }
+  }
+  return best;
+}
+
+//snap rounds the edges near a crossing to a grid 2^-24 of the bbox, so
+//edges that crossed now meet at a shared hot pixel center, and leaves the
+//far away edges as they are. Up to ARRANGEMENT_LIMIT vertices the outer
+//boundary of the union of the enclosed faces is kept; above it (building
+//an Arrangement_2 of one long outline is quadratic) the boundary is split
+//where it touches itself and the largest loop is kept
+static void snapAndClean(Polygon_2 &p, const std::vector<std::pair<int, int> > &crossings, bool all) {
+  const std::vector<Point> &v = p.container();
+  size_t m = v.size();
+  CGAL::Bbox_2 box = p.bbox();
+  double span = std::max(box.xmax() - box.xmin(), box.ymax() - box.ymin());
+  double pixel = std::ldexp(span, -24);
+
+  std::vector<CGAL::Bbox_2> near;
+  for (size_t k = 0; k < crossings.size(); k++) {
+    int ends[2] = {crossings[k].first, crossings[k].second};
+    for (int e = 0; e < 2; e++) {
+      CGAL::Bbox_2 b = v[ends[e]].bbox() + v[(ends[e] + 1) % m].bbox();
+      near.push_back(CGAL::Bbox_2(b.xmin() - 4 * pixel, b.ymin() - 4 * pixel,
+                                  b.xmax() + 4 * pixel, b.ymax() + 4 * pixel));
+    }
+  }
+  std::vector<bool> snapped(m, all);
+  for (size_t k = 0; k < m && !all; k++) {
+    CGAL::Bbox_2 b = v[k].bbox() + v[(k + 1) % m].bbox();
+    for (size_t n = 0; n < near.size() && !snapped[k]; n++) snapped[k] = CGAL::do_overlap(b, near[n]);
+  }
+
+  std::list<ExactKernel::Segment_2> segments;
+  for (size_t k = 0; k < m; k++) {
+    if (!snapped[k]) continue;
+    const Point &a = v[k], &b = v[(k + 1) % m];
+    segments.push_back(ExactKernel::Segment_2(ExactKernel::Point_2(a.x(), a.y()), ExactKernel::Point_2(b.x(), b.y())));
+  }
+  std::list<std::list<ExactKernel::Point_2> > polylines;
+  CGAL::snap_rounding_2<SnapTraits>(segments.begin(), segments.end(), polylines, pixel, true, false, 1);
+
+  //the boundary again, with every snapped edge replaced by its polyline
+  //(they come out in the order of the segments); a vertex between a
+  //snapped and a kept edge stays and is joined to its hot pixel center.
+  //Only snapped vertices can be shared, the kept edges touch nothing
+  std::vector<ExactKernel::Point_2> walk;
+  std::vector<bool> shared;
+  std::list<std::list<ExactKernel::Point_2> >::iterator pl = polylines.begin();
+  for (size_t k = 0; k < m; k++) {
+    if (!snapped[k] || !snapped[(k + m - 1) % m]) {
+      walk.push_back(ExactKernel::Point_2(v[k].x(), v[k].y()));
+      shared.push_back(false);
+    }
+    if (!snapped[k]) continue;
+    std::list<ExactKernel::Point_2>::iterator last = --pl->end();
+    for (std::list<ExactKernel::Point_2>::iterator it = pl->begin(); it != last; ++it) {
+      walk.push_back(*it);
+      shared.push_back(true);
+    }
+    if (!snapped[(k + 1) % m]) {
+      walk.push_back(*last);
+      shared.push_back(true);
+    }
+    ++pl;
+  }
+
+  std::vector<Point> best = m <= ARRANGEMENT_LIMIT ? outerBoundary(walk) : largestLoop(walk, shared);
+  p = Polygon_2(best.begin(), best.end());
+}
+
+bool repairPolygon(Polygon_2 &p) {
+  std::vector<Point> v = dropDuplicatesAndSpikes(p.container());
+  p = Polygon_2(v.begin(), v.end());
+  PolygonReport report = validatePolygon(p, REPAIR_LOCAL_LIMIT);
+  if (!report.intersections.empty()) {
+    snapAndClean(p, report.intersections, report.intersections.size() >= REPAIR_LOCAL_LIMIT);
+    //overlapping edges snap onto each other and leave spikes behind
+    v = dropDuplicatesAndSpikes(p.container());
+    p = Polygon_2(v.begin(), v.end());
+    report = validatePolygon(p, 1);
+  }
+  if (report.vertices >= 3 && report.clockwise) p.reverse_orientation();
+  return report.valid();
+}
+
+void printPolygonReport(std::ostream &out, const PolygonReport &report) {
+  out << "polygon p has " << report.vertices << " distinct vertices, oriented "
+      << (report.clockwise ? "clockwise" : "counterclockwise") << "." << std::endl;
+  out << "  duplicate vertices: " << report.duplicateVertices
+      << ", collinear vertices: " << report.collinearVertices
+      << ", spikes: " << report.spikes << std::endl;
+  out << "  self intersections:";
+  if (report.intersections.empty()) out << " none";
+  for (size_t k = 0; k < report.intersections.size(); k++) {
+    out << " (" << report.intersections[k].first << "," << report.intersections[k].second << ")";
+  }
+  out << std::endl;
+}
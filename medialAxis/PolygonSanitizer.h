@@ -0,0 +1,40 @@
+/* Description: Header file for PolygonSanitizer.cpp. Cheap validation of
+ *              an input polygon before anything is triangulated, and an
+ *              optional repair, so bad inputs are rejected up front
+ *              instead of producing a garbage axis after a full run.
+*/
+
+#ifndef POLYGONSANITIZER_H
+#define POLYGONSANITIZER_H
+
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "MedialBalls.h"
+
+struct PolygonReport {
+  size_t vertices;
+  //consecutive vertices at the same position
+  size_t duplicateVertices;
+  //collinear vertices are fine (dense boundaries make a better axis),
+  //spikes are the ones where the boundary folds back onto itself
+  size_t collinearVertices;
+  size_t spikes;
+  //pairs of non adjacent edges that touch or cross, edge i runs from
+  //vertex i to the next distinct vertex; capped at the requested maximum
+  std::vector<std::pair<int, int> > intersections;
+  bool clockwise;
+
+  bool valid() const {
+    return vertices >= 3 && duplicateVertices == 0 && spikes == 0 && intersections.empty();
+  }
+};
+
+PolygonReport validatePolygon(const Polygon_2 &p, size_t maxIntersections = 16);
+//drops duplicates and spikes, snap rounds and cleans up self intersections
+//and orients the polygon counterclockwise; false if it is still invalid
+bool repairPolygon(Polygon_2 &p);
+void printPolygonReport(std::ostream &out, const PolygonReport &report);
+
+#endif
@@ -0,0 +1,400 @@
+/* Description: Raster approximation of the medial axis. The polygon is
+ *              scan converted at pixel centers, then the exact Euclidean
+ *              distance transform is computed in two separable passes
+ *              (nearest outside row per column, then the lower envelope
+ *              of parabolas per row, Felzenszwalb and Huttenlocher), and
+ *              the ridge is taken with the integer medial axis test of
+ *              Hesselink and Roerdink. Ridge pixels are traced into
+ *              branches and simplified back into balls and edges. Every
+ *              pass works on independent rows or columns and is split
+ *              across threads.
+*/
+
+#include "RasterAxis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+
+#include "ParallelFor.h"
+
+static const int NO_ROW = -(1 << 29);
+
+RasterImage rasterizePolygon(const Polygon_2 &p, int resolution) {
+  RasterImage img;
+  CGAL::Bbox_2 box = p.bbox();
+  double w = box.xmax() - box.xmin(), h = box.ymax() - box.ymin();
+  img.pixel = std::max(w, h) / std::max(resolution - 2, 1);
+  if (img.pixel <= 0) img.pixel = 1;
+  img.xmin = box.xmin() - img.pixel;
+  img.ymin = box.ymin() - img.pixel;
+  img.width = (int) std::ceil(w / img.pixel) + 2;
+  img.height = (int) std::ceil(h / img.pixel) + 2;
+  img.inside.assign((size_t) img.width * img.height, 0);
+
+  //x of every edge crossing a row center, in pixel coordinates; rows are
+  //half open in y so a vertex shared by two edges is counted once
+  std::vector<std::vector<double> > crossings(img.height);
+  for (Polygon_2::Edge_const_iterator ei = p.edges_begin(); ei != p.edges_end(); ++ei) {
+    double xa = (ei->source().x() - img.xmin) / img.pixel - 0.5;
+    double ya = (ei->source().y() - img.ymin) / img.pixel - 0.5;
+    double xb = (ei->target().x() - img.xmin) / img.pixel - 0.5;
+    double yb = (ei->target().y() - img.ymin) / img.pixel - 0.5;
+    if (ya == yb) continue;
+    if (ya > yb) {
+      std::swap(xa, xb);
+      std::swap(ya, yb);
+    }
+    int r0 = std::max(0, (int) std::ceil(ya));
+    int r1 = std::min(img.height - 1, (int) std::ceil(yb) - 1);
+    double slope = (xb - xa) / (yb - ya);
+    for (int r = r0; r <= r1; r++) {
+      crossings[r].push_back(xa + (r - ya) * slope);
+    }
+  }
+
+  parallelFor(img.height, [&](int begin, int end) {
+    for (int r = begin; r < end; r++) {
+      std::vector<double> &row = crossings[r];
+      std::sort(row.begin(), row.end());
+      unsigned char *line = &img.inside[(size_t) r * img.width];
+      for (size_t c = 0; c + 1 < row.size(); c += 2) {
+        int x0 = std::max(0, (int) std::ceil(row[c]));
+        int x1 = std::min(img.width - 1, (int) std::ceil(row[c + 1]) - 1);
+        for (int x = x0; x <= x1; x++) line[x] = 1;
+      }
+    }
+  });
+  return img;
+}
+
+DistanceTransform distanceTransform(const RasterImage &img) {
+  int W = img.width, H = img.height;
+  DistanceTransform dt;
+  dt.sqDist.resize((size_t) W * H);
+  dt.feature.resize((size_t) W * H);
+  std::vector<int> nearRow((size_t) W * H);
+
+  //pass 1: nearest outside pixel in the same column. The sweeps walk rows
+  //and the inner loops run over contiguous x, so they vectorize; threads
+  //take vertical strips.
+  parallelFor(W, [&](int x0, int x1) {
+    const unsigned char *in = &img.inside[0];
+    int *near = &nearRow[0];
+    for (int x = x0; x < x1; x++) near[x] = in[x] ? NO_ROW : 0;
+    for (int y = 1; y < H; y++) {
+      const unsigned char *inY = in + (size_t) y * W;
+      const int *above = near + (size_t) (y - 1) * W;
+      int *nearY = near + (size_t) y * W;
+      for (int x = x0; x < x1; x++) nearY[x] = inY[x] ? above[x] : y;
+    }
+    for (int y = H - 2; y >= 0; y--) {
+      const int *below = near + (size_t) (y + 1) * W;
+      int *nearY = near + (size_t) y * W;
+      for (int x = x0; x < x1; x++) {
+        int up = y - nearY[x], down = below[x] - y;
+        nearY[x] = (below[x] != NO_ROW && down < up) ? below[x] : nearY[x];
+      }
+    }
+  });
+
+  //pass 2: lower envelope of the parabolas (x - q)^2 + g(q)^2 per row
+  parallelFor(H, [&](int y0, int y1) {
+    std::vector<int> v(W);
+    std::vector<double> z(W + 1);
+    std::vector<long long> f(W);
+    for (int y = y0; y < y1; y++) {
+      const int *nearY = &nearRow[(size_t) y * W];
+      long long *dist = &dt.sqDist[(size_t) y * W];
+      int *feat = &dt.feature[(size_t) y * W];
+      int k = -1;
+      for (int q = 0; q < W; q++) {
+        if (nearY[q] == NO_ROW) continue;
+        long long g = nearY[q] - y;
+        f[q] = g * g;
+        double s = -std::numeric_limits<double>::infinity();
+        while (k >= 0) {
+          int r = v[k];
+          s = ((f[q] + (long long) q * q) - (f[r] + (long long) r * r)) / (2.0 * (q - r));
+          if (s > z[k]) break;
+          k--;
+        }
+        if (k < 0) s = -std::numeric_limits<double>::infinity();
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = std::numeric_limits<double>::infinity();
+      }
+      if (k < 0) {
+        for (int x = 0; x < W; x++) {
+          dist[x] = std::numeric_limits<long long>::max();
+          feat[x] = -1;
+        }
+        continue;
+      }
+      int j = 0;
+      for (int x = 0; x < W; x++) {
+        while (z[j + 1] < x) j++;
+        long long dx = x - v[j];
+        dist[x] = dx * dx + f[v[j]];
+        feat[x] = nearY[v[j]] * W + v[j];
+      }
+    }
+  });
+  return dt;
+}
+
+//Zhang-Suen thinning, the ridge is at most a couple of pixels thick so
+//this takes very few rounds; it removes the small cycles that two pixel
+//thick runs would otherwise leave in the traced graph
+static void thinRidge(std::vector<unsigned char> &ridge, int W, int H) {
+  std::vector<unsigned char> remove(ridge.size());
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int pass = 0; pass < 2; pass++) {
+      std::fill(remove.begin(), remove.end(), 0);
+      parallelFor(H, [&](int y0, int y1) {
+        for (int y = std::max(y0, 1); y < std::min(y1, H - 1); y++) {
+          for (int x = 1; x < W - 1; x++) {
+            size_t i = (size_t) y * W + x;
+            if (!ridge[i]) continue;
+            //P2..P9 clockwise from north
+            int n[8] = {ridge[i - W], ridge[i - W + 1], ridge[i + 1], ridge[i + W + 1],
+                        ridge[i + W], ridge[i + W - 1], ridge[i - 1], ridge[i - W - 1]};
+            int b = 0, a = 0;
+            for (int k = 0; k < 8; k++) {
+              b += n[k];
+              a += !n[k] && n[(k + 1) % 8];
+            }
+            if (b < 2 || b > 6 || a != 1) continue;
+            bool cut = pass == 0 ? !(n[0] && n[2] && n[4]) && !(n[2] && n[4] && n[6])
+                                 : !(n[0] && n[2] && n[6]) && !(n[0] && n[4] && n[6]);
+            if (cut) remove[i] = 1;
+          }
+        }
+      });
+      for (size_t i = 0; i < ridge.size(); i++) {
+        if (remove[i]) {
+          ridge[i] = 0;
+          changed = true;
+        }
+      }
+    }
+  }
+}
+
+std::vector<unsigned char> rasterRidge(const RasterImage &img, const DistanceTransform &dt,
+                                       double prune) {
+  int W = img.width, H = img.height;
+  double gamma = prune * prune;
+  std::vector<unsigned char> ridge((size_t) W * H, 0);
+
+  //p is on the ridge when a 4-neighbor q has a feature far from p's and p
+  //is on q's side of their bisector or on it; every row only writes itself
+  parallelFor(H, [&](int y0, int y1) {
+    static const int DX[4] = {1, -1, 0, 0}, DY[4] = {0, 0, 1, -1};
+    for (int y = std::max(y0, 1); y < std::min(y1, H - 1); y++) {
+      for (int x = 1; x < W - 1; x++) {
+        size_t pi = (size_t) y * W + x;
+        if (!img.inside[pi]) continue;
+        long long fpx = dt.feature[pi] % W, fpy = dt.feature[pi] / W;
+        for (int d = 0; d < 4; d++) {
+          size_t qi = (size_t) (y + DY[d]) * W + x + DX[d];
+          if (!img.inside[qi]) continue;
+          long long fqx = dt.feature[qi] % W, fqy = dt.feature[qi] / W;
+          long long ex = fpx - fqx, ey = fpy - fqy;
+          if (ex * ex + ey * ey <= gamma) continue;
+          long long crit = ex * (fpx + fqx - 2 * x - DX[d]) + ey * (fpy + fqy - 2 * y - DY[d]);
+          if (crit >= 0) {
+            ridge[pi] = 1;
+            break;
+          }
+        }
+      }
+    }
+  });
+  thinRidge(ridge, W, H);
+  return ridge;
+}
+
+//ridge pixels adjacent to pixel i: 4-neighbors, and diagonal neighbors
+//not already joined through one of the two pixels between them
+static int ridgeNeighbors(const std::vector<unsigned char> &ridge, int W, int H, int i, int out[8]) {
+  int x = i % W, y = i / W, n = 0;
+  bool e = x + 1 < W && ridge[i + 1], w = x > 0 && ridge[i - 1];
+  bool s = y + 1 < H && ridge[i + W], nn = y > 0 && ridge[i - W];
+  if (e) out[n++] = i + 1;
+  if (w) out[n++] = i - 1;
+  if (s) out[n++] = i + W;
+  if (nn) out[n++] = i - W;
+  if (x + 1 < W && y + 1 < H && ridge[i + W + 1] && !e && !s) out[n++] = i + W + 1;
+  if (x > 0 && y + 1 < H && ridge[i + W - 1] && !w && !s) out[n++] = i + W - 1;
+  if (x + 1 < W && y > 0 && ridge[i - W + 1] && !e && !nn) out[n++] = i - W + 1;
+  if (x > 0 && y > 0 && ridge[i - W - 1] && !w && !nn) out[n++] = i - W - 1;
+  return n;
+}
+
+//Douglas-Peucker on (x, y, radius) in pixels, so radius error is bounded too
+static void simplifyBranch(const std::vector<double> &pts, double tolerance,
+                           std::vector<bool> &keep) {
+  size_t n = pts.size() / 3;
+  keep.assign(n, false);
+  keep[0] = keep[n - 1] = true;
+  std::vector<std::pair<size_t, size_t> > stack(1, std::make_pair((size_t) 0, n - 1));
+  while (!stack.empty()) {
+    size_t a = stack.back().first, b = stack.back().second;
+    stack.pop_back();
+    if (b <= a + 1) continue;
+    double d[3], len2 = 0;
+    for (int c = 0; c < 3; c++) {
+      d[c] = pts[3 * b + c] - pts[3 * a + c];
+      len2 += d[c] * d[c];
+    }
+    double worst = -1;
+    size_t split = a;
+    for (size_t k = a + 1; k < b; k++) {
+      double v[3], t = 0, e2 = 0;
+      for (int c = 0; c < 3; c++) {
+        v[c] = pts[3 * k + c] - pts[3 * a + c];
+        t += v[c] * d[c];
+      }
+      t = len2 > 0 ? std::max(0.0, std::min(1.0, t / len2)) : 0;
+      for (int c = 0; c < 3; c++) e2 += (v[c] - t * d[c]) * (v[c] - t * d[c]);
+      if (e2 > worst) {
+        worst = e2;
+        split = k;
+      }
+    }
+    if (worst > tolerance * tolerance) {
+      keep[split] = true;
+      stack.push_back(std::make_pair(a, split));
+      stack.push_back(std::make_pair(split, b));
+    }
+  }
+}
+
+MedialGraph vectorizeRidge(const RasterImage &img, const DistanceTransform &dt,
+                           const std::vector<unsigned char> &ridge, double tolerance) {
+  int W = img.width, H = img.height;
+  MedialGraph g;
+  std::unordered_map<int, int> ballOf;
+  std::vector<unsigned char> visited(ridge.size(), 0);
+
+  struct Emit {
+    const RasterImage &img;
+    const DistanceTransform &dt;
+    MedialGraph &g;
+    std::unordered_map<int, int> &ballOf;
+    int ball(int i) {
+      std::unordered_map<int, int>::iterator it = ballOf.find(i);
+      if (it != ballOf.end()) return it->second;
+      MedialBall b;
+      b.center = Point(img.xmin + (i % img.width + 0.5) * img.pixel,
+                       img.ymin + (i / img.width + 0.5) * img.pixel);
+      b.radius = std::max(std::sqrt((double) dt.sqDist[i]) - 0.5, 0.0) * img.pixel;
+      b.removalScale = std::numeric_limits<double>::infinity();
+      int id = (int) g.balls.size();
+      g.balls.push_back(b);
+      ballOf[i] = id;
+      return id;
+    }
+    void edge(int a, int b) {
+      g.edges.push_back(std::make_pair(a, b));
+      g.edgeRemovalScale.push_back(std::numeric_limits<double>::infinity());
+    }
+  } emit = {img, dt, g, ballOf};
+
+  std::vector<int> branch;
+  std::vector<double> pts;
+  std::vector<bool> keep;
+  int nb[8], nb2[8];
+  //walks from start through first until a pixel that is not a plain
+  //chain pixel (or start again), then emits the simplified branch
+  auto trace = [&](int start, int first) {
+    branch.assign(1, start);
+    int prev = start, cur = first;
+    while (true) {
+      branch.push_back(cur);
+      if (cur == start || ridgeNeighbors(ridge, W, H, cur, nb2) != 2) break;
+      visited[cur] = 1;
+      int next = nb2[0] == prev ? nb2[1] : nb2[0];
+      prev = cur;
+      cur = next;
+    }
+    pts.resize(3 * branch.size());
+    for (size_t k = 0; k < branch.size(); k++) {
+      pts[3 * k] = branch[k] % W;
+      pts[3 * k + 1] = branch[k] / W;
+      pts[3 * k + 2] = std::sqrt((double) dt.sqDist[branch[k]]);
+    }
+    simplifyBranch(pts, tolerance, keep);
+    int last = emit.ball(branch[0]);
+    for (size_t k = 1; k < branch.size(); k++) {
+      if (!keep[k]) continue;
+      int id = emit.ball(branch[k]);
+      emit.edge(last, id);
+      last = id;
+    }
+  };
+
+  for (int i = 0; i < W * H; i++) {
+    if (!ridge[i]) continue;
+    int n = ridgeNeighbors(ridge, W, H, i, nb);
+    if (n == 2) continue;
+    emit.ball(i);
+    int own[8];
+    std::copy(nb, nb + n, own);
+    for (int k = 0; k < n; k++) {
+      int m = ridgeNeighbors(ridge, W, H, own[k], nb2);
+      if (m != 2) {
+        //two branch points side by side, emit their edge once
+        if (i < own[k]) emit.edge(emit.ball(i), emit.ball(own[k]));
+      }
+      else if (!visited[own[k]]) {
+        trace(i, own[k]);
+      }
+    }
+  }
+  //closed loops without any branch point
+  for (int i = 0; i < W * H; i++) {
+    if (!ridge[i] || visited[i] || ballOf.count(i)) continue;
+    if (ridgeNeighbors(ridge, W, H, i, nb) != 2) continue;
+    visited[i] = 1;
+    trace(i, nb[0]);
+  }
+
+  //a polygon is simply connected, so remaining cycles are digitization
+  //artifacts: keep a spanning forest, preferring edges through big balls
+  std::vector<int> order(g.edges.size()), parent(g.balls.size());
+  std::vector<double> width(g.edges.size());
+  for (size_t e = 0; e < g.edges.size(); e++) {
+    order[e] = (int) e;
+    width[e] = std::min(g.balls[g.edges[e].first].radius, g.balls[g.edges[e].second].radius);
+  }
+  for (size_t b = 0; b < parent.size(); b++) parent[b] = (int) b;
+  std::sort(order.begin(), order.end(), [&](int a, int b) { return width[a] > width[b]; });
+  auto root = [&](int b) {
+    while (parent[b] != b) b = parent[b] = parent[parent[b]];
+    return b;
+  };
+  std::vector<std::pair<int, int> > forest;
+  for (size_t k = 0; k < order.size(); k++) {
+    int a = root(g.edges[order[k]].first), b = root(g.edges[order[k]].second);
+    if (a == b) continue;
+    parent[a] = b;
+    forest.push_back(g.edges[order[k]]);
+  }
+  g.edges.swap(forest);
+  g.edgeRemovalScale.resize(g.edges.size());
+  return g;
+}
+
+MedialGraph rasterMedialAxis(const Polygon_2 &p, int resolution, double prune) {
+  RasterImage img = rasterizePolygon(p, resolution);
+  DistanceTransform dt = distanceTransform(img);
+  std::vector<unsigned char> ridge = rasterRidge(img, dt, prune);
+  return vectorizeRidge(img, dt, ridge, 1.0);
+}
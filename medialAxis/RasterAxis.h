@@ -0,0 +1,38 @@
+/* Description: Header file for RasterAxis.cpp. Approximate medial axis
+ *              for very large or noisy polygons: the polygon is
+ *              rasterized, an exact Euclidean distance transform is taken,
+ *              and the ridge of the transform is vectorized back into
+ *              medial balls and edges. Cost is linear in the pixel count
+ *              and does not depend on the number of polygon vertices.
+*/
+
+#ifndef RASTERAXIS_H
+#define RASTERAXIS_H
+
+#include <vector>
+
+#include "MedialBalls.h"
+
+//polygon sampled at pixel centers, with a one pixel empty margin
+struct RasterImage {
+  int width, height;
+  double xmin, ymin, pixel;
+  std::vector<unsigned char> inside;
+};
+
+//squared distance (in pixels) from every pixel to the nearest outside
+//pixel center, and the index of that pixel
+struct DistanceTransform {
+  std::vector<long long> sqDist;
+  std::vector<int> feature;
+};
+
+RasterImage rasterizePolygon(const Polygon_2 &p, int resolution);
+DistanceTransform distanceTransform(const RasterImage &img);
+std::vector<unsigned char> rasterRidge(const RasterImage &img, const DistanceTransform &dt,
+                                       double prune);
+MedialGraph vectorizeRidge(const RasterImage &img, const DistanceTransform &dt,
+                           const std::vector<unsigned char> &ridge, double tolerance);
+MedialGraph rasterMedialAxis(const Polygon_2 &p, int resolution, double prune = 4.0);
+
+#endif
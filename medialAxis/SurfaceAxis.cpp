@@ -0,0 +1,242 @@
+/* Description: 3D mode. Read OFF meshes and point samples, built the
+ *              Delaunay triangulation of the points (CGAL's parallel
+ *              insertion when linked with TBB) and kept the tetrahedra
+ *              whose circumcenter is inside the surface. For a mesh every
+ *              circumcenter casts three rays against an AABB tree of the
+ *              triangles and the majority of the crossing parities wins,
+ *              so a ray grazing an edge or a vertex cannot flip it. For a
+ *              sample with normals the circumcenter is inside when it is
+ *              behind the surface as seen from most of the tetrahedron's
+ *              vertices, which is what makes the inner pole of a sample
+ *              inner. Circumcenters are computed and classified for all
+ *              tetrahedra in parallel.
+*/
+
+#include "SurfaceAxis.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include <CGAL/Delaunay_triangulation_3.h>
+#include <CGAL/Triangulation_vertex_base_with_info_3.h>
+#include <CGAL/Triangulation_cell_base_with_info_3.h>
+#include <CGAL/AABB_tree.h>
+#include <CGAL/AABB_traits.h>
+#include <CGAL/AABB_triangle_primitive.h>
+
+#include "ParallelFor.h"
+
+#ifdef CGAL_LINKED_WITH_TBB
+typedef CGAL::Parallel_tag SampleConcurrency;
+#else
+typedef CGAL::Sequential_tag SampleConcurrency;
+#endif
+
+//vertex info is the sample index, cell info the index of the cell's
+//medial ball, -1 if outside
+typedef CGAL::Triangulation_vertex_base_with_info_3<int, K> SampleVb;
+typedef CGAL::Triangulation_cell_base_with_info_3<int, K> SampleCb;
+typedef CGAL::Triangulation_data_structure_3<SampleVb, SampleCb, SampleConcurrency> SampleTds;
+typedef CGAL::Delaunay_triangulation_3<K, SampleTds> SampleTriangulation;
+
+typedef CGAL::Triangle_3<K> Triangle_3;
+typedef CGAL::Ray_3<K> Ray_3;
+typedef std::vector<Triangle_3>::const_iterator TriangleIterator;
+typedef CGAL::AABB_triangle_primitive<K, TriangleIterator> TrianglePrimitive;
+typedef CGAL::AABB_traits<K, TrianglePrimitive> TriangleTraits;
+typedef CGAL::AABB_tree<TriangleTraits> TriangleTree;
+
+//next line holding something other than a comment
+static bool nextLine(std::istream &in, std::istringstream &line) {
+  std::string text;
+  while (std::getline(in, text)) {
+    size_t hash = text.find('#');
+    if (hash != std::string::npos) text.erase(hash);
+    if (text.find_first_not_of(" \t\r") == std::string::npos) continue;
+    line.clear();
+    line.str(text);
+    return true;
+  }
+  return false;
+}
+
+bool readOFF(const std::string &fileName, SurfaceSample &s) {
+  s = SurfaceSample();
+  std::ifstream in(fileName.c_str());
+  std::istringstream line;
+  std::string header;
+  if (!nextLine(in, line) || !(line >> header)) return false;
+  //[ST][C][N]OFF; 4D and n-dimensional variants are not supported
+  size_t off = header.rfind("OFF");
+  if (off == std::string::npos || off + 3 != header.size()) return false;
+  std::string prefix = header.substr(0, off);
+  if (prefix.find_first_of("4n") != std::string::npos) return false;
+  bool normals = prefix.find('N') != std::string::npos;
+
+  int nv, nf;
+  if (!(line >> nv >> nf) && (!nextLine(in, line) || !(line >> nv >> nf))) return false;
+  if (nv < 0 || nf < 0) return false;
+
+  for (int i = 0; i < nv; i++) {
+    double x, y, z, nx, ny, nz;
+    if (!nextLine(in, line) || !(line >> x >> y >> z)) return false;
+    s.points.push_back(Point_3(x, y, z));
+    if (!normals) continue;
+    if (!(line >> nx >> ny >> nz)) return false;
+    s.normals.push_back(Vector_3(nx, ny, nz));
+  }
+  for (int f = 0; f < nf; f++) {
+    int k;
+    if (!nextLine(in, line) || !(line >> k) || k < 0) return false;
+    std::vector<int> polygon(k);
+    for (int j = 0; j < k; j++) {
+      if (!(line >> polygon[j]) || polygon[j] < 0 || polygon[j] >= nv) return false;
+    }
+    for (int j = 1; j + 1 < k; j++) {
+      s.triangles.push_back(polygon[0]);
+      s.triangles.push_back(polygon[j]);
+      s.triangles.push_back(polygon[j + 1]);
+    }
+  }
+  return true;
+}
+
+//odd number of triangles crossed by most of three rays in unrelated
+//directions
+static bool insideMesh(const TriangleTree &tree, const CGAL::Bbox_3 &box, const Point_3 &c) {
+  if (c.x() < box.xmin() || c.x() > box.xmax() || c.y() < box.ymin() || c.y() > box.ymax() ||
+      c.z() < box.zmin() || c.z() > box.zmax()) {
+    return false;
+  }
+  static const double DIRECTIONS[3][3] = {
+    {1, 0.3137, 0.1731}, {-0.2213, 1, 0.4261}, {0.3571, -0.1337, -1}
+  };
+  int votes = 0;
+  for (int r = 0; r < 3; r++) {
+    Ray_3 ray(c, Vector_3(DIRECTIONS[r][0], DIRECTIONS[r][1], DIRECTIONS[r][2]));
+    votes += tree.number_of_intersected_primitives(ray) % 2;
+    if (votes == 2 || votes + 2 - r < 2) break;
+  }
+  return votes >= 2;
+}
+
+SurfaceAxis surfaceMedialAxis(const SurfaceSample &s) {
+  SurfaceAxis axis;
+  bool mesh = !s.triangles.empty();
+  if (s.points.size() < 4 || (!mesh && s.normals.size() != s.points.size())) return axis;
+
+  CGAL::Bbox_3 box = s.points[0].bbox();
+  for (size_t i = 1; i < s.points.size(); i++) box = box + s.points[i].bbox();
+#ifdef CGAL_LINKED_WITH_TBB
+  SampleTriangulation::Lock_data_structure locks(box, 50);
+  SampleTriangulation t(K(), &locks);
+#else
+  SampleTriangulation t;
+#endif
+  t.insert(s.points.begin(), s.points.end());
+
+  //range insertion drops the order, so samples are found back by position
+  std::vector<int> order(s.points.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = (int) i;
+  struct LessPoint {
+    const std::vector<Point_3> &points;
+    bool operator()(int a, int b) const { return points[a] < points[b]; }
+  } lessPoint = {s.points};
+  std::stable_sort(order.begin(), order.end(), lessPoint);
+  for (SampleTriangulation::Finite_vertices_iterator vi = t.finite_vertices_begin();
+       vi != t.finite_vertices_end(); ++vi) {
+    std::vector<int>::iterator it = std::lower_bound(order.begin(), order.end(), -1,
+      [&](int a, int) { return s.points[a] < vi->point(); });
+    vi->info() = it != order.end() && s.points[*it] == vi->point() ? *it : -1;
+  }
+
+  std::vector<SampleTriangulation::Cell_handle> cells;
+  for (SampleTriangulation::Cell_iterator ci = t.cells_begin(); ci != t.cells_end(); ++ci) {
+    ci->info() = -1;
+    if (!t.is_infinite(ci)) cells.push_back(ci);
+  }
+
+  std::vector<Triangle_3> triangles;
+  for (size_t k = 0; k + 2 < s.triangles.size(); k += 3) {
+    Triangle_3 tri(s.points[s.triangles[k]], s.points[s.triangles[k + 1]], s.points[s.triangles[k + 2]]);
+    if (!tri.is_degenerate()) triangles.push_back(tri);
+  }
+  TriangleTree tree(triangles.begin(), triangles.end());
+  //built here, a lazy build on the first query would race
+  if (mesh) tree.build();
+
+  std::vector<Point_3> centers(cells.size());
+  std::vector<char> inside(cells.size(), 0);
+  parallelFor((int) cells.size(), [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      SampleTriangulation::Cell_handle c = cells[i];
+      centers[i] = CGAL::circumcenter(c->vertex(0)->point(), c->vertex(1)->point(),
+                                      c->vertex(2)->point(), c->vertex(3)->point());
+      if (mesh) {
+        inside[i] = insideMesh(tree, box, centers[i]);
+        continue;
+      }
+      int behind = 0;
+      for (int v = 0; v < 4; v++) {
+        int sample = c->vertex(v)->info();
+        if (sample >= 0 && (centers[i] - c->vertex(v)->point()) * s.normals[sample] < 0) behind++;
+      }
+      inside[i] = behind >= 3;
+    }
+  });
+
+  //the inner pole of a sample is the biggest inside ball it touches
+  std::vector<double> poleRadius(s.points.size(), -1);
+  std::vector<int> pole(s.points.size(), -1);
+  for (size_t i = 0; i < cells.size(); i++) {
+    if (!inside[i]) continue;
+    MedialBall3 ball;
+    ball.center = centers[i];
+    ball.radius = std::sqrt(CGAL::squared_distance(centers[i], cells[i]->vertex(0)->point()));
+    ball.pole = false;
+    cells[i]->info() = (int) axis.balls.size();
+    for (int v = 0; v < 4; v++) {
+      int sample = cells[i]->vertex(v)->info();
+      if (sample >= 0 && ball.radius > poleRadius[sample]) {
+        poleRadius[sample] = ball.radius;
+        pole[sample] = cells[i]->info();
+      }
+    }
+    axis.balls.push_back(ball);
+  }
+  for (size_t i = 0; i < pole.size(); i++) {
+    if (pole[i] >= 0) axis.balls[pole[i]].pole = true;
+  }
+
+  //the Voronoi face dual to a Delaunay edge joins the balls of the cells
+  //around the edge, it is internal when all of them are
+  for (SampleTriangulation::Finite_edges_iterator ei = t.finite_edges_begin(); ei != t.finite_edges_end(); ++ei) {
+    std::vector<int> face;
+    SampleTriangulation::Cell_circulator cc = t.incident_cells(*ei), done = cc;
+    do {
+      if (cc->info() < 0) {
+        face.clear();
+        break;
+      }
+      face.push_back(cc->info());
+    } while (++cc != done);
+    if (face.size() >= 3) axis.faces.push_back(face);
+  }
+  return axis;
+}
+
+void writeSurfaceAxis(std::ostream &out, const SurfaceAxis &axis) {
+  out << axis.balls.size() << " " << axis.faces.size() << "\n";
+  for (size_t i = 0; i < axis.balls.size(); i++) {
+    const MedialBall3 &b = axis.balls[i];
+    out << b.center.x() << " " << b.center.y() << " " << b.center.z() << " " << b.radius << " "
+        << (b.pole ? 1 : 0) << "\n";
+  }
+  for (size_t f = 0; f < axis.faces.size(); f++) {
+    out << axis.faces[f].size();
+    for (size_t k = 0; k < axis.faces[f].size(); k++) out << " " << axis.faces[f][k];
+    out << "\n";
+  }
+}
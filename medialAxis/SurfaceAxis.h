@@ -0,0 +1,53 @@
+/* Description: Header file for SurfaceAxis.cpp. Medial surface of a
+ *              closed surface approximated the way the 2D tool does it:
+ *              the Voronoi vertices of a dense sample (circumcenters of
+ *              the Delaunay tetrahedra) that lie inside the surface, and
+ *              the Voronoi faces whose vertices are all inside. Inside is
+ *              decided by ray parity against the mesh triangles or, for
+ *              a point sample with normals, by the oriented normals of
+ *              the tetrahedron's vertices (the poles method).
+*/
+
+#ifndef SURFACEAXIS_H
+#define SURFACEAXIS_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
+
+typedef CGAL::Exact_predicates_inexact_constructions_kernel K;
+typedef CGAL::Point_3<K> Point_3;
+typedef CGAL::Vector_3<K> Vector_3;
+
+//an OFF file: points, plus triangles (polygons are fanned) for a mesh or
+//outward normals (NOFF) for a point sample
+struct SurfaceSample {
+  std::vector<Point_3> points;
+  std::vector<Vector_3> normals;
+  std::vector<int> triangles;
+};
+
+struct MedialBall3 {
+  Point_3 center;
+  double radius;
+  //largest inside ball touching one of the samples (its inner pole)
+  bool pole;
+};
+
+struct SurfaceAxis {
+  std::vector<MedialBall3> balls;
+  //ball indices around every internal Voronoi face
+  std::vector<std::vector<int> > faces;
+};
+
+//false if the file is missing or not a valid OFF file
+bool readOFF(const std::string &fileName, SurfaceSample &s);
+//empty if the sample has neither triangles nor normals
+SurfaceAxis surfaceMedialAxis(const SurfaceSample &s);
+//ball and face counts, "x y z radius pole" per ball, then the ball count
+//and indices of every face
+void writeSurfaceAxis(std::ostream &out, const SurfaceAxis &axis);
+
+#endif
@@ -30,6 +30,7 @@
 #include <vector>
 #include <algorithm>
 #include <utility>
+#include <iterator>
 #include <iostream>
 
 #include <CGAL/utility.h>
@@ -39,6 +40,7 @@
 #include <CGAL/Alpha_shape_vertex_base_2.h>
 #include <CGAL/Alpha_shape_face_base_2.h>
 #include <CGAL/internal/Lazy_alpha_nt_2.h>
+#include <CGAL/internal/Flat_interval_tree.h>
 
 
 
@@ -53,9 +55,9 @@ class Alpha_shape_2 : public Dt
   // connectivity and order among its faces. Each k-dimensional face of the
   // Delaunay triangulation is associated with an interval that specifies
   // for which values of alpha the face belongs to the alpha-shape (sorted
-  // linear arrays resp. multimaps or interval trees). There are links
+  // linear arrays, and interval trees built on demand). There are links
   // between the intervals and the k-dimensional faces of the Delaunay
-  // triangulation (multimaps resp. std::hashtables).
+  // triangulation.
   //
 
   //------------------------- TYPES ------------------------------------
@@ -115,17 +117,20 @@ public:
 
 private:
 
-  typedef std::multimap< Type_of_alpha, Face_handle >  Interval_face_map;
-  typedef typename Interval_face_map::value_type    Interval_face;
+  // the "maps" are vectors sorted once by interval, in the order of
+  // the multimaps they replace (equal intervals keep the order in which
+  // they were computed)
+  typedef std::pair< Type_of_alpha, Face_handle >   Interval_face;
+  typedef std::vector< Interval_face >              Interval_face_map;
 
   typedef typename Tds::Face::Interval_3            Interval3;
   
-  typedef std::multimap< Interval3, Edge >          Interval_edge_map;
-  typedef typename Interval_edge_map::value_type    Interval_edge;
+  typedef std::pair< Interval3, Edge >              Interval_edge;
+  typedef std::vector< Interval_edge >              Interval_edge_map;
 
   typedef std::pair< Type_of_alpha, Type_of_alpha > Interval2;
-  typedef std::multimap< Interval2, Vertex_handle > Interval_vertex_map;
-  typedef typename Interval_vertex_map::value_type  Interval_vertex;
+  typedef std::pair< Interval2, Vertex_handle >     Interval_vertex;
+  typedef std::vector< Interval_vertex >            Interval_vertex_map;
 
   typedef Face_handle const const_void;
   typedef std::pair<const_void, int> const_Edge;
@@ -134,7 +139,7 @@ private:
   
   typedef std::vector< Segment > Vect_seg;
 
-  typedef Unique_hash_map< Face_handle, bool > Marked_face_set;
+  typedef internal::Flat_interval_tree Interval_tree;
 
 public:
 
@@ -174,12 +179,30 @@ public:
 
 private:
 
+  //made private as the Triangulation_2 versions do not compute the alpha
+  //values
+  void binary_output(std::ostream& os) const;
+  bool binary_input(std::istream& is, bool check = false);
+
   // only finite edges and faces are inserted into the maps 
   Interval_face_map _interval_face_map;
   Interval_edge_map _interval_edge_map;
   Interval_vertex_map _interval_vertex_map;
 
   Alpha_spectrum _alpha_spectrum;
+
+  // The filtration, built on first use by initialize_filtration(). The
+  // ends of the intervals are replaced by their ranks in the spectrum
+  // (see alpha_rank()). Edge and vertex e are in
+  //   _singular_*_tree as [rank where e becomes singular, where regular)
+  //   _regular_*_tree  as [rank where e becomes regular, where interior)
+  // and the events list e * 3, e * 3 + 1, e * 3 + 2 for these three
+  // ranks, sorted by rank. _solid_components[r] is the number of solid
+  // components at the alphas of rank r.
+  mutable Interval_tree _singular_edge_tree, _regular_edge_tree;
+  mutable Interval_tree _singular_vertex_tree, _regular_vertex_tree;
+  mutable std::vector<int> _edge_events, _vertex_events;
+  mutable std::vector<size_type> _solid_components;
  
   Type_of_alpha _alpha;
   Mode _mode;
@@ -192,6 +215,7 @@ private:
 
   mutable bool use_vertex_cache;
   mutable bool use_edge_cache;
+  mutable bool use_filtration_cache;
 public:
 
   //------------------------- CONSTRUCTORS ------------------------------
@@ -201,7 +225,8 @@ public:
   Alpha_shape_2(Type_of_alpha alpha = Type_of_alpha(0), 
 		Mode m = GENERAL)
     : _alpha(alpha), _mode(m), Infinity(-1), UNDEFINED(-2),
-      use_vertex_cache(false), use_edge_cache(false)
+      use_vertex_cache(false), use_edge_cache(false),
+      use_filtration_cache(false)
     {}
  
   // Introduces an alpha-shape `A' for a positive alpha-value
@@ -213,7 +238,8 @@ public:
 		const Type_of_alpha& alpha = Type_of_alpha(0),
 		Mode m = GENERAL)
     : _alpha(alpha), _mode(m), Infinity(-1), UNDEFINED(-2) ,
-      use_vertex_cache(false), use_edge_cache(false)
+      use_vertex_cache(false), use_edge_cache(false),
+      use_filtration_cache(false)
     {
       Dt::insert(first, last);
       if (dimension() == 2)
@@ -238,7 +264,8 @@ public:
 		const Type_of_alpha& alpha = Type_of_alpha(0),
 		Mode m = GENERAL)
     : _alpha(alpha), _mode(m), Infinity(-1), UNDEFINED(-2) ,
-      use_vertex_cache(false), use_edge_cache(false)
+      use_vertex_cache(false), use_edge_cache(false),
+      use_filtration_cache(false)
     {
       Dt::swap(dt);
       if (dimension() == 2)
@@ -310,6 +337,8 @@ private :
 
   void initialize_alpha_spectrum();
 
+  void initialize_filtration() const;
+
   //---------------------------------------------------------------------
 
 public:
@@ -325,6 +354,15 @@ public:
     
       _alpha_spectrum.clear();
 
+      _singular_edge_tree.clear();
+      _regular_edge_tree.clear();
+      _singular_vertex_tree.clear();
+      _regular_vertex_tree.clear();
+      _edge_events.clear();
+      _vertex_events.clear();
+      _solid_components.clear();
+      use_filtration_cache = false;
+
       Alpha_shape_vertices_list.clear();
       Alpha_shape_edges_list.clear();
     
@@ -360,6 +398,53 @@ private:
       }
   };
 
+  // orders the entries of the interval maps by interval only, as the
+  // keys of a multimap
+  struct Less_interval
+  {
+    template <class Entry>
+    bool operator()(const Entry& e, const Entry& e2) const
+      {
+	return e.first < e2.first;
+      }
+  };
+
+  // orders the events of the filtration by rank
+  struct Less_event
+  {
+    const Interval_tree* singular;
+    const Interval_tree* regular;
+
+    Less_event(const Interval_tree* s, const Interval_tree* r)
+      : singular(s), regular(r) {}
+
+    int rank(int event) const
+      {
+	int e = event / 3;
+	switch (event % 3)
+	  {
+	  case 0  : return singular->lo(e);
+	  case 1  : return regular->lo(e);
+	  default : return regular->hi(e);
+	  }
+      }
+
+    bool operator()(int event, int event2) const
+      {
+	return rank(event) < rank(event2);
+      }
+
+    bool operator()(int event, const std::ptrdiff_t& r) const
+      {
+	return rank(event) < r;
+      }
+
+    bool operator()(const std::ptrdiff_t& r, int event) const
+      {
+	return r < rank(event);
+      }
+  };
+
   
   //----------------------- ACCESS TO PRIVATE MEMBERS -----------------
 
@@ -378,6 +463,20 @@ private:
       // return the Interval3 for the edge n
     }
 
+  std::ptrdiff_t alpha_rank(const Type_of_alpha& alpha) const
+    {
+      // returns the number of alpha-values of the spectrum that are
+      // not greater than `alpha', or its size + 1 for Infinity. The end
+      // of an interval is not greater than alpha iff its rank is not
+      // greater than the rank of alpha, as the ends are 0, Infinity or
+      // in the spectrum.
+      if (alpha == Infinity)
+	return _alpha_spectrum.size() + 1;
+      return std::upper_bound(_alpha_spectrum.begin(),
+			      _alpha_spectrum.end(),
+			      alpha) - _alpha_spectrum.begin();
+    }
+
 
   //---------------------------------------------------------------------
 
@@ -573,6 +672,88 @@ public:
 			      alpha);
     }
 
+  //--------------------- FILTRATION -----------------------------------
+
+  // The boundary of the alpha shape for any alpha, and the way it
+  // changes from one alpha to another, in the current mode. The
+  // intervals are ranked in the spectrum and put in flat interval trees
+  // on the first call, after which each call takes O(log n + k) time
+  // for k edges or vertices written. Sweeping the spectrum with
+  // consecutive changes thus costs the size of the filtration, instead
+  // of a scan of the sorted intervals for each alpha-value.
+
+  template < class OutputIterator >
+  OutputIterator alpha_shape_edges(const Type_of_alpha& alpha,
+				   OutputIterator out) const
+    {
+      // Writes the regular edges of the alpha shape for `alpha' to
+      // `out', followed by the singular ones in GENERAL mode.
+      return write_boundary(_singular_edge_tree, _regular_edge_tree,
+			    _interval_edge_map, alpha, out);
+    }
+
+  template < class OutputIterator >
+  OutputIterator alpha_shape_vertices(const Type_of_alpha& alpha,
+				      OutputIterator out) const
+    {
+      // Writes the regular vertices of the alpha shape for `alpha' to
+      // `out', followed by the singular ones in GENERAL mode.
+      return write_boundary(_singular_vertex_tree, _regular_vertex_tree,
+			    _interval_vertex_map, alpha, out);
+    }
+
+  template < class OutputIterator1, class OutputIterator2 >
+  std::pair<OutputIterator1, OutputIterator2>
+  alpha_shape_edges_change(const Type_of_alpha& from,
+			   const Type_of_alpha& to,
+			   OutputIterator1 added,
+			   OutputIterator2 removed) const
+    {
+      // Writes the edges of the alpha shape for `to' that are not in
+      // the alpha shape for `from' to `added', and the edges of the
+      // alpha shape for `from' that are not in the one for `to' to
+      // `removed'.
+      return write_change(_singular_edge_tree, _regular_edge_tree,
+			  _edge_events, _interval_edge_map,
+			  from, to, added, removed);
+    }
+
+  template < class OutputIterator1, class OutputIterator2 >
+  std::pair<OutputIterator1, OutputIterator2>
+  alpha_shape_vertices_change(const Type_of_alpha& from,
+			      const Type_of_alpha& to,
+			      OutputIterator1 added,
+			      OutputIterator2 removed) const
+    {
+      // Same as alpha_shape_edges_change() for the vertices.
+      return write_change(_singular_vertex_tree, _regular_vertex_tree,
+			  _vertex_events, _interval_vertex_map,
+			  from, to, added, removed);
+    }
+
+private:
+
+  template < class Interval_map, class OutputIterator >
+  OutputIterator write_boundary(const Interval_tree& singular,
+				const Interval_tree& regular,
+				const Interval_map& map,
+				const Type_of_alpha& alpha,
+				OutputIterator out) const;
+
+  template < class Interval_map,
+	     class OutputIterator1, class OutputIterator2 >
+  std::pair<OutputIterator1, OutputIterator2>
+  write_change(const Interval_tree& singular,
+	       const Interval_tree& regular,
+	       const std::vector<int>& events,
+	       const Interval_map& map,
+	       const Type_of_alpha& from,
+	       const Type_of_alpha& to,
+	       OutputIterator1 added,
+	       OutputIterator2 removed) const;
+
+public:
+
   //--------------------- PREDICATES -----------------------------------
 
   // the classification predicates take 
@@ -688,12 +869,6 @@ public:
   size_type
   number_of_solid_components(const Type_of_alpha& alpha) const;
 
-private:
-
-  void traverse(const Face_handle& pFace,
-		Marked_face_set& marked_face_set, 
-		const Type_of_alpha alpha) const;
-
 //  class Line_face_circulator;
 
   //----------------------------------------------------------------------
@@ -765,15 +940,20 @@ Alpha_shape_2<Dt,EACT>::initialize_interval_face_map()
 {
   Type_of_alpha alpha_f;
 
+  _interval_face_map.reserve(this->number_of_faces());
+
   // only finite faces
   for(Finite_faces_iterator face_it = faces_begin(); face_it != faces_end(); ++face_it)
     {
       alpha_f = squared_radius(face_it);
-      _interval_face_map.insert(Interval_face(alpha_f, face_it));
+      _interval_face_map.push_back(Interval_face(alpha_f, face_it));
 
       // cross references
       face_it->set_alpha(alpha_f);
     } 
+
+  std::stable_sort(_interval_face_map.begin(), _interval_face_map.end(),
+		   Less_interval());
 }
 
 //-------------------------------------------------------------------------
@@ -785,6 +965,9 @@ Alpha_shape_2<Dt,EACT>::initialize_interval_edge_map()
   Edge_iterator edge_it;
   Edge edge;
 
+  // V - E + F = 1 counting the finite faces only
+  _interval_edge_map.reserve(number_of_vertices() + this->number_of_faces() - 1);
+
   // only finite faces
   for( edge_it = edges_begin(); 
        edge_it != edges_end(); 
@@ -868,7 +1051,7 @@ Alpha_shape_2<Dt,EACT>::initialize_interval_edge_map()
 	    }
 	}
       
-      _interval_edge_map.insert(Interval_edge(interval, edge));
+      _interval_edge_map.push_back(Interval_edge(interval, edge));
       
       // cross-links
       (edge.first)->set_ranges(edge.second,interval);
@@ -879,6 +1062,9 @@ Alpha_shape_2<Dt,EACT>::initialize_interval_edge_map()
 
     }
 
+  std::stable_sort(_interval_edge_map.begin(), _interval_edge_map.end(),
+		   Less_interval());
+
   // Remark:
   // The interval_edge_map will be sorted as follows
   // first the attached edges on the convex hull
@@ -902,6 +1088,8 @@ Alpha_shape_2<Dt,EACT>::initialize_interval_vertex_map()
 
   Finite_vertices_iterator vertex_it;
 
+  _interval_vertex_map.reserve(number_of_vertices());
+
   for( vertex_it = finite_vertices_begin(); 
        vertex_it != finite_vertices_end(); 
        ++vertex_it) 
@@ -991,11 +1179,14 @@ Alpha_shape_2<Dt,EACT>::initialize_interval_vertex_map()
 	
  
       Interval2 interval = std::make_pair(alpha_mid_v, alpha_max_v);
-      _interval_vertex_map.insert(Interval_vertex(interval, vertex_it));
+      _interval_vertex_map.push_back(Interval_vertex(interval, vertex_it));
 
       // cross references
       vertex_it->set_range(interval);
     }
+
+  std::stable_sort(_interval_vertex_map.begin(), _interval_vertex_map.end(),
+		   Less_interval());
 }
 
 //-------------------------------------------------------------------------
@@ -1071,163 +1262,224 @@ Alpha_shape_2<Dt,EACT>::initialize_alpha_spectrum()
 
 }
 
-
 //-------------------------------------------------------------------------
 
-
-
 template < class Dt, class EACT >
-void
-Alpha_shape_2<Dt,EACT>::update_alpha_shape_vertex_list()const {
-	//typedef typename Alpha_shape_2<Dt,EACT>::Interval_vertex_map 
-	//                                              Interval_vertex_map;
-	typename Interval_vertex_map::const_iterator vertex_alpha_it;
-
-	//const typename Alpha_shape_2<Dt,EACT>::Interval2* pInterval2;
-	const Interval2* pInterval2;
-	Vertex_handle v;
-	Alpha_shape_vertices_list.clear();
-	// write the regular vertices
-
-	for (vertex_alpha_it = _interval_vertex_map.begin(); 
-		vertex_alpha_it != _interval_vertex_map.end() &&
-		(*vertex_alpha_it).first.first <= get_alpha();
-		++vertex_alpha_it) 
-		{
-		pInterval2 = &(*vertex_alpha_it).first;
-
-		if((pInterval2->second > get_alpha()
-		|| pInterval2->second == Infinity)) 
-		{
-		// alpha must be larger than the min boundary
-		// and alpha is smaller than the upper boundary
-		// which might be infinity 
-		// write the vertex
-		v = (*vertex_alpha_it).second;
-		CGAL_triangulation_assertion((classify(v) == REGULAR));
-		Alpha_shape_vertices_list.push_back(v);
-		}
-		}
-	 
-	if (get_mode() == Alpha_shape_2<Dt,EACT>::GENERAL) 
-		{
-		// write the singular vertices
-		for (; 
-		vertex_alpha_it != _interval_vertex_map.end();
-		++vertex_alpha_it) 
-		{
-		v = (*vertex_alpha_it).second;
-		CGAL_triangulation_assertion((classify(v) == SINGULAR));
-
-		Alpha_shape_vertices_list.push_back(v);
-		}
-		}
-	use_vertex_cache = true;
-  }
-
-//-------------------------------------------------------------------------
-
-template < class Dt, class EACT >
-void
-Alpha_shape_2<Dt,EACT>::update_alpha_shape_edges_list() const 
+void 
+Alpha_shape_2<Dt,EACT>::initialize_filtration() const
 {
+  _singular_edge_tree.clear();
+  _regular_edge_tree.clear();
+  _singular_vertex_tree.clear();
+  _regular_vertex_tree.clear();
+  _edge_events.clear();
+  _vertex_events.clear();
+
+  // an edge is singular from interval.first (never if it is attached),
+  // regular from interval.second and interior from interval.third
+  _singular_edge_tree.reserve(_interval_edge_map.size());
+  _regular_edge_tree.reserve(_interval_edge_map.size());
+  for (typename Interval_edge_map::const_iterator 
+	 edge_alpha_it = _interval_edge_map.begin();
+       edge_alpha_it != _interval_edge_map.end();
+       ++edge_alpha_it)
+    {
+      const Interval3& interval = (*edge_alpha_it).first;
+      int mid = int(alpha_rank(interval.second));
+      int max = int(alpha_rank(interval.third));
+      int min = (interval.first == UNDEFINED) ?
+	mid : int(alpha_rank(interval.first));
+      _singular_edge_tree.push_back(min, mid);
+      _regular_edge_tree.push_back(mid, max);
+    }
 
-  // Writes the edges of the alpha shape `A' for the current $\alpha$-value
-  // to the container where 'out' refers to. Returns an output iterator 
-  // which is the end of the constructed range.
-  //typedef  typename Alpha_shape_2<Dt,EACT>::Interval_edge_map Interval_edge_map;
-  typename Interval_edge_map::const_iterator edge_alpha_it;
+  // a vertex is singular from 0 (in GENERAL mode), regular from
+  // interval.first and interior from interval.second
+  _singular_vertex_tree.reserve(_interval_vertex_map.size());
+  _regular_vertex_tree.reserve(_interval_vertex_map.size());
+  for (typename Interval_vertex_map::const_iterator 
+	 vertex_alpha_it = _interval_vertex_map.begin();
+       vertex_alpha_it != _interval_vertex_map.end();
+       ++vertex_alpha_it)
+    {
+      const Interval2& interval = (*vertex_alpha_it).first;
+      int mid = int(alpha_rank(interval.first));
+      int max = int(alpha_rank(interval.second));
+      _singular_vertex_tree.push_back(0, mid);
+      _regular_vertex_tree.push_back(mid, max);
+    }
 
-  //const typename Alpha_shape_2<Dt,EACT>::Interval3* pInterval;
-  const Interval3* pInterval;
-  Alpha_shape_edges_list.clear();
-  if (get_mode() == REGULARIZED) 
+  _singular_edge_tree.build();
+  _regular_edge_tree.build();
+  _singular_vertex_tree.build();
+  _regular_vertex_tree.build();
+
+  // the events of rank 0 never happen between two alphas
+  Less_event less_edge(&_singular_edge_tree, &_regular_edge_tree);
+  _edge_events.reserve(3 * _interval_edge_map.size());
+  for (int event = 0; event < 3 * int(_interval_edge_map.size()); ++event)
+    if (less_edge.rank(event) > 0)
+      _edge_events.push_back(event);
+  std::sort(_edge_events.begin(), _edge_events.end(), less_edge);
+
+  Less_event less_vertex(&_singular_vertex_tree, &_regular_vertex_tree);
+  _vertex_events.reserve(3 * _interval_vertex_map.size());
+  for (int event = 0; event < 3 * int(_interval_vertex_map.size()); ++event)
+    if (less_vertex.rank(event) > 0)
+      _vertex_events.push_back(event);
+  std::sort(_vertex_events.begin(), _vertex_events.end(), less_vertex);
+
+  // the number of solid components for each rank: the faces are added
+  // by increasing alpha, each one joining the components of its
+  // neighbors already added (a union-find over the positions of the
+  // faces in _interval_face_map)
+  std::size_t nb_faces = _interval_face_map.size();
+  Unique_hash_map< Face_handle, int > position(0, nb_faces);
+  for (std::size_t i = 0; i < nb_faces; ++i)
+    position[_interval_face_map[i].second] = int(i);
+
+  std::vector<int> parent(nb_faces);
+  size_type nb_solid_components = 0;
+  std::size_t end = 0;
+  _solid_components.assign(_alpha_spectrum.size() + 1, 0);
+  for (std::size_t r = 0; r <= _alpha_spectrum.size(); ++r)
     {
-      // it is much faster looking at the sorted intervals 
-      // than looking at all sorted faces
-      // alpha must be larger than the mid boundary
-      // and alpha is smaller than the upper boundary
-      for (edge_alpha_it = _interval_edge_map.begin(); 
-	   edge_alpha_it != _interval_edge_map.end() &&
-	     (*edge_alpha_it).first.first <= get_alpha();
-	   ++edge_alpha_it) 
+      std::size_t begin = end;
+      while (end < nb_faces &&
+	     (r == _alpha_spectrum.size() ||
+	      _interval_face_map[end].first < _alpha_spectrum[r]))
 	{
-	  pInterval = &(*edge_alpha_it).first;
-      
-	  CGAL_triangulation_assertion(pInterval->second != Infinity);
-	  // since this happens only for convex hull of dimension 2
-	  // thus singular
-
-	  if(pInterval->second <= get_alpha() &&
-	     (pInterval->third > get_alpha()
-	      || pInterval->third == Infinity)) 
-	    {
-	      // alpha must be larger than the mid boundary
-	      // and alpha is smaller than the upper boundary
-	      // which might be infinity 
-	      // visualize the boundary
- CGAL_triangulation_assertion((classify((*edge_alpha_it).second.first,
-					(*edge_alpha_it).second.second)
-			       == REGULAR));
-	      Alpha_shape_edges_list.push_back(Edge((*edge_alpha_it).second.first,
-						    (*edge_alpha_it).second.second));
-	    }
+	  parent[end] = int(end);
+	  ++end;
+	  ++nb_solid_components;
 	}
-    }
-  else 
-    {  // get_mode() == GENERAL -------------------------------------------
-      // draw the edges
-      for (edge_alpha_it = _interval_edge_map.begin(); 
-	   edge_alpha_it != _interval_edge_map.end() &&
-	     (*edge_alpha_it).first.first <= get_alpha();
-	   ++edge_alpha_it) 
+      for (std::size_t i = begin; i < end; ++i)
 	{
-	  pInterval = &(*edge_alpha_it).first;
-      
-	  if (pInterval->first == UNDEFINED) 
+	  Face_handle f = _interval_face_map[i].second;
+	  for (int j = 0; j < 3; ++j)
 	    {
-	      CGAL_triangulation_assertion(pInterval->second != Infinity);
-	      // since this happens only for convex hull of dimension 2
-	      // thus singular
-	
-	      if(pInterval->second <= get_alpha() &&
-		 (pInterval->third > get_alpha()
-		  || pInterval->third == Infinity)) 
+	      if (is_infinite(f->neighbor(j)))
+		continue;
+	      int k = position[f->neighbor(j)];
+	      if (std::size_t(k) >= end)
+		continue;
+	      int a = int(i);
+	      while (parent[a] != a)
+		a = parent[a] = parent[parent[a]];
+	      while (parent[k] != k)
+		k = parent[k] = parent[parent[k]];
+	      if (a != k)
 		{
-		  // alpha must be larger than the mid boundary
-		  // and alpha is smaller than the upper boundary
-		  // which might be infinity 
-		  // visualize the boundary
- CGAL_triangulation_assertion((classify((*edge_alpha_it).second.first,
-					(*edge_alpha_it).second.second) 
-			       == REGULAR));
-		  Alpha_shape_edges_list.push_back(Edge((*edge_alpha_it).second.first,
-							(*edge_alpha_it).second.second));
+		  parent[a] = k;
+		  --nb_solid_components;
 		}
 	    }
-	  else 
-	    {
-	
-	      if(pInterval->third > get_alpha()
-		 || pInterval->third == Infinity) 
-		{
-		  // if alpha is smaller than the upper boundary
-		  // which might be infinity 
-		  // visualize the boundary
- CGAL_triangulation_assertion(((classify((*edge_alpha_it).second.first,
-					 (*edge_alpha_it).second.second) 
-				== REGULAR)
-			       || (classify((*edge_alpha_it).second.first,
-					    (*edge_alpha_it).second.second) 
-				   == SINGULAR)));
-		  Alpha_shape_edges_list.push_back(Edge((*edge_alpha_it).second.first,
-							(*edge_alpha_it).second.second));
-		}
-	    }
-      
 	}
-    
+      _solid_components[r] = nb_solid_components;
+    }
+
+  use_filtration_cache = true;
+}
+
+//-------------------------------------------------------------------------
+
+template < class Dt, class EACT >
+template < class Interval_map, class OutputIterator >
+OutputIterator
+Alpha_shape_2<Dt,EACT>::write_boundary(const Interval_tree& singular,
+				       const Interval_tree& regular,
+				       const Interval_map& map,
+				       const Type_of_alpha& alpha,
+				       OutputIterator out) const
+{
+  if (!use_filtration_cache)
+    initialize_filtration();
+
+  int r = int(alpha_rank(alpha));
+  std::vector<int> ids;
+  regular.stab(r, std::back_inserter(ids));
+  if (get_mode() == GENERAL)
+    singular.stab(r, std::back_inserter(ids));
+
+  for (std::size_t i = 0; i < ids.size(); ++i)
+    *out++ = map[ids[i]].second;
+  return out;
+}
+
+//-------------------------------------------------------------------------
+
+template < class Dt, class EACT >
+template < class Interval_map, class OutputIterator1, class OutputIterator2 >
+std::pair<OutputIterator1, OutputIterator2>
+Alpha_shape_2<Dt,EACT>::write_change(const Interval_tree& singular,
+				     const Interval_tree& regular,
+				     const std::vector<int>& events,
+				     const Interval_map& map,
+				     const Type_of_alpha& from,
+				     const Type_of_alpha& to,
+				     OutputIterator1 added,
+				     OutputIterator2 removed) const
+{
+  if (!use_filtration_cache)
+    initialize_filtration();
+
+  // only the simplices with an event between the two ranks can change,
+  // and only the events that start or end the boundary interval of the
+  // mode count; a simplex with both of them there is in neither alpha
+  // shape
+  int skipped = (get_mode() == GENERAL) ? 1 : 0;
+  std::ptrdiff_t r = alpha_rank(from);
+  std::ptrdiff_t r2 = alpha_rank(to);
+  Less_event less(&singular, &regular);
+  std::vector<int>::const_iterator 
+    event_it = std::upper_bound(events.begin(), events.end(),
+				(CGAL::min)(r, r2), less);
+  for (; event_it != events.end() && 
+	 less.rank(*event_it) <= (CGAL::max)(r, r2);
+       ++event_it)
+    {
+      if (*event_it % 3 == skipped)
+	continue;
+      int e = *event_it / 3;
+      int lo = (get_mode() == GENERAL) ? singular.lo(e) : regular.lo(e);
+      int hi = regular.hi(e);
+      bool before = (lo <= r && r < hi);
+      bool after = (lo <= r2 && r2 < hi);
+      if (before == after)
+	continue;
+      if (after)
+	*added++ = map[e].second;
+      else
+	*removed++ = map[e].second;
     }
+  return std::make_pair(added, removed);
+}
+
+
+//-------------------------------------------------------------------------
+
+
+
+template < class Dt, class EACT >
+void
+Alpha_shape_2<Dt,EACT>::update_alpha_shape_vertex_list()const {
+  // writes the regular vertices, then the singular ones in GENERAL mode
+  Alpha_shape_vertices_list.clear();
+  alpha_shape_vertices(get_alpha(),
+		       std::back_inserter(Alpha_shape_vertices_list));
+  use_vertex_cache = true;
+}
+
+//-------------------------------------------------------------------------
+
+template < class Dt, class EACT >
+void
+Alpha_shape_2<Dt,EACT>::update_alpha_shape_edges_list() const 
+{
+  // writes the regular edges, then the singular ones in GENERAL mode
+  Alpha_shape_edges_list.clear();
+  alpha_shape_edges(get_alpha(),
+		    std::back_inserter(Alpha_shape_edges_list));
   use_edge_cache = true;
 }
 
@@ -1304,65 +1556,17 @@ template < class Dt, class EACT >
 typename Alpha_shape_2<Dt,EACT>::size_type
 Alpha_shape_2<Dt,EACT>::number_of_solid_components(const Type_of_alpha& alpha) const
 {
-  // Determine the number of connected solid components 
-  typedef typename Marked_face_set::Data Data;
-  Marked_face_set marked_face_set(false);
-  Finite_faces_iterator face_it;
-  size_type nb_solid_components = 0;
-  
+  // Determine the number of connected solid components, counted for
+  // every alpha-value of the spectrum by initialize_filtration()
   if (number_of_vertices()==0)
     return 0;
-  
-  // only finite faces
-  for( face_it = faces_begin(); 
-       face_it != faces_end(); 
-       ++face_it) 
-    {
-      Face_handle pFace = face_it;
-      CGAL_triangulation_postcondition( pFace != NULL);
-      
-      if (classify(pFace, alpha) == INTERIOR){
-	Data& data = marked_face_set[pFace];
-	if(data == false)
-	  {
-	    // we traverse only interior faces
-	    traverse(pFace, marked_face_set, alpha);
-	    nb_solid_components++;  
-	  }
-      }
-    }
-  return nb_solid_components;
-}
 
-//-------------------------------------------------------------------------
+  if (!use_filtration_cache)
+    initialize_filtration();
 
-template < class Dt, class EACT >
-void
-Alpha_shape_2<Dt,EACT>::traverse(const Face_handle& pFace,
-			    Marked_face_set& marked_face_set, 
-			    const Type_of_alpha alpha) const 
-{
-  typedef typename Marked_face_set::Data Data;
-  std::list<Face_handle> faces;
-  faces.push_back(pFace);
-  Face_handle pNeighbor, fh;
-
-  while(! faces.empty()){
-    fh = faces.front();
-    faces.pop_front();
-    for (int i=0; i<3; i++)
-      {
-	pNeighbor = fh->neighbor(i);
-	 CGAL_triangulation_assertion(pNeighbor != NULL);
-	if (classify(pNeighbor, alpha) == INTERIOR){
-	  Data& data = marked_face_set[pNeighbor];
-	  if(data == false){
-	    data = true;
-	    faces.push_back(pNeighbor);
-	  }
-	}
-      }
-  }
+  std::ptrdiff_t r = (CGAL::min)(alpha_rank(alpha),
+				 std::ptrdiff_t(_solid_components.size()) - 1);
+  return _solid_components[r];
 }
 
 //-------------------------------------------------------------------------
@@ -35,6 +35,11 @@
 #include <CGAL/Apollonius_graph_2/basic.h>
 
 #include <CGAL/Triangulation_2.h>
+#include <CGAL/hilbert_sort.h>
+#include <CGAL/Multiscale_sort.h>
+#include <CGAL/Spatial_sort_traits_adapter_2.h>
+#include <boost/random/random_number_generator.hpp>
+#include <boost/random/linear_congruential.hpp>
 #include <CGAL/Triangulation_data_structure_2.h>
 #include <CGAL/Triangulation_face_base_2.h>
 #include <CGAL/Apollonius_graph_vertex_base_2.h>
@@ -266,6 +271,44 @@ protected:
     }
   };
 
+  // Copies the sites of the range to wp_list in the order of the range
+  // insertion: rounds of decreasing weight, each in Hilbert order. The
+  // sites are sorted by decreasing weight, as a site can only be hidden by
+  // a larger one, and cut into rounds of increasing sizes as spatial_sort
+  // does (ties in weight in random order); each round is then sorted along
+  // a Hilbert curve of the centers, so that the nearest neighbor searches
+  // are short
+  template< class Input_iterator >
+  void spatially_sorted_sites(Input_iterator first, Input_iterator beyond,
+			      Site_list& wp_list) const {
+    Site_list sites(first, beyond);
+    if ( sites.empty() ) { return; }
+    boost::rand48 random;
+    boost::random_number_generator<boost::rand48> rng(random);
+    std::random_shuffle(sites.begin(), sites.end(), rng);
+    Site_less_than_comparator less_than(geom_traits());
+    std::stable_sort(sites.begin(), sites.end(), less_than);
+
+    std::vector<Point_2> centers;
+    std::vector<std::ptrdiff_t> indices(sites.size());
+    centers.reserve(sites.size());
+    for (std::size_t i = 0; i < sites.size(); ++i) {
+      centers.push_back(sites[i].point());
+      indices[i] = i;
+    }
+    typedef Spatial_sort_traits_adapter_2<typename Gt::R,Point_2*>
+      Search_traits;
+    typedef Hilbert_sort_2<Search_traits, Hilbert_sort_median_policy> Sort;
+    Search_traits traits(&centers[0]);
+    Multiscale_sort<Sort> sort(Sort(traits, 4), 16, 0.25);
+    sort(indices.begin(), indices.end());
+
+    wp_list.reserve(sites.size());
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+      wp_list.push_back(sites[indices[i]]);
+    }
+  }
+
 public:
   // CREATION
   //---------
@@ -480,20 +523,17 @@ public:
   //----------
   template< class Input_iterator >
   size_type insert(Input_iterator first, Input_iterator beyond) {
-    // copy to a local container
+    // copy to a local container, in spatial order
     Site_list wp_list;
-    for (Input_iterator it = first; it != beyond; ++it) {
-      wp_list.push_back(*it);
-    }
-
-    // sort by decreasing weight
-    Site_less_than_comparator less_than(geom_traits());
-    std::sort(wp_list.begin(), wp_list.end(), less_than);
+    spatially_sorted_sites(first, beyond, wp_list);
 
-    // now insert
+    // now insert, each site from the last vertex inserted (a hidden site
+    // has no vertex and leaves the hint unchanged)
+    Vertex_handle vnear;
     Site_list_iterator lit;
     for (lit = wp_list.begin(); lit != wp_list.end(); ++lit) {
-      insert(*lit);
+      Vertex_handle v = insert(*lit, vnear);
+      if ( v != Vertex_handle() ) { vnear = v; }
     }
 
     // store how many sites where in the range
@@ -132,17 +132,11 @@ public:
   template < class Input_iterator >
   size_type insert(Input_iterator first, Input_iterator beyond)
   {
-    // copy the sites to a local container
+    // copy the sites to a local container, by rounds of decreasing weight
+    // each in spatial order: the nearest neighbor searches go down the
+    // hierarchy without a hint, but along nearby vertices
     typename Apollonius_graph_base::Site_list wp_list;
-    //    Site_list wp_list;
-    for (Input_iterator it = first; it != beyond; ++it) {
-      wp_list.push_back(*it);
-    }
-
-    // sort by decreasing weight
-    typename Apollonius_graph_base::Site_less_than_comparator
-      less_than(this->geom_traits());
-    std::sort(wp_list.begin(), wp_list.end(), less_than);
+    this->spatially_sorted_sites(first, beyond, wp_list);
 
     // now insert
     typename Apollonius_graph_base::Site_list_iterator lit;
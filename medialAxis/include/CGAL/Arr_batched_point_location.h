@@ -24,35 +24,47 @@
 
 #include <CGAL/Arrangement_on_surface_2.h>
 #include <CGAL/Basic_sweep_line_2.h>
+#include <CGAL/Arr_point_location_result.h>
+#include <CGAL/tags.h>
 
 #include <vector>
+#include <algorithm>
 #include <boost/mpl/if.hpp>
 #include <boost/type_traits.hpp>
 
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/parallel_sort.h>
+#  include <tbb/blocked_range.h>
+#  include <tbb/task_scheduler_init.h>
+#endif
+
+// The smallest number of query points handed to one x-slab by the parallel
+// batched point location.
+#ifndef CGAL_ARR_BATCHED_PL_MIN_SLAB_SIZE
+#  define CGAL_ARR_BATCHED_PL_MIN_SLAB_SIZE 4096
+#endif
+
 namespace CGAL {
 
+namespace internal {
+
 /*!
- * Issue a batched point-location query on an arrangement given an input
- * range of points.
- * \param arr The arrangement.
- * \param points_begin An iterator for the range of query points.
- * \param points_end A past-the-end iterator for the range of query points.
- * \param oi Output: An output iterator for the query results.
- * \pre The value-type of PointsIterator is Arrangement::Point_2,
- *      and the value-type of OutputIterator is is pair<Point_2, Result>, 
- *      where Result is either
- *       (i) Object or
- *      (ii) boost::optional<boost::variant<Vertex_const_handle,
- *                                          Halfedge_const_handle,
- *                                          Face_const_handle> >.
- *      It represents the arrangement feature containing the point.
+ * Issue a batched point-location query by a sweep over the arrangement.
+ * If x_min and x_max are given, only the edges and isolated vertices whose
+ * x-range meets [x(*x_min), x(*x_max)] are swept. This gives the same
+ * result for query points in that range, as long as the top face does not
+ * depend on the features to the left of the range, that is, when all sides
+ * of the arrangement are oblivious.
  */
 template<typename GeomTraits, typename TopTraits,
          typename PointsIterator, typename OutputIterator> 
 OutputIterator
-locate(const Arrangement_on_surface_2<GeomTraits, TopTraits>& arr,
-       PointsIterator points_begin, PointsIterator points_end,
-       OutputIterator oi)
+batched_locate(const Arrangement_on_surface_2<GeomTraits, TopTraits>& arr,
+               PointsIterator points_begin, PointsIterator points_end,
+               OutputIterator oi,
+               const typename GeomTraits::Point_2* x_min = NULL,
+               const typename GeomTraits::Point_2* x_max = NULL)
 {
   // Arrangement types:
   typedef Arrangement_on_surface_2<GeomTraits, TopTraits>  Arr;
@@ -70,35 +82,53 @@ locate(const Arrangement_on_surface_2<GeomTraits, TopTraits>& arr,
   typedef typename Bpl_traits_2::X_monotone_curve_2    Bpl_x_monotone_curve_2;
   typedef typename Bpl_traits_2::Point_2               Bpl_point_2;
 
+  // Obtain a extended traits-class object.
+  GeomTraits* geom_traits = const_cast<GeomTraits*>(arr.geometry_traits());
+
+  typename GeomTraits::Compare_x_2  compare_x =
+    geom_traits->compare_x_2_object();
+  typename GeomTraits::Construct_min_vertex_2  min_vertex =
+    geom_traits->construct_min_vertex_2_object();
+  typename GeomTraits::Construct_max_vertex_2  max_vertex =
+    geom_traits->construct_max_vertex_2_object();
+  const bool  is_slab = (x_min != NULL);
+
   // Go over all arrangement edges and collect their associated x-monotone
   // curves. To each curve we attach a halfedge handle going from right to
   // left.
-  std::vector<Bpl_x_monotone_curve_2>  xcurves_vec(arr.number_of_edges());
+  std::vector<Bpl_x_monotone_curve_2>  xcurves_vec;
   Edge_const_iterator                  eit;
-  unsigned int                         i = 0;
+  xcurves_vec.reserve(arr.number_of_edges());
   for (eit = arr.edges_begin(); eit != arr.edges_end(); ++eit) {
+    if (is_slab &&
+        (compare_x(max_vertex(eit->curve()), *x_min) == SMALLER ||
+         compare_x(min_vertex(eit->curve()), *x_max) == LARGER))
+      continue;
+
     // Associate each x-monotone curve with the halfedge that represent it
     // that is directed from right to left.
     Halfedge_const_handle he =
       (eit->direction() == ARR_RIGHT_TO_LEFT) ? eit : eit->twin();
-    xcurves_vec[i++] = Bpl_x_monotone_curve_2(eit->curve(), he);
+    xcurves_vec.push_back(Bpl_x_monotone_curve_2(eit->curve(), he));
   }
 
   // Go over all isolated vertices and collect their points. To each point
   // we attach its vertex handle.
-  std::vector<Bpl_point_2>    iso_pts_vec(arr.number_of_isolated_vertices());
+  std::vector<Bpl_point_2>    iso_pts_vec;
   Vertex_const_iterator       vit;
-  i = 0;
+  iso_pts_vec.reserve(arr.number_of_isolated_vertices());
   for (vit = arr.vertices_begin(); vit != arr.vertices_end(); ++vit) {
     if (vit->is_isolated()) {
+      if (is_slab &&
+          (compare_x(vit->point(), *x_min) == SMALLER ||
+           compare_x(vit->point(), *x_max) == LARGER))
+        continue;
+
       Vertex_const_handle iso_v = vit;
-      iso_pts_vec[i++] = Bpl_point_2(vit->point(), iso_v);
+      iso_pts_vec.push_back(Bpl_point_2(vit->point(), iso_v));
     }
   }
     
-  // Obtain a extended traits-class object.
-  GeomTraits* geom_traits = const_cast<GeomTraits*>(arr.geometry_traits());
-
   /* We would like to avoid copy construction of the geometry traits class.
    * Copy construction is undesired, because it may results with data
    * duplication or even data loss.
@@ -128,6 +158,193 @@ locate(const Arrangement_on_surface_2<GeomTraits, TopTraits>& arr,
   return oi;
 }
 
+/*! \class
+ * Sorts points in xy-lexicographic order.
+ */
+template <typename GeomTraits>
+class Less_xy_point
+{
+  typename GeomTraits::Compare_xy_2  m_compare_xy;
+
+public:
+  Less_xy_point(const GeomTraits& traits) :
+    m_compare_xy(traits.compare_xy_2_object())
+  {}
+
+  bool operator()(const typename GeomTraits::Point_2& p1,
+                  const typename GeomTraits::Point_2& p2) const
+  { return (m_compare_xy(p1, p2) == SMALLER); }
+};
+
+// Arrangements with boundary conditions: the top face of a sweep depends
+// on everything to its left, so the queries are located by a single sweep.
+template<typename GeomTraits, typename TopTraits,
+         typename PointsIterator, typename OutputIterator> 
+OutputIterator
+parallel_batched_locate(const Arrangement_on_surface_2<GeomTraits,
+                                                       TopTraits>& arr,
+                        PointsIterator points_begin, PointsIterator points_end,
+                        OutputIterator oi, Arr_not_all_sides_oblivious_tag)
+{
+  return batched_locate(arr, points_begin, points_end, oi);
+}
+
+#ifdef CGAL_LINKED_WITH_TBB
+/*! \class
+ * Locates the query points of a range of x-slabs, each by its own sweep.
+ */
+template <typename Arr, typename Result_pair>
+class Locate_in_slabs
+{
+  typedef typename Arr::Point_2                         Point_2;
+
+  const Arr&                                    m_arr;
+  const std::vector<Point_2>&                   m_points;
+  const std::vector<std::size_t>&               m_slabs;
+  std::vector<std::vector<Result_pair> >&       m_results;
+
+public:
+  Locate_in_slabs(const Arr& arr, const std::vector<Point_2>& points,
+                  const std::vector<std::size_t>& slabs,
+                  std::vector<std::vector<Result_pair> >& results) :
+    m_arr(arr),
+    m_points(points),
+    m_slabs(slabs),
+    m_results(results)
+  {}
+
+  void operator()(const tbb::blocked_range<std::size_t>& r) const
+  {
+    for (std::size_t s = r.begin(); s != r.end(); ++s) {
+      const std::size_t  first = m_slabs[s];
+      const std::size_t  last = m_slabs[s + 1];
+
+      batched_locate(m_arr, m_points.begin() + first,
+                     m_points.begin() + last,
+                     std::back_inserter(m_results[s]),
+                     &m_points[first], &m_points[last - 1]);
+    }
+  }
+};
+#endif
+
+// Arrangements without boundary conditions: the sorted queries are split
+// into x-slabs, which are located by independent sweeps over the edges that
+// cross them.
+template<typename GeomTraits, typename TopTraits,
+         typename PointsIterator, typename OutputIterator> 
+OutputIterator
+parallel_batched_locate(const Arrangement_on_surface_2<GeomTraits,
+                                                       TopTraits>& arr,
+                        PointsIterator points_begin, PointsIterator points_end,
+                        OutputIterator oi, Arr_all_sides_oblivious_tag)
+{
+  typedef Arrangement_on_surface_2<GeomTraits, TopTraits>  Arr;
+  typedef typename Arr::Point_2                            Point_2;
+
+  // The sweep inserts the query points into its event queue much faster
+  // when they arrive sorted, so sort them even if there is a single slab.
+  const GeomTraits&     traits = *(arr.geometry_traits());
+  std::vector<Point_2>  points(points_begin, points_end);
+#ifndef CGAL_LINKED_WITH_TBB
+  std::sort(points.begin(), points.end(), Less_xy_point<GeomTraits>(traits));
+  return batched_locate(arr, points.begin(), points.end(), oi);
+#else
+  typedef typename Arr_point_location_result<Arr>::Type   Result_type;
+  typedef std::pair<Point_2, Result_type>                  Result_pair;
+
+  tbb::parallel_sort(points.begin(), points.end(),
+                     Less_xy_point<GeomTraits>(traits));
+  const std::size_t     n_slabs =
+    (std::min)(points.size() / CGAL_ARR_BATCHED_PL_MIN_SLAB_SIZE,
+               static_cast<std::size_t>(
+                 4 * tbb::task_scheduler_init::default_num_threads()));
+  if (n_slabs < 2)
+    return batched_locate(arr, points.begin(), points.end(), oi);
+
+  // Cut the sorted points into slabs of about the same size. Equal points
+  // stay in the same slab, as the sweep reports them only once.
+  typename GeomTraits::Equal_2  equal = traits.equal_2_object();
+  std::vector<std::size_t>      slabs(1, 0);
+  for (std::size_t s = 1; s < n_slabs; ++s) {
+    std::size_t  cut = points.size() * s / n_slabs;
+    while (cut < points.size() && equal(points[cut - 1], points[cut]))
+      ++cut;
+    if (cut > slabs.back() && cut < points.size())
+      slabs.push_back(cut);
+  }
+  slabs.push_back(points.size());
+
+  std::vector<std::vector<Result_pair> >  results(slabs.size() - 1);
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, results.size(), 1),
+                    Locate_in_slabs<Arr, Result_pair>(arr, points, slabs,
+                                                      results));
+
+  // The slabs follow each other in xy-order, like the events of one sweep.
+  for (std::size_t s = 0; s < results.size(); ++s)
+    oi = std::copy(results[s].begin(), results[s].end(), oi);
+  return oi;
+#endif
+}
+
+} // namespace internal
+
+/*!
+ * Issue a batched point-location query on an arrangement given an input
+ * range of points.
+ * \param arr The arrangement.
+ * \param points_begin An iterator for the range of query points.
+ * \param points_end A past-the-end iterator for the range of query points.
+ * \param oi Output: An output iterator for the query results.
+ * \pre The value-type of PointsIterator is Arrangement::Point_2,
+ *      and the value-type of OutputIterator is is pair<Point_2, Result>, 
+ *      where Result is either
+ *       (i) Object or
+ *      (ii) boost::optional<boost::variant<Vertex_const_handle,
+ *                                          Halfedge_const_handle,
+ *                                          Face_const_handle> >.
+ *      It represents the arrangement feature containing the point.
+ */
+template<typename GeomTraits, typename TopTraits,
+         typename PointsIterator, typename OutputIterator> 
+OutputIterator
+locate(const Arrangement_on_surface_2<GeomTraits, TopTraits>& arr,
+       PointsIterator points_begin, PointsIterator points_end,
+       OutputIterator oi)
+{
+  return internal::batched_locate(arr, points_begin, points_end, oi);
+}
+
+/*!
+ * Issue a batched point-location query on an arrangement given an input
+ * range of points, splitting the work between threads.
+ * If TBB is linked and all sides of the arrangement are oblivious (as for
+ * arrangements of bounded curves in the plane), the sorted query points
+ * are cut into x-slabs, and each slab is located by its own sweep over the
+ * edges whose x-range meets it. Otherwise a single sweep is performed
+ * (on the sorted points, if all sides are oblivious).
+ * The results are the same, and in the same order, as those of the
+ * sequential locate(). The arrangement and its traits are only read, so
+ * their kernel objects must allow concurrent reading (a lazy exact kernel
+ * does not).
+ * \pre The value-type of PointsIterator is Arrangement::Point_2,
+ *      and the value-type of OutputIterator is is pair<Point_2, Result>
+ *      (see above).
+ */
+template<typename GeomTraits, typename TopTraits,
+         typename PointsIterator, typename OutputIterator> 
+OutputIterator
+locate(const Arrangement_on_surface_2<GeomTraits, TopTraits>& arr,
+       PointsIterator points_begin, PointsIterator points_end,
+       OutputIterator oi, Parallel_tag)
+{
+  typedef Arrangement_on_surface_2<GeomTraits, TopTraits>  Arr;
+
+  return internal::parallel_batched_locate(
+    arr, points_begin, points_end, oi,
+    typename Arr::Are_all_sides_oblivious_category());
+}
+
 } //namespace CGAL
 
 #endif
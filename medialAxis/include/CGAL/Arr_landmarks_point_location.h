@@ -31,8 +31,15 @@
 #include <CGAL/Arr_point_location_result.h>
 #include <CGAL/Arrangement_2/Arr_traits_adaptor_2.h>
 #include <CGAL/Arr_point_location/Arr_lm_vertices_generator.h>
+#include <CGAL/tags.h>
 
 #include <set>
+#include <vector>
+
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
 
 namespace CGAL {
 
@@ -187,7 +194,50 @@ public:
    */
   result_type locate(const Point_2& p) const;
 
+  /*!
+   * Locate a range of query points, each by a walk from its nearest
+   * landmark. If TBB is linked, the points are located concurrently; the
+   * generator is only queried for the nearest landmark, which its nearest-
+   * neighbor search structure supports. As for the parallel batched
+   * locate(), the kernel objects must allow concurrent reading (a lazy exact
+   * kernel does not).
+   * \param begin An iterator for the range of query points.
+   * \param end A past-the-end iterator for the range of query points.
+   * \param oi Output: The pairs of each query point and its location, in
+   *           the order of the input range.
+   * \pre The value-type of OutputIterator is pair<Point_2, result_type>.
+   */
+  template <typename InputIterator, typename OutputIterator>
+  OutputIterator locate(InputIterator begin, InputIterator end,
+                        OutputIterator oi, Parallel_tag) const;
+
 protected:
+#ifdef CGAL_LINKED_WITH_TBB
+  /*! \class
+   * Locates a range of query points by their own walks.
+   */
+  class Locate_range {
+    const Arr_landmarks_point_location&  m_pl;
+    const std::vector<Point_2>&          m_points;
+    std::vector<result_type>&            m_results;
+
+  public:
+    Locate_range(const Arr_landmarks_point_location& pl,
+                 const std::vector<Point_2>& points,
+                 std::vector<result_type>& results) :
+      m_pl(pl),
+      m_points(points),
+      m_results(results)
+    {}
+
+    void operator()(const tbb::blocked_range<std::size_t>& r) const
+    {
+      for (std::size_t i = r.begin(); i != r.end(); ++i)
+        m_results[i] = m_pl.locate(m_points[i]);
+    }
+  };
+#endif
+
   /*! Walk from the given vertex to the query point.
    * \param vh The given vertex handle.
    * \param p The query point.
@@ -91,6 +91,33 @@ Arr_landmarks_point_location<Arr, Gen>::locate(const Point_2& p) const
   return out_obj;
 }
 
+//-----------------------------------------------------------------------------
+// Locate a range of query points.
+//
+template <typename Arr, typename Gen>
+template <typename InputIterator, typename OutputIterator>
+OutputIterator
+Arr_landmarks_point_location<Arr, Gen>::locate(InputIterator begin,
+                                               InputIterator end,
+                                               OutputIterator oi,
+                                               Parallel_tag) const
+{
+#ifdef CGAL_LINKED_WITH_TBB
+  // Locate the points into a vector of results, in parallel.
+  std::vector<Point_2>      points(begin, end);
+  std::vector<result_type>  results(points.size());
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, points.size(), 256),
+                    Locate_range(*this, points, results));
+
+  for (std::size_t i = 0; i < points.size(); ++i)
+    *oi++ = std::make_pair(points[i], results[i]);
+#else
+  for (; begin != end; ++begin)
+    *oi++ = std::make_pair(*begin, locate(*begin));
+#endif
+  return oi;
+}
+
 //-----------------------------------------------------------------------------
 // Walk from a given vertex to the query point.
 //
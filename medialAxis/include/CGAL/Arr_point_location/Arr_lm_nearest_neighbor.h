@@ -28,6 +28,7 @@
 #include <CGAL/basic.h>
 #include <CGAL/Search_traits.h>
 #include <CGAL/Orthogonal_k_neighbor_search.h>
+#include <CGAL/tags.h>
 #include <CGAL/Arr_point_location_result.h>
 #include <CGAL/Arrangement_2/Arr_traits_adaptor_2.h>
 
@@ -166,6 +167,9 @@ public:
 
   /*!
    * Allocate the search tree and initialize it with landmark points.
+   * If TBB is linked, the tree is built right away, in parallel, so that
+   * it can then be queried concurrently; otherwise it is built by the
+   * first query.
    * \param begin An iterator for the first landmark point.
    * \param end A past-the-end iterator for the landmark points.
    * \pre The search tree is not initialized.
@@ -179,6 +183,9 @@ public:
     if (begin != end) {
       m_tree = new Tree(begin, end);
       m_is_empty = false;
+#ifdef CGAL_LINKED_WITH_TBB
+      m_tree->build(Parallel_tag());
+#endif
     }
     else {
       m_tree = new Tree();
@@ -862,6 +862,32 @@ inline OutputIterator join(InputIterator begin, InputIterator end,
   return join(begin, end, oi, tr, k);
 }
 
+// Join a range of polygons, uniting clusters of polygons with overlapping
+// bounding boxes in parallel (see Gps_on_surface_base_2::join()). The
+// output has the same polygons as the sequential join, but they may come
+// out in another order and their boundaries may start at other vertices.
+template <typename InputIterator, typename OutputIterator, class Traits>
+inline OutputIterator join(InputIterator begin, InputIterator end,
+                           OutputIterator oi, Traits&, Parallel_tag tag,
+                           unsigned int k=5)
+{
+  if (begin == end)
+    return (oi);
+
+  General_polygon_set_2<Traits> gps(*begin);
+  gps.join(++begin, end, tag, k);
+  return (gps.polygons_with_holes(oi));
+}
+
+template <typename InputIterator, typename OutputIterator>
+inline OutputIterator join(InputIterator begin, InputIterator end,
+                           OutputIterator oi, Parallel_tag tag,
+                           unsigned int k=5)
+{
+  typename map_iterator_to_traits<InputIterator>::Traits          tr;
+  return join(begin, end, oi, tr, tag, k);
+}
+
 // Join two ranges of simple polygons and polygons with holes.
 template <typename InputIterator1, typename InputIterator2,
           typename OutputIterator, class Traits>
@@ -40,6 +40,14 @@
 #include <CGAL/Boolean_set_operations_2/Gps_merge.h>
 #include <CGAL/Boolean_set_operations_2/Gps_polygon_simplifier.h>
 #include <CGAL/Boolean_set_operations_2/Ccb_curve_iterator.h>
+#include <CGAL/box_intersection_d.h>
+#include <CGAL/Box_intersection_d/Box_with_handle_d.h>
+#include <CGAL/tags.h>
+
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
 
 /*!
   \file   Gps_on_surface_base_2.h
@@ -702,6 +710,67 @@ public:
     this->_reset_faces();
   }
 
+  // join a range of polygons (simple or with holes) in parallel.
+  // The polygons and the current set are grouped into clusters whose
+  // bounding boxes overlap, using box_self_intersection_d. Each cluster is
+  // joined by the D&C algorithm above, the clusters concurrently if TBB is
+  // linked, and the disjoint results are merged by a D&C whose independent
+  // sub-ranges are swept concurrently as well.
+  // The result is the same set, with the same polygons and vertices, as
+  // the one of join(begin, end, k), but the arrangement is built in another
+  // order: the polygons may come out in another order, and a boundary may
+  // start at another vertex.
+  // The x-monotone curves of the traits must provide bbox().
+  template <typename InputIterator>
+  void join(InputIterator begin, InputIterator end, Parallel_tag,
+            unsigned int k = 5)
+  {
+    std::vector<InputIterator> pgns;
+    for (InputIterator itr = begin; itr != end; ++itr)
+      pgns.push_back(itr);
+
+    std::vector<Arr_entry> arr_vec (pgns.size() + 1);
+    arr_vec[0].first = this->m_arr;
+    for (std::size_t i = 1; i < arr_vec.size(); ++i)
+      arr_vec[i].first = new Aos_2(m_traits);
+
+#ifdef CGAL_LINKED_WITH_TBB
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, pgns.size(), 64),
+                      Insert_polygons<InputIterator>(*this, pgns, arr_vec));
+#else
+    for (std::size_t i = 0; i < pgns.size(); ++i)
+      _insert(*pgns[i], *(arr_vec[i + 1].first));
+#endif
+
+    std::vector<std::vector<Arr_entry> > clusters;
+    _build_clusters(arr_vec, clusters);
+
+#ifdef CGAL_LINKED_WITH_TBB
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, clusters.size(), 1),
+                      Join_clusters(*this, clusters, k));
+#else
+    for (std::size_t c = 0; c < clusters.size(); ++c)
+      _join_cluster(clusters[c], k);
+#endif
+
+    std::vector<Arr_entry> res_vec (clusters.size());
+    for (std::size_t c = 0; c < clusters.size(); ++c)
+      res_vec[c] = clusters[c][0];
+
+    Join_merge<Aos_2> join_merge;
+#ifdef CGAL_LINKED_WITH_TBB
+    _parallel_divide_and_conquer(0, static_cast<unsigned int>(res_vec.size()-1), res_vec, k, join_merge);
+#else
+    _divide_and_conquer(0, static_cast<unsigned int>(res_vec.size()-1), res_vec, k, join_merge);
+#endif
+
+    //the result arrangement is at index 0
+    this->m_arr = res_vec[0].first;
+    delete res_vec[0].second;
+    this->remove_redundant_edges();
+    this->_reset_faces();
+  }
+
 
   // intersect range of polygins (see previous comment about k=5).
   template <typename InputIterator>
@@ -1051,6 +1120,219 @@ protected:
     
     return;
   }
+
+  typedef Box_intersection_d::Box_with_handle_d<double, 2, Arr_entry*>
+                                                       Entry_box;
+
+  // find the representative of a cluster (with path halving)
+  static std::size_t _find_cluster (std::vector<std::size_t>& parent,
+                                    std::size_t i)
+  {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return (i);
+  }
+
+  // unite the clusters of two entries whose boxes intersect
+  class Unite_clusters
+  {
+    Arr_entry                   *m_first;
+    std::vector<std::size_t>    *m_parent;
+
+  public:
+
+    Unite_clusters (Arr_entry *first, std::vector<std::size_t> *parent) :
+      m_first (first),
+      m_parent (parent)
+    {}
+
+    void operator() (const Entry_box& b1, const Entry_box& b2) const
+    {
+      std::size_t  r1 = _find_cluster (*m_parent, b1.handle() - m_first);
+      std::size_t  r2 = _find_cluster (*m_parent, b2.handle() - m_first);
+
+      // keep the smallest index as the representative
+      if (r1 < r2)
+        (*m_parent)[r2] = r1;
+      else if (r2 < r1)
+        (*m_parent)[r1] = r2;
+    }
+  };
+
+  // group the entries into clusters of overlapping bounding boxes. The
+  // entries of a cluster, as well as the clusters, keep their order in
+  // arr_vec, so a single cluster is joined exactly as by the sequential
+  // join. An arrangement whose reference face is contained overlaps all
+  // the others.
+  void _build_clusters (std::vector<Arr_entry>& arr_vec,
+                        std::vector<std::vector<Arr_entry> >& clusters)
+  {
+    const std::size_t          n = arr_vec.size();
+    std::vector<std::size_t>   parent (n);
+    std::vector<Entry_box>     boxes;
+    bool                       is_unbounded = false;
+    std::size_t                i;
+
+    boxes.reserve (n);
+    for (i = 0; i < n; i++)
+    {
+      parent[i] = i;
+
+      Aos_2  *p_arr = arr_vec[i].first;
+      if (p_arr->reference_face()->contained())
+        is_unbounded = true;
+      if (p_arr->number_of_edges() == 0)
+        continue;
+
+      Edge_iterator  eit = p_arr->edges_begin();
+      Bbox_2         bbox = eit->curve().bbox();
+      for (++eit; eit != p_arr->edges_end(); ++eit)
+        bbox = bbox + eit->curve().bbox();
+      boxes.push_back (Entry_box (bbox, &arr_vec[i]));
+    }
+
+    if (is_unbounded)
+    {
+      for (i = 0; i < n; i++)
+        parent[i] = 0;
+    }
+    else
+    {
+      box_self_intersection_d (boxes.begin(), boxes.end(),
+                               Unite_clusters (&arr_vec[0], &parent));
+    }
+
+    std::vector<std::size_t>  cluster_of (n, n);
+    for (i = 0; i < n; i++)
+    {
+      const std::size_t  r = _find_cluster (parent, i);
+      if (cluster_of[r] == n)
+      {
+        cluster_of[r] = clusters.size();
+        clusters.push_back (std::vector<Arr_entry>());
+      }
+      clusters[cluster_of[r]].push_back (arr_vec[i]);
+    }
+  }
+
+  // join the arrangements of one cluster into its first entry
+  void _join_cluster (std::vector<Arr_entry>& cluster, unsigned int k)
+  {
+    Join_merge<Aos_2> join_merge;
+    _build_sorted_vertices_vectors (cluster);
+    _divide_and_conquer(0, static_cast<unsigned int>(cluster.size()-1), cluster, k, join_merge);
+  }
+
+#ifdef CGAL_LINKED_WITH_TBB
+  // the D&C above, with the k sub-ranges of each level merged concurrently
+  template <class Merge>
+  void _parallel_divide_and_conquer (unsigned int lower, unsigned int upper,
+                                     std::vector<Arr_entry>& arr_vec,
+                                     unsigned int k, Merge merge_func)
+  {
+    if ((upper - lower) < k)
+    {
+      merge_func(lower, upper, 1, arr_vec);
+      return;
+    }
+
+    unsigned int sub_size = ((upper - lower + 1) / k);
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, k, 1),
+                      Divide_and_conquer_range<Merge>(*this, lower, upper,
+                                                      sub_size, arr_vec, k,
+                                                      merge_func));
+    merge_func (lower, lower + (k-1)*sub_size, sub_size, arr_vec);
+  }
+
+  // the i-th sub-range of a level of _parallel_divide_and_conquer()
+  template <class Merge>
+  class Divide_and_conquer_range
+  {
+    Self&                     m_gps;
+    unsigned int              m_lower;
+    unsigned int              m_upper;
+    unsigned int              m_sub_size;
+    std::vector<Arr_entry>&   m_arr_vec;
+    unsigned int              m_k;
+    Merge                     m_merge_func;
+
+  public:
+
+    Divide_and_conquer_range (Self& gps, unsigned int lower,
+                              unsigned int upper, unsigned int sub_size,
+                              std::vector<Arr_entry>& arr_vec,
+                              unsigned int k, Merge merge_func) :
+      m_gps (gps),
+      m_lower (lower),
+      m_upper (upper),
+      m_sub_size (sub_size),
+      m_arr_vec (arr_vec),
+      m_k (k),
+      m_merge_func (merge_func)
+    {}
+
+    void operator() (const tbb::blocked_range<unsigned int>& r) const
+    {
+      for (unsigned int i = r.begin(); i != r.end(); ++i)
+      {
+        unsigned int curr_lower = m_lower + i * m_sub_size;
+        unsigned int curr_upper = (i == m_k - 1) ? m_upper :
+                                  curr_lower + m_sub_size - 1;
+        m_gps._parallel_divide_and_conquer (curr_lower, curr_upper,
+                                            m_arr_vec, m_k, m_merge_func);
+      }
+    }
+  };
+
+  // insert the i-th polygon of the range into the (i+1)-th arrangement
+  template <typename InputIterator>
+  class Insert_polygons
+  {
+    Self&                              m_gps;
+    const std::vector<InputIterator>&  m_pgns;
+    std::vector<Arr_entry>&            m_arr_vec;
+
+  public:
+
+    Insert_polygons (Self& gps, const std::vector<InputIterator>& pgns,
+                     std::vector<Arr_entry>& arr_vec) :
+      m_gps (gps),
+      m_pgns (pgns),
+      m_arr_vec (arr_vec)
+    {}
+
+    void operator() (const tbb::blocked_range<std::size_t>& r) const
+    {
+      for (std::size_t i = r.begin(); i != r.end(); ++i)
+        m_gps._insert (*m_pgns[i], *(m_arr_vec[i + 1].first));
+    }
+  };
+
+  class Join_clusters
+  {
+    Self&                                   m_gps;
+    std::vector<std::vector<Arr_entry> >&   m_clusters;
+    unsigned int                            m_k;
+
+  public:
+
+    Join_clusters (Self& gps, std::vector<std::vector<Arr_entry> >& clusters,
+                   unsigned int k) :
+      m_gps (gps),
+      m_clusters (clusters),
+      m_k (k)
+    {}
+
+    void operator() (const tbb::blocked_range<std::size_t>& r) const
+    {
+      for (std::size_t c = r.begin(); c != r.end(); ++c)
+        m_gps._join_cluster (m_clusters[c], m_k);
+    }
+  };
+#endif
   
   // mark all faces as non-visited
   void _reset_faces() const
@@ -350,6 +350,7 @@ public:
     std::swap(last_item, c.last_item);
     std::swap(free_list, c.free_list);
     all_items.swap(c.all_items);
+    allocations.swap(c.allocations);
     std::swap(time_stamper, c.time_stamper);
   }
 
@@ -601,6 +602,12 @@ public:
 
   void clear();
 
+  // Destroys all elements but keeps the blocks, which go back to the free
+  // list in iterator order, so that refilling the container does not go
+  // through the allocator again. Like erase(), it increments the erase
+  // counters of the destroyed elements.
+  void reset();
+
   // Merge the content of d into *this.  d gets cleared.
   // The complexity is O(size(free list = capacity-size)).
   void merge(Self &d);
@@ -673,35 +680,50 @@ public:
 
   /** Reserve method to ensure that the capacity of the Compact_container be
    * greater or equal than a given value n.
+   * The missing capacity is obtained with a single allocation, which is then
+   * cut into the blocks that the increment policy would have allocated one by
+   * one, so that operator[] and is_used() are unaffected.
    */
   void reserve(size_type n)
   {
+    typedef internal::Erase_counter_strategy<
+      internal::has_increment_erase_counter<T>::value> EraseCounterStrategy;
+
     if ( capacity_>=n ) return;
 
     size_type lastblock = all_items.size();
+    std::vector<size_type> sizes;
+    size_type total = 0;
+    for (size_type c = capacity_; c < n; c += sizes.back())
+    {
+      sizes.push_back(block_size);
+      total += block_size + 2;
+      // Increase the block_size for the next time.
+      Increment_policy::increase_size(*this);
+    }
 
-    while ( capacity_<n )
-    { // Pb because the order of free list is no more the order of
-      // allocate_new_block();
-      pointer new_block = alloc.allocate(block_size + 2);
-      all_items.push_back(std::make_pair(new_block, block_size + 2));
-      capacity_ += block_size;
+    pointer new_items = alloc.allocate(total);
+    allocations.push_back(std::make_pair(new_items, total));
+    for (std::size_t b = 0; b < sizes.size(); ++b)
+    {
+      pointer new_block = new_items;
+      new_items += sizes[b] + 2;
+      all_items.push_back(std::make_pair(new_block, sizes[b] + 2));
+      capacity_ += sizes[b];
       // We insert this new block at the end.
       if (last_item == NULL) // First time
       {
         first_item = new_block;
-        last_item  = new_block + block_size + 1;
+        last_item  = new_block + sizes[b] + 1;
         set_type(first_item, NULL, START_END);
       }
       else
       {
         set_type(last_item, new_block, BLOCK_BOUNDARY);
         set_type(new_block, last_item, BLOCK_BOUNDARY);
-        last_item = new_block + block_size + 1;
+        last_item = new_block + sizes[b] + 1;
       }
       set_type(last_item, NULL, START_END);
-      // Increase the block_size for the next time.
-      Increment_policy::increase_size(*this);
     }
 
     // Now we put all the new elements on freelist, starting from the last block
@@ -714,7 +736,10 @@ public:
       --curblock; // We are sure we have at least create a new block
       pointer new_block = all_items[curblock].first;
       for (size_type i = all_items[curblock].second-2; i >= 1; --i)
+      {
+        EraseCounterStrategy::set_erase_counter(*(new_block + i), 0);
         put_on_free_list(new_block + i);
+      }
     }
     while ( curblock>lastblock );
   }
@@ -781,6 +806,8 @@ private:
   // by walking through the block till its end.
   // This opens up the possibility for the compiler to optimize the clear()
   // function considerably when has_trivial_destructor<T>.
+  // The blocks are not always allocated one by one (see reserve()), so the
+  // allocations are kept separately for deallocate().
   typedef std::vector<std::pair<pointer, size_type> >  All_items;
 
   void init()
@@ -792,6 +819,7 @@ private:
     first_item = NULL;
     last_item  = NULL;
     all_items  = All_items();
+    allocations = All_items();
     time_stamper->reset();
   }
 
@@ -803,6 +831,7 @@ private:
   pointer          first_item;
   pointer          last_item;
   All_items        all_items;
+  All_items        allocations;
 
   // This is a pointer, so that the definition of Compact_container does
   // not require a complete type `T`.
@@ -836,6 +865,7 @@ void Compact_container<T, Allocator, Increment_policy, TimeStamper>::merge(Self
     last_item = d.last_item;
   }
   all_items.insert(all_items.end(), d.all_items.begin(), d.all_items.end());
+  allocations.insert(allocations.end(), d.allocations.begin(), d.allocations.end());
   // Add the sizes.
   size_ += d.size_;
   // Add the capacities.
@@ -857,11 +887,38 @@ void Compact_container<T, Allocator, Increment_policy, TimeStamper>::clear()
       if (type(pp) == USED)
         alloc.destroy(pp);
     }
-    alloc.deallocate(p, s);
   }
+  for (typename All_items::iterator it = allocations.begin(), itend = allocations.end();
+       it != itend; ++it)
+    alloc.deallocate(it->first, it->second);
   init();
 }
 
+template < class T, class Allocator, class Increment_policy, class TimeStamper >
+void Compact_container<T, Allocator, Increment_policy, TimeStamper>::reset()
+{
+  typedef internal::Erase_counter_strategy<
+    internal::has_increment_erase_counter<T>::value> EraseCounterStrategy;
+
+  // Blocks and elements are walked backwards, so that the insertion order
+  // will correspond to the iterator order...
+  free_list = NULL;
+  for (typename All_items::reverse_iterator it = all_items.rbegin(), itend = all_items.rend();
+       it != itend; ++it) {
+    pointer p = it->first;
+    size_type s = it->second;
+    for (pointer pp = p + s - 2; pp != p; --pp) {
+      if (type(pp) == USED) {
+        EraseCounterStrategy::increment_erase_counter(*pp);
+        alloc.destroy(pp);
+      }
+      put_on_free_list(pp);
+    }
+  }
+  size_ = 0;
+  time_stamper->reset();
+}
+
 template < class T, class Allocator, class Increment_policy, class TimeStamper >
 void Compact_container<T, Allocator, Increment_policy, TimeStamper>::allocate_new_block()
 {
@@ -870,6 +927,7 @@ void Compact_container<T, Allocator, Increment_policy, TimeStamper>::allocate_ne
 
   pointer new_block = alloc.allocate(block_size + 2);
   all_items.push_back(std::make_pair(new_block, block_size + 2));
+  allocations.push_back(all_items.back());
   capacity_ += block_size;
   // We don't touch the first and the last one.
   // We mark them free in reverse order, so that the insertion order
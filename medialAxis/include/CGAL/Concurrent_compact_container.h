@@ -433,6 +433,10 @@ public:
 
   void clear();
 
+  // Same interface as Compact_container::reset(). The free lists are
+  // per thread here, so the blocks are not kept: this is clear().
+  void reset() { clear(); }
+
   // Merge the content of d into *this.  d gets cleared.
   // The complexity is O(size(free list = capacity-size)).
   void merge(Self &d);
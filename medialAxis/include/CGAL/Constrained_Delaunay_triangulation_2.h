@@ -24,16 +24,17 @@
 #include <CGAL/triangulation_assertions.h>
 #include <CGAL/Constrained_triangulation_2.h>
 
+#include <boost/iterator/counting_iterator.hpp>
+
 #ifndef CGAL_TRIANGULATION_2_DONT_INSERT_RANGE_OF_POINTS_WITH_INFO
 #include <CGAL/Spatial_sort_traits_adapter_2.h>
 #include <CGAL/internal/info_check.h>
+#include <CGAL/internal/Constraint_endpoints_2.h>
 #include <CGAL/is_iterator.h>
 
 #include <boost/iterator/zip_iterator.hpp>
 #include <boost/mpl/and.hpp>
 
-#include <boost/iterator/counting_iterator.hpp>
-
 namespace CGAL {
 
 namespace internal{
@@ -55,6 +56,71 @@ struct Get_iterator_value_type<T,true>{
 
 namespace CGAL {
 
+namespace internal {
+
+// Inserts points in tr along a Hilbert curve, each insertion starting
+// from the face of the previous vertex, then the constraints [first,
+// beyond) (pairs of indices in points) in the order of their first
+// endpoint on that curve: a constraint starts close to the previous one
+// and the faces it crosses are likely still in cache. Shared by
+// Constrained_Delaunay_triangulation_2 and Constrained_triangulation_plus_2,
+// which insert points and constraints their own way.
+template <class Tr, class IndicesIterator>
+std::size_t
+insert_constraints_in_spatial_order(Tr& tr,
+                                    const std::vector<typename Tr::Point>& points,
+                                    IndicesIterator first,
+                                    IndicesIterator beyond)
+{
+  typedef typename Tr::Point          Point;
+  typedef typename Tr::Vertex_handle  Vertex_handle;
+  typedef typename Tr::Face_handle    Face_handle;
+  typedef std::pair<std::size_t, std::size_t>  Rank_and_index;
+
+  std::size_t n = tr.number_of_vertices();
+  if (points.empty()) return 0;
+
+  std::vector<std::ptrdiff_t> vertex_indices;
+  vertex_indices.reserve(points.size());
+  std::copy(boost::counting_iterator<std::ptrdiff_t>(0),
+            boost::counting_iterator<std::ptrdiff_t>(points.size()),
+            std::back_inserter(vertex_indices));
+  Spatial_sort_traits_adapter_2<typename Tr::Geom_traits, const Point*>
+    sort_traits(&(points[0]), tr.geom_traits());
+  spatial_sort(vertex_indices.begin(), vertex_indices.end(), sort_traits);
+
+  std::vector<Vertex_handle> vertices(points.size());
+  std::vector<std::size_t> rank(points.size());
+  Face_handle hint;
+  for (std::size_t i = 0; i < vertex_indices.size(); ++i) {
+    std::ptrdiff_t k = vertex_indices[i];
+    vertices[k] = tr.insert(points[k], hint);
+    hint = vertices[k]->face();
+    rank[k] = i;
+  }
+
+  std::vector< std::pair<std::size_t, std::size_t> > constraints;
+  std::vector<Rank_and_index> order;
+  for (IndicesIterator it = first; it != beyond; ++it) {
+    std::size_t a = it->first, b = it->second;
+    order.push_back(Rank_and_index((std::min)(rank[a], rank[b]),
+                                   constraints.size()));
+    constraints.push_back(std::make_pair(a, b));
+  }
+  std::sort(order.begin(), order.end());
+
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    const std::pair<std::size_t, std::size_t>& c = constraints[order[i].second];
+    Vertex_handle v1 = vertices[c.first];
+    Vertex_handle v2 = vertices[c.second];
+    if (v1 != v2) tr.insert_constraint(v1, v2);
+  }
+
+  return tr.number_of_vertices() - n;
+}
+
+} // namespace internal
+
 
 template <class Gt, 
           class Tds = Triangulation_data_structure_2 <
@@ -191,6 +257,12 @@ public:
 //   std::ptrdiff_t insert(InputIterator first, InputIterator last);
 
   void remove(Vertex_handle v);
+  // Removes the vertices of [first, beyond), none of them having incident
+  // constraints, and returns how many were removed. As for
+  // Delaunay_triangulation_2, a large fraction is removed by triangulating
+  // the remaining vertices (and constraints) again.
+  template < class InputIterator >
+  size_type remove(InputIterator first, InputIterator beyond);
   void remove_incident_constraints(Vertex_handle v);
   void remove_constrained_edge(Face_handle f, int i);
 //  template <class OutputItFaces>
@@ -335,47 +407,18 @@ public:
 #endif //CGAL_TRIANGULATION_2_DONT_INSERT_RANGE_OF_POINTS_WITH_INFO
 
 
+  // Inserts the points, then the constraints between them given as pairs
+  // of indices in points, both in spatial order (see
+  // internal::insert_constraints_in_spatial_order()). Returns the number
+  // of vertices created.
   template <class IndicesIterator>
   std::size_t insert_constraints( const std::vector<Point>& points,
                                   IndicesIterator indices_first,
                                   IndicesIterator indices_beyond )
   {
-    typedef std::vector<std::ptrdiff_t> Vertex_indices;
-    typedef std::vector<Vertex_handle> Vertices;
-
-    Vertex_indices vertex_indices;
-    vertex_indices.resize(points.size());
-
-    std::copy(boost::counting_iterator<std::ptrdiff_t>(0),
-              boost::counting_iterator<std::ptrdiff_t>(points.size()),
-              std::back_inserter(vertex_indices));
-
-    size_type n = this->number_of_vertices();
-    Spatial_sort_traits_adapter_2<Gt, const Point*> sort_traits(&(points[0]));
-
-    spatial_sort(vertex_indices.begin(), vertex_indices.end(), sort_traits);
-
-    Vertices vertices;
-    vertices.resize(points.size());
-
-    Face_handle hint;
-    for(typename Vertex_indices::const_iterator
-          it_pti = vertex_indices.begin(), end = vertex_indices.end();
-          it_pti != end; ++it_pti)
-    {
-      vertices[*it_pti] = insert(points[*it_pti], hint);
-      hint=vertices[*it_pti]->face();
-    }
-
-    for(IndicesIterator it_cst=indices_first, end=indices_beyond;
-        it_cst!=end; ++it_cst)
-    {
-      Vertex_handle v1 = vertices[it_cst->first];
-      Vertex_handle v2 = vertices[it_cst->second];
-      if(v1 != v2) insert_constraint(v1, v2);
-    }
-
-    return this->number_of_vertices() - n;
+    return internal::insert_constraints_in_spatial_order(*this, points,
+                                                         indices_first,
+                                                         indices_beyond);
   }
 
   template <class PointIterator, class IndicesIterator>
@@ -388,22 +431,6 @@ public:
     return insert_constraints(points, indices_first, indices_beyond);
   }
 
-  template <class Segment_2>
-  static const Point& get_source(const Segment_2& segment){
-    return segment.source();
-  }
-  template <class Segment_2>
-  static const Point& get_target(const Segment_2& segment){
-    return segment.target();
-  }
-
-  static const Point& get_source(const Constraint& cst){
-    return cst.first;
-  }
-  static const Point& get_target(const Constraint& cst){
-    return cst.second;
-  }
-
   template <class ConstraintIterator>
   std::size_t insert_constraints(ConstraintIterator first,
                                  ConstraintIterator beyond)
@@ -411,8 +438,8 @@ public:
     std::vector<Point> points;
     for (ConstraintIterator s_it=first; s_it!=beyond; ++s_it)
     {
-      points.push_back( get_source(*s_it) );
-      points.push_back( get_target(*s_it) );
+      points.push_back( internal::constraint_source<Point>(*s_it) );
+      points.push_back( internal::constraint_target<Point>(*s_it) );
     }
 
     std::vector< std::pair<std::size_t, std::size_t> > segment_indices;
@@ -935,6 +962,79 @@ remove(Vertex_handle v)
   return;
 }
 
+namespace internal {
+// orders the pairs of a lookup table by their first element only
+struct Less_first_of_pair {
+  template <class Pair>
+  bool operator()(const Pair& a, const Pair& b) const
+  { return a.first < b.first; }
+};
+
+// copy_face of Triangulation_2::take_faces_of() for constrained faces
+struct Copy_constraints {
+  template < class F, class G >
+  void operator()(const F& f, const G& g) const
+  {
+    for (int i = 0; i < 3; ++i)
+      g->set_constraint(i, f->is_constrained(i));
+  }
+};
+}
+
+template < class Gt, class Tds, class Itag >
+template < class InputIterator >
+typename Constrained_Delaunay_triangulation_2<Gt,Tds,Itag>::size_type
+Constrained_Delaunay_triangulation_2<Gt,Tds,Itag>::
+remove(InputIterator first, InputIterator beyond)
+{
+  size_type n = number_of_vertices();
+  std::vector<Vertex_handle> vertices;
+  this->sorted_vertices(first, beyond, vertices);
+  for (std::size_t i = 0; i < vertices.size(); ++i) {
+    CGAL_triangulation_precondition( ! is_infinite(vertices[i]));
+    CGAL_triangulation_precondition(
+      ! are_there_incident_constraints(vertices[i]));
+  }
+
+  if (dimension() == 2 &&
+      vertices.size() > CGAL_T2_BULK_REMOVE_REBUILD_FRACTION * n) {
+    typedef std::pair<Vertex_handle, std::size_t> Vertex_index;
+    std::vector<Vertex_handle> kept;
+    this->kept_vertices(vertices, kept);
+    std::vector<Vertex_index> index;
+    index.reserve(kept.size());
+    for (std::size_t i = 0; i < kept.size(); ++i)
+      index.push_back(Vertex_index(kept[i], i));
+    internal::Less_first_of_pair less;
+    std::sort(index.begin(), index.end(), less);
+
+    CDt tr(geom_traits());
+    std::vector<Vertex_handle> tr_vertices;
+    if (this->insert_points_of(kept, tr, tr_vertices)) {
+      // the constraints only join kept vertices
+      for (typename Ctr::Finite_edges_iterator e = this->finite_edges_begin();
+           e != this->finite_edges_end(); ++e) {
+        if (! this->is_constrained(*e)) continue;
+        Face_handle f = e->first;
+        int i = e->second;
+        std::size_t a = std::lower_bound(index.begin(), index.end(),
+                          Vertex_index(f->vertex(cw(i)), 0), less)->second;
+        std::size_t b = std::lower_bound(index.begin(), index.end(),
+                          Vertex_index(f->vertex(ccw(i)), 0), less)->second;
+        tr.insert_constraint(tr_vertices[a], tr_vertices[b]);
+      }
+      this->take_faces_of(tr, tr_vertices, kept, vertices,
+                          internal::Copy_constraints());
+      return n - number_of_vertices();
+    }
+  }
+
+  this->spatial_sort_vertices(vertices);
+  for (std::size_t i = 0; i < vertices.size(); ++i)
+    remove(vertices[i]);
+  return n - number_of_vertices();
+}
+
 // template < class Gt, class Tds, class Itag >  
 // typename
 // Constrained_Delaunay_triangulation_2<Gt,Tds,Itag>::Vertex_handle
@@ -232,6 +232,9 @@ private:
     CGAL_error_msg("Do not use that function!");
     return v;
   }
+  //made private as the Triangulation_2 versions lose the constraints
+  void binary_output(std::ostream& os) const;
+  bool binary_input(std::istream& is, bool check = false);
 
 public:
 // made public for Laurent  to find out deleted faces
@@ -24,6 +24,7 @@
 #include <CGAL/triangulation_assertions.h>
 #include <CGAL/Constraint_hierarchy_2.h>
 #include <CGAL/Constrained_Delaunay_triangulation_2.h>
+#include <CGAL/internal/Constraint_endpoints_2.h>
 
 #if defined(BOOST_MSVC)
 #  pragma warning(push)
@@ -157,6 +158,7 @@ public:
 
     //Helping
   void clear() { Base::clear(); hierarchy.clear();}
+  void reset() { Base::reset(); hierarchy.clear();}
   void copy_triangulation(const Constrained_triangulation_plus_2 &ctp);
   void swap(Constrained_triangulation_plus_2 &ctp);
 
@@ -259,6 +261,50 @@ public:
     return number_of_vertices() - n;
   }
 
+  // Same as Constrained_Delaunay_triangulation_2::insert_constraints(),
+  // the constraints going to the hierarchy.
+  template <class IndicesIterator>
+  std::size_t insert_constraints(const std::vector<Point>& points,
+                                 IndicesIterator indices_first,
+                                 IndicesIterator indices_beyond)
+  {
+    return internal::insert_constraints_in_spatial_order(*this, points,
+                                                         indices_first,
+                                                         indices_beyond);
+  }
+
+  template <class PointIterator, class IndicesIterator>
+  std::size_t insert_constraints(PointIterator points_first,
+                                 PointIterator points_beyond,
+                                 IndicesIterator indices_first,
+                                 IndicesIterator indices_beyond)
+  {
+    std::vector<Point> points(points_first, points_beyond);
+    return insert_constraints(points, indices_first, indices_beyond);
+  }
+
+  template <class ConstraintIterator>
+  std::size_t insert_constraints(ConstraintIterator first,
+                                 ConstraintIterator beyond)
+  {
+    std::vector<Point> points;
+    for (ConstraintIterator s_it=first; s_it!=beyond; ++s_it)
+    {
+      points.push_back( internal::constraint_source<Point>(*s_it) );
+      points.push_back( internal::constraint_target<Point>(*s_it) );
+    }
+
+    std::vector< std::pair<std::size_t, std::size_t> > segment_indices;
+    std::size_t nb_segments = points.size() / 2;
+    segment_indices.reserve( nb_segments );
+    for (std::size_t k=0; k < nb_segments; ++k)
+      segment_indices.push_back( std::make_pair(2*k,2*k+1) );
+
+    return insert_constraints( points,
+                               segment_indices.begin(),
+                               segment_indices.end() );
+  }
+
    template <class OutputItFaces>  
      OutputItFaces  
      remove_constraint(Vertex_handle va,   
@@ -222,6 +222,20 @@ public:
     faces_level.refine(visitor);
   }
 
+  /** With \c Parallel_tag (when linked with TBB) the zones of conflicts
+      of batches of bad faces are computed concurrently, see
+      Mesh_2::Refine_faces::refine_in_parallel(). */
+  void refine_mesh(Sequential_tag)
+  {
+    refine_mesh();
+  }
+
+  void refine_mesh(Parallel_tag)
+  {
+    if(initialized != true) init();
+    faces_level.refine_in_parallel(visitor);
+  }
+
   /** \name REMESHING FUNCTIONS */
 
   void set_criteria(const Criteria& criteria_,
@@ -355,6 +369,19 @@ refine_Delaunay_mesh_2(Tr& t,
 }
 
 
+template <typename Tr, typename Criteria, typename Concurrency_tag>
+void
+refine_Delaunay_mesh_2(Tr& t,
+                       const Criteria& criteria, bool domain_specified,
+                       Concurrency_tag tag)
+{
+  typedef Delaunay_mesher_2<Tr, Criteria> Mesher;
+
+  Mesher mesher(t, criteria);
+  mesher.init(domain_specified);
+  mesher.refine_mesh(tag);
+}
+
 template <typename Tr, typename Criteria, typename InputIterator>
 void
 refine_Delaunay_mesh_2(Tr& t,
@@ -145,6 +145,35 @@ public:
 
   void  remove(Vertex_handle v );
 
+  // Removes the vertices of [first, beyond) and returns how many were
+  // removed. Past CGAL_T2_BULK_REMOVE_REBUILD_FRACTION of the vertices the
+  // remaining ones are triangulated again and take the new faces (their
+  // handles stay valid), otherwise the vertices are removed one by one in
+  // Hilbert order.
+  template < class InputIterator >
+  size_type remove(InputIterator first, InputIterator beyond)
+  {
+    size_type n = this->number_of_vertices();
+    std::vector<Vertex_handle> vertices;
+    this->sorted_vertices(first, beyond, vertices);
+    if (this->dimension() == 2 &&
+        vertices.size() > CGAL_T2_BULK_REMOVE_REBUILD_FRACTION * n) {
+      std::vector<Vertex_handle> kept;
+      this->kept_vertices(vertices, kept);
+      Delaunay_triangulation_2<Gt,Tds> tr(geom_traits());
+      std::vector<Vertex_handle> tr_vertices;
+      if (this->insert_points_of(kept, tr, tr_vertices)) {
+        this->take_faces_of(tr, tr_vertices, kept, vertices,
+                            typename Triangulation::Copy_nothing());
+        return n - this->number_of_vertices();
+      }
+    }
+    this->spatial_sort_vertices(vertices);
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+      remove(vertices[i]);
+    return n - this->number_of_vertices();
+  }
+
   // DISPLACEMENT
   void restore_Delaunay(Vertex_handle v);
 
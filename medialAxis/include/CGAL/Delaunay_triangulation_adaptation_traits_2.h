@@ -26,6 +26,7 @@
 #include <CGAL/Voronoi_diagram_2/Adaptation_traits_base_2.h>
 #include <CGAL/Voronoi_diagram_2/Site_accessors.h>
 #include <CGAL/Voronoi_diagram_2/Construct_dual_points.h>
+#include <CGAL/Voronoi_diagram_2/Construct_flat_edges.h>
 #include <CGAL/Voronoi_diagram_2/Adaptation_traits_functors.h>
 
 
@@ -42,6 +43,9 @@ struct Delaunay_triangulation_adaptation_traits_2
 {
   typedef typename DT2::Geom_traits::Point_2      Point_2;
   typedef Point_2                                 Site_2;
+
+  typedef CGAL_VORONOI_DIAGRAM_2_INS::Delaunay_triangulation_flat_edge_2<DT2>
+  Flat_edge_2;
 };
 
 
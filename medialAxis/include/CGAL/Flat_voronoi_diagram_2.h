@@ -0,0 +1,78 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+// A Voronoi diagram clipped to a box, as filled by
+// Voronoi_diagram_2::materialize(): a half-edge structure whose vertices,
+// half-edges and faces are indices into arrays, with the coordinates as
+// doubles. It holds no handle and does not depend on the Delaunay graph it
+// was computed from, so it can be kept, copied or handed to a renderer
+// after the graph changes.
+//
+// Vertex v is at (points[2v], points[2v+1]). The half-edges come in pairs:
+// the twin of h is h ^ 1, and its target is the source of its twin. The
+// face on the left of h is halfedge_face[h], or -1 out of the box; its
+// boundary is followed with halfedge_next, counterclockwise inside the
+// box and clockwise around it. Face f is the cell of the f-th finite
+// vertex of the Delaunay graph (in the order of finite_vertices_begin());
+// face_halfedge[f] is one of its half-edges, or -1 when the cell does not
+// meet the box or is degenerate.
+//
+// The half-edges of the Voronoi edges come first, then the half-edges
+// along the box, whose twins are out of the box. An edge that leaves the
+// box ends on a vertex of the boundary; the corners of the box are
+// vertices too.
+
+#ifndef CGAL_FLAT_VORONOI_DIAGRAM_2_H
+#define CGAL_FLAT_VORONOI_DIAGRAM_2_H
+
+#include <cstddef>
+#include <vector>
+#include <CGAL/Bbox_2.h>
+
+namespace CGAL {
+
+struct Flat_voronoi_diagram_2
+{
+  Bbox_2               bbox;
+  std::vector<double>  points;
+  std::vector<int>     halfedge_source;
+  std::vector<int>     halfedge_next;
+  std::vector<int>     halfedge_face;
+  std::vector<int>     face_halfedge;
+
+  std::size_t number_of_vertices() const { return points.size() / 2; }
+  std::size_t number_of_halfedges() const { return halfedge_source.size(); }
+  std::size_t number_of_faces() const { return face_halfedge.size(); }
+
+  static int twin(int h) { return h ^ 1; }
+  int source(int h) const { return halfedge_source[h]; }
+  int target(int h) const { return halfedge_source[h ^ 1]; }
+  int next(int h) const { return halfedge_next[h]; }
+  int face(int h) const { return halfedge_face[h]; }
+
+  // true if h lies along the box (one of h and its twin is out of it)
+  bool is_on_boundary(int h) const {
+    return halfedge_face[h] < 0 || halfedge_face[h ^ 1] < 0;
+  }
+
+  void clear()
+  {
+    points.clear();
+    halfedge_source.clear();
+    halfedge_next.clear();
+    halfedge_face.clear();
+    face_halfedge.clear();
+  }
+};
+
+} //namespace CGAL
+
+#endif // CGAL_FLAT_VORONOI_DIAGRAM_2_H
@@ -0,0 +1,155 @@
+// You can redistribute this file and/or modify it under the terms of the
+// GNU Lesser General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+// A stateless allocator asking the system for transparent huge pages when
+// the allocation is large. Allocations of at least
+// CGAL_HUGE_PAGE_THRESHOLD bytes are aligned on a huge page and advised
+// with madvise(MADV_HUGEPAGE), so that walking a large Compact_container
+// (a reserve()d one, for instance) costs fewer TLB misses. Smaller
+// allocations, and all of them where transparent huge pages are not
+// available, go through operator new like std::allocator.
+//
+// It can be given to a container directly:
+//
+//   Compact_container<T, Huge_page_allocator<T> >
+//
+// or made the default allocator of CGAL by defining CGAL_USE_HUGE_PAGES,
+// see <CGAL/memory.h>. The macro must then be defined for the whole
+// program, not for some translation units only.
+
+#ifndef CGAL_HUGE_PAGE_ALLOCATOR_H
+#define CGAL_HUGE_PAGE_ALLOCATOR_H
+
+#include <CGAL/config.h>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+// Size of a transparent huge page on x86-64.
+#ifndef CGAL_HUGE_PAGE_SIZE
+#  define CGAL_HUGE_PAGE_SIZE (std::size_t(2) << 20)
+#endif
+
+#ifndef CGAL_HUGE_PAGE_THRESHOLD
+#  define CGAL_HUGE_PAGE_THRESHOLD CGAL_HUGE_PAGE_SIZE
+#endif
+
+namespace CGAL {
+
+namespace internal {
+
+inline bool use_huge_pages(std::size_t bytes)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  return bytes >= CGAL_HUGE_PAGE_THRESHOLD;
+#else
+  (void) bytes;
+  return false;
+#endif
+}
+
+inline void* allocate_huge_pages(std::size_t bytes)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Rounded up to whole huge pages, the tail would be small pages anyway.
+  bytes = (bytes + CGAL_HUGE_PAGE_SIZE - 1) / CGAL_HUGE_PAGE_SIZE
+          * CGAL_HUGE_PAGE_SIZE;
+  void* p = 0;
+  if (posix_memalign(&p, CGAL_HUGE_PAGE_SIZE, bytes) != 0)
+    throw std::bad_alloc();
+  // Only advice: the kernel falls back to small pages if it has to.
+  madvise(p, bytes, MADV_HUGEPAGE);
+  return p;
+#else
+  return ::operator new(bytes);
+#endif
+}
+
+} // namespace internal
+
+template <class T>
+class Huge_page_allocator
+{
+public:
+  typedef T                 value_type;
+  typedef T*                pointer;
+  typedef const T*          const_pointer;
+  typedef T&                reference;
+  typedef const T&          const_reference;
+  typedef std::size_t       size_type;
+  typedef std::ptrdiff_t    difference_type;
+
+  template <class U>
+  struct rebind { typedef Huge_page_allocator<U> other; };
+
+  Huge_page_allocator() {}
+  template <class U>
+  Huge_page_allocator(const Huge_page_allocator<U>&) {}
+
+  pointer       address(reference x) const       { return &x; }
+  const_pointer address(const_reference x) const { return &x; }
+
+  pointer allocate(size_type n, const void* = 0)
+  {
+    if (n > max_size())
+      throw std::bad_alloc();
+    std::size_t bytes = n * sizeof(T);
+    if (internal::use_huge_pages(bytes))
+      return static_cast<pointer>(internal::allocate_huge_pages(bytes));
+    return static_cast<pointer>(::operator new(bytes));
+  }
+
+  void deallocate(pointer p, size_type n)
+  {
+    if (internal::use_huge_pages(n * sizeof(T)))
+      std::free(p);
+    else
+      ::operator delete(p);
+  }
+
+  size_type max_size() const { return size_type(-1) / sizeof(T); }
+
+  void construct(pointer p, const T& t) { ::new (static_cast<void*>(p)) T(t); }
+  void destroy(pointer p) { p->~T(); }
+};
+
+template <>
+class Huge_page_allocator<void>
+{
+public:
+  typedef void              value_type;
+  typedef void*             pointer;
+  typedef const void*       const_pointer;
+  typedef std::size_t       size_type;
+  typedef std::ptrdiff_t    difference_type;
+
+  template <class U>
+  struct rebind { typedef Huge_page_allocator<U> other; };
+};
+
+template <class T, class U>
+inline bool operator==(const Huge_page_allocator<T>&,
+                       const Huge_page_allocator<U>&)
+{ return true; }
+
+template <class T, class U>
+inline bool operator!=(const Huge_page_allocator<T>&,
+                       const Huge_page_allocator<U>&)
+{ return false; }
+
+} // namespace CGAL
+
+#endif // CGAL_HUGE_PAGE_ALLOCATOR_H
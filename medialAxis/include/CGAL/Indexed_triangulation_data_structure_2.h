@@ -0,0 +1,2091 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+// A triangulation data structure storing vertices and faces as 32 bit
+// indices in separate arrays (points, vertex -> face, face -> vertices,
+// face -> neighbors) instead of Compact_container elements linked by
+// pointers. A vertex costs a point plus 4 bytes and a face 24 bytes, about
+// half of the pointer based Triangulation_data_structure_2 on 64 bit
+// platforms. It is meant as the Tds argument of Triangulation_2 and
+// Delaunay_triangulation_2:
+//
+//   typedef Indexed_triangulation_data_structure_2<K>      Tds;
+//   typedef Delaunay_triangulation_2<K, Tds>                Dt;
+//
+// Handles and iterators are transient: a handle holds a pointer to the
+// storage and an index, and dereferences to a proxy Vertex or Face giving
+// the same interface as Triangulation_vertex_base_2 and
+// Triangulation_ds_face_base_2 (plus info() when an info type is given).
+// A reference obtained through operator* lives as long as the handle it
+// comes from. The arrays grow like std::vector: creating a vertex may move
+// the points, and reserve() before inserting a known number of points
+// avoids the copies and the memory peak of growing.
+// copy_tds() only copies from the same data structure type.
+
+#ifndef CGAL_INDEXED_TRIANGULATION_DATA_STRUCTURE_2_H
+#define CGAL_INDEXED_TRIANGULATION_DATA_STRUCTURE_2_H
+
+#include <CGAL/basic.h>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <CGAL/triangulation_assertions.h>
+#include <CGAL/Triangulation_utils_2.h>
+#include <CGAL/Triangulation_ds_iterators_2.h>
+#include <CGAL/Triangulation_ds_circulators_2.h>
+#include <CGAL/IO/io.h>
+#include <CGAL/internal/Tds_2_binary_io.h>
+
+namespace CGAL {
+
+namespace internal { namespace Indexed_TDS_2 {
+
+typedef boost::uint32_t Index;
+
+// no vertex or face
+const Index NONE = 0xFFFFFFFF;
+// marks a slot on the free list
+const Index FREE = 0xFFFFFFFE;
+
+struct Index_triple { Index i[3]; };
+
+// Numbers of the vertices or of the faces for the binary output, by index
+struct Numbering
+{
+  explicit Numbering(std::size_t size) : numbers(size, NONE) {}
+  template <class Handle>
+  Index& operator[](const Handle& h) { return numbers[h.index()]; }
+  std::vector<Index> numbers;
+};
+
+// Contiguous array growing like std::vector, without initializing the
+// capacity it does not use yet. Trivially copyable elements are grown with
+// realloc(), which can remap large arrays instead of copying them.
+template <class T>
+class Array
+{
+  enum { TRIVIAL = boost::has_trivial_copy<T>::value
+                   && boost::has_trivial_destructor<T>::value };
+
+public:
+  Array() : _data(0), _size(0), _capacity(0) {}
+  Array(const Array& a) : _data(0), _size(0), _capacity(0) { *this = a; }
+  ~Array() { clear(); }
+
+  Array& operator=(const Array& a)
+  {
+    if (this == &a) return *this;
+    clear();
+    reserve(a._size);
+    std::uninitialized_copy(a._data, a._data + a._size, _data);
+    _size = a._size;
+    return *this;
+  }
+
+  T& operator[](std::size_t i) const { return _data[i]; }
+
+  std::size_t size() const { return _size; }
+  std::size_t capacity() const { return _capacity; }
+  std::size_t memory_usage() const { return _capacity * sizeof(T); }
+
+  // appends a default constructed element and returns its index
+  std::size_t push_back()
+  {
+    if (_size == _capacity) reserve((std::max)(std::size_t(64), 2 * _capacity));
+    ::new (static_cast<void*>(_data + _size)) T();
+    return _size++;
+  }
+  void reset(std::size_t i) { _data[i] = T(); }
+
+  void reserve(std::size_t n)
+  {
+    if (n <= _capacity) return;
+    T* data;
+    if (TRIVIAL) {
+      data = static_cast<T*>(std::realloc(_data, n * sizeof(T)));
+      if (data == 0) throw std::bad_alloc();
+    } else {
+      data = static_cast<T*>(::operator new(n * sizeof(T)));
+      std::uninitialized_copy(_data, _data + _size, data);
+      destroy();
+      ::operator delete(_data);
+    }
+    _data = data;
+    _capacity = n;
+  }
+
+  void clear()
+  {
+    destroy();
+    if (TRIVIAL) std::free(_data);
+    else ::operator delete(_data);
+    _data = 0;
+    _size = _capacity = 0;
+  }
+  // destroys the elements, keeps the capacity
+  void clear_elements()
+  {
+    destroy();
+    _size = 0;
+  }
+  void swap(Array& a)
+  {
+    std::swap(_data, a._data);
+    std::swap(_size, a._size);
+    std::swap(_capacity, a._capacity);
+  }
+
+private:
+  void destroy()
+  {
+    if (TRIVIAL) return;
+    for (std::size_t i = 0; i < _size; ++i) _data[i].~T();
+  }
+
+  T* _data;
+  std::size_t _size;
+  std::size_t _capacity;
+};
+
+// no info: nothing stored
+template <>
+class Array<void>
+{
+public:
+  std::size_t memory_usage() const { return 0; }
+  std::size_t push_back() { return 0; }
+  void reset(std::size_t) {}
+  void reserve(std::size_t) {}
+  void clear() {}
+  void clear_elements() {}
+  void swap(Array&) {}
+};
+
+template <class T>
+inline void copy_info(const Array<T>& from, Index i,
+                      Array<T>& to, Index j)
+{ to[j] = from[i]; }
+
+inline void copy_info(const Array<void>&, Index,
+                      Array<void>&, Index)
+{}
+
+template <class Point, class VertexInfo, class FaceInfo>
+struct Storage
+{
+  Array<Point>        points;
+  Array<Index>        vertex_face;
+  Array<VertexInfo>   vertex_info;
+  Array<Index_triple> face_vertices;
+  Array<Index_triple> face_neighbors;
+  Array<FaceInfo>     face_info;
+  std::vector<Index>        free_vertices;
+  // deleted faces are chained through their first neighbor
+  Index                     free_faces;
+  std::size_t               number_of_vertices;
+  std::size_t               number_of_faces;
+
+  Storage() : free_faces(NONE), number_of_vertices(0), number_of_faces(0) {}
+
+  bool is_vertex(Index i) const
+  { return i < points.size() && vertex_face[i] != FREE; }
+  bool is_face(Index i) const
+  { return i < face_vertices.size() && face_vertices[i].i[0] != FREE; }
+
+  Index new_vertex()
+  {
+    Index i;
+    if (free_vertices.empty()) {
+      i = Index(points.push_back());
+      vertex_face.push_back();
+      vertex_info.push_back();
+    } else {
+      i = free_vertices.back();
+      free_vertices.pop_back();
+      points.reset(i);
+      vertex_info.reset(i);
+    }
+    vertex_face[i] = NONE;
+    ++number_of_vertices;
+    return i;
+  }
+
+  void delete_vertex(Index i)
+  {
+    vertex_face[i] = FREE;
+    free_vertices.push_back(i);
+    --number_of_vertices;
+  }
+
+  Index new_face()
+  {
+    Index i;
+    if (free_faces == NONE) {
+      i = Index(face_vertices.push_back());
+      face_neighbors.push_back();
+      face_info.push_back();
+    } else {
+      i = free_faces;
+      free_faces = face_neighbors[i].i[0];
+      face_info.reset(i);
+    }
+    Index_triple& v = face_vertices[i];
+    Index_triple& n = face_neighbors[i];
+    v.i[0] = v.i[1] = v.i[2] = NONE;
+    n.i[0] = n.i[1] = n.i[2] = NONE;
+    ++number_of_faces;
+    return i;
+  }
+
+  void delete_face(Index i)
+  {
+    face_vertices[i].i[0] = FREE;
+    face_neighbors[i].i[0] = free_faces;
+    free_faces = i;
+    --number_of_faces;
+  }
+
+  // iteration skips free slots, NONE is before the first slot and past
+  // the last one
+  Index next_vertex(Index i) const
+  {
+    for (std::size_t j = (i == NONE) ? 0 : std::size_t(i) + 1; j < points.size(); ++j)
+      if (vertex_face[j] != FREE) return Index(j);
+    return NONE;
+  }
+  Index previous_vertex(Index i) const
+  {
+    std::size_t j = (i == NONE) ? points.size() : i;
+    while (j-- > 0)
+      if (vertex_face[j] != FREE) return Index(j);
+    return NONE;
+  }
+  Index next_face(Index i) const
+  {
+    for (std::size_t j = (i == NONE) ? 0 : std::size_t(i) + 1; j < face_vertices.size(); ++j)
+      if (face_vertices[j].i[0] != FREE) return Index(j);
+    return NONE;
+  }
+  Index previous_face(Index i) const
+  {
+    std::size_t j = (i == NONE) ? face_vertices.size() : i;
+    while (j-- > 0)
+      if (face_vertices[j].i[0] != FREE) return Index(j);
+    return NONE;
+  }
+
+  void reserve(std::size_t vertices, std::size_t faces)
+  {
+    points.reserve(vertices);
+    vertex_face.reserve(vertices);
+    vertex_info.reserve(vertices);
+    face_vertices.reserve(faces);
+    face_neighbors.reserve(faces);
+    face_info.reserve(faces);
+  }
+
+  void clear()
+  {
+    points.clear();
+    vertex_face.clear();
+    vertex_info.clear();
+    face_vertices.clear();
+    face_neighbors.clear();
+    face_info.clear();
+    std::vector<Index>().swap(free_vertices);
+    free_faces = NONE;
+    number_of_vertices = number_of_faces = 0;
+  }
+
+  void reset()
+  {
+    points.clear_elements();
+    vertex_face.clear_elements();
+    vertex_info.clear_elements();
+    face_vertices.clear_elements();
+    face_neighbors.clear_elements();
+    face_info.clear_elements();
+    free_vertices.clear();
+    free_faces = NONE;
+    number_of_vertices = number_of_faces = 0;
+  }
+
+  std::size_t memory_usage() const
+  {
+    return sizeof(*this) + points.memory_usage() + vertex_face.memory_usage()
+      + vertex_info.memory_usage() + face_vertices.memory_usage()
+      + face_neighbors.memory_usage() + face_info.memory_usage()
+      + free_vertices.capacity() * sizeof(Index);
+  }
+};
+
+// info() of a vertex or face proxy, absent without an info type
+template <class Proxy, class Info_>
+class Vertex_info_access
+{
+public:
+  typedef Info_ Info;
+  Info& info() const
+  {
+    const Proxy& p = static_cast<const Proxy&>(*this);
+    return p.storage()->vertex_info[p.index()];
+  }
+};
+
+template <class Proxy>
+class Vertex_info_access<Proxy, void> {};
+
+template <class Proxy, class Info_>
+class Face_info_access
+{
+public:
+  typedef Info_ Info;
+  Info& info() const
+  {
+    const Proxy& p = static_cast<const Proxy&>(*this);
+    return p.storage()->face_info[p.index()];
+  }
+};
+
+template <class Proxy>
+class Face_info_access<Proxy, void> {};
+
+// Triangulation_ds_vertex_circulator_2 returns the address of the vertex
+// behind a temporary handle; keep that handle in the circulator instead.
+template <class Tds>
+class Vertex_circulator
+  : public Triangulation_ds_vertex_circulator_2<Tds>
+{
+  typedef Triangulation_ds_vertex_circulator_2<Tds> Base;
+
+public:
+  typedef typename Tds::Vertex         Vertex;
+  typedef typename Tds::Face_handle    Face_handle;
+  typedef typename Tds::Vertex_handle  Vertex_handle;
+
+  Vertex_circulator() {}
+  Vertex_circulator(Vertex_handle v, Face_handle f = Face_handle())
+    : Base(v, f) {}
+
+  Vertex_circulator& operator++() { Base::operator++(); return *this; }
+  Vertex_circulator  operator++(int)
+  { Vertex_circulator tmp(*this); ++(*this); return tmp; }
+  Vertex_circulator& operator--() { Base::operator--(); return *this; }
+  Vertex_circulator  operator--(int)
+  { Vertex_circulator tmp(*this); --(*this); return tmp; }
+
+  Vertex& operator*() const { _current = this->base(); return *_current; }
+  Vertex* operator->() const { _current = this->base(); return &*_current; }
+
+private:
+  mutable Vertex_handle _current;
+};
+
+} } //namespace internal::Indexed_TDS_2
+
+template < class Gt, class VertexInfo = void, class FaceInfo = void >
+class Indexed_triangulation_data_structure_2
+  :public Triangulation_cw_ccw_2
+{
+  typedef Indexed_triangulation_data_structure_2<Gt,VertexInfo,FaceInfo> Tds;
+
+public:
+  typedef Gt                                         Geom_traits;
+  typedef typename Gt::Point_2                       Point;
+  typedef internal::Indexed_TDS_2::Index             Index;
+  typedef internal::Indexed_TDS_2::Storage<Point,VertexInfo,FaceInfo>
+                                                     Storage;
+  typedef std::size_t                                size_type;
+  typedef std::ptrdiff_t                             difference_type;
+
+  class Vertex;
+  class Face;
+  class Vertex_handle;
+  class Face_handle;
+
+  class Face
+    : public internal::Indexed_TDS_2::Face_info_access<Face, FaceInfo>
+  {
+  public:
+    typedef Tds                          Triangulation_data_structure;
+    typedef typename Tds::Vertex_handle  Vertex_handle;
+    typedef typename Tds::Face_handle    Face_handle;
+
+    Face() : _s(0), _i(internal::Indexed_TDS_2::NONE) {}
+    Face(Storage* s, Index i) : _s(s), _i(i) {}
+
+    Vertex_handle vertex(int i) const
+    {
+      CGAL_triangulation_precondition( i == 0 || i == 1 || i == 2);
+      return Vertex_handle(_s, _s->face_vertices[_i].i[i]);
+    }
+    bool has_vertex(Vertex_handle v) const
+    {
+      const Index* V = _s->face_vertices[_i].i;
+      return V[0] == v.index() || V[1] == v.index() || V[2] == v.index();
+    }
+    bool has_vertex(Vertex_handle v, int& i) const
+    {
+      const Index* V = _s->face_vertices[_i].i;
+      for (i = 0; i < 3; ++i)
+	if (V[i] == v.index()) return true;
+      return false;
+    }
+    int index(Vertex_handle v) const
+    {
+      const Index* V = _s->face_vertices[_i].i;
+      if (V[0] == v.index()) return 0;
+      if (V[1] == v.index()) return 1;
+      CGAL_triangulation_assertion( V[2] == v.index() );
+      return 2;
+    }
+
+    Face_handle neighbor(int i) const
+    {
+      CGAL_triangulation_precondition( i == 0 || i == 1 || i == 2);
+      return Face_handle(_s, _s->face_neighbors[_i].i[i]);
+    }
+    bool has_neighbor(Face_handle n) const
+    {
+      const Index* N = _s->face_neighbors[_i].i;
+      return N[0] == n.index() || N[1] == n.index() || N[2] == n.index();
+    }
+    bool has_neighbor(Face_handle n, int& i) const
+    {
+      const Index* N = _s->face_neighbors[_i].i;
+      for (i = 0; i < 3; ++i)
+	if (N[i] == n.index()) return true;
+      return false;
+    }
+    int index(Face_handle n) const
+    {
+      const Index* N = _s->face_neighbors[_i].i;
+      if (N[0] == n.index()) return 0;
+      if (N[1] == n.index()) return 1;
+      CGAL_triangulation_assertion( N[2] == n.index() );
+      return 2;
+    }
+
+    void set_vertex(int i, Vertex_handle v)
+    {
+      CGAL_triangulation_precondition( i == 0 || i == 1 || i == 2);
+      _s->face_vertices[_i].i[i] = v.index();
+    }
+    void set_vertices()
+    {
+      Index* V = _s->face_vertices[_i].i;
+      V[0] = V[1] = V[2] = internal::Indexed_TDS_2::NONE;
+    }
+    void set_vertices(Vertex_handle v0, Vertex_handle v1, Vertex_handle v2)
+    {
+      Index* V = _s->face_vertices[_i].i;
+      V[0] = v0.index();
+      V[1] = v1.index();
+      V[2] = v2.index();
+    }
+    void set_neighbor(int i, Face_handle n)
+    {
+      CGAL_triangulation_precondition( i == 0 || i == 1 || i == 2);
+      CGAL_triangulation_precondition( _i != n.index() );
+      _s->face_neighbors[_i].i[i] = n.index();
+    }
+    void set_neighbors()
+    {
+      Index* N = _s->face_neighbors[_i].i;
+      N[0] = N[1] = N[2] = internal::Indexed_TDS_2::NONE;
+    }
+    void set_neighbors(Face_handle n0, Face_handle n1, Face_handle n2)
+    {
+      Index* N = _s->face_neighbors[_i].i;
+      N[0] = n0.index();
+      N[1] = n1.index();
+      N[2] = n2.index();
+    }
+
+    void reorient()
+    {
+      //exchange the vertices 0 and 1
+      Index* V = _s->face_vertices[_i].i;
+      Index* N = _s->face_neighbors[_i].i;
+      std::swap(V[0], V[1]);
+      std::swap(N[0], N[1]);
+    }
+    void ccw_permute()
+    {
+      Index* V = _s->face_vertices[_i].i;
+      Index* N = _s->face_neighbors[_i].i;
+      Index v = V[2], n = N[2];
+      V[2] = V[1]; V[1] = V[0]; V[0] = v;
+      N[2] = N[1]; N[1] = N[0]; N[0] = n;
+    }
+    void cw_permute()
+    {
+      Index* V = _s->face_vertices[_i].i;
+      Index* N = _s->face_neighbors[_i].i;
+      Index v = V[0], n = N[0];
+      V[0] = V[1]; V[1] = V[2]; V[2] = v;
+      N[0] = N[1]; N[1] = N[2]; N[2] = n;
+    }
+
+    int dimension() const
+    {
+      const Index* V = _s->face_vertices[_i].i;
+      if (V[2] != internal::Indexed_TDS_2::NONE) return 2;
+      return V[1] != internal::Indexed_TDS_2::NONE ? 1 : 0;
+    }
+
+    bool is_valid(bool /* verbose */ = false, int /* level */ = 0) const
+    {return true;}
+
+    Storage* storage() const { return _s; }
+    Index index() const { return _i; }
+
+    static int ccw(int i) {return Triangulation_cw_ccw_2::ccw(i);}
+    static int  cw(int i) {return Triangulation_cw_ccw_2::cw(i);}
+
+  private:
+    friend class Indexed_triangulation_data_structure_2::Face_handle;
+    Storage* _s;
+    Index _i;
+  };
+
+  class Vertex
+    : public internal::Indexed_TDS_2::Vertex_info_access<Vertex, VertexInfo>
+  {
+  public:
+    typedef Tds                          Triangulation_data_structure;
+    typedef Gt                           Geom_traits;
+    typedef typename Gt::Point_2         Point;
+    typedef typename Tds::Vertex_handle  Vertex_handle;
+    typedef typename Tds::Face_handle    Face_handle;
+
+    Vertex() : _s(0), _i(internal::Indexed_TDS_2::NONE) {}
+    Vertex(Storage* s, Index i) : _s(s), _i(i) {}
+
+    Point& point() const { return _s->points[_i]; }
+    void set_point(const Point& p) { _s->points[_i] = p; }
+
+    Face_handle face() const { return Face_handle(_s, _s->vertex_face[_i]); }
+    void set_face(Face_handle f) { _s->vertex_face[_i] = f.index(); }
+
+    bool is_valid(bool /*verbose*/=false, int /*level*/= 0) const
+    {return face() != Face_handle();}
+
+    Storage* storage() const { return _s; }
+    Index index() const { return _i; }
+
+  private:
+    friend class Indexed_triangulation_data_structure_2::Vertex_handle;
+    Storage* _s;
+    Index _i;
+  };
+
+  // A handle is also the iterator over all faces. The proxy it points to
+  // lives inside the handle.
+  class Face_handle
+  {
+  public:
+    typedef std::bidirectional_iterator_tag  iterator_category;
+    typedef Face                             value_type;
+    typedef std::ptrdiff_t                   difference_type;
+    typedef Face*                            pointer;
+    typedef Face&                            reference;
+
+    Face_handle() {}
+    Face_handle(Storage* s, Index i) : _f(s, i) {}
+
+    Face& operator*() const { return _f; }
+    Face* operator->() const { return &_f; }
+
+    Face_handle& operator++() { _f._i = _f._s->next_face(_f._i); return *this; }
+    Face_handle& operator--() { _f._i = _f._s->previous_face(_f._i); return *this; }
+    Face_handle operator++(int) { Face_handle tmp(*this); ++(*this); return tmp; }
+    Face_handle operator--(int) { Face_handle tmp(*this); --(*this); return tmp; }
+
+    // the null handle and the past the end iterator share the NONE index
+    bool operator==(const Face_handle& f) const { return _f._i == f._f._i; }
+    bool operator!=(const Face_handle& f) const { return _f._i != f._f._i; }
+    bool operator<(const Face_handle& f) const { return _f._i < f._f._i; }
+
+    Index index() const { return _f._i; }
+
+  private:
+    mutable Face _f;
+  };
+
+  class Vertex_handle
+  {
+  public:
+    typedef std::bidirectional_iterator_tag  iterator_category;
+    typedef Vertex                           value_type;
+    typedef std::ptrdiff_t                   difference_type;
+    typedef Vertex*                          pointer;
+    typedef Vertex&                          reference;
+
+    Vertex_handle() {}
+    Vertex_handle(Storage* s, Index i) : _v(s, i) {}
+
+    Vertex& operator*() const { return _v; }
+    Vertex* operator->() const { return &_v; }
+
+    Vertex_handle& operator++() { _v._i = _v._s->next_vertex(_v._i); return *this; }
+    Vertex_handle& operator--() { _v._i = _v._s->previous_vertex(_v._i); return *this; }
+    Vertex_handle operator++(int) { Vertex_handle tmp(*this); ++(*this); return tmp; }
+    Vertex_handle operator--(int) { Vertex_handle tmp(*this); --(*this); return tmp; }
+
+    bool operator==(const Vertex_handle& v) const { return _v._i == v._v._i; }
+    bool operator!=(const Vertex_handle& v) const { return _v._i != v._v._i; }
+    bool operator<(const Vertex_handle& v) const { return _v._i < v._v._i; }
+
+    Index index() const { return _v._i; }
+
+  private:
+    mutable Vertex _v;
+  };
+
+  typedef Face_handle                                Face_iterator;
+  typedef Vertex_handle                              Vertex_iterator;
+
+  // what faces() and vertices() return, enough for the iterators
+  class Face_range
+  {
+  public:
+    Face_range(Storage* s) : _s(s) {}
+    Face_iterator begin() const
+    { return Face_iterator(_s, _s->next_face(internal::Indexed_TDS_2::NONE)); }
+    Face_iterator end() const
+    { return Face_iterator(_s, internal::Indexed_TDS_2::NONE); }
+    size_type size() const { return _s->number_of_faces; }
+    size_type capacity() const { return _s->face_vertices.capacity(); }
+  private:
+    Storage* _s;
+  };
+
+  class Vertex_range
+  {
+  public:
+    Vertex_range(Storage* s) : _s(s) {}
+    Vertex_iterator begin() const
+    { return Vertex_iterator(_s, _s->next_vertex(internal::Indexed_TDS_2::NONE)); }
+    Vertex_iterator end() const
+    { return Vertex_iterator(_s, internal::Indexed_TDS_2::NONE); }
+    size_type size() const { return _s->number_of_vertices; }
+    size_type capacity() const { return _s->points.capacity(); }
+  private:
+    Storage* _s;
+  };
+
+  typedef Triangulation_ds_edge_iterator_2<Tds>      Edge_iterator;
+
+  typedef Triangulation_ds_face_circulator_2<Tds>    Face_circulator;
+  typedef internal::Indexed_TDS_2::Vertex_circulator<Tds>
+                                                     Vertex_circulator;
+  typedef Triangulation_ds_edge_circulator_2<Tds>    Edge_circulator;
+
+  typedef std::pair<Face_handle, int>                Edge;
+  typedef std::list<Edge> List_edges;
+
+protected:
+  int _dimension;
+  Storage* _storage;
+
+  //CREATORS - DESTRUCTORS
+public:
+  Indexed_triangulation_data_structure_2()
+    : _dimension(-2), _storage(new Storage) {}
+  Indexed_triangulation_data_structure_2(const Tds &tds)
+    : _dimension(tds._dimension), _storage(new Storage(*tds._storage)) {}
+  ~Indexed_triangulation_data_structure_2() { delete _storage; }
+  Tds& operator= (const Tds &tds)
+  {
+    copy_tds(tds);
+    return *this;
+  }
+  void swap(Tds &tds)
+  {
+    std::swap(_dimension, tds._dimension);
+    std::swap(_storage, tds._storage);
+  }
+
+  //ACCESS FUNCTIONS
+  Face_range faces() const { return Face_range(_storage); }
+  Vertex_range vertices() const { return Vertex_range(_storage); }
+  Storage& storage() const { return *_storage; }
+
+  int  dimension() const { return _dimension;  }
+  size_type number_of_vertices() const {return _storage->number_of_vertices;}
+  size_type number_of_faces() const
+  { return dimension() < 2 ? 0 : _storage->number_of_faces; }
+  size_type number_of_edges() const
+  {
+    switch (dimension()) {
+    case 1:  return number_of_vertices();
+    case 2:  return 3*number_of_faces()/2;
+    default: return 0;
+    }
+  }
+  size_type number_of_full_dim_faces() const
+  { return _storage->number_of_faces; }
+
+  // Makes room for n vertices and the 2n faces of their triangulation.
+  void reserve(size_type n) { _storage->reserve(n + 1, 2 * n + 2); }
+  // Bytes held by the arrays, whether in use or free.
+  size_type memory_usage() const
+  { return sizeof(*this) + _storage->memory_usage(); }
+
+  // TEST FEATURES
+  bool is_vertex(Vertex_handle v) const
+  { return _storage->is_vertex(v.index()); }
+  bool is_edge(Face_handle fh, int i) const;
+  bool is_edge(Vertex_handle va, Vertex_handle vb) const;
+  bool is_edge(Vertex_handle va, Vertex_handle vb,
+	       Face_handle& fr,  int& i) const;
+  bool is_face(Face_handle fh) const
+  { return dimension() == 2 && _storage->is_face(fh.index()); }
+  bool is_face(Vertex_handle v1,
+	       Vertex_handle v2,
+	       Vertex_handle v3) const
+  {
+    Face_handle f;
+    return is_face(v1,v2,v3,f);
+  }
+  bool is_face(Vertex_handle v1,
+	       Vertex_handle v2,
+	       Vertex_handle v3,
+	       Face_handle& fr) const;
+
+  // ITERATORS AND CIRCULATORS
+public:
+  Face_iterator face_iterator_base_begin() const    {
+    return faces().begin();
+  }
+  Face_iterator face_iterator_base_end() const    {
+    return faces().end();
+  }
+
+  Face_iterator faces_begin() const {
+    if (dimension() < 2) return faces_end();
+    return faces().begin();
+  }
+
+  Face_iterator faces_end() const {
+    return faces().end();
+  }
+
+  Vertex_iterator vertices_begin() const  {
+    return vertices().begin();
+  }
+
+  Vertex_iterator vertices_end() const {
+    return vertices().end();
+  }
+
+  Edge_iterator edges_begin() const {
+    return Edge_iterator(this);
+  }
+
+  Edge_iterator edges_end() const {
+    return Edge_iterator(this,1);
+  }
+
+  Face_circulator incident_faces(Vertex_handle v,
+				 Face_handle f =  Face_handle()) const{
+    return Face_circulator(v,f);
+  }
+  Vertex_circulator incident_vertices(Vertex_handle v,
+				      Face_handle f = Face_handle()) const
+  {
+    return Vertex_circulator(v,f);
+  }
+
+  Edge_circulator incident_edges(Vertex_handle v,
+				 Face_handle f = Face_handle()) const{
+    return Edge_circulator(v,f);
+  }
+
+  size_type degree(Vertex_handle v) const {
+    int count = 0;
+    Vertex_circulator vc = incident_vertices(v), done(vc);
+    if ( ! vc.is_empty()) {
+      do {
+	count += 1;
+      } while (++vc != done);
+    }
+    return count;
+  }
+
+  Vertex_handle
+  mirror_vertex(Face_handle f, int i) const
+  {
+    CGAL_triangulation_precondition ( f->neighbor(i) != Face_handle()
+				    && f->dimension() >= 1);
+  return f->neighbor(i)->vertex(mirror_index(f,i));
+  }
+
+  int
+  mirror_index(Face_handle f, int i) const
+  {
+    // return the index of opposite vertex in neighbor(i);
+    CGAL_triangulation_precondition (f->neighbor(i) != Face_handle() &&
+				     f->dimension() >= 1);
+    if (f->dimension() == 1) {
+      CGAL_assertion(i<=1);
+      const int j = f->neighbor(i)->index(f->vertex((i==0) ? 1 : 0));
+      CGAL_assertion(j<=1);
+      return (j==0) ? 1 : 0;
+    }
+    return ccw( f->neighbor(i)->index(f->vertex(ccw(i))));
+  }
+
+  Edge
+  mirror_edge(const Edge e) const
+  {
+    CGAL_triangulation_precondition(e.first->neighbor(e.second) != Face_handle()
+                                    && e.first->dimension() >= 1);
+    return Edge(e.first->neighbor(e.second),
+                mirror_index(e.first,  e.second));
+  }
+
+  // MODIFY
+  void flip(Face_handle f, int i);
+
+  Vertex_handle insert_first();
+  Vertex_handle insert_second();
+  Vertex_handle insert_in_face(Face_handle f);
+  Vertex_handle insert_in_edge(Face_handle f, int i);
+  Vertex_handle insert_dim_up(Vertex_handle w = Vertex_handle(),
+			      bool orient=true);
+
+  void remove_degree_3(Vertex_handle v, Face_handle f = Face_handle());
+  void remove_1D(Vertex_handle v);
+
+  void remove_second(Vertex_handle v);
+  void remove_first(Vertex_handle v);
+  void remove_dim_down(Vertex_handle v);
+  void dim_down(Face_handle f, int i);
+
+  Vertex_handle star_hole(List_edges& hole);
+  void    star_hole(Vertex_handle v, List_edges& hole);
+  void    make_hole(Vertex_handle v, List_edges& hole);
+
+  Vertex_handle create_vertex(const Vertex &v = Vertex());
+  Vertex_handle create_vertex(Vertex_handle v); //copies point and info
+  Face_handle create_face(const Face& f = Face());
+  Face_handle create_face(Face_handle f); //copies vertices, neighbors, info
+
+  Face_handle create_face(Face_handle f1, int i1,
+			  Face_handle f2, int i2,
+			  Face_handle f3, int i3);
+  Face_handle create_face(Face_handle f1, int i1,
+			  Face_handle f2, int i2);
+  Face_handle create_face(Face_handle f1, int i1, Vertex_handle v);
+  Face_handle create_face(Vertex_handle v1,
+			  Vertex_handle v2,
+			  Vertex_handle v3);
+  Face_handle create_face(Vertex_handle v1,
+			  Vertex_handle v2,
+			  Vertex_handle v3,
+			  Face_handle f1,
+			  Face_handle f2,
+			  Face_handle f3);
+  void set_adjacency(Face_handle f0, int i0, Face_handle f1, int i1) const;
+  void delete_face(Face_handle);
+  void delete_vertex(Vertex_handle);
+
+  // insert_degree_2 and remove_degree_2 operations
+  Vertex_handle insert_degree_2(Face_handle f, int i);
+  void remove_degree_2(Vertex_handle v);
+
+  // CHECKING
+  bool is_valid(bool verbose = false, int level = 0) const;
+
+public:
+  void clear()
+  {
+    _storage->clear();
+    set_dimension(-2);
+  }
+  // like clear(), but the arrays keep their capacity
+  void reset()
+  {
+    _storage->reset();
+    set_dimension(-2);
+  }
+
+  Vertex_handle copy_tds(const Tds &tds, Vertex_handle vh);
+  Vertex_handle copy_tds(const Tds &tds)
+  {
+    return copy_tds(tds, Vertex_handle());
+  }
+
+  // I/O
+  Vertex_handle file_input(std::istream& is, bool skip_first=false);
+  void file_output(std::ostream& os,
+		   Vertex_handle v = Vertex_handle(),
+		   bool skip_first=false) const;
+  // the blocks of Triangulation_2::binary_output(), v is the vertex 0
+  void binary_file_output(std::ostream& os, Vertex_handle v) const;
+  bool binary_file_input(std::istream& is, std::vector<Vertex_handle>& V);
+
+  // SETTING (had to make them public for use in remove from Triangulations)
+  void set_dimension (int n) {_dimension = n ;}
+
+  // template members definition
+public:
+  template< class EdgeIt>
+  Vertex_handle star_hole(EdgeIt edge_begin, EdgeIt edge_end)
+  {
+     Vertex_handle newv = create_vertex();
+     star_hole(newv, edge_begin, edge_end);
+     return newv;
+  }
+
+  template< class EdgeIt>
+  void  star_hole(Vertex_handle v, EdgeIt edge_begin,  EdgeIt edge_end)
+  {
+    std::list<Face_handle> empty_list;
+    star_hole(v,
+	      edge_begin,
+	      edge_end,
+	      empty_list.begin(),
+	      empty_list.end());
+    return;
+  }
+
+  template< class EdgeIt, class FaceIt>
+  Vertex_handle star_hole(EdgeIt edge_begin,
+		    EdgeIt edge_end,
+		    FaceIt face_begin,
+		    FaceIt face_end)
+  {
+    Vertex_handle newv = create_vertex();
+    star_hole(newv, edge_begin, edge_end, face_begin, face_end);
+    return newv;
+  }
+
+  template< class EdgeIt, class FaceIt>
+  void  star_hole(Vertex_handle newv,
+		  EdgeIt edge_begin,
+		  EdgeIt edge_end,
+		  FaceIt face_begin,
+		  FaceIt face_end)
+    // uses vertex v
+    // to star the hole described by the range [edge_begin,edge_end[
+    // reusing the faces in the range [face_begin,face_end[
+    // the triangulation is assumed to have dim=2
+    // hole is supposed to be ccw oriented
+  {
+    CGAL_triangulation_precondition(dimension() == 2);
+    EdgeIt eit = edge_begin;
+    FaceIt fit = face_begin;
+
+    Face_handle fn = (*eit).first;
+    int in = (*eit).second;
+    fn->vertex(cw(in))->set_face(fn);
+    Face_handle first_f =  reset_or_create_face(fn, in , newv, fit, face_end);
+    Face_handle previous_f=first_f, next_f;
+    ++eit;
+
+    for( ; eit != edge_end ; eit++) {
+      fn = (*eit).first;
+      in = (*eit).second;
+      fn->vertex(cw(in))->set_face(fn);
+      next_f = reset_or_create_face(fn, in , newv, fit, face_end);
+      set_adjacency(next_f, 1, previous_f, 0);
+      previous_f=next_f;
+    }
+
+    set_adjacency(next_f, 0, first_f, 1);
+    newv->set_face(first_f);
+    return;
+  }
+
+private:
+  template< class FaceIt>
+  Face_handle  reset_or_create_face(Face_handle fn,
+			      int in,
+			      Vertex_handle v,
+			      FaceIt& fit,
+			      const FaceIt& face_end)
+  {
+    if (fit == face_end) return create_face(fn, in, v);
+    (*fit)->set_vertices(fn->vertex(cw(in)), fn->vertex(ccw(in)), v);
+    (*fit)->set_neighbors(Face_handle(),Face_handle(),fn);
+    fn->set_neighbor(in, *fit);
+    return *fit++;
+  }
+
+};
+
+template < class Gt, class Vi, class Fi >
+inline bool
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+is_edge(Face_handle fh, int i) const
+{
+  if ( dimension() == 0 )  return false;
+  if ( dimension() == 1 && i != 2) return false;
+  if (i > 2) return false;
+  return _storage->is_face(fh.index());
+}
+
+template < class Gt, class Vi, class Fi >
+bool
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+is_edge(Vertex_handle va, Vertex_handle vb) const
+// returns true (false) if the line segment ab is (is not) an edge of t
+//It is assumed that va is a vertex of t
+{
+  Vertex_circulator vc = incident_vertices(va), done(vc);
+  if ( vc == 0) return false;
+  do {
+    if( vb == vc ) {return true;} 
+  } while (++vc != done);
+  return false;
+}
+ 
+
+template < class Gt, class Vi, class Fi >
+bool
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+is_edge(Vertex_handle va, Vertex_handle vb, 
+	Face_handle &fr,  int & i) const
+// assume va is a vertex of t
+// returns true (false) if the line segment ab is (is not) an edge of t
+// if true is returned (fr,i) is the edge ab
+// with face fr on the right of a->b
+{
+  Face_handle fc = va->face(); 
+  Face_handle start = fc;
+  if (fc == Face_handle()) return false;
+  int inda, indb;
+  do {
+    inda=fc->index(va);
+    indb = (dimension() == 2 ? cw(inda) : 1-inda);
+    if(fc->vertex(indb) == vb) {
+      fr=fc;
+      i = 3 - inda - indb; //works in dim 1 or 2
+      return true;
+    }
+    fc=fc->neighbor(indb); //turns ccw around va
+  } while (fc != start);
+  return false;
+}
+
+template < class Gt, class Vi, class Fi >
+bool 
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+is_face(Vertex_handle v1, 
+	Vertex_handle v2, 
+	Vertex_handle v3,
+	Face_handle &f) const
+{
+  if (dimension() != 2) return false;
+  int i;
+  bool b = is_edge(v1,v2,f,i);
+  if (!b) return false;
+  else if (v3== f->vertex(i)) return true;
+  f = f-> neighbor(i);
+  int ind1= f->index(v1);
+  int ind2= f->index(v2);
+  if (v3 == f->vertex(3-ind1-ind2)) { return true;}
+  return false;  
+}
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+flip(Face_handle f, int i)
+{
+  CGAL_triangulation_precondition( dimension()==2);
+  Face_handle n  = f->neighbor(i);
+  int ni = mirror_index(f,i); //ni = n->index(f);
+    
+  Vertex_handle  v_cw = f->vertex(cw(i));
+  Vertex_handle  v_ccw = f->vertex(ccw(i));
+
+  // bl == bottom left, tr == top right
+  Face_handle tr = f->neighbor(ccw(i));
+  int tri =  mirror_index(f,ccw(i));  
+  Face_handle bl = n->neighbor(ccw(ni));
+  int bli =  mirror_index(n,ccw(ni)); 
+      
+  f->set_vertex(cw(i), n->vertex(ni));
+  n->set_vertex(cw(ni), f->vertex(i));
+    
+  // update the neighborhood relations
+  set_adjacency(f, i, bl, bli);
+  set_adjacency(f, ccw(i), n, ccw(ni));
+  set_adjacency(n, ni, tr, tri);
+
+  if(v_cw->face() == f) {
+    v_cw->set_face(n);
+  }
+    
+  if(v_ccw->face() == n) {
+    v_ccw->set_face(f);
+  }
+}
+  
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+insert_first( )
+{
+  CGAL_triangulation_precondition( number_of_vertices() == 0 &&
+				   dimension()==-2 );
+  return insert_dim_up();
+}
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle 
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+insert_second()
+{
+  CGAL_triangulation_precondition( number_of_vertices() == 1 &&
+				   dimension()==-1 );
+  return insert_dim_up();
+
+}
+
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+insert_in_face(Face_handle f)
+  // New vertex will replace f->vertex(0) in face f
+{
+  CGAL_triangulation_precondition( f != Face_handle() && dimension()== 2);
+  Vertex_handle  v = create_vertex();
+
+  Vertex_handle v0 = f->vertex(0);
+  Vertex_handle v2 = f->vertex(2);
+  Vertex_handle v1 = f->vertex(1);
+    
+  Face_handle n1 = f->neighbor(1);
+  Face_handle n2 = f->neighbor(2);
+    
+  Face_handle f1 = create_face(v0, v, v2, f, n1, Face_handle());
+  Face_handle f2 = create_face(v0, v1, v, f, Face_handle(), n2);
+
+  set_adjacency(f1, 2, f2, 1);
+  if (n1 != Face_handle()) {
+    int i1 = mirror_index(f,1); //int i1 = n1->index(f);
+    n1->set_neighbor(i1,f1);
+  }
+  if (n2 != Face_handle()) {
+    int i2 = mirror_index(f,2);//int i2 = n2->index(f);
+    n2->set_neighbor(i2,f2);}
+
+  f->set_vertex(0, v);
+  f->set_neighbor(1, f1);
+  f->set_neighbor(2, f2);
+
+  if( v0->face() == f  ) {  v0->set_face(f2); }
+  v->set_face(f);
+
+  return v;
+}
+
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+insert_in_edge(Face_handle f, int i)
+  //insert in the edge opposite to vertex i of face f
+{
+  CGAL_triangulation_precondition(f != Face_handle() && dimension() >= 1); 
+  if (dimension() == 1) {CGAL_triangulation_precondition(i == 2);}
+  if (dimension() == 2) {CGAL_triangulation_precondition(i == 0 || 
+							 i == 1 || 
+							 i == 2);}
+  Vertex_handle v;
+  if (dimension() == 1) {
+    v = create_vertex();
+    Face_handle ff = f->neighbor(0);
+    Vertex_handle vv = f->vertex(1);
+    Face_handle g = create_face(v,vv,Vertex_handle(),ff, f, Face_handle());
+    f->set_vertex(1,v);f->set_neighbor(0,g);
+    ff->set_neighbor(1,g);
+    v->set_face(g);
+    vv->set_face(ff);
+  }
+
+    else { //dimension() ==2
+    Face_handle n = f->neighbor(i);
+    int in = mirror_index(f,i); //n->index(f);
+    v = insert_in_face(f);
+    flip(n,in); 
+    }
+
+  return v;
+}
+
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+insert_dim_up(Vertex_handle w,  bool orient)
+{
+  // the following function insert 
+  // a vertex  v which is outside the affine  hull of Tds
+  // The triangulation will be starred from  v and w 
+  // ( geometrically w=  // the infinite vertex )
+  // w=NULL for first and second insertions
+  // orient governs the orientation of the resulting triangulation
+
+  Vertex_handle v = create_vertex();
+  set_dimension( dimension() + 1);
+  Face_handle f1;
+  Face_handle f2;
+
+  const int dim = dimension(); //it is the resulting dimension
+    
+  switch (dim) { 
+  case -1:
+    f1 = create_face(v,Vertex_handle(),Vertex_handle());
+    v->set_face(f1);
+    break;
+  case 0 :
+    f1 = face_iterator_base_begin();
+    f2 = create_face(v,Vertex_handle(),Vertex_handle());
+    set_adjacency(f1, 0, f2, 0);
+    v->set_face(f2);
+    break;
+  case 1 :
+  case 2 :
+    {
+      std::list<Face_handle> faces_list;
+      Face_iterator ib= face_iterator_base_begin(); 
+      Face_iterator ib_end = face_iterator_base_end();
+      for (; ib != ib_end ; ++ib){
+	faces_list.push_back( ib);
+      }
+      
+      std::list<Face_handle>  to_delete;
+      typename std::list<Face_handle>::iterator lfit = faces_list.begin();
+      Face_handle f, g;
+
+      for ( ; lfit != faces_list.end() ; ++lfit) {
+	f = * lfit;
+	g = create_face(f); //calls copy constructor of face
+	f->set_vertex(dim,v);
+	g->set_vertex(dim,w);
+	set_adjacency(f, dim, g, dim);
+	if (f->has_vertex(w)) to_delete.push_back(g); // flat face to delete
+      }
+
+      lfit = faces_list.begin();
+      for ( ; lfit != faces_list.end() ; ++lfit) {
+	f = * lfit;
+	g = f->neighbor(dim);
+	for(int j = 0; j < dim ; ++j) {
+	  g->set_neighbor(j, f->neighbor(j)->neighbor(dim));
+	}
+      }
+
+      // couldn't unify the code for reorientation mater
+      lfit = faces_list.begin() ; 
+      if (dim == 1){
+	if (orient) {
+	  (*lfit)->reorient(); ++lfit ;  (*lfit)->neighbor(1)->reorient();
+	}
+	else {
+	  (*lfit)->neighbor(1)->reorient(); ++lfit ; (*lfit)->reorient(); 
+	}
+      }
+      else { // dimension == 2
+	for( ;lfit  != faces_list.end(); ++lfit ) {
+	  if (orient) {(*lfit)->neighbor(2)->reorient();}
+	  else { (*lfit)->reorient();}
+	}
+      }
+
+      lfit = to_delete.begin();
+      int i1, i2;
+      for ( ;lfit  != to_delete.end(); ++lfit){
+	f = *lfit ;
+	int j ;
+	if (f->vertex(0) == w) {j=0;}
+	else {j=1;}
+	f1= f->neighbor(dim); i1= mirror_index(f,dim); //f1->index(f);
+	f2= f->neighbor(j); i2= mirror_index(f,j); //f2->index(f);
+	set_adjacency(f1, i1, f2, i2);
+	delete_face(f);
+      }
+    
+      v->set_face( *(faces_list.begin()));
+    }
+    break;
+  default:
+    CGAL_triangulation_assertion(false);
+    break;  }
+  return v;
+}
+
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+remove_degree_3(Vertex_handle v, Face_handle f)
+// remove a vertex of degree 3
+{
+  CGAL_triangulation_precondition(v != Vertex_handle());
+  CGAL_triangulation_precondition(degree(v) == 3);
+
+  if (f == Face_handle()) {f= v->face();}
+  else { CGAL_triangulation_assertion( f->has_vertex(v));}
+      
+  int i = f->index(v);
+  Face_handle left = f->neighbor(cw(i));
+  int li = mirror_index(f,cw(i)); 
+  Face_handle right = f->neighbor(ccw(i));
+  int ri = mirror_index(f,ccw(i)); 
+
+  Face_handle ll, rr;
+  Vertex_handle q = left->vertex(li);
+  CGAL_triangulation_assertion( left->vertex(li) == right->vertex(ri));
+    
+  ll = left->neighbor(cw(li));
+  if(ll != Face_handle()) {
+    int lli = mirror_index(left,cw(li)); 
+    ll->set_neighbor(lli, f);
+  } 
+  f->set_neighbor(cw(i), ll);
+  if (f->vertex(ccw(i))->face() == left) f->vertex(ccw(i))->set_face(f);    
+        
+  rr = right->neighbor(ccw(ri));
+  if(rr != Face_handle()) {
+    int rri =  mirror_index(right,ccw(ri)); //rr->index(right);
+    rr->set_neighbor(rri, f);
+  } 
+  f->set_neighbor(ccw(i), rr);
+  if (f->vertex(cw(i))->face() == right) f->vertex(cw(i))->set_face(f);  
+        
+  f->set_vertex(i, q);
+  if (q->face() == right || q->face() == left) {
+    q->set_face(f);
+  }
+  delete_face(right);
+  delete_face(left);
+        
+  delete_vertex(v);
+} 
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+dim_down(Face_handle f, int i)
+{
+  CGAL_triangulation_expensive_precondition( is_valid() );
+  CGAL_triangulation_precondition( dimension() == 2 );
+  CGAL_triangulation_precondition( number_of_vertices() > 3 );
+  CGAL_triangulation_precondition( degree( f->vertex(i) ) == 
+                                   number_of_vertices()-1 );
+
+  Vertex_handle v = f->vertex(i);
+  std::list<Face_handle > to_delete;
+  std::list<Face_handle> to_downgrade;
+  Face_iterator ib = face_iterator_base_begin();
+  for( ; ib != face_iterator_base_end(); ++ib ){
+    if ( ! ib->has_vertex(v) ) { to_delete.push_back(ib);}
+    else { to_downgrade.push_back(ib);}
+  }
+
+  typename std::list<Face_handle>::iterator lfit = to_downgrade.begin();
+  int j;
+  for( ; lfit !=  to_downgrade.end() ; ++lfit) {
+    Face_handle fs = *lfit; j = fs->index(v);
+    if (j == 0) fs->cw_permute();
+    else if(j == 1) fs->ccw_permute();
+    fs->set_vertex(2, Vertex_handle());
+    fs->set_neighbor(2, Face_handle());
+    fs->vertex(0)->set_face(fs);
+  }
+  lfit = to_delete.begin();
+  for( ; lfit !=  to_delete.end() ; ++lfit) {
+    delete_face(*lfit);
+  }
+  set_dimension(dimension() -1);
+  Face_handle n0 = f->neighbor(0);
+  //Face_handle n1 = f->neighbor(1);
+  //Vertex_handle v0 = f->vertex(0);
+  Vertex_handle v1 = f->vertex(1);
+  f->set_vertex(1, v);
+  Face_handle fl = create_face(v, v1, Vertex_handle(),
+	                       n0, f, Face_handle());
+  f->set_neighbor(0, fl);
+  n0->set_neighbor(1, fl);
+  v->set_face(f);
+}
+  
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+remove_dim_down(Vertex_handle v)
+{
+  Face_handle f;
+  switch( dimension()){
+  case -1: 
+    delete_face(v->face());
+    break;
+  case 0:
+    f = v->face();
+    f->neighbor(0)->set_neighbor(0,Face_handle());
+    delete_face(v->face());
+    break;
+  case 1:
+  case 2:
+//  CGAL_triangulation_precondition ( 
+//           (dimension() == 1 &&  number_of_vertices() == 3) ||
+//           (dimension() == 2 && number_of_vertices() > 3) );
+    // the faces incident to v are down graded one dimension
+    // the other faces are deleted
+    std::list<Face_handle > to_delete;
+    std::list<Face_handle > to_downgrade;
+    Face_iterator ib = face_iterator_base_begin();
+    for( ; ib != face_iterator_base_end(); ++ib ){
+      if ( ! ib->has_vertex(v) ) { to_delete.push_back(ib);}
+      else { to_downgrade.push_back(ib);}
+    }
+
+    typename std::list<Face_handle>::iterator lfit = to_downgrade.begin();
+    int j;
+    for( ; lfit !=  to_downgrade.end() ; ++lfit) {
+      f = *lfit; j = f->index(v);
+      if (dimension() == 1) {
+	if (j == 0) 	f->reorient();
+	f->set_vertex(1,Vertex_handle());
+	f->set_neighbor(1, Face_handle());
+      }
+      else { //dimension() == 2
+	if (j == 0) f->cw_permute();
+	else if(j == 1) f->ccw_permute();
+	f->set_vertex(2, Vertex_handle());
+	f->set_neighbor(2, Face_handle());
+      }
+      f->vertex(0)->set_face(f);
+    }
+
+    lfit = to_delete.begin();
+    for( ; lfit !=  to_delete.end() ; ++lfit) {
+      delete_face(*lfit);
+    }
+  }  
+  delete_vertex(v);
+  set_dimension(dimension() -1);
+  return;
+}
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::  
+remove_1D(Vertex_handle v)
+{
+  CGAL_triangulation_precondition( dimension() == 1 &&
+				   number_of_vertices() > 3);
+  Face_handle f = v->face();
+  int i = f->index(v);
+  if (i==0) {f = f->neighbor(1);}
+  CGAL_triangulation_assertion( f->index(v) == 1);
+  Face_handle g= f->neighbor(0);
+  f->set_vertex(1, g->vertex(1));
+  set_adjacency(f, 0, g->neighbor(0), 1);
+  g->vertex(1)->set_face(f);
+  delete_face(g);
+  delete_vertex(v);
+  return;
+}
+
+
+
+template < class Gt, class Vi, class Fi >
+inline void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+remove_second(Vertex_handle v)
+{
+  CGAL_triangulation_precondition(number_of_vertices()== 2 &&
+ 				  dimension() == 0);
+  remove_dim_down(v);
+  return;
+}
+
+    
+template < class Gt, class Vi, class Fi >
+inline void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+remove_first(Vertex_handle v)
+{
+  CGAL_triangulation_precondition(number_of_vertices()== 1 && 
+ 				  dimension() == -1);
+  remove_dim_down(v);
+  return; 
+}
+
+template < class Gt, class Vi, class Fi >
+inline
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+star_hole(List_edges& hole)
+{
+  Vertex_handle newv = create_vertex();
+  star_hole(newv, hole);
+  return newv;
+}
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+star_hole(Vertex_handle newv, List_edges& hole)
+  // star the hole represented by hole around newv
+  // the triangulation is assumed to have dim=2
+  // hole is supposed to be ccw oriented
+{
+   
+  star_hole(newv, hole.begin(), hole.end());
+  return;	    
+}
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+make_hole(Vertex_handle v, List_edges& hole)
+  // delete the faces incident to v and v
+  // and return the dscription of the hole in hole
+{
+ CGAL_triangulation_precondition(dimension() == 2);
+ std::list<Face_handle> to_delete;  
+
+ Face_handle  f, fn;
+ int i =0, in =0;
+ Vertex_handle  vv;
+
+ Face_circulator fc = incident_faces(v);
+ Face_circulator done(fc);
+ do {
+   f = fc ;
+   i = f->index(v);
+   fn = f->neighbor(i);
+   in = mirror_index(f,i); //fn->index(f);
+   vv = f->vertex(cw(i));
+   if( vv->face()==  f) vv->set_face(fn);
+   vv = fc->vertex(ccw(i));
+   if( vv->face()== f) vv->set_face(fn);
+   fn->set_neighbor(in, Face_handle());
+   hole.push_back(Edge(fn,in));
+   to_delete.push_back(f);
+ }
+  while(++fc != done);
+
+  while (! to_delete.empty()){
+    delete_face(to_delete.front());
+    to_delete.pop_front();
+  }
+  delete_vertex(v);
+  return;
+}
+
+
+template < class Gt, class Vi, class Fi >
+inline void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+set_adjacency(Face_handle f0, int i0, Face_handle f1, int i1) const
+{
+  CGAL_triangulation_assertion(i0 >= 0 && i0 <= dimension());
+  CGAL_triangulation_assertion(i1 >= 0 && i1 <= dimension());
+  CGAL_triangulation_assertion(f0 != f1);
+  f0->set_neighbor(i0,f1);
+  f1->set_neighbor(i1,f0);
+}
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+insert_degree_2(Face_handle f, int i)
+{
+  /*
+  // This method basically does the following transformation
+  // The remove_degree_2 method performs the same operation in the
+  // opposite direction
+  //
+  //
+  //                                                *
+  //                 i                             / \
+  //                 *                            /   \
+  //                / \                          /  f  \
+  //               /   \                        / _____	\
+  //              /  f  \                      / /  f1 \ \
+  //             /       \                     |/   v   \|
+  //  v0=ccw(i) *---------* v1=cw(i)  ===>  v0 *----*----* v1
+  //             \       /                     |\   f2  /|
+  //              \  g  /                      \ \_____/ /
+  //               \   /                        \       /
+  //                \ /                          \  g  /
+  //                 *                            \   /
+  //                 j                             \ /
+  //                                                *
+  //
+  */
+
+  Face_handle g = f->neighbor(i);
+  int j = mirror_index(f,i);
+
+  Vertex_handle  v = create_vertex();
+
+  Vertex_handle v0 = f->vertex( ccw(i) );
+  Vertex_handle v1 = f->vertex( cw(i)  );
+
+  Face_handle f_undef;
+
+  Face_handle f1 = create_face(v0, v, v1, f_undef, f, f_undef);
+  Face_handle f2 = create_face(v0, v1, v, f_undef, f_undef, g);
+
+  set_adjacency(f1, 0, f2, 0);
+  set_adjacency(f1, 2, f2, 1);
+
+  f->set_neighbor(i, f1);
+  g->set_neighbor(j, f2);
+
+  v->set_face(f1);
+
+  return v;
+}
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+remove_degree_2(Vertex_handle v)
+{
+  CGAL_precondition( degree(v) == 2 );
+
+  Face_handle f1 = v->face();
+  int i = f1->index(v);
+
+  Face_handle f2 = f1->neighbor( ccw(i) );
+  int j = f2->index(v);
+
+  Face_handle ff1 = f1->neighbor( i );
+  Face_handle ff2 = f2->neighbor( j );
+
+  int id1 = mirror_index(f1,i);
+  int id2 = mirror_index(f2,j);
+
+  set_adjacency(ff1, id1, ff2, id2);
+
+  Vertex_handle v1 = f1->vertex( ccw(i) );
+  //    if ( v1->face() == f1 || v1->face() == f2 ) {
+  v1->set_face(ff1);
+  //    }
+
+  Vertex_handle v2 = f1->vertex( cw(i) );
+  //    if ( v2->face() == f1 || v2->face() == f2 ) {
+  v2->set_face(ff2);
+  //    }
+
+  delete_face(f1);
+  delete_face(f2);
+
+  delete_vertex(v);
+}
+
+// CHECKING
+template < class Gt, class Vi, class Fi >
+bool
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+is_valid(bool verbose, int level) const
+{
+  if(number_of_vertices() == 0){ 
+    return (dimension() == -2);
+  }
+
+      
+  bool result = (dimension()>= -1);
+  CGAL_triangulation_assertion(result);
+
+  //count and test the validity of the faces (for positive dimensions)
+  Face_iterator ib = face_iterator_base_begin(); 
+  Face_iterator ib_end = face_iterator_base_end();
+  size_type count_stored_faces =0;
+  for ( ; ib != ib_end ; ++ib){
+    count_stored_faces += 1;
+    if (dimension()>= 0) {
+      result = result && ib->is_valid(verbose,level);
+      CGAL_triangulation_assertion(result);
+    }
+  }
+  
+  result = result && (count_stored_faces == number_of_full_dim_faces());
+  CGAL_triangulation_assertion(
+		 count_stored_faces == number_of_full_dim_faces());
+ 
+  // vertex count
+  size_type vertex_count = 0;
+  for(Vertex_iterator vit = vertices_begin(); vit != vertices_end();
+      ++vit) {
+    CGAL_triangulation_assertion( vit->face() != Face_handle());
+    result = result && vit->is_valid(verbose,level);
+    CGAL_triangulation_assertion( result );
+    ++vertex_count;
+  }
+  result = result && (number_of_vertices() == vertex_count);
+  CGAL_triangulation_assertion( number_of_vertices() == vertex_count );
+    
+  //edge count
+  size_type edge_count = 0;
+  for(Edge_iterator eit = edges_begin(); eit != edges_end(); ++eit) { 
+    ++edge_count;
+  }
+
+  // face count
+  size_type face_count = 0;
+  for(Face_iterator fit = faces_begin(); fit != faces_end(); ++fit) {
+    ++face_count;
+  }
+        
+  switch(dimension()) {
+  case -1: 
+    result = result && vertex_count == 1 && face_count == 0
+      && edge_count == 0;
+    CGAL_triangulation_assertion(result);
+    break;
+  case 0:
+    result = result && vertex_count == 2 && face_count == 0
+      && edge_count == 0;
+    CGAL_triangulation_assertion(result);
+    break;
+  case 1:
+    result = result &&  edge_count == vertex_count;
+    CGAL_triangulation_assertion(result);
+    result = result &&  face_count == 0;
+    CGAL_triangulation_assertion(result);
+    break;
+  case 2:
+    result = result &&  edge_count == 3*face_count/2 ;
+    CGAL_triangulation_assertion(edge_count == 3*face_count/2);
+    break;
+  default:
+    result = false;
+    CGAL_triangulation_assertion(result);
+  }
+  return result;
+}
+
+template < class Gt, class Vi, class Fi >
+inline
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_vertex(const Vertex &v)
+{
+  Vertex_handle vh(_storage, _storage->new_vertex());
+  if (v.storage() != 0) {
+    _storage->points[vh.index()] = v.storage()->points[v.index()];
+    internal::Indexed_TDS_2::copy_info(v.storage()->vertex_info, v.index(),
+                                       _storage->vertex_info, vh.index());
+  }
+  return vh;
+}
+
+template < class Gt, class Vi, class Fi >
+inline
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_vertex(Vertex_handle vh)
+{
+  return create_vertex(*vh);
+}
+
+template < class Gt, class Vi, class Fi >
+inline
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Face_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_face(const Face& f)
+{
+  Face_handle fh(_storage, _storage->new_face());
+  if (f.storage() != 0) {
+    _storage->face_vertices[fh.index()] = f.storage()->face_vertices[f.index()];
+    _storage->face_neighbors[fh.index()] = f.storage()->face_neighbors[f.index()];
+    internal::Indexed_TDS_2::copy_info(f.storage()->face_info, f.index(),
+                                       _storage->face_info, fh.index());
+  }
+  return fh;
+}
+
+template < class Gt, class Vi, class Fi >
+inline
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Face_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_face( Face_handle fh)
+{
+  return create_face(*fh);
+}
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Face_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_face(Face_handle f1, int i1,
+	    Face_handle f2, int i2,
+	    Face_handle f3, int i3)
+{
+  Face_handle newf = create_face(f1->vertex(cw(i1)),
+				 f2->vertex(cw(i2)),
+				 f3->vertex(cw(i3)),
+				 f2, f3, f1);
+  f1->set_neighbor(i1,newf);
+  f2->set_neighbor(i2,newf);
+  f3->set_neighbor(i3,newf);
+  return newf;
+}
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Face_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_face(Face_handle f1, int i1, Face_handle f2, int i2)
+{
+  Face_handle newf = create_face(f1->vertex(cw(i1)),
+				 f2->vertex(cw(i2)),
+				 f2->vertex(ccw(i2)),
+				 f2, Face_handle(), f1);
+  f1->set_neighbor(i1,newf);
+  f2->set_neighbor(i2,newf);
+  return newf;
+}
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Face_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_face(Face_handle f1, int i1, Vertex_handle v)
+{
+  Face_handle newf = create_face();
+  newf->set_vertices(f1->vertex(cw(i1)), f1->vertex(ccw(i1)), v);
+  newf->set_neighbors(Face_handle(), Face_handle(), f1);
+  f1->set_neighbor(i1,newf);
+  return newf;
+}
+
+template < class Gt, class Vi, class Fi >
+inline
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Face_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_face(Vertex_handle v1, Vertex_handle v2, Vertex_handle v3)
+{
+  Face_handle newf(_storage, _storage->new_face());
+  newf->set_vertices(v1, v2, v3);
+  return newf;
+}
+
+template < class Gt, class Vi, class Fi >
+inline
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Face_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+create_face(Vertex_handle v1, Vertex_handle v2, Vertex_handle v3,
+	    Face_handle f1, Face_handle f2, Face_handle f3)
+{
+  Face_handle newf(_storage, _storage->new_face());
+  newf->set_vertices(v1, v2, v3);
+  newf->set_neighbors(f1, f2, f3);
+  return newf;
+}
+
+template < class Gt, class Vi, class Fi >
+inline void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+delete_face(Face_handle f)
+{
+  CGAL_triangulation_expensive_precondition( dimension() != 2 || is_face(f));
+  CGAL_triangulation_expensive_precondition( dimension() != 1 || is_edge(f,2));
+  CGAL_triangulation_expensive_precondition( dimension() != 0 ||
+					     is_vertex(f->vertex(0)) );
+  _storage->delete_face(f.index());
+}
+
+template < class Gt, class Vi, class Fi >
+inline void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+delete_vertex(Vertex_handle v)
+{
+  CGAL_triangulation_expensive_precondition( is_vertex(v) );
+  _storage->delete_vertex(v.index());
+}
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+copy_tds(const Tds &tds, Vertex_handle vh)
+  // return the vertex corresponding to vh in the new tds; the arrays are
+  // copied as they are, so the indices are the same
+{
+  if (this == &tds) return Vertex_handle();
+  if (vh != Vertex_handle())
+    CGAL_triangulation_precondition( tds.is_vertex(vh));
+  *_storage = *tds._storage;
+  set_dimension(tds.dimension());
+  return Vertex_handle(_storage, vh.index());
+}
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+file_output( std::ostream& os, Vertex_handle v, bool skip_first) const
+{
+  // ouput to a file, in the format of Triangulation_data_structure_2
+  // if non NULL, v is the vertex to be output first
+  // if skip_first is true, the point in the first vertex is not output
+  // (it may be for instance the infinite vertex of the triangulation)
+
+  size_type n = number_of_vertices();
+  size_type m = number_of_full_dim_faces();
+  if(is_ascii(os))  os << n << ' ' << m << ' ' << dimension() << std::endl;
+  else     os << n << m << dimension();
+  if (n==0) return;
+
+  // output numbers of the vertices and faces, by index
+  std::vector<int> V(_storage->points.size(), -1);
+  std::vector<int> F(_storage->face_vertices.size(), -1);
+
+  // first vertex
+  int inum = 0;
+  if ( v != Vertex_handle()) {
+    V[v.index()] = inum++;
+    if( ! skip_first){
+      os << v->point();
+    if(is_ascii(os))  os << std::endl;
+    }
+  }
+
+  // other vertices
+  for( Vertex_iterator vit= vertices_begin(); vit != vertices_end() ; ++vit) {
+    if ( v != vit ) {
+	V[vit.index()] = inum++;
+	os << vit->point();
+	if(is_ascii(os)) os << "\n";
+    }
+  }
+  if(is_ascii(os)) os << "\n";
+
+  // vertices of the faces
+  inum = 0;
+  int dim = (dimension() == -1 ? 1 :  dimension() + 1);
+  for( Face_iterator ib = face_iterator_base_begin();
+       ib != face_iterator_base_end(); ++ib) {
+    F[ib.index()] = inum++;
+    for(int j = 0; j < dim ; ++j) {
+      os << V[ib->vertex(j).index()];
+      if(is_ascii(os)) os << " ";
+    }
+    if(is_ascii(os)) os << "\n";
+  }
+  if(is_ascii(os)) os << "\n";
+
+  // neighbor pointers of the  faces
+  for( Face_iterator it = face_iterator_base_begin();
+       it != face_iterator_base_end(); ++it) {
+    for(int j = 0; j < dimension()+1; ++j){
+      os << F[it->neighbor(j).index()];
+      if(is_ascii(os))  os << " ";
+    }
+    if(is_ascii(os)) os << "\n";
+  }
+
+  return ;
+}
+
+
+template < class Gt, class Vi, class Fi >
+typename Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::Vertex_handle
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+file_input( std::istream& is, bool skip_first)
+{
+  //input from file
+  //return a pointer to the first input vertex
+  // if skip_first is true, a first vertex is added (infinite_vertex)
+  //set this  first vertex as infinite_Vertex
+  if(number_of_vertices() != 0)    clear();
+
+  size_type n, m;
+  int d;
+  is >> n >> m >> d;
+
+  if (n==0){ return Vertex_handle();}
+
+  set_dimension(d);
+  reserve(n);
+
+  std::vector<Vertex_handle > V(n);
+  std::vector<Face_handle> F(m);
+
+  // read vertices
+  size_type i = 0;
+  if(skip_first){
+    V[0] = create_vertex();
+    ++i;
+  }
+  for( ; i < n; ++i) {
+    V[i] = create_vertex();
+    is >> V[i]->point();
+  }
+
+  // Creation of the faces
+  int index;
+  int dim = (dimension() == -1 ? 1 :  dimension() + 1);
+  {
+    for(i = 0; i < m; ++i) {
+      F[i] = create_face() ;
+      for(int j = 0; j < dim ; ++j){
+	is >> index;
+	F[i]->set_vertex(j, V[index]);
+	V[index]->set_face(F[i]);
+      }
+    }
+  }
+
+  // Setting the neighbor pointers
+  {
+    for(i = 0; i < m; ++i) {
+      for(int j = 0; j < dimension()+1; ++j){
+	is >> index;
+	F[i]->set_neighbor(j, F[index]);
+      }
+    }
+  }
+
+  return V[0];
+}
+
+template < class Gt, class Vi, class Fi >
+void
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+binary_file_output( std::ostream& os, Vertex_handle v) const
+{
+  CGAL_triangulation_precondition( v != Vertex_handle());
+  internal::Indexed_TDS_2::Numbering V(_storage->points.size());
+  internal::Indexed_TDS_2::Numbering F(_storage->face_vertices.size());
+  internal::Tds_2_binary_io::binary_output(os, *this, v, V, F);
+}
+
+template < class Gt, class Vi, class Fi >
+bool
+Indexed_triangulation_data_structure_2<Gt,Vi,Fi>::
+binary_file_input( std::istream& is, std::vector<Vertex_handle>& V)
+{
+  return internal::Tds_2_binary_io::binary_input(is, *this, V);
+}
+
+} //namespace CGAL
+
+#endif //CGAL_INDEXED_TRIANGULATION_DATA_STRUCTURE_2_H
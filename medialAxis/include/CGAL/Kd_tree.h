@@ -29,11 +29,17 @@
 #include <CGAL/Kd_tree_node.h>
 #include <CGAL/Splitters.h>
 #include <CGAL/Compact_container.h>
+#include <CGAL/tags.h>
 
 #ifdef CGAL_HAS_THREADS
 #include <boost/thread/mutex.hpp>
 #endif
 
+#ifdef CGAL_LINKED_WITH_TBB
+#include <tbb/parallel_invoke.h>
+#include <tbb/spin_mutex.h>
+#endif
+
 namespace CGAL {
 
   //template <class SearchTraits, class Splitter_=Median_of_rectangle<SearchTraits>, class UseExtendedNode = Tag_true >
@@ -81,13 +87,35 @@ private:
   #ifdef CGAL_HAS_THREADS
   mutable boost::mutex building_mutex;//mutex used to protect const calls inducing build()
   #endif
+  #ifdef CGAL_LINKED_WITH_TBB
+  tbb::spin_mutex nodes_mutex;//serializes the allocation of nodes in build(Parallel_tag)
+  bool parallel_build_;
+  #endif
   bool built_;
 
   // protected copy constructor
   Kd_tree(const Tree& tree)
-    : traits_(tree.traits_),built_(tree.built_)
+    : traits_(tree.traits_),
+  #ifdef CGAL_LINKED_WITH_TBB
+      parallel_build_(false),
+  #endif
+      built_(tree.built_)
   {};
 
+  // All nodes are allocated here, so that build(Parallel_tag) can
+  // serialize the allocation while it creates subtrees concurrently.
+  Node_handle
+  new_node(const Node& n)
+  {
+  #ifdef CGAL_LINKED_WITH_TBB
+    if (parallel_build_){
+      tbb::spin_mutex::scoped_lock lock(nodes_mutex);
+      return nodes.insert(n);
+    }
+  #endif
+    return nodes.insert(n);
+  }
+
 
   // Instead of the recursive construction of the tree in the class Kd_tree_node
   // we do this in the tree class. The advantage is that we then can optimize
@@ -97,7 +125,7 @@ private:
   Node_handle
   create_leaf_node(Point_container& c)
   {
-    Node_handle nh = nodes.emplace(static_cast<unsigned int>(c.size()), Node::LEAF);
+    Node_handle nh = new_node(Node(static_cast<unsigned int>(c.size()), Node::LEAF));
 
     nh->data = c.begin();
     return nh;
@@ -127,7 +155,7 @@ private:
   Node_handle
   create_internal_node_use_extension(Point_container& c)
   {
-    Node_handle nh = nodes.emplace(Node::EXTENDED_INTERNAL);
+    Node_handle nh = new_node(Node(Node::EXTENDED_INTERNAL));
 
     Point_container c_low(c.dimension(),traits_);
     split(nh->separator(), c, c_low);
@@ -160,7 +188,7 @@ private:
   Node_handle
   create_internal_node(Point_container& c)
   {
-    Node_handle nh = nodes.emplace(Node::INTERNAL);
+    Node_handle nh = new_node(Node(Node::INTERNAL));
 
     Point_container c_low(c.dimension(),traits_);
     split(nh->separator(), c, c_low);
@@ -178,18 +206,96 @@ private:
     return nh;
   }
 
+  // The root of a tree with more than one bucket of points.
+  Node_handle
+  create_root(Point_container& c, Sequential_tag)
+  {
+    return create_internal_node(c, UseExtendedNode());
+  }
 
+  Node_handle
+  create_root(Point_container& c, Parallel_tag)
+  {
+  #ifdef CGAL_LINKED_WITH_TBB
+    parallel_build_ = true;
+    Node_handle nh = create_subtree(c);
+    parallel_build_ = false;
+    return nh;
+  #else
+    return create_root(c, Sequential_tag());
+  #endif
+  }
+
+  #ifdef CGAL_LINKED_WITH_TBB
+  // Subtrees with fewer points than this are built by a single task.
+  static std::size_t parallel_build_cutoff() { return 4096; }
+
+  // The same node as create_internal_node(c, UseExtendedNode()), with the
+  // lower and upper subtrees of large nodes built concurrently.
+  Node_handle
+  create_subtree(Point_container& c)
+  {
+    if (c.size() <= split.bucket_size()){
+      return create_leaf_node(c);
+    }
+    if (c.size() < parallel_build_cutoff()){
+      return create_internal_node(c, UseExtendedNode());
+    }
+
+    Node_handle nh = new_node(Node(UseExtendedNode::value ? Node::EXTENDED_INTERNAL
+                                                          : Node::INTERNAL));
+
+    Point_container c_low(c.dimension(),traits_);
+    split(nh->separator(), c, c_low);
+
+    if (UseExtendedNode::value){
+      int cd  = nh->separator().cutting_dimension();
+
+      nh->low_val = c_low.bounding_box().min_coord(cd);
+      nh->high_val = c.bounding_box().max_coord(cd);
+    }
+
+    tbb::parallel_invoke(Create_subtree(*this, c_low, nh->lower_ch),
+                         Create_subtree(*this, c, nh->upper_ch));
+    return nh;
+  }
+
+  class Create_subtree
+  {
+    Self& tree;
+    Point_container& c;
+    Node_handle& nh;
+
+  public:
+    Create_subtree(Self& tree_, Point_container& c_, Node_handle& nh_)
+      : tree(tree_), c(c_), nh(nh_)
+    {}
+
+    void operator()() const
+    {
+      nh = tree.create_subtree(c);
+    }
+  };
+  #endif
 
 public:
 
   Kd_tree(Splitter s = Splitter(),const SearchTraits traits=SearchTraits())
-    : traits_(traits),split(s), built_(false)
+    : traits_(traits),split(s),
+  #ifdef CGAL_LINKED_WITH_TBB
+      parallel_build_(false),
+  #endif
+      built_(false)
   {}
 
   template <class InputIterator>
   Kd_tree(InputIterator first, InputIterator beyond,
 	  Splitter s = Splitter(),const SearchTraits traits=SearchTraits())
-    : traits_(traits),split(s), built_(false)
+    : traits_(traits),split(s),
+  #ifdef CGAL_LINKED_WITH_TBB
+      parallel_build_(false),
+  #endif
+      built_(false)
   {
     pts.insert(pts.end(), first, beyond);
   }
@@ -200,6 +306,16 @@ public:
 
   void
   build()
+  {
+    build(Sequential_tag());
+  }
+
+  // With Parallel_tag, and if TBB is linked, the lower and upper subtrees
+  // of large nodes are built concurrently. The tree is the same as the one
+  // of build().
+  template <class ConcurrencyTag>
+  void
+  build(ConcurrencyTag tag)
   {
     const Point_d& p = *pts.begin();
     typename SearchTraits::Construct_cartesian_const_iterator_d ccci=traits_.construct_cartesian_const_iterator_d_object();
@@ -214,7 +330,7 @@ public:
     if (c.size() <= split.bucket_size()){
       tree_root = create_leaf_node(c);
     }else {
-      tree_root = create_internal_node(c, UseExtendedNode());
+      tree_root = create_root(c, tag);
     }
     built_ = true;
   }
@@ -0,0 +1,86 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+//******************************************************************************
+// File Description : Lloyd move function of Mesh_global_optimizer_2
+//******************************************************************************
+
+#ifndef CGAL_MESH_2_LLOYD_MOVE_2_H
+#define CGAL_MESH_2_LLOYD_MOVE_2_H
+
+namespace CGAL {
+
+namespace Mesh_2 {
+
+/**
+ * Moves a vertex to the centroid of its Voronoi cell. The cell is split by
+ * the Delaunay edges: its part in the incident face (v, a, b) is the
+ * quadrilateral (v, m_a, c, m_b), m_a and m_b being the midpoints of
+ * [v,a] and [v,b] and c the circumcenter of the face. The areas are
+ * signed, so that the circumcenters out of their faces cancel out.
+ *
+ * The density is uniform: the mesher already sized the mesh, and a
+ * density taken from the mesh itself (as Mesh_3::Lloyd_move takes it from
+ * Mesh_sizing_field) drew the vertices against the constraints, whose
+ * vertices do not move, and degraded the faces there.
+ */
+template <typename CDT>
+class Lloyd_move_2
+{
+  typedef typename CDT::Geom_traits       Gt;
+  typedef typename Gt::FT                 FT;
+  typedef typename Gt::Point_2            Point_2;
+  typedef typename Gt::Vector_2           Vector_2;
+
+  typedef typename CDT::Vertex_handle     Vertex_handle;
+  typedef typename CDT::Face_circulator   Face_circulator;
+
+public:
+  Vector_2 operator()(const Vertex_handle& v, const CDT& cdt) const
+  {
+    typename Gt::Construct_vector_2 vector =
+      Gt().construct_vector_2_object();
+    typename Gt::Compute_determinant_2 determinant =
+      Gt().compute_determinant_2_object();
+
+    const Point_2& p = v->point();
+    Vector_2 move(FT(0), FT(0));
+    FT sum_areas(0);
+
+    Face_circulator fc = cdt.incident_faces(v), done(fc);
+    do
+    {
+      int i = fc->index(v);
+      Vector_2 pa = vector(p, fc->vertex(CDT::ccw(i))->point()) / 2;
+      Vector_2 pb = vector(p, fc->vertex(CDT::cw(i))->point()) / 2;
+      Vector_2 pc = vector(p, cdt.circumcenter(fc));
+
+      // Triangles (v, m_a, c) and (v, c, m_b), with twice their areas
+      FT area_a = determinant(pa, pc);
+      FT area_b = determinant(pc, pb);
+
+      move = move + area_a * (pa + pc) + area_b * (pc + pb);
+      sum_areas += area_a + area_b;
+    }
+    while ( ++fc != done );
+
+    // The centroids of the triangles are a third of the sums above
+    if ( FT(0) < sum_areas )
+      return move / (3 * sum_areas);
+    else
+      return Vector_2(FT(0), FT(0));
+  }
+};
+
+} // end namespace Mesh_2
+
+} //namespace CGAL
+
+#endif // CGAL_MESH_2_LLOYD_MOVE_2_H
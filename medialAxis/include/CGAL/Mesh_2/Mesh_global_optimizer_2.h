@@ -0,0 +1,628 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+//******************************************************************************
+// File Description : The 2D counterpart of Mesh_3::Mesh_global_optimizer,
+// for the meshes of Delaunay_mesher_2.
+//******************************************************************************
+
+#ifndef CGAL_MESH_2_MESH_GLOBAL_OPTIMIZER_2_H
+#define CGAL_MESH_2_MESH_GLOBAL_OPTIMIZER_2_H
+
+#include <CGAL/tags.h>
+#include <CGAL/Mesh_optimization_return_code.h>
+
+#include <vector>
+#include <set>
+#include <stack>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+
+#include <boost/type_traits/is_convertible.hpp>
+
+#ifdef CGAL_LINKED_WITH_TBB
+# include <tbb/parallel_for.h>
+# include <tbb/blocked_range.h>
+#endif
+
+namespace CGAL {
+
+namespace Mesh_2 {
+
+/**
+ * Moves the vertices of a mesh of Delaunay_mesher_2 to the positions given
+ * by \c MoveFunction (see Lloyd_move_2 and Odt_move_2), all of them at
+ * once in each iteration. The domain is the set of faces marked
+ * in_domain. Vertices with incident constraints, on the convex hull or
+ * on the border of the domain never move, so neither do the constraints
+ * nor the domain.
+ *
+ * A vertex is moved by removing it and inserting its new position, which
+ * must lie in its star: the constraints around it stay where they are.
+ * The moves are computed from the mesh as it is at the beginning of the
+ * iteration; with \c Parallel_tag (when linked with TBB), they are
+ * computed concurrently, the triangulation being only read meanwhile.
+ * The kernel constructions must then be thread safe (not those of a lazy
+ * exact kernel). The mesh is updated sequentially.
+ */
+template <typename CDT, typename MoveFunction,
+          typename Concurrency_tag = Sequential_tag>
+class Mesh_global_optimizer_2
+{
+  typedef Mesh_global_optimizer_2<CDT, MoveFunction, Concurrency_tag> Self;
+
+  typedef typename CDT::Geom_traits         Gt;
+  typedef typename Gt::FT                   FT;
+  typedef typename Gt::Point_2              Point_2;
+  typedef typename Gt::Vector_2             Vector_2;
+
+  typedef typename CDT::Vertex_handle       Vertex_handle;
+  typedef typename CDT::Face_handle         Face_handle;
+  typedef typename CDT::Face_circulator     Face_circulator;
+  typedef typename CDT::Vertex_circulator   Vertex_circulator;
+
+  typedef std::vector<Vertex_handle>                 Moving_vertices;
+  typedef std::vector<std::pair<Vertex_handle, Point_2> > Moves_vector;
+
+public:
+  /**
+   * Constructor
+   */
+  Mesh_global_optimizer_2(CDT& cdt,
+                          const FT& freeze_ratio,
+                          const bool do_freeze,
+                          const FT& convergence_ratio,
+                          const MoveFunction move_function = MoveFunction())
+    : cdt_(cdt)
+    , sq_freeze_ratio_(freeze_ratio*freeze_ratio)
+    , convergence_ratio_(convergence_ratio)
+    , do_freeze_(do_freeze)
+    , move_function_(move_function)
+    , big_moves_size_(0)
+    , time_limit_(-1)
+    , start_time_()
+  {}
+
+  /**
+   * Launch optimization process
+   *
+   * @param nb_interations maximum number of iterations
+   */
+  Mesh_optimization_return_code operator()(int nb_iterations);
+
+  /// Time accessors
+  void set_time_limit(double time) { time_limit_ = time; }
+  double time_limit() const { return time_limit_; }
+
+private:
+  /**
+   * Returns true if \c v may move: it has no incident constraint and all
+   * its incident faces are finite and in the domain.
+   */
+  bool is_movable(const Vertex_handle& v) const;
+
+  /**
+   * Computes the move of \c v. Returns false if \c v does not move, frozen
+   * or not, and sets \c sq_ratio to its squared move over its local size.
+   */
+  bool compute_move(const Vertex_handle& v, Point_2& new_position,
+                    FT& sq_ratio) const;
+
+  /**
+   * Returns moves for vertices of \c moving_vertices, and removes the
+   * frozen ones from it if do_freeze_ is set.
+   */
+  Moves_vector compute_moves(Moving_vertices& moving_vertices);
+
+  /**
+   * Updates mesh using moves of \c moves vector. Fills moving_vertices
+   * with the moved vertices and their neighbors.
+   */
+  void update_mesh(const Moves_vector& moves,
+                   Moving_vertices& moving_vertices);
+
+  /**
+   * Returns true if \c v may move to \c p: the faces of its star stay
+   * positively oriented (so that \c p is in the star), and their smallest
+   * angle does not get smaller. The flips that make the mesh Delaunay again
+   * only make it larger.
+   */
+  bool is_improving_move(const Vertex_handle& v, const Point_2& p) const;
+
+  /**
+   * Returns the squared sine of the smallest angle of triangle (pa,pb,pc),
+   * as Delaunay_mesh_criteria_2
+   */
+  FT quality(const Point_2& pa, const Point_2& pb, const Point_2& pc) const;
+
+  /**
+   * Marks in_domain the faces created when \c v was moved: they are
+   * connected to \c v without crossing a constraint.
+   */
+  void mark_new_faces(const Vertex_handle& v);
+
+  /**
+   * Returns true if convergence is reached
+   */
+  bool check_convergence() const;
+
+  /**
+   * Returns true if time_limit is reached
+   */
+  bool is_time_limit_reached() const
+  {
+    return ( (time_limit() > 0) && (running_time() > time_limit()) );
+  }
+
+  /**
+   * Returns the wall-clock time since the optimization began: with
+   * Parallel_tag, the CPU time of CGAL::Timer would add up the threads.
+   */
+  double running_time() const
+  {
+    return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start_time_).count();
+  }
+
+#ifdef CGAL_LINKED_WITH_TBB
+  // Functor for compute_moves function
+  class Compute_move
+  {
+    const Self& mgo_;
+    const Moving_vertices& vertices_;
+    std::vector<Point_2>& positions_;
+    std::vector<FT>& sq_ratios_;
+    std::vector<char>& moved_;
+
+  public:
+    Compute_move(const Self& mgo,
+                 const Moving_vertices& vertices,
+                 std::vector<Point_2>& positions,
+                 std::vector<FT>& sq_ratios,
+                 std::vector<char>& moved)
+      : mgo_(mgo), vertices_(vertices), positions_(positions)
+      , sq_ratios_(sq_ratios), moved_(moved)
+    {}
+
+    void operator()(const tbb::blocked_range<std::size_t>& r) const
+    {
+      for( std::size_t i = r.begin() ; i != r.end() ; ++i )
+        moved_[i] = mgo_.compute_move(vertices_[i], positions_[i],
+                                      sq_ratios_[i]);
+    }
+  };
+#endif // CGAL_LINKED_WITH_TBB
+
+private:
+  CDT& cdt_;
+  FT sq_freeze_ratio_;
+  FT convergence_ratio_;
+  bool do_freeze_;
+  MoveFunction move_function_;
+
+  // The largest squared move ratios of the current iteration, in a heap
+  // with the smallest of them on top.
+  std::size_t big_moves_size_;
+  std::vector<FT> big_moves_;
+
+  double time_limit_;
+  std::chrono::steady_clock::time_point start_time_;
+};
+
+
+template <typename CDT, typename Mf, typename Ct>
+Mesh_optimization_return_code
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+operator()(int nb_iterations)
+{
+  start_time_ = std::chrono::steady_clock::now();
+
+  // Fill set containing moving vertices
+  Moving_vertices moving_vertices;
+  for( typename CDT::Finite_vertices_iterator vit = cdt_.finite_vertices_begin();
+       vit != cdt_.finite_vertices_end(); ++vit )
+  {
+    if ( is_movable(vit) )
+      moving_vertices.push_back(vit);
+  }
+
+  std::size_t initial_vertices_nb = moving_vertices.size();
+
+  // Initialize big moves (stores the largest moves)
+  big_moves_.clear();
+  big_moves_size_ =
+    (std::max)(std::size_t(1), std::size_t(moving_vertices.size()/500));
+
+  bool convergence_stop = false;
+
+  // Iterate
+  int i = -1;
+  while ( ++i < nb_iterations && ! is_time_limit_reached() )
+  {
+    std::size_t nb_vertices_moved = moving_vertices.size();
+
+    // Compute move for each vertex
+    Moves_vector moves = compute_moves(moving_vertices);
+
+    //Pb with Freeze : sometimes a few vertices continue moving indefinitely
+    //if the nb of moving vertices is < 1% of total nb AND does not decrease
+    if(do_freeze_
+      && nb_vertices_moved < 0.005 * initial_vertices_nb
+      && nb_vertices_moved == moving_vertices.size())
+    {
+      // we should stop because we are
+      // probably entering an infinite instable loop
+      convergence_stop = true;
+      break;
+    }
+
+    // Stop if time_limit is reached
+    if ( is_time_limit_reached() )
+      break;
+
+    // Update mesh with those moves
+    update_mesh(moves, moving_vertices);
+
+    if ( do_freeze_ && moving_vertices.empty() )
+      break;
+
+    if(check_convergence())
+      break;
+  }
+
+  if ( do_freeze_ && moving_vertices.empty() )
+    return ALL_VERTICES_FROZEN;
+
+  else if ( do_freeze_ && convergence_stop )
+    return CANT_IMPROVE_ANYMORE;
+
+  else if ( is_time_limit_reached() )
+    return TIME_LIMIT_REACHED;
+
+  else if ( check_convergence() )
+    return CONVERGENCE_REACHED;
+
+  return MAX_ITERATION_NUMBER_REACHED;
+}
+
+
+template <typename CDT, typename Mf, typename Ct>
+bool
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+is_movable(const Vertex_handle& v) const
+{
+  if ( cdt_.are_there_incident_constraints(v) )
+    return false;
+
+  Face_circulator fc = cdt_.incident_faces(v), done(fc);
+  do
+  {
+    if ( cdt_.is_infinite(fc) || ! fc->is_in_domain() )
+      return false;
+  }
+  while ( ++fc != done );
+
+  return true;
+}
+
+
+template <typename CDT, typename Mf, typename Ct>
+bool
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+compute_move(const Vertex_handle& v, Point_2& new_position,
+             FT& sq_ratio) const
+{
+  typename Gt::Compute_squared_distance_2 sq_distance =
+    Gt().compute_squared_distance_2_object();
+  typename Gt::Compute_squared_length_2 sq_length =
+    Gt().compute_squared_length_2_object();
+  typename Gt::Construct_translated_point_2 translate =
+    Gt().construct_translated_point_2_object();
+
+  sq_ratio = 0;
+  Vector_2 move = move_function_(v, cdt_);
+  FT sq_move = sq_length(move);
+  if ( FT(0) == sq_move )
+    return false;
+
+  // The local size is the length of the shortest incident edge
+  const Point_2& p = v->point();
+  Vertex_circulator vc = cdt_.incident_vertices(v), done(vc);
+  FT local_sq_size = sq_distance(p, vc->point());
+  while ( ++vc != done )
+    local_sq_size = (std::min)(local_sq_size, sq_distance(p, vc->point()));
+
+  if ( FT(0) == local_sq_size )
+    return false;
+
+  sq_ratio = sq_move / local_sq_size;
+
+  // Move point only if displacement is big enough w.r.t local size
+  if ( sq_ratio < sq_freeze_ratio_ )
+    return false;
+
+  new_position = translate(p, move);
+  if ( ! is_improving_move(v, new_position) )
+  {
+    sq_ratio = 0;
+    return false;
+  }
+
+  return true;
+}
+
+
+template <typename CDT, typename Mf, typename Ct>
+typename Mesh_global_optimizer_2<CDT,Mf,Ct>::Moves_vector
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+compute_moves(Moving_vertices& moving_vertices)
+{
+  std::size_t n = moving_vertices.size();
+  std::vector<Point_2> positions(n);
+  std::vector<FT> sq_ratios(n);
+  std::vector<char> moved(n);
+
+#ifdef CGAL_LINKED_WITH_TBB
+  // Parallel
+  if (boost::is_convertible<Ct, Parallel_tag>::value)
+  {
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n),
+                      Compute_move(*this, moving_vertices,
+                                   positions, sq_ratios, moved));
+  }
+  // Sequential
+  else
+#endif // CGAL_LINKED_WITH_TBB
+  {
+    for ( std::size_t i = 0 ; i < n ; ++i )
+      moved[i] = compute_move(moving_vertices[i], positions[i], sq_ratios[i]);
+  }
+
+  // Store new position of points which have to move, and keep the largest
+  // moves
+  Moves_vector moves;
+  moves.reserve(n);
+  big_moves_.clear();
+  std::greater<FT> greater;
+
+  std::size_t kept = 0;
+  for ( std::size_t i = 0 ; i < n ; ++i )
+  {
+    big_moves_.push_back(sq_ratios[i]);
+    std::push_heap(big_moves_.begin(), big_moves_.end(), greater);
+    if ( big_moves_.size() > big_moves_size_ )
+    {
+      std::pop_heap(big_moves_.begin(), big_moves_.end(), greater);
+      big_moves_.pop_back();
+    }
+
+    if ( moved[i] )
+      moves.push_back(std::make_pair(moving_vertices[i], positions[i]));
+    if ( moved[i] || ! do_freeze_ )
+      moving_vertices[kept++] = moving_vertices[i];
+  }
+  moving_vertices.resize(kept);
+
+  return moves;
+}
+
+
+template <typename CDT, typename Mf, typename Ct>
+void
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+update_mesh(const Moves_vector& moves,
+            Moving_vertices& moving_vertices)
+{
+  // The vertices left in moving_vertices are those which were to move.
+  // Those moved get a new handle, the others keep theirs.
+  moving_vertices.clear();
+
+  for ( typename Moves_vector::const_iterator it = moves.begin() ;
+       it != moves.end() ; ++it )
+  {
+    const Vertex_handle& v = it->first;
+    const Point_2& new_position = it->second;
+
+    // The star of v has changed since the move was computed
+    if ( ! is_improving_move(v, new_position) )
+    {
+      moving_vertices.push_back(v);
+      continue;
+    }
+
+    // A face outside the star of v, thus kept by the removal
+    Face_handle hint = v->face()->neighbor(v->face()->index(v));
+
+    cdt_.remove(v);
+    Vertex_handle new_v = cdt_.insert(new_position, hint);
+    mark_new_faces(new_v);
+    moving_vertices.push_back(new_v);
+  }
+
+  // Update moving vertices: they become the moved ones and their
+  // neighbors, as the moves of those have changed. They are kept in the
+  // order of the moves, not of the handles, for the next update not to
+  // depend on where the vertices were allocated.
+  if ( do_freeze_ )
+  {
+    std::set<Vertex_handle> seen(moving_vertices.begin(),
+                                 moving_vertices.end());
+    std::size_t n = moving_vertices.size();
+    for ( std::size_t i = 0 ; i < n ; ++i )
+    {
+      Vertex_circulator vc = cdt_.incident_vertices(moving_vertices[i]),
+                        done(vc);
+      do
+      {
+        if ( ! cdt_.is_infinite(vc) && is_movable(vc)
+            && seen.insert(vc).second )
+          moving_vertices.push_back(vc);
+      }
+      while ( ++vc != done );
+    }
+  }
+  else
+  {
+    moving_vertices.clear();
+    for( typename CDT::Finite_vertices_iterator vit = cdt_.finite_vertices_begin();
+         vit != cdt_.finite_vertices_end(); ++vit )
+    {
+      if ( is_movable(vit) )
+        moving_vertices.push_back(vit);
+    }
+  }
+}
+
+
+template <typename CDT, typename Mf, typename Ct>
+bool
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+is_improving_move(const Vertex_handle& v, const Point_2& p) const
+{
+  typename Gt::Orientation_2 orientation = Gt().orientation_2_object();
+
+  const Point_2& pv = v->point();
+  FT old_quality(1), new_quality(1);
+  Face_circulator fc = cdt_.incident_faces(v), done(fc);
+  do
+  {
+    int i = fc->index(v);
+    const Point_2& a = fc->vertex(CDT::ccw(i))->point();
+    const Point_2& b = fc->vertex(CDT::cw(i))->point();
+    if ( orientation(p, a, b) != LEFT_TURN )
+      return false;
+
+    old_quality = (std::min)(old_quality, quality(pv, a, b));
+    new_quality = (std::min)(new_quality, quality(p, a, b));
+  }
+  while ( ++fc != done );
+
+  return new_quality >= old_quality;
+}
+
+
+template <typename CDT, typename Mf, typename Ct>
+typename Mesh_global_optimizer_2<CDT,Mf,Ct>::FT
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+quality(const Point_2& pa, const Point_2& pb, const Point_2& pc) const
+{
+  typename Gt::Compute_area_2 area_2 = Gt().compute_area_2_object();
+  typename Gt::Compute_squared_distance_2 squared_distance =
+    Gt().compute_squared_distance_2_object();
+
+  FT area = 2*area_2(pa, pb, pc);
+  area = area*area; // area = 4 * area^2(triangle)
+
+  FT a = squared_distance(pb, pc);
+  FT b = squared_distance(pc, pa);
+  FT c = squared_distance(pa, pb);
+
+  // divided by the two longest edges
+  if ( a < b )
+    return ( a < c ) ? area/(b*c) : area/(a*b);
+  else
+    return ( b < c ) ? area/(a*c) : area/(a*b);
+}
+
+
+template <typename CDT, typename Mf, typename Ct>
+void
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+mark_new_faces(const Vertex_handle& v)
+{
+  // The new faces are those of the star of the old vertex (not in the
+  // domain by default), and v only had faces of the domain around it:
+  // they are reached from v without crossing a constraint. The domain
+  // does not extend to the infinite faces, even without constraints on
+  // the convex hull.
+  std::stack<Face_handle> faces;
+  Face_circulator fc = cdt_.incident_faces(v), done(fc);
+  do
+  {
+    fc->set_in_domain(true);
+    faces.push(fc);
+  }
+  while ( ++fc != done );
+
+  while ( ! faces.empty() )
+  {
+    Face_handle fh = faces.top();
+    faces.pop();
+    for ( int i = 0 ; i < 3 ; ++i )
+    {
+      Face_handle fi = fh->neighbor(i);
+      if ( ! fi->is_in_domain() && ! fh->is_constrained(i)
+          && ! cdt_.is_infinite(fi) )
+      {
+        fi->set_in_domain(true);
+        faces.push(fi);
+      }
+    }
+  }
+}
+
+
+template <typename CDT, typename Mf, typename Ct>
+bool
+Mesh_global_optimizer_2<CDT,Mf,Ct>::
+check_convergence() const
+{
+  FT sum(0);
+  for( typename std::vector<FT>::const_iterator
+       it = big_moves_.begin(), end = big_moves_.end() ; it != end ; ++it )
+  {
+    sum += CGAL::sqrt(*it);
+  }
+
+  FT average_move = sum/FT(big_moves_size_);/*even if set is not full, divide*/
+       /*by max size so that if only 1 point moves, it goes to 0*/
+
+  return ( average_move < convergence_ratio_ );
+}
+
+// Runs the optimizer with the move Move<CDT>; shared by
+// lloyd_optimize_mesh_2() and odt_optimize_mesh_2().
+template <template <typename> class Move,
+          typename CDT, typename Concurrency_tag>
+Mesh_optimization_return_code
+optimize_mesh_2_impl(CDT& cdt,
+                     const double time_limit,
+                     std::size_t max_iteration_number,
+                     const double convergence,
+                     const double freeze_bound,
+                     const bool do_freeze,
+                     Concurrency_tag)
+{
+  typedef Mesh_global_optimizer_2<CDT, Move<CDT>, Concurrency_tag> Optimizer;
+
+  // Create optimizer
+  Optimizer opt (cdt,
+                 freeze_bound,
+                 do_freeze,
+                 convergence);
+
+  // Set max time
+  opt.set_time_limit(time_limit);
+
+  // 1000 iteration max to avoid infinite loops
+  if ( 0 == max_iteration_number )
+    max_iteration_number = 1000;
+
+  // Launch optimization
+  return opt(static_cast<int>(max_iteration_number));
+}
+
+} // end namespace Mesh_2
+
+} //namespace CGAL
+
+#endif // CGAL_MESH_2_MESH_GLOBAL_OPTIMIZER_2_H
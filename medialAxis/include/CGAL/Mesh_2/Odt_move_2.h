@@ -0,0 +1,76 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+//******************************************************************************
+// File Description : Odt move function of Mesh_global_optimizer_2
+//******************************************************************************
+
+#ifndef CGAL_MESH_2_ODT_MOVE_2_H
+#define CGAL_MESH_2_ODT_MOVE_2_H
+
+namespace CGAL {
+
+namespace Mesh_2 {
+
+/**
+ * Moves a vertex to the mean of the circumcenters of its incident faces,
+ * weighted by their areas. The density is uniform, see Lloyd_move_2.
+ */
+template <typename CDT>
+class Odt_move_2
+{
+  typedef typename CDT::Geom_traits       Gt;
+  typedef typename Gt::FT                 FT;
+  typedef typename Gt::Point_2            Point_2;
+  typedef typename Gt::Vector_2           Vector_2;
+
+  typedef typename CDT::Vertex_handle     Vertex_handle;
+  typedef typename CDT::Face_circulator   Face_circulator;
+
+public:
+  Vector_2 operator()(const Vertex_handle& v, const CDT& cdt) const
+  {
+    typename Gt::Construct_vector_2 vector =
+      Gt().construct_vector_2_object();
+    typename Gt::Compute_area_2 area =
+      Gt().compute_area_2_object();
+
+    const Point_2& p = v->point();
+    Vector_2 move(FT(0), FT(0));
+    FT sum_area(0);
+
+    Face_circulator fc = cdt.incident_faces(v), done(fc);
+    do
+    {
+      // Compute move
+      Vector_2 p_circum = vector(p, cdt.circumcenter(fc));
+
+      // Points of face are positively oriented
+      FT face_area = area(fc->vertex(0)->point(),
+                          fc->vertex(1)->point(),
+                          fc->vertex(2)->point());
+
+      move = move + p_circum * face_area;
+      sum_area += face_area;
+    }
+    while ( ++fc != done );
+
+    if ( FT(0) != sum_area )
+      return move/sum_area;
+    else
+      return Vector_2(FT(0), FT(0));
+  }
+};
+
+} // end namespace Mesh_2
+
+} //namespace CGAL
+
+#endif // CGAL_MESH_2_ODT_MOVE_2_H
@@ -543,6 +543,26 @@ public:
     return status;
   }
 
+  /**
+   * Read-only part of test_point_conflict_from_superior_impl(): tells if
+   * \c p encroaches a constrained edge of the boundary of \c zone,
+   * without pushing anything. Safe to call from several threads while the
+   * triangulation is not modified.
+   */
+  bool is_boundary_encroached(const Point& p, const Zone& zone) const
+  {
+    for(typename Zone::Edges::const_iterator eit = zone.boundary_edges.begin();
+        eit != zone.boundary_edges.end(); ++eit)
+      {
+        const Face_handle& fh = eit->first;
+        const int& i = eit->second;
+
+        if(fh->is_constrained(i) && !is_locally_conform(tr, fh, i, p))
+          return true;
+      }
+    return false;
+  }
+
   /** Unmark as constrained. */
   void before_insertion_impl(const Edge& e, const Point&,
 			     const Zone&)
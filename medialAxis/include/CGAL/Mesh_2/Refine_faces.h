@@ -23,10 +23,30 @@
 
 #include <CGAL/Mesh_2/Face_badness.h>
 #include <CGAL/Double_map.h>
+#include <CGAL/Bbox_2.h>
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <string>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <CGAL/Spatial_lock_grid_2.h>
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+// Number of the worst bad faces whose zones of conflicts are computed
+// together by Refine_faces::refine_in_parallel().
+#ifndef CGAL_MESH_2_PARALLEL_BATCH_SIZE
+#  define CGAL_MESH_2_PARALLEL_BATCH_SIZE 1024
+#endif
+
+// Resolution of the lock grid of Refine_faces::refine_in_parallel().
+#ifndef CGAL_MESH_2_LOCK_GRID_CELLS_PER_AXIS
+#  define CGAL_MESH_2_LOCK_GRID_CELLS_PER_AXIS 128
+#endif
 
 namespace CGAL {
 
@@ -400,6 +420,25 @@ public:
 
   typedef typename Base::Bad_faces Bad_faces;
 
+  typedef typename Tr::Face_handle Face_handle;
+  typedef typename Tr::Point Point;
+  typedef typename Mesher::Zone Zone;
+  typedef typename Base::Quality Quality;
+
+  /** A bad face of a batch of refine_in_parallel(), with its refinement
+      point, its zone of conflicts and the cells of the lock grid it
+      holds. */
+  struct Candidate
+  {
+    Face_handle face;
+    Quality quality;
+    Point point;
+    Zone zone;
+    std::vector<int> cells;
+    bool encroaches;
+    bool locked;
+  };
+
   typedef typename boost::transform_iterator<
     Pair_get_first<typename Bad_faces::Direct_entry>,
     typename Bad_faces::const_iterator>
@@ -411,6 +450,190 @@ public:
   {
   }
 
+  /** \name PARALLEL REFINEMENT */
+
+  /**
+   * Refines with the same criteria as refine(visitor), so the result meets
+   * them too, but it is not the same mesh: the bad faces are taken by
+   * batches of up to CGAL_MESH_2_PARALLEL_BATCH_SIZE among the worst ones
+   * (when linked with TBB), so the points are inserted in another order
+   * than by the sequential queue. The refinement points and zones of
+   * conflicts of a batch are computed concurrently on the unmodified
+   * triangulation, and each zone locks the cells of a Spatial_lock_grid_2
+   * holding its vertices. The points whose
+   * zones got all their cells are then inserted one after the other: the
+   * zones share no vertex, so no insertion changes the zone of another.
+   * The triangulation data structure cannot create faces from several
+   * threads, hence this last step is sequential. A point that encroaches
+   * a constrained edge goes through the sequential path, which splits
+   * the edge first, and a zone that could not be locked waits for the
+   * next batch.
+   */
+  template <class Mesh_visitor>
+  void refine_in_parallel(Mesh_visitor visitor)
+  {
+#ifdef CGAL_LINKED_WITH_TBB
+    Tr& tr = this->triangulation_ref_impl();
+    if(tr.dimension() < 2)
+      return this->refine(visitor);
+
+    Bbox_2 bbox = tr.finite_vertices_begin()->point().bbox();
+    for(typename Tr::Finite_vertices_iterator vit =
+          tr.finite_vertices_begin();
+        vit != tr.finite_vertices_end(); ++vit)
+      bbox = bbox + vit->point().bbox();
+    Spatial_lock_grid_2 grid(bbox, CGAL_MESH_2_LOCK_GRID_CELLS_PER_AXIS);
+
+    std::vector<Candidate> candidates;
+    while(! this->is_algorithm_done() )
+    {
+      this->Base::previous.refine(visitor.previous_level());
+      if(! this->no_longer_element_to_refine() )
+        process_a_batch(visitor, grid, candidates);
+    }
+#else
+    this->refine(visitor);
+#endif
+  }
+
+#ifdef CGAL_LINKED_WITH_TBB
+  /** Computes the refinement point and the zone of conflicts of \c c,
+      and locks the cells of the zone for \c owner (> 0) if it encroaches
+      nothing. \c c.cells holds the cells of the vertices of \c c.face,
+      already locked for \c owner, and in the end the cells to unlock
+      after the batch. Only reads the triangulation. */
+  void compute_candidate(Candidate& c, unsigned int owner,
+                         Spatial_lock_grid_2& grid)
+  {
+    const Tr& tr = this->triangulation_ref_impl();
+    c.point = this->refinement_point_impl(c.face);
+    c.zone = this->conflicts_zone_impl(c.point, c.face);
+    c.locked = false;
+    c.encroaches = c.zone.faces.empty() ||
+      this->Base::previous.is_boundary_encroached(c.point, c.zone);
+    if(c.encroaches) return;
+
+    std::vector<int> cells;
+    for(typename Zone::Faces_iterator fit = c.zone.faces.begin();
+        fit != c.zone.faces.end(); ++fit)
+      for(int i = 0; i < 3; ++i)
+        if(! tr.is_infinite((*fit)->vertex(i)) )
+        {
+          int cell = grid.get_grid_index((*fit)->vertex(i)->point());
+          if(! std::binary_search(c.cells.begin(), c.cells.end(), cell) )
+            cells.push_back(cell);
+        }
+    std::sort(cells.begin(), cells.end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+    for(std::size_t i = 0; i < cells.size(); ++i)
+      if(! grid.try_lock(cells[i], owner) )
+      {
+        for(std::size_t j = 0; j < i; ++j)
+          grid.unlock(cells[j]);
+        return;
+      }
+    c.cells.insert(c.cells.end(), cells.begin(), cells.end());
+    c.locked = true;
+  }
+
+private:
+  /** Functor of the parallel_for of process_a_batch(). */
+  class Compute_candidates
+  {
+    Self& m_faces_level;
+    std::vector<Candidate>& m_candidates;
+    Spatial_lock_grid_2& m_grid;
+
+  public:
+    Compute_candidates(Self& faces_level,
+                       std::vector<Candidate>& candidates,
+                       Spatial_lock_grid_2& grid)
+      : m_faces_level(faces_level), m_candidates(candidates), m_grid(grid)
+    {}
+
+    void operator()(const tbb::blocked_range<std::size_t>& r) const
+    {
+      for(std::size_t i = r.begin(); i != r.end(); ++i)
+        m_faces_level.compute_candidate(m_candidates[i],
+                                        static_cast<unsigned int>(i + 1),
+                                        m_grid);
+    }
+  };
+
+  template <class Mesh_visitor>
+  void process_a_batch(Mesh_visitor visitor, Spatial_lock_grid_2& grid,
+                       std::vector<Candidate>& candidates)
+  {
+    // The batch takes the worst faces whose vertices are in cells that
+    // no face of the batch holds yet: neighboring bad faces, which are
+    // common, would only fail to lock their zones.
+    const Tr& tr = this->triangulation_ref_impl();
+    std::size_t n = 0;
+    std::size_t scanned = 0;
+    typename Bad_faces::iterator rit = this->bad_faces.front();
+    candidates.resize(CGAL_MESH_2_PARALLEL_BATCH_SIZE);
+    while(n < candidates.size() && scanned < this->bad_faces.size() &&
+          scanned < 4 * candidates.size())
+    {
+      Candidate& c = candidates[n];
+      c.quality = rit->first;
+      c.face = rit->second;
+      ++rit;
+      ++scanned;
+      c.cells.clear();
+      for(int i = 0; i < 3; ++i)
+        if(! tr.is_infinite(c.face->vertex(i)) )
+          c.cells.push_back(grid.get_grid_index(c.face->vertex(i)->point()));
+      std::sort(c.cells.begin(), c.cells.end());
+      c.cells.erase(std::unique(c.cells.begin(), c.cells.end()), c.cells.end());
+      bool free = true;
+      for(std::size_t i = 0; free && i < c.cells.size(); ++i)
+        free = ! grid.is_cell_locked(c.cells[i]);
+      if(! free) continue;
+      for(std::size_t i = 0; i < c.cells.size(); ++i)
+        grid.try_lock(c.cells[i], static_cast<unsigned int>(n + 1));
+      ++n;
+    }
+    candidates.resize(n);
+
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n),
+                      Compute_candidates(*this, candidates, grid));
+
+    std::size_t inserted = 0, encroaching = 0;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      Candidate& c = candidates[i];
+      if(c.locked)
+      {
+        this->current_badness = this->is_bad(c.quality);
+        this->insert_in_zone(c.face, c.point, c.zone, visitor);
+        ++inserted;
+      }
+      else if(c.encroaches)
+        ++encroaching;
+    }
+    for(std::size_t i = 0; i < n; ++i)
+      for(std::size_t j = 0; j < candidates[i].cells.size(); ++j)
+        grid.unlock(candidates[i].cells[j]);
+    CGAL_expensive_assertion(grid.check_if_all_cells_are_unlocked());
+
+    // As many sequential steps as encroaching candidates, and one if
+    // nothing could be done in parallel, so that the refinement always
+    // goes on.
+    if(inserted == 0 && encroaching == 0)
+      encroaching = 1;
+    for(std::size_t i = 0; i < encroaching && ! this->is_algorithm_done(); ++i)
+    {
+      this->Base::previous.refine(visitor.previous_level());
+      if(! this->no_longer_element_to_refine() )
+        this->process_one_element(visitor);
+    }
+  }
+
+public:
+#endif // CGAL_LINKED_WITH_TBB
+
   /** \name DEBUGGING FUNCTIONS */
 
   Bad_faces_const_iterator begin() const
@@ -61,6 +61,7 @@ CGAL_PRAGMA_DIAG_PUSH
 CGAL_MESH_3_IGNORE_BOOST_PARAMETER_NAME_WARNINGS
 
 BOOST_PARAMETER_NAME( c3t3 )
+BOOST_PARAMETER_NAME( cdt )
 BOOST_PARAMETER_NAME( domain )
 BOOST_PARAMETER_NAME( criteria )
   
@@ -72,6 +73,7 @@ BOOST_PARAMETER_NAME( (freeze_bound, tag) freeze_bound_)
 BOOST_PARAMETER_NAME( (do_freeze, tag) do_freeze_)
 BOOST_PARAMETER_NAME( (max_iteration_number, tag) max_iteration_number_ )
 BOOST_PARAMETER_NAME( (convergence, tag) convergence_)
+BOOST_PARAMETER_NAME( (concurrency_tag, tag) concurrency_tag_)
 
 BOOST_PARAMETER_NAME( (dump_after_init_prefix, tag ) dump_after_init_prefix_)
 BOOST_PARAMETER_NAME( (dump_after_refine_surface_prefix, tag ) dump_after_refine_surface_prefix_)
@@ -349,6 +349,23 @@ public:
     return result;
   }
 
+  /**
+   * Inserts the refinement point \c p of \c e, whose zone of conflicts
+   * \c zone was computed beforehand and conflicts with nothing (used by
+   * the parallel refinement of Mesh_2::Refine_faces, where the zones are
+   * computed concurrently).
+   */
+  template <class Mesh_visitor>
+  Vertex_handle insert_in_zone(Element e, const Point& p, Zone& zone,
+                               Mesh_visitor visitor)
+  {
+    before_conflicts(e, p, visitor);
+    before_insertion(e, p, zone, visitor);
+    Vertex_handle v = insert(p, zone);
+    after_insertion(v, visitor);
+    return v;
+  }
+
   /** Return (can_split_the_element, drop_element). */
   Mesher_level_conflict_status
   test_point_conflict(const Point& p, Zone& zone)
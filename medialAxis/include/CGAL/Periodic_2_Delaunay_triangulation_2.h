@@ -31,6 +31,25 @@
 #include <boost/mpl/and.hpp>
 #endif //CGAL_TRIANGULATION_2_DONT_INSERT_RANGE_OF_POINTS_WITH_INFO
 
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <cmath>
+#  include <CGAL/Spatial_lock_grid_2.h>
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+// Number of points whose conflict regions are computed together by
+// Periodic_2_Delaunay_triangulation_2::insert(first, last, Parallel_tag).
+#ifndef CGAL_PERIODIC_2_PARALLEL_BATCH_SIZE
+#  define CGAL_PERIODIC_2_PARALLEL_BATCH_SIZE 1024
+#endif
+
+// Minimal resolution of the lock grid of the parallel insertion; the grid
+// gets finer with the number of points.
+#ifndef CGAL_PERIODIC_2_LOCK_GRID_CELLS_PER_AXIS
+#  define CGAL_PERIODIC_2_LOCK_GRID_CELLS_PER_AXIS 128
+#endif
+
 
 namespace CGAL
 {
@@ -179,6 +198,11 @@ public:
     std::vector<Point> points(first, last);
     typename std::vector<Point>::iterator pbegin = points.begin();
 
+    // The dummy points are always safe if the points give a 1-cover, and
+    // they skip the 9-sheeted covering.
+    if (n == 0 && !is_large_point_set)
+      is_large_point_set = this->is_1_cover_guaranteed(points.begin(), points.end());
+
     if (is_large_point_set)
       {
         std::vector<Vertex_handle> tmp_dummy_points = this->insert_dummy_points();
@@ -237,6 +261,24 @@ public:
 
     return number_of_vertices() - n;
   }
+
+  /// Inserts the points with several threads when CGAL is linked with TBB.
+  /// This is done only in an empty triangulation, for points that are sure
+  /// to give a 1-cover (see is_1_cover_guaranteed()); other points are
+  /// inserted by insert(first, last).
+  template < class InputIterator >
+  std::ptrdiff_t
+  insert(InputIterator first, InputIterator last, Parallel_tag)
+  {
+    size_type n = number_of_vertices();
+    std::vector<Point> points(first, last);
+    if (n != 0 || !this->is_1_cover_guaranteed(points.begin(), points.end()))
+      return insert(points.begin(), points.end());
+
+    insert_in_parallel(points);
+    return number_of_vertices() - n;
+  }
+
 #ifndef CGAL_TRIANGULATION_2_DONT_INSERT_RANGE_OF_POINTS_WITH_INFO
 private:
   //top stands for tuple-or-pair
@@ -285,6 +327,8 @@ private:
     // The heuristic discards the existing triangulation so it can only be
     // applied to empty triangulations.
     if (n != 0) is_large_point_set = false;
+    else if (!is_large_point_set)
+      is_large_point_set = this->is_1_cover_guaranteed(points.begin(), points.end());
 
     std::set<Vertex_handle> dummy_points;
     typename std::vector<std::ptrdiff_t>::iterator pbegin = indices.begin();
@@ -678,6 +722,65 @@ private:
 
 // end of auxilliary functions for remove
 
+  // auxilliary functions for the parallel insertion
+  void insert_in_parallel(std::vector<Point> &points);
+
+#ifdef CGAL_LINKED_WITH_TBB
+  // A point of the parallel insertion, located from the vertex hint. The
+  // cells are those of the vertices of its conflict region in the lock
+  // grid.
+  struct Point_candidate
+  {
+    std::ptrdiff_t    index;
+    Vertex_handle     hint;
+    Face_handle       loc;
+    Locate_type       lt;
+    int               li;
+    Vertex_handle     vertex;
+    std::vector<int>  cells;
+    bool              locked;
+  };
+
+  void compute_point_candidate(Point_candidate &c, const Point &p,
+                               unsigned int owner,
+                               Spatial_lock_grid_2 &grid) const;
+
+  void process_point_batch(std::vector<Point_candidate> &candidates,
+                           const std::vector<Point> &points,
+                           Spatial_lock_grid_2 &grid,
+                           std::vector<std::ptrdiff_t> &deferred,
+                           std::vector<Vertex_handle> &vertices,
+                           std::set<Vertex_handle> &dummy_points);
+
+  // functor of the parallel_for of process_point_batch()
+  class Compute_point_candidates
+  {
+    const Self &m_tr;
+    std::vector<Point_candidate> &m_candidates;
+    const std::vector<Point> &m_points;
+    Spatial_lock_grid_2 &m_grid;
+
+  public:
+    Compute_point_candidates(const Self &tr,
+                             std::vector<Point_candidate> &candidates,
+                             const std::vector<Point> &points,
+                             Spatial_lock_grid_2 &grid)
+      : m_tr(tr), m_candidates(candidates), m_points(points), m_grid(grid)
+    {}
+
+    void operator()(const tbb::blocked_range<std::size_t> &r) const
+    {
+      for (std::size_t i = r.begin(); i != r.end(); ++i)
+        {
+          m_tr.compute_point_candidate(m_candidates[i],
+                                       m_points[m_candidates[i].index],
+                                       static_cast<unsigned int>(i + 1),
+                                       m_grid);
+        }
+    }
+  };
+#endif
+
 
 
 
@@ -937,6 +1040,252 @@ insert(const Point  &p, Locate_type lt, Face_handle loc, int li)
   return vh;
 }
 
+// The parallel insertion starts from the dummy points, so it works in the
+// 1-cover from the start, and it goes by passes over the points sorted
+// along a Hilbert curve. Every k-th point is inserted first, one by one,
+// and the others follow by rounds that halve the gaps between them, each
+// round cut into batches of up to CGAL_PERIODIC_2_PARALLEL_BATCH_SIZE
+// points spread over the domain. The points of a batch are located, and
+// their conflict regions computed, concurrently on the unmodified
+// triangulation; each region locks the cells of a Spatial_lock_grid_2 over
+// the domain that hold its vertices. Two regions without a common vertex
+// do not change each other, so the points whose regions got all their
+// cells are then inserted one after the other at the place where they
+// were located. The others wait for the next pass. The dummy points are
+// removed at the end, which keeps the 1-cover since the points give one.
+template < class Gt, class Tds >
+void
+Periodic_2_Delaunay_triangulation_2<Gt, Tds>::
+insert_in_parallel(std::vector<Point> &points)
+{
+  CGAL_triangulation_precondition(empty());
+
+  std::set<Vertex_handle> dummy_points;
+  std::vector<Vertex_handle> tmp_dummy_points = this->insert_dummy_points();
+  std::copy(tmp_dummy_points.begin(), tmp_dummy_points.end(),
+            std::inserter(dummy_points, dummy_points.begin()));
+
+  spatial_sort(points.begin(), points.end(), geom_traits());
+
+  std::ptrdiff_t m = static_cast<std::ptrdiff_t>(points.size());
+  std::ptrdiff_t stride = (std::max)(m / CGAL_PERIODIC_2_PARALLEL_BATCH_SIZE,
+                                     std::ptrdiff_t(1));
+#ifndef CGAL_LINKED_WITH_TBB
+  stride = 1;
+#endif
+
+  // the vertices by position in the Hilbert order
+  std::vector<Vertex_handle> vertices(m);
+
+  Face_handle f;
+  Locate_type lt;
+  int li;
+  for (std::ptrdiff_t i = 0; i < m; i += stride)
+    {
+      f = locate(points[i], lt, li, f);
+      if (lt == Triangulation::VERTEX)
+        {
+          vertices[i] = f->vertex(li);
+          dummy_points.erase(vertices[i]);
+        }
+      else
+        {
+          vertices[i] = insert(points[i], lt, f, li);
+        }
+      f = vertices[i]->face();
+    }
+
+#ifdef CGAL_LINKED_WITH_TBB
+  if (stride > 1)
+    {
+      int cells_per_axis = (std::max)(static_cast<int>(std::sqrt(static_cast<double>(m))),
+                                      int(CGAL_PERIODIC_2_LOCK_GRID_CELLS_PER_AXIS));
+      Spatial_lock_grid_2 grid(this->domain().bbox(), cells_per_axis);
+
+      // round r inserts the points whose offset o from the sample before
+      // them has its lowest set bit at r, from the highest round down, so
+      // that the point at o - 2^r is already in
+      std::ptrdiff_t step = 1;
+      while (2 * step < stride) step *= 2;
+
+      std::vector<std::ptrdiff_t> pending, deferred;
+      std::vector<Point_candidate> candidates;
+      for (; step > 0; step /= 2)
+        {
+          pending.clear();
+          for (std::ptrdiff_t i = 0; i < m; i++)
+            {
+              std::ptrdiff_t o = i % stride;
+              if (o != 0 && (o & -o) == step) pending.push_back(i);
+            }
+
+          while (!pending.empty())
+            {
+              // a batch much smaller than the triangulation, lest the
+              // regions of the first rounds all meet
+              std::size_t n = pending.size();
+              std::size_t size = (std::min)(std::size_t(CGAL_PERIODIC_2_PARALLEL_BATCH_SIZE),
+                                            std::size_t(number_of_vertices() / 16 + 1));
+              std::size_t batches = (n + size - 1) / size;
+              deferred.clear();
+              for (std::size_t b = 0; b < batches; b++)
+                {
+                  candidates.resize((n - b + batches - 1) / batches);
+                  std::size_t k = 0;
+                  for (std::size_t i = b; i < n; i += batches, k++)
+                    {
+                      candidates[k].index = pending[i];
+                      candidates[k].hint = vertices[pending[i] - step];
+                    }
+                  process_point_batch(candidates, points, grid, deferred,
+                                      vertices, dummy_points);
+                }
+              pending.swap(deferred);
+            }
+        }
+    }
+#endif
+
+  for (typename std::set<Vertex_handle>::const_iterator it = dummy_points.begin();
+       it != dummy_points.end(); ++it)
+    {
+      remove(*it);
+    }
+  CGAL_triangulation_postcondition(is_1_cover());
+}
+
+#ifdef CGAL_LINKED_WITH_TBB
+// locates c and locks the cells of the vertices of its conflict region for
+// owner (> 0); only reads the triangulation
+template < class Gt, class Tds >
+void
+Periodic_2_Delaunay_triangulation_2<Gt, Tds>::
+compute_point_candidate(Point_candidate &c, const Point &p, unsigned int owner,
+                        Spatial_lock_grid_2 &grid) const
+{
+  c.locked = false;
+  c.cells.clear();
+  c.loc = locate(p, c.lt, c.li, c.hint->face());
+  if (c.lt == Triangulation::VERTEX)
+    {
+      // nothing to insert; keeps the vertex, as c.loc may be destroyed by
+      // the insertions of the batch that come first
+      c.vertex = c.loc->vertex(c.li);
+      c.locked = true;
+      return;
+    }
+
+  // walks the conflict region carrying the offset of p in each face, as
+  // march_locate_2D() does, so that each face costs one circle test
+  // instead of one per copy of p
+  std::vector<std::pair<Face_handle, Offset> > stack;
+  std::vector<Face_handle> visited(1, c.loc);
+  stack.push_back(std::make_pair(c.loc, this->get_location_offset(c.loc, p, Offset())));
+  while (!stack.empty())
+    {
+      Face_handle f = stack.back().first;
+      Offset o = stack.back().second;
+      stack.pop_back();
+      for (int j = 0; j < 3; j++)
+        c.cells.push_back(grid.get_grid_index(f->vertex(j)->point()));
+
+      for (int j = 0; j < 3; j++)
+        {
+          Face_handle nb = f->neighbor(j);
+          if (std::find(visited.begin(), visited.end(), nb) != visited.end())
+            continue;
+          visited.push_back(nb);
+          Offset o_nb = combine_offsets(o, get_neighbor_offset(f, j, nb, nb->index(f)));
+          if (side_of_oriented_circle(nb->vertex(0)->point(), nb->vertex(1)->point(),
+                                      nb->vertex(2)->point(), p,
+                                      get_offset(nb, 0), get_offset(nb, 1),
+                                      get_offset(nb, 2), o_nb, true) == ON_POSITIVE_SIDE)
+            stack.push_back(std::make_pair(nb, o_nb));
+        }
+    }
+
+  std::sort(c.cells.begin(), c.cells.end());
+  c.cells.erase(std::unique(c.cells.begin(), c.cells.end()), c.cells.end());
+
+  for (std::size_t i = 0; i < c.cells.size(); i++)
+    {
+      if (!grid.try_lock(c.cells[i], owner))
+        {
+          for (std::size_t j = 0; j < i; j++)
+            grid.unlock(c.cells[j]);
+          c.cells.clear();
+          return;
+        }
+    }
+  c.locked = true;
+}
+
+// vertices[c.index] gets the vertex of the point of c
+template < class Gt, class Tds >
+void
+Periodic_2_Delaunay_triangulation_2<Gt, Tds>::
+process_point_batch(std::vector<Point_candidate> &candidates,
+                    const std::vector<Point> &points,
+                    Spatial_lock_grid_2 &grid,
+                    std::vector<std::ptrdiff_t> &deferred,
+                    std::vector<Vertex_handle> &vertices,
+                    std::set<Vertex_handle> &dummy_points)
+{
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, candidates.size()),
+                    Compute_point_candidates(*this, candidates, points, grid));
+
+  bool progress = false;
+  for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+      Point_candidate &c = candidates[i];
+      if (!c.locked) continue;
+      if (c.lt == Triangulation::VERTEX)
+        {
+          vertices[c.index] = c.vertex;
+          dummy_points.erase(vertices[c.index]);
+        }
+      else
+        {
+          vertices[c.index] = insert(points[c.index], c.lt, c.loc, c.li);
+          progress = true;
+        }
+    }
+
+  for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+      for (std::size_t j = 0; j < candidates[i].cells.size(); j++)
+        grid.unlock(candidates[i].cells[j]);
+    }
+  CGAL_expensive_assertion(grid.check_if_all_cells_are_unlocked());
+
+  // the first point that could not be locked is inserted anyway if
+  // nothing else was, so that every batch makes progress
+  for (std::size_t i = 0; i < candidates.size(); i++)
+    {
+      Point_candidate &c = candidates[i];
+      if (c.locked) continue;
+      if (!progress)
+        {
+          Face_handle loc = locate(points[c.index], c.lt, c.li, c.hint->face());
+          if (c.lt == Triangulation::VERTEX)
+            {
+              vertices[c.index] = loc->vertex(c.li);
+              dummy_points.erase(vertices[c.index]);
+            }
+          else
+            {
+              vertices[c.index] = insert(points[c.index], c.lt, loc, c.li);
+            }
+          progress = true;
+        }
+      else
+        {
+          deferred.push_back(c.index);
+        }
+    }
+}
+#endif
+
 template < class Gt, class Tds >
 void
 Periodic_2_Delaunay_triangulation_2<Gt, Tds>::
@@ -28,6 +28,7 @@
 #include <algorithm>
 #include <utility>
 #include <iostream>
+#include <cmath>
 
 #include <CGAL/iterator.h>
 #include <CGAL/Iterator_project.h>
@@ -383,6 +384,13 @@ public:
   /// Checks whether the triangulation is a valid simplicial complex in the one cover.
   bool is_triangulation_in_1_sheet() const;
 
+  /// Checks whether the Delaunay triangulation of the points is sure to be
+  /// a valid simplicial complex in the one cover, before it is built.
+  /// Uses the edge-length-criterion with a bound on the empty circles
+  /// given by a grid whose cells all hold a point.
+  template<class InputIterator>
+  bool is_1_cover_guaranteed(InputIterator first, InputIterator last) const;
+
   /// Convert a 9 sheeted cover (used for sparse triangulations) to a single sheeted cover.
   /// \pre !is_1_cover();
   void convert_to_1_sheeted_covering();
@@ -4279,6 +4287,37 @@ inline bool Periodic_2_triangulation_2<GT, Tds>::is_extensible_triangulation_in_
   return true;
 }
 
+template<class GT, class Tds>
+template<class InputIterator>
+bool Periodic_2_triangulation_2<GT, Tds>::is_1_cover_guaranteed(
+  InputIterator first, InputIterator last) const
+{
+  // An empty circle contains no cell of a grid whose cells of side s all
+  // hold a point, so its radius is at most sqrt(2)*s, and a Delaunay edge,
+  // a chord of such a circle, is at most 2*sqrt(2)*s long. The grid is the
+  // coarsest one for which this is below the edge length threshold.
+  double width = to_double(_domain.xmax() - _domain.xmin());
+  double threshold = to_double(_edge_length_threshold);
+  int n = static_cast<int>(std::sqrt(8 * width * width / threshold)) + 1;
+  double resolution = n / width;
+
+  std::vector<bool> occupied(n * n, false);
+  int empty_cells = n * n;
+  for (; first != last && empty_cells != 0; ++first)
+    {
+      int ix = static_cast<int>((to_double(first->x()) - to_double(_domain.xmin())) * resolution);
+      int iy = static_cast<int>((to_double(first->y()) - to_double(_domain.ymin())) * resolution);
+      ix = (std::max)(0, (std::min)(ix, n - 1));
+      iy = (std::max)(0, (std::min)(iy, n - 1));
+      if (!occupied[iy * n + ix])
+        {
+          occupied[iy * n + ix] = true;
+          --empty_cells;
+        }
+    }
+  return empty_cells == 0;
+}
+
 template<class GT, class Tds>
 inline bool Periodic_2_triangulation_2<GT, Tds>::is_triangulation_in_1_sheet() const
 {
@@ -33,6 +33,25 @@
 #include <CGAL/Periodic_3_triangulation_remove_traits_3.h>
 #include <CGAL/Delaunay_triangulation_3.h>
 
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <cmath>
+#  include <CGAL/Spatial_owner_lock_grid_3.h>
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+// Number of points whose conflict regions are computed together by
+// Periodic_3_Delaunay_triangulation_3::insert(first, last, Parallel_tag).
+#ifndef CGAL_PERIODIC_3_PARALLEL_BATCH_SIZE
+#  define CGAL_PERIODIC_3_PARALLEL_BATCH_SIZE 1024
+#endif
+
+// Minimal resolution of the lock grid of the parallel insertion; the grid
+// gets finer with the number of points.
+#ifndef CGAL_PERIODIC_3_LOCK_GRID_CELLS_PER_AXIS
+#  define CGAL_PERIODIC_3_LOCK_GRID_CELLS_PER_AXIS 32
+#endif
+
 namespace CGAL {
 
 template < class Gt,
@@ -193,6 +212,11 @@ public:
     if (n!=0) is_large_point_set = false;
 
     std::vector<Point> points(first, last);
+    // The dummy points are always safe if the points give a 1-cover, and
+    // they skip the 27-sheeted covering.
+    if (n==0 && !is_large_point_set)
+      is_large_point_set = this->is_1_cover_guaranteed(points.begin(),
+	  points.end());
     std::random_shuffle (points.begin(), points.end());
     Cell_handle hint;
     std::vector<Vertex_handle> dummy_points, double_vertices;
@@ -215,23 +239,27 @@ public:
     double_vertices = Base::insert_in_conflict(
 	points.begin(),points.end(),hint,tester,hider); 
    
-    if (is_large_point_set) {
-      typedef CGAL::Periodic_3_triangulation_remove_traits_3< Gt > P3removeT;
-      typedef CGAL::Delaunay_triangulation_3< P3removeT > DT;
-      typedef Vertex_remover< DT > Remover;
-      P3removeT remove_traits(domain());
-      DT dt(remove_traits);
-      Remover remover(this,dt);
-      Conflict_tester t(this);
-      for (unsigned int i=0; i<dummy_points.size(); i++) {
-	if (std::find(double_vertices.begin(), double_vertices.end(),
-		dummy_points[i]) == double_vertices.end())
-	  Base::remove(dummy_points[i],remover,t);
-      }
-    }
+    if (is_large_point_set)
+      remove_dummy_points(dummy_points, double_vertices);
 
     return number_of_vertices() - n;
   }
+
+  /// Inserts the points with several threads when CGAL is linked with
+  /// TBB. This is done only in an empty triangulation, for points that are
+  /// sure to give a 1-cover (see is_1_cover_guaranteed()); other points
+  /// are inserted by insert(first, last).
+  template < class InputIterator >
+  std::ptrdiff_t insert(InputIterator first, InputIterator last,
+      Parallel_tag) {
+    size_type n = number_of_vertices();
+    std::vector<Point> points(first, last);
+    if (n!=0 || !this->is_1_cover_guaranteed(points.begin(), points.end()))
+      return insert(points.begin(), points.end());
+
+    insert_in_parallel(points);
+    return number_of_vertices() - n;
+  }
   //@}
 
   /** @name Point moving */ //@{
@@ -640,6 +668,62 @@ protected:
 private:
   class Point_hider;
 
+  /** @name Insertion helpers */ //@{
+  // removes the dummy points but those that are also input points
+  void remove_dummy_points(const std::vector<Vertex_handle> &dummy_points,
+      const std::vector<Vertex_handle> &double_vertices);
+
+  void insert_in_parallel(std::vector<Point> &points);
+
+#ifdef CGAL_LINKED_WITH_TBB
+  // A point of the parallel insertion, located from the vertex hint. The
+  // region holds its cells in conflict, with the offset of the point in
+  // each, and cells those of their vertices in the lock grid.
+  struct Point_candidate {
+    std::ptrdiff_t    index;
+    Vertex_handle     hint;
+    Cell_handle       loc;
+    Locate_type       lt;
+    int               li, lj;
+    Vertex_handle     vertex;
+    std::vector<std::pair<Cell_handle, Offset> >  region;
+    std::vector<int>  cells;
+    bool              locked;
+  };
+
+  void compute_point_candidate(Point_candidate &c, const Point &p,
+      unsigned int owner, Spatial_owner_lock_grid_3 &grid) const;
+
+  void process_point_batch(std::vector<Point_candidate> &candidates,
+      const std::vector<Point> &points, Spatial_owner_lock_grid_3 &grid,
+      std::vector<std::ptrdiff_t> &deferred,
+      std::vector<Vertex_handle> &vertices,
+      std::vector<Vertex_handle> &double_vertices);
+
+  // functor of the parallel_for of process_point_batch()
+  class Compute_point_candidates {
+    const Self &m_tr;
+    std::vector<Point_candidate> &m_candidates;
+    const std::vector<Point> &m_points;
+    Spatial_owner_lock_grid_3 &m_grid;
+
+  public:
+    Compute_point_candidates(const Self &tr,
+	std::vector<Point_candidate> &candidates,
+	const std::vector<Point> &points, Spatial_owner_lock_grid_3 &grid)
+      : m_tr(tr), m_candidates(candidates), m_points(points), m_grid(grid)
+    {}
+
+    void operator()(const tbb::blocked_range<std::size_t> &r) const {
+      for (std::size_t i = r.begin(); i != r.end(); ++i)
+	m_tr.compute_point_candidate(m_candidates[i],
+	    m_points[m_candidates[i].index],
+	    static_cast<unsigned int>(i + 1), m_grid);
+    }
+  };
+#endif
+  //@}
+
 #ifndef CGAL_CFG_OUTOFLINE_TEMPLATE_MEMBER_DEFINITION_BUG
   template <class TriangulationR3> struct Vertex_remover;
 #else
@@ -827,6 +911,231 @@ void Periodic_3_Delaunay_triangulation_3<Gt,Tds>::remove(Vertex_handle v)
   CGAL_triangulation_expensive_assertion(is_valid());
 }
 
+template < class Gt, class Tds >
+void Periodic_3_Delaunay_triangulation_3<Gt,Tds>::remove_dummy_points(
+    const std::vector<Vertex_handle> &dummy_points,
+    const std::vector<Vertex_handle> &double_vertices) {
+  typedef CGAL::Periodic_3_triangulation_remove_traits_3< Gt > P3removeT;
+  typedef CGAL::Delaunay_triangulation_3< P3removeT > DT;
+  typedef Vertex_remover< DT > Remover;
+  P3removeT remove_traits(domain());
+  DT dt(remove_traits);
+  Remover remover(this,dt);
+  Conflict_tester t(this);
+  for (unsigned int i=0; i<dummy_points.size(); i++) {
+    if (std::find(double_vertices.begin(), double_vertices.end(),
+	    dummy_points[i]) == double_vertices.end())
+      Base::remove(dummy_points[i],remover,t);
+  }
+}
+
+// The parallel insertion starts from the dummy points, so it works in the
+// 1-cover from the start, and it goes by passes over the points sorted
+// along a Hilbert curve. Every k-th point is inserted first, one by one,
+// and the others follow by rounds that halve the gaps between them, each
+// round cut into batches of up to CGAL_PERIODIC_3_PARALLEL_BATCH_SIZE
+// points spread over the domain. The points of a batch are located, and
+// their conflict regions computed, concurrently on the unmodified
+// triangulation; each region locks the cells of a lock grid over the
+// domain that hold its vertices. Two regions without a common vertex do
+// not change each other, so the points whose regions got all their cells
+// are then inserted one after the other at the place where they were
+// located. The others wait for the next pass. As in insert(first, last),
+// the dummy points are removed at the end.
+template < class Gt, class Tds >
+void Periodic_3_Delaunay_triangulation_3<Gt,Tds>::insert_in_parallel(
+    std::vector<Point> &points) {
+  CGAL_triangulation_precondition(number_of_vertices() == 0);
+
+  std::vector<Vertex_handle> dummy_points = insert_dummy_points();
+  std::vector<Vertex_handle> double_vertices;
+
+  spatial_sort(points.begin(), points.end(), typename Geom_traits::K());
+
+  std::ptrdiff_t m = static_cast<std::ptrdiff_t>(points.size());
+  std::ptrdiff_t stride = (std::max)(m / CGAL_PERIODIC_3_PARALLEL_BATCH_SIZE,
+      std::ptrdiff_t(1));
+#ifndef CGAL_LINKED_WITH_TBB
+  stride = 1;
+#endif
+
+  // the vertices by position in the Hilbert order
+  std::vector<Vertex_handle> vertices(m);
+
+  Cell_handle c;
+  Locate_type lt;
+  int li, lj;
+  for (std::ptrdiff_t i = 0; i < m; i += stride) {
+    c = locate(points[i], lt, li, lj, c);
+    if (lt == Base::VERTEX) {
+      vertices[i] = c->vertex(li);
+      double_vertices.push_back(vertices[i]);
+    } else {
+      vertices[i] = insert(points[i], lt, c, li, lj);
+    }
+    c = vertices[i]->cell();
+  }
+
+#ifdef CGAL_LINKED_WITH_TBB
+  if (stride > 1) {
+    int cells_per_axis = (std::max)(
+	2 * static_cast<int>(std::pow(static_cast<double>(m), 1./3.)),
+	int(CGAL_PERIODIC_3_LOCK_GRID_CELLS_PER_AXIS));
+    Spatial_owner_lock_grid_3 grid(domain().bbox(), cells_per_axis);
+
+    // round r inserts the points whose offset o from the sample before
+    // them has its lowest set bit at r, from the highest round down, so
+    // that the point at o - 2^r is already in
+    std::ptrdiff_t step = 1;
+    while (2 * step < stride) step *= 2;
+
+    std::vector<std::ptrdiff_t> pending, deferred;
+    std::vector<Point_candidate> candidates;
+    for (; step > 0; step /= 2) {
+      pending.clear();
+      for (std::ptrdiff_t i = 0; i < m; i++) {
+	std::ptrdiff_t o = i % stride;
+	if (o != 0 && (o & -o) == step) pending.push_back(i);
+      }
+
+      while (!pending.empty()) {
+	// a batch much smaller than the triangulation, lest the regions
+	// of the first rounds all meet
+	std::size_t n = pending.size();
+	std::size_t size = (std::min)(
+	    std::size_t(CGAL_PERIODIC_3_PARALLEL_BATCH_SIZE),
+	    std::size_t(number_of_vertices() / 256 + 1));
+	std::size_t batches = (n + size - 1) / size;
+	deferred.clear();
+	for (std::size_t b = 0; b < batches; b++) {
+	  candidates.resize((n - b + batches - 1) / batches);
+	  std::size_t k = 0;
+	  for (std::size_t i = b; i < n; i += batches, k++) {
+	    candidates[k].index = pending[i];
+	    candidates[k].hint = vertices[pending[i] - step];
+	  }
+	  process_point_batch(candidates, points, grid, deferred,
+	      vertices, double_vertices);
+	}
+	pending.swap(deferred);
+      }
+    }
+  }
+#endif
+
+  remove_dummy_points(dummy_points, double_vertices);
+  CGAL_triangulation_postcondition(is_1_cover());
+}
+
+#ifdef CGAL_LINKED_WITH_TBB
+// Locates c, finds its conflict region and locks the cells of the
+// vertices of the region for owner (> 0). Only reads the triangulation:
+// the region is walked as in find_conflicts(), the offset of p carried
+// from cell to cell, but without marking the cells.
+template < class Gt, class Tds >
+void Periodic_3_Delaunay_triangulation_3<Gt,Tds>::compute_point_candidate(
+    Point_candidate &c, const Point &p, unsigned int owner,
+    Spatial_owner_lock_grid_3 &grid) const {
+  c.locked = false;
+  c.region.clear();
+  c.cells.clear();
+  c.loc = locate(p, c.lt, c.li, c.lj, c.hint->cell());
+  if (c.lt == Base::VERTEX) {
+    // nothing to insert; keeps the vertex, as c.loc may be destroyed by
+    // the insertions of the batch that come first
+    c.vertex = c.loc->vertex(c.li);
+    c.locked = true;
+    return;
+  }
+
+  Conflict_tester tester(p, this);
+  std::vector<Cell_handle> visited(1, c.loc);
+  c.region.push_back(std::make_pair(c.loc,
+	  get_location_offset(tester, c.loc)));
+  for (std::size_t k=0; k<c.region.size(); k++) {
+    Cell_handle ch = c.region[k].first;
+    Offset off = c.region[k].second;
+    for (int j=0; j<4; j++)
+      c.cells.push_back(grid.get_grid_index(ch->vertex(j)->point()));
+
+    for (int j=0; j<4; j++) {
+      Cell_handle nb = ch->neighbor(j);
+      if (std::find(visited.begin(), visited.end(), nb) != visited.end())
+	continue;
+      visited.push_back(nb);
+      Offset o_nb = off + get_neighbor_offset(ch, j, nb);
+      if (tester(nb, o_nb))
+	c.region.push_back(std::make_pair(nb, o_nb));
+    }
+  }
+
+  std::sort(c.cells.begin(), c.cells.end());
+  c.cells.erase(std::unique(c.cells.begin(), c.cells.end()), c.cells.end());
+
+  for (std::size_t i=0; i<c.cells.size(); i++) {
+    if (!grid.try_lock(c.cells[i], owner)) {
+      for (std::size_t j=0; j<i; j++)
+	grid.unlock(c.cells[j]);
+      c.cells.clear();
+      return;
+    }
+  }
+  c.locked = true;
+}
+
+// vertices[c.index] gets the vertex of the point of c
+template < class Gt, class Tds >
+void Periodic_3_Delaunay_triangulation_3<Gt,Tds>::process_point_batch(
+    std::vector<Point_candidate> &candidates,
+    const std::vector<Point> &points, Spatial_owner_lock_grid_3 &grid,
+    std::vector<std::ptrdiff_t> &deferred,
+    std::vector<Vertex_handle> &vertices,
+    std::vector<Vertex_handle> &double_vertices) {
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, candidates.size()),
+      Compute_point_candidates(*this, candidates, points, grid));
+
+  bool progress = false;
+  for (std::size_t i=0; i<candidates.size(); i++) {
+    Point_candidate &c = candidates[i];
+    if (!c.locked) continue;
+    if (c.lt == Base::VERTEX) {
+      vertices[c.index] = c.vertex;
+      double_vertices.push_back(vertices[c.index]);
+    } else {
+      vertices[c.index] = Base::insert_in_conflict_region(points[c.index],
+	  c.region);
+      progress = true;
+    }
+  }
+
+  for (std::size_t i=0; i<candidates.size(); i++)
+    for (std::size_t j=0; j<candidates[i].cells.size(); j++)
+      grid.unlock(candidates[i].cells[j]);
+  CGAL_triangulation_expensive_assertion(
+      grid.check_if_all_cells_are_unlocked());
+
+  // the first point that could not be locked is inserted anyway if
+  // nothing else was, so that every batch makes progress
+  for (std::size_t i=0; i<candidates.size(); i++) {
+    Point_candidate &c = candidates[i];
+    if (c.locked) continue;
+    if (progress) {
+      deferred.push_back(c.index);
+      continue;
+    }
+    Cell_handle loc = locate(points[c.index], c.lt, c.li, c.lj,
+	c.hint->cell());
+    if (c.lt == Base::VERTEX) {
+      vertices[c.index] = loc->vertex(c.li);
+      double_vertices.push_back(vertices[c.index]);
+    } else {
+      vertices[c.index] = insert(points[c.index], c.lt, loc, c.li, c.lj);
+    }
+    progress = true;
+  }
+}
+#endif
+
 template < class Gt, class Tds >
 template <class OutputIteratorBoundaryFacets, class OutputIteratorCells,
           class OutputIteratorInternalFacets>
@@ -351,6 +351,10 @@ public:
   bool is_extensible_triangulation_in_1_sheet_h1() const;
   bool is_extensible_triangulation_in_1_sheet_h2() const;
   bool is_triangulation_in_1_sheet() const;
+  // Checks before the triangulation is built whether the Delaunay
+  // triangulation of [first, last) is sure to be in the 1-cover.
+  template <class InputIterator>
+  bool is_1_cover_guaranteed(InputIterator first, InputIterator last) const;
 
   void convert_to_1_sheeted_covering();
   void convert_to_27_sheeted_covering();
@@ -955,6 +959,10 @@ private:
       Cell_handle c, const Conflict_tester &tester,
       Point_hider &hider, Vertex_handle vh = Vertex_handle());
 
+  // Sets the offsets of the cells incident to the new vertex v, nbs, from
+  // those of their vertices, and clears the latter.
+  void set_offsets_of_star(Vertex_handle v, std::vector<Cell_handle> &nbs);
+
   template <class Point_iterator, class Offset_iterator>
   void periodic_sort(Point_iterator /*p_begin*/, Point_iterator /*p_end*/,
                      Offset_iterator /*o_begin*/, Offset_iterator /*o_end*/) const {
@@ -1005,6 +1013,12 @@ protected:
     Cell_handle c, int li, int lj, const Conflict_tester &tester,
     Point_hider &hider);
 
+  // Inserts p in the 1-cover in the hole of the cells in conflict with
+  // it, found beforehand with the offset of p in each of them: the
+  // conflict region is not searched, the region given is trusted.
+  Vertex_handle insert_in_conflict_region(const Point & p,
+      const std::vector<std::pair<Cell_handle, Offset> > &region);
+
   template < class InputIterator, class Conflict_tester,
       class Point_hider>
   std::vector<Vertex_handle> insert_in_conflict(
@@ -1537,6 +1551,40 @@ is_extensible_triangulation_in_1_sheet_h2() const {
   return true;
 }
 
+// An empty sphere contains no cell of a grid whose cubes of side s all
+// hold a point, so its radius is at most sqrt(3)*s and the square of a
+// Delaunay edge, a chord of it, at most 12*s^2. The grid is the coarsest
+// one for which this is below edge_length_threshold.
+template < class GT, class TDS >
+template < class InputIterator >
+bool
+Periodic_3_triangulation_3<GT,TDS>::
+is_1_cover_guaranteed(InputIterator first, InputIterator last) const {
+  double width = to_double(_domain.xmax()-_domain.xmin());
+  double threshold = to_double(edge_length_threshold);
+  int n = static_cast<int>(std::sqrt(12*width*width/threshold)) + 1;
+  double resolution = n/width;
+
+  std::vector<bool> occupied(n*n*n, false);
+  int empty_cells = n*n*n;
+  for (; first != last && empty_cells != 0; ++first) {
+    int ix = static_cast<int>(
+	(to_double(first->x())-to_double(_domain.xmin()))*resolution);
+    int iy = static_cast<int>(
+	(to_double(first->y())-to_double(_domain.ymin()))*resolution);
+    int iz = static_cast<int>(
+	(to_double(first->z())-to_double(_domain.zmin()))*resolution);
+    ix = (std::max)(0, (std::min)(ix, n-1));
+    iy = (std::max)(0, (std::min)(iy, n-1));
+    iz = (std::max)(0, (std::min)(iz, n-1));
+    if (!occupied[(iz*n+iy)*n+ix]) {
+      occupied[(iz*n+iy)*n+ix] = true;
+      --empty_cells;
+    }
+  }
+  return empty_cells == 0;
+}
+
 template < class GT, class TDS >
 inline bool
 Periodic_3_triangulation_3<GT,TDS>::
@@ -2213,11 +2261,31 @@ Periodic_3_triangulation_3<GT,TDS>::periodic_insert(
       facet.first, facet.second);
   v->set_point(p);
 
+  std::vector<Cell_handle> nbs;
+  set_offsets_of_star(v, nbs);
+
+  if (vh != Vertex_handle()) {
+    virtual_vertices[v] = Virtual_vertex(vh,o);
+    virtual_vertices_reverse[vh].push_back(v);
+  }
+
+  if (!is_1_cover())
+    insert_too_long_edges(v, nbs.begin(), nbs.end());
+
+  // Store the hidden points in their new cells.
+  hider.reinsert_vertices(v);
+  return v;
+}
+
+template < class GT, class TDS >
+inline void
+Periodic_3_triangulation_3<GT,TDS>::set_offsets_of_star(
+    Vertex_handle v, std::vector<Cell_handle> &nbs)
+{
   //TODO: this could be done within the _insert_in_hole without losing any
   //time because each cell is visited in any case.
   //- Do timings to argue to modify _insert_in_conflicts if need be
   //- Find the modified _insert_in_hole in the branch svn history of TDS
-  std::vector<Cell_handle> nbs;
   incident_cells(v, std::back_inserter(nbs));
   // For all neighbors of the newly added vertex v: fetch their offsets from
   // the tester and reset them in the triangulation data structure.
@@ -2235,17 +2303,54 @@ Periodic_3_triangulation_3<GT,TDS>::periodic_insert(
     (*voit)->clear_offset();
   }
   v_offsets.clear();
+}
 
-  if (vh != Vertex_handle()) {
-    virtual_vertices[v] = Virtual_vertex(vh,o);
-    virtual_vertices_reverse[vh].push_back(v);
+/** Inserts p into the 1-cover, the cells in conflict with p being given.
+ *
+ * Implementation: as in periodic_insert, without find_conflicts. The
+ * cells of the region are marked in conflict, and each facet between one
+ * of them and a cell out of it sets the offsets of its vertices as seen
+ * from p. The boundary cells are not marked; _insert_in_hole only needs
+ * to tell them from those in conflict.
+ */
+template < class GT, class TDS >
+typename Periodic_3_triangulation_3<GT,TDS>::Vertex_handle
+Periodic_3_triangulation_3<GT,TDS>::insert_in_conflict_region(
+    const Point & p,
+    const std::vector<std::pair<Cell_handle, Offset> > &region)
+{
+  CGAL_triangulation_precondition(is_1_cover());
+  CGAL_triangulation_precondition(!region.empty());
+
+  std::vector<Cell_handle> cells;
+  cells.reserve(region.size());
+  for (std::size_t i=0; i<region.size(); i++) {
+    region[i].first->tds_data().mark_in_conflict();
+    cells.push_back(region[i].first);
   }
 
-  if (!is_1_cover())
-    insert_too_long_edges(v, nbs.begin(), nbs.end());
+  Facet facet;
+  for (std::size_t k=0; k<region.size(); k++) {
+    Cell_handle c = region[k].first;
+    for (int i=0; i<4; i++) {
+      if (c->neighbor(i)->tds_data().is_in_conflict()) continue;
+      facet = Facet(c, i);
+      for (int j=0; j<4; j++) {
+	if (j==i) continue;
+	if (!c->vertex(j)->get_offset_flag()) {
+	  c->vertex(j)->set_offset(int_to_off(c->offset(j))-region[k].second);
+	  v_offsets.push_back(c->vertex(j));
+	}
+      }
+    }
+  }
 
-  // Store the hidden points in their new cells.
-  hider.reinsert_vertices(v);
+  Vertex_handle v = _tds._insert_in_hole(cells.begin(), cells.end(),
+      facet.first, facet.second);
+  v->set_point(p);
+
+  std::vector<Cell_handle> nbs;
+  set_offsets_of_star(v, nbs);
   return v;
 }
 
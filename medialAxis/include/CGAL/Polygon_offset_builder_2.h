@@ -21,14 +21,21 @@
 
 #include <vector>
 #include <algorithm>
+#include <functional>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <CGAL/tags.h>
 #include <CGAL/Straight_skeleton_2/Straight_skeleton_aux.h>
 
 #include <CGAL/Polygon_offset_builder_traits_2.h>
 
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
 namespace CGAL {
 
 template<class Traits_, class SSkel_>
@@ -86,6 +93,26 @@ public :
   template<class OutputIterator>
   OutputIterator construct_offset_contours( FT aTime, OutputIterator aOut ) ;
 
+  // Constructs the offset contours at each of the times in [aTimesBegin,aTimesEnd), which must be positive and
+  // sorted in increasing order. The contours at the i-th time are appended to aOut[i], which can be for instance
+  // a std::vector<ContainerPtr>. They are the same as those of construct_offset_contours(aTime,...) for each time,
+  // but each skeleton node is compared against all the times at once by a binary search, so tracing the levels
+  // evaluates no predicate, and faces that collapsed before a time are not searched for seeds at that time.
+  // With Parallel_tag (and TBB) the nodes and then the levels are split among threads, which call the visitor concurrently.
+  template<class InputIterator, class RandomAccessIterator>
+  RandomAccessIterator construct_offset_contours( InputIterator        aTimesBegin
+                                                , InputIterator        aTimesEnd
+                                                , RandomAccessIterator aOut
+                                                , Sequential_tag       = Sequential_tag()
+                                                ) ;
+
+  template<class InputIterator, class RandomAccessIterator>
+  RandomAccessIterator construct_offset_contours( InputIterator        aTimesBegin
+                                                , InputIterator        aTimesEnd
+                                                , RandomAccessIterator aOut
+                                                , Parallel_tag
+                                                ) ;
+
   struct Bisector_data
   {
     Bisector_data() : IsVisited(false), IsUsedSeed(false) {}
@@ -94,14 +121,26 @@ public :
     bool IsUsedSeed ;
   } ;
   
+  // The place of a skeleton node among the times of a batch
+  struct Node_levels
+  {
+    Node_levels() : Lo(0), Hi(0) {}
+    
+    int Lo ; // The number of times smaller than the node's event time
+    int Hi ; // The number of times not larger than it
+  } ;
+  
 private:
 
+  typedef Polygon_offset_builder_2<Ss_,Traits_,Container_,Visitor_> Self ;
+  
   typedef typename Ss::Vertex                Vertex ;
   typedef typename Ss::Halfedge_handle       Halfedge_handle  ;
   typedef typename Ss::Halfedge_const_handle Halfedge_const_handle  ;
   typedef typename Ss::Vertex_const_handle   Vertex_const_handle  ;
   
   typedef std::vector<Halfedge_const_handle> Halfedge_vector ;
+  typedef std::vector<Vertex_const_handle>   Vertex_vector ;
 
   typedef typename Traits::Segment_2        Segment_2 ;
   typedef typename Traits::Trisegment_2     Trisegment_2 ;
@@ -125,8 +164,63 @@ private:
 
   Halfedge_const_handle LocateSeed( FT aTime, Halfedge_const_handle aBorder ) ;
   
+  Halfedge_const_handle LocateSeed( FT aTime, Halfedge_const_handle aBorder, bool& rNoHook ) ;
+  
   Halfedge_const_handle LocateSeed( FT aTime ) ;
 
+  template<class InputIterator>
+  void SetupLevels( InputIterator aTimesBegin, InputIterator aTimesEnd ) ;
+  
+  void ClassifyNode( std::size_t aIdx ) ;
+  
+  void ClassifyNodes( Sequential_tag ) ;
+  
+  void ClassifyNodes( Parallel_tag ) ;
+  
+  void SetupBorderLevels() ;
+  
+  template<class RandomAccessIterator>
+  void TraceLevels( std::size_t aBegin, std::size_t aEnd, RandomAccessIterator aOut ) ;
+  
+  void ClearLevels() ;
+  
+#ifdef CGAL_LINKED_WITH_TBB
+  // functor of the parallel_for of ClassifyNodes(Parallel_tag)
+  class Classify_nodes
+  {
+    Self& mBuilder ;
+    
+  public:
+  
+    Classify_nodes( Self& aBuilder ) : mBuilder(aBuilder) {}
+    
+    void operator() ( tbb::blocked_range<std::size_t> const& aRange ) const
+    {
+      for ( std::size_t i = aRange.begin() ; i != aRange.end() ; ++ i )
+        mBuilder.ClassifyNode(i);
+    }
+  } ;
+  
+  // functor of the parallel_for of construct_offset_contours(...,Parallel_tag). Each range of levels is traced
+  // by its own copy of the builder since the bisector marks and the trisegments are not shared between threads.
+  template<class RandomAccessIterator>
+  class Trace_levels
+  {
+    Self const&          mBuilder ;
+    RandomAccessIterator mOut ;
+    
+  public:
+  
+    Trace_levels( Self const& aBuilder, RandomAccessIterator aOut ) : mBuilder(aBuilder), mOut(aOut) {}
+    
+    void operator() ( tbb::blocked_range<std::size_t> const& aRange ) const
+    {
+      Self lBuilder(mBuilder) ;
+      lBuilder.TraceLevels(aRange.begin(),aRange.end(),mOut);
+    }
+  } ;
+#endif
+
   Bisector_data const& GetBisectorData ( Halfedge_const_handle aBisector ) const { return mBisectorData[aBisector->id()] ; }
   Bisector_data&       GetBisectorData ( Halfedge_const_handle aBisector )       { return mBisectorData[aBisector->id()] ; }
     
@@ -180,6 +274,13 @@ private:
   {
     CGAL_precondition( aNode->is_skeleton() ) ;
     
+    // While tracing a batch the node was already compared against aT (see ClassifyNode())
+    if ( mLevel >= 0 )
+    {
+      Node_levels const& lL = mNodeLevels[aNode->id()] ;
+      return mLevel < lL.Lo ? SMALLER : ( mLevel < lL.Hi ? EQUAL : LARGER ) ;
+    }
+    
     Comparison_result r = aNode->has_infinite_time() ? SMALLER
                                                      : static_cast<Comparison_result>(Compare_offset_against_event_time_2(mTraits)(aT,CreateTrisegment(aNode)));
     
@@ -242,8 +343,17 @@ private:
   Traits const&              mTraits ;
   Visitor const&             mVisitor ;
   Halfedge_vector            mBorders ;
+  Vertex_vector              mNodes ; // The skeleton nodes
   std::vector<Bisector_data> mBisectorData;
   OptionalPoint_2            mLastPoint ; 
+  
+  // Batch of times, see construct_offset_contours(aTimesBegin,aTimesEnd,...)
+  std::vector<FT>          mTimes ;
+  std::vector<Node_levels> mNodeLevels ;    // By vertex ID
+  std::vector<int>         mBorderLevels ;  // For each border, the number of times its face does not collapse before
+  std::vector<int>         mActiveBorders ; // Those of the borders whose faces are still there at the current time
+  std::vector<int>         mSeedBorders ;   // Those of them which may still hold a seed, see LocateSeed()
+  int                      mLevel ;         // Index of the current time in the batch, -1 outside of a batch
   CGAL_POLYOFFSET_DEBUG_CODE( int mStepID ; )
 };
 
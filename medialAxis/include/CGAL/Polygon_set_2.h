@@ -136,6 +136,12 @@ public:
     Base::join(begin, end);
   }
 
+  template <class InputIterator>
+  inline void join(InputIterator begin, InputIterator end, Parallel_tag tag)
+  {
+    Base::join(begin, end, tag);
+  }
+
   template <class InputIterator1, class InputIterator2>
   inline void join(InputIterator1 begin1, InputIterator1 end1,
                    InputIterator2 begin2, InputIterator2 end2)
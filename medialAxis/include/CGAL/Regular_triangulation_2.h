@@ -302,6 +302,21 @@ public:
   void remove_degree_3(Vertex_handle v, 
 		       Face_handle f = Face_handle());
   void remove(Vertex_handle v);
+  // Removes the vertices (hidden or not) of [first, beyond) in Hilbert
+  // order and returns how many were removed. There is no rebuild as in
+  // Delaunay_triangulation_2: the hidden vertices would have to be
+  // distributed again.
+  template < class InputIterator >
+  size_type remove(InputIterator first, InputIterator beyond)
+  {
+    size_type n = number_of_vertices() + number_of_hidden_vertices();
+    std::vector<Vertex_handle> vertices;
+    this->sorted_vertices(first, beyond, vertices);
+    this->spatial_sort_vertices(vertices);
+    for (std::size_t i = 0; i < vertices.size(); ++i)
+      remove(vertices[i]);
+    return n - number_of_vertices() - number_of_hidden_vertices();
+  }
 
   All_vertices_iterator all_vertices_begin () const;
   All_vertices_iterator all_vertices_end () const;
@@ -318,8 +333,13 @@ public:
 
 public:
   void clear();
+  void reset();
   void copy_triangulation(const Self& tr);
 private:
+  //made private as the Triangulation_2 versions lose the weights and the
+  //hidden vertices
+  void binary_output(std::ostream& os) const;
+  bool binary_input(std::istream& is, bool check = false);
   void copy_triangulation_();
   Vertex_handle reinsert(Vertex_handle v, Face_handle start);
   void regularize(Vertex_handle v);
@@ -683,6 +703,15 @@ clear()
   _hidden_vertices = 0;
 }
 
+template < class Gt, class Tds >
+void
+Regular_triangulation_2<Gt,Tds>::
+reset()
+{
+  Base::reset();
+  _hidden_vertices = 0;
+}
+
 template < class Gt, class Tds >
 void
 Regular_triangulation_2<Gt,Tds>::
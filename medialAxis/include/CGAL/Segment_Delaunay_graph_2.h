@@ -52,6 +52,26 @@
 
 #include <boost/iterator/counting_iterator.hpp>
 
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <cmath>
+#  include <CGAL/Spatial_lock_grid_2.h>
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+// Number of sites whose conflict regions are computed together by
+// Segment_Delaunay_graph_2::insert_segments(..., Parallel_tag) and
+// insert_points(..., Parallel_tag).
+#ifndef CGAL_SDG_PARALLEL_BATCH_SIZE
+#  define CGAL_SDG_PARALLEL_BATCH_SIZE 1024
+#endif
+
+// Minimal resolution of the lock grid of the parallel insertion; the grid
+// gets finer with the number of sites.
+#ifndef CGAL_SDG_LOCK_GRID_CELLS_PER_AXIS
+#  define CGAL_SDG_LOCK_GRID_CELLS_PER_AXIS 128
+#endif
+
 /*
   Conventions:
   ------------
@@ -293,6 +313,9 @@ protected:
 
   typedef std::pair<Face_handle,Face_handle>    Face_pair;
 
+  typedef std::pair<Vertex_handle,Vertex_handle>  Vertex_pair;
+  typedef std::vector<Vertex_pair>                Vertex_pair_vector;
+
   typedef typename Storage_traits::Storage_site_2   Storage_site_2;
 
   // the edge list
@@ -521,27 +544,49 @@ public:
     return insert_points(points);
   }
 
-  template <class IndicesIterator>
-  std::size_t insert_segments( const std::vector<Point_2>& points,
-                               IndicesIterator indices_first,
-                               IndicesIterator indices_beyond )
+  std::size_t insert_points(std::vector<Point_2>& points, Sequential_tag)
+  {
+    return insert_points(points);
+  }
+
+  // Same diagram as the sequential insert_points(), but the conflict
+  // regions are computed by several threads when CGAL is linked with TBB:
+  // see insert_points_in_parallel().
+  std::size_t insert_points(std::vector<Point_2>& points, Parallel_tag)
+  {
+    size_type n = this->number_of_vertices();
+    std::vector<Vertex_handle> vertices;
+    insert_points_in_parallel(points, vertices);
+    return this->number_of_vertices() - n;
+  }
+
+  template <class PointIterator, class Concurrency_tag>
+  std::size_t insert_points(PointIterator first, PointIterator beyond,
+                            Concurrency_tag tag)
+  {
+    std::vector<Point_2> points (first, beyond);
+    return insert_points(points, tag);
+  }
+
+protected:
+  // inserts the points in spatial order; vertices[i] is the vertex of
+  // points[i]
+  void insert_segment_endpoints( const std::vector<Point_2>& points,
+                                 std::vector<Vertex_handle>& vertices )
   {
     typedef std::vector<std::ptrdiff_t> Vertex_indices;
-    typedef std::vector<Vertex_handle> Vertices;
 
     Vertex_indices vertex_indices;
-    vertex_indices.resize(points.size());
+    vertex_indices.reserve(points.size());
 
     std::copy(boost::counting_iterator<std::ptrdiff_t>(0),
               boost::counting_iterator<std::ptrdiff_t>(points.size()),
               std::back_inserter(vertex_indices));
 
-    size_type n = this->number_of_vertices();
     Spatial_sort_traits_adapter_2<Gt,const Point_2*> sort_traits(&(points[0]));
 
     spatial_sort(vertex_indices.begin(), vertex_indices.end(), sort_traits);
 
-    Vertices vertices;
     vertices.resize(points.size());
 
     Vertex_handle hint;
@@ -552,6 +597,21 @@ public:
       hint = insert(points[*it_pti], hint);
       vertices[*it_pti] = hint;
     }
+  }
+
+public:
+  template <class IndicesIterator>
+  std::size_t insert_segments( const std::vector<Point_2>& points,
+                               IndicesIterator indices_first,
+                               IndicesIterator indices_beyond )
+  {
+    typedef std::vector<Vertex_handle> Vertices;
+
+    size_type n = this->number_of_vertices();
+    if ( points.empty() ) { return 0; }
+
+    Vertices vertices;
+    insert_segment_endpoints(points, vertices);
 
     for(IndicesIterator it_cst=indices_first, end=indices_beyond;
         it_cst!=end; ++it_cst)
@@ -564,6 +624,46 @@ public:
     return this->number_of_vertices() - n;
   }
 
+  template <class IndicesIterator>
+  std::size_t insert_segments( const std::vector<Point_2>& points,
+                               IndicesIterator indices_first,
+                               IndicesIterator indices_beyond,
+                               Sequential_tag )
+  {
+    return insert_segments(points, indices_first, indices_beyond);
+  }
+
+  // Same diagram as the sequential insert_segments(), but the conflict
+  // regions of the points and then of the segments are computed by
+  // several threads when CGAL is linked with TBB: see
+  // insert_points_in_parallel() and insert_segments_in_parallel().
+  template <class IndicesIterator>
+  std::size_t insert_segments( const std::vector<Point_2>& points,
+                               IndicesIterator indices_first,
+                               IndicesIterator indices_beyond,
+                               Parallel_tag )
+  {
+    typedef std::vector<Vertex_handle> Vertices;
+
+    size_type n = this->number_of_vertices();
+    if ( points.empty() ) { return 0; }
+
+    Vertices vertices;
+    insert_points_in_parallel(points, vertices);
+
+    Vertex_pair_vector segments;
+    for(IndicesIterator it_cst=indices_first, end=indices_beyond;
+        it_cst!=end; ++it_cst)
+    {
+      Vertex_handle v1 = vertices[it_cst->first];
+      Vertex_handle v2 = vertices[it_cst->second];
+      if(v1 != v2) segments.push_back( Vertex_pair(v1, v2) );
+    }
+    insert_segments_in_parallel(segments);
+
+    return this->number_of_vertices() - n;
+  }
+
   template <class PointIterator, class IndicesIterator>
   std::size_t insert_segments(PointIterator points_first,
                               PointIterator points_beyond,
@@ -574,6 +674,17 @@ public:
     return insert_segments(points, indices_first, indices_beyond);
   }
 
+  template <class PointIterator, class IndicesIterator, class Concurrency_tag>
+  std::size_t insert_segments(PointIterator points_first,
+                              PointIterator points_beyond,
+                              IndicesIterator indices_first,
+                              IndicesIterator indices_beyond,
+                              Concurrency_tag tag)
+  {
+    std::vector<Point_2> points (points_first, points_beyond);
+    return insert_segments(points, indices_first, indices_beyond, tag);
+  }
+
   static const Point_2& get_source(const std::pair<Point_2, Point_2>& segment){
     return segment.first;
   }
@@ -600,6 +711,13 @@ public:
 
   template <class SegmentIterator>
   std::size_t insert_segments(SegmentIterator first, SegmentIterator beyond)
+  {
+    return insert_segments(first, beyond, Sequential_tag());
+  }
+
+  template <class SegmentIterator, class Concurrency_tag>
+  std::size_t insert_segments(SegmentIterator first, SegmentIterator beyond,
+                              Concurrency_tag tag)
   {
     std::vector<Point_2> points;
     for (SegmentIterator s_it=first; s_it!=beyond; ++s_it)
@@ -616,7 +734,7 @@ public:
 
     return insert_segments( points,
                             segment_indices.begin(),
-                            segment_indices.end() );
+                            segment_indices.end(), tag );
   }
 
   template <class Input_iterator>
@@ -1434,6 +1552,91 @@ protected:
 				     Face_map& fm);
 #endif
 
+protected:
+  // HELPER METHODS FOR THE PARALLEL INSERTION
+  //------------------------------------------
+  // the conflict region of a site, as expand_conflict_region() finds it
+  // from start: the edges (f, i) through which it went, in order, so
+  // that the edge list and the faces can be rebuilt without predicates
+  struct Site_zone
+  {
+    Face_handle        start;
+    std::vector<Edge>  steps;
+  };
+
+  // a site of a batch of the parallel insertion: a point, whose nearest
+  // neighbor is searched from v0, or a segment between v0 and v1; it is
+  // simple if its zone could be found, and locked if its zone got all its
+  // cells in the lock grid
+  struct Site_candidate
+  {
+    Site_2            t;
+    Vertex_handle     v0, v1;
+    Vertex_handle     vnearest;
+    std::ptrdiff_t    index;
+    Site_zone         zone;
+    std::vector<int>  cells;
+    bool              simple;
+    bool              locked;
+  };
+
+  bool meets_other_site(const Site_2& t, const Vertex_handle& v) const;
+
+  bool find_site_zone(const Site_2& t, const Vertex_handle& vnearest,
+		      Site_zone& z) const;
+
+  bool expand_site_zone(const Face_handle& f, const Site_2& t,
+			Face_map& fm, Sign_map& sign_map,
+			std::vector<Edge>& steps) const;
+
+  Vertex_handle insert_site_in_zone(const Storage_site_2& ss,
+				    const Site_zone& z);
+
+  void insert_points_in_parallel(const std::vector<Point_2>& points,
+				 std::vector<Vertex_handle>& vertices);
+
+  void insert_segments_in_parallel(Vertex_pair_vector& segments);
+
+#ifdef CGAL_LINKED_WITH_TBB
+  int lock_grid_cells_per_axis(size_type n) const;
+  Bbox_2 points_bbox() const;
+
+  void add_lock_cells(const Face_handle& f, const Spatial_lock_grid_2& grid,
+		      std::vector<int>& cells) const;
+
+  void compute_site_candidate(Site_candidate& c, unsigned int owner,
+			      Spatial_lock_grid_2& grid) const;
+
+  void process_site_batch(std::vector<Site_candidate>& candidates,
+			  Spatial_lock_grid_2& grid,
+			  std::vector<std::ptrdiff_t>& deferred,
+			  std::vector<Vertex_handle>& vertices);
+
+  // functor of the parallel_for of process_site_batch()
+  class Compute_site_candidates
+  {
+    const Self& m_sdg;
+    std::vector<Site_candidate>& m_candidates;
+    Spatial_lock_grid_2& m_grid;
+
+  public:
+    Compute_site_candidates(const Self& sdg,
+			    std::vector<Site_candidate>& candidates,
+			    Spatial_lock_grid_2& grid)
+      : m_sdg(sdg), m_candidates(candidates), m_grid(grid)
+    {}
+
+    void operator()(const tbb::blocked_range<std::size_t>& r) const
+    {
+      for (std::size_t i = r.begin(); i != r.end(); ++i) {
+	m_sdg.compute_site_candidate(m_candidates[i],
+				     static_cast<unsigned int>(i + 1),
+				     m_grid);
+      }
+    }
+  };
+#endif
+
 
 protected:
   // TYPES AND ACCESS METHODS FOR VISUALIZATION
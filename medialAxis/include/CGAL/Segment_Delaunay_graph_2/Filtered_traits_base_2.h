@@ -27,6 +27,7 @@
 #include <CGAL/Segment_Delaunay_graph_2/Traits_base_2.h>
 #include <CGAL/Segment_Delaunay_graph_2/Kernel_wrapper_2.h>
 #include <CGAL/Segment_Delaunay_graph_2/Cartesian_converter.h>
+#include <CGAL/Segment_Delaunay_graph_2/Static_filtered_predicates_C2.h>
 
 #include <CGAL/Filtered_predicate.h>
 #include <CGAL/Filtered_construction.h>
@@ -315,14 +316,25 @@ public:
 		     FK_Oriented_side_of_bisector_2, C2E, C2F>
   Oriented_side_of_bisector_2;
 
+private:
+  // with a double construction kernel, the two predicates that dominate
+  // the construction first try the semi-static filters of the common
+  // configurations; see Static_filtered_predicates_C2.h
   typedef
-  Filtered_predicate<EK_Vertex_conflict_2,
-		     FK_Vertex_conflict_2, C2E, C2F>
+  CGAL_SEGMENT_DELAUNAY_GRAPH_2_NS::Internal::Static_filtered_predicates_C2
+  <CK,
+   Filtered_predicate<EK_Vertex_conflict_2,
+		      FK_Vertex_conflict_2, C2E, C2F>,
+   Filtered_predicate<EK_Finite_edge_interior_conflict_2,
+		      FK_Finite_edge_interior_conflict_2, C2E, C2F> >
+  Static_filtered_predicates;
+
+public:
+  typedef typename Static_filtered_predicates::Vertex_conflict_2
   Vertex_conflict_2;
 
   typedef
-  Filtered_predicate<EK_Finite_edge_interior_conflict_2,
-		     FK_Finite_edge_interior_conflict_2, C2E, C2F>
+  typename Static_filtered_predicates::Finite_edge_interior_conflict_2
   Finite_edge_interior_conflict_2;
 
   typedef
@@ -1311,6 +1311,503 @@ retriangulate_conflict_region(Vertex_handle v, List& l,
   // 7. DONE!!!!
 }
 
+//--------------------------------------------------------------------
+// parallel insertion
+//--------------------------------------------------------------------
+
+// true if t meets the site of v somewhere else than at the endpoints of
+// t: such a site is split or merged by the sequential insertion
+template<class Gt, class ST, class D_S, class LTag>
+bool
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+meets_other_site(const Site_2& t, const Vertex_handle& v) const
+{
+  if ( is_infinite(v) ) { return false; }
+
+  Arrangement_type at_res = arrangement_type(t, v);
+
+  if ( v->is_segment() ) {
+    return !( at_res == AT2::DISJOINT || at_res == AT2::TOUCH_1 ||
+	      at_res == AT2::TOUCH_2 || at_res == AT2::TOUCH_11 ||
+	      at_res == AT2::TOUCH_12 || at_res == AT2::TOUCH_21 ||
+	      at_res == AT2::TOUCH_22 );
+  }
+  return at_res == AT2::INTERIOR || at_res == AT2::IDENTICAL;
+}
+
+// the read-only part of insert_point2() and insert_segment_interior():
+// returns false if t meets another site or, for a point, is only in
+// conflict with the interior of an edge, and otherwise records its
+// conflict region in z
+template<class Gt, class ST, class D_S, class LTag>
+bool
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+find_site_zone(const Site_2& t, const Vertex_handle& vnearest,
+	       Site_zone& z) const
+{
+  CGAL_precondition( this->dimension() == 2 );
+
+  if ( t.is_point() ) {
+    if ( meets_other_site(t, vnearest) ) { return false; }
+  } else {
+    Vertex_circulator vc = incident_vertices(vnearest);
+    Vertex_circulator vc_start = vc;
+    do {
+      Vertex_handle vv(vc);
+      if ( meets_other_site(t, vv) ) { return false; }
+      ++vc;
+    } while ( vc != vc_start );
+  }
+
+  Face_circulator fc_start = incident_faces(vnearest);
+  Face_circulator fc = fc_start;
+  Sign_map sign_map;
+
+  z.start = Face_handle();
+  do {
+    Face_handle f(fc);
+    Sign s = incircle(f, t);
+    sign_map[f] = s;
+    if ( s == NEGATIVE ) {
+      z.start = f;
+      break;
+    }
+    ++fc;
+  } while ( fc != fc_start );
+
+  if ( z.start == Face_handle() ) { return false; }
+
+  Face_map fm;
+  z.steps.clear();
+  return expand_site_zone(z.start, t, fm, sign_map, z.steps);
+}
+
+// same traversal as expand_conflict_region(), with the edge list
+// replaced by the steps
+template<class Gt, class ST, class D_S, class LTag>
+bool
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+expand_site_zone(const Face_handle& f, const Site_2& t,
+		 Face_map& fm, Sign_map& sign_map,
+		 std::vector<Edge>& steps) const
+{
+  fm[f] = true;
+
+  for (int i = 0; i < 3; i++) {
+    Face_handle n = f->neighbor(i);
+
+    bool face_registered = (fm.find(n) != fm.end());
+
+    if ( !face_registered ) {
+      for (int j = 0; j < 3; j++) {
+	if ( meets_other_site(t, n->vertex(j)) ) { return false; }
+      }
+    }
+
+    Sign s = incircle(n, t);
+    sign_map[n] = s;
+
+    Sign s_f = sign_map[f];
+
+    if ( s == POSITIVE ) { continue; }
+    if ( s != s_f ) { continue; }
+
+    bool interior_in_conflict = edge_interior(f, i, t, s);
+
+    if ( !interior_in_conflict ) { continue; }
+
+    if ( face_registered ) { continue; }
+
+    steps.push_back( Edge(f, i) );
+
+    if ( !expand_site_zone(n, t, fm, sign_map, steps) ) { return false; }
+  }
+  return true;
+}
+
+// inserts a site whose zone was found by find_site_zone(); the edge list
+// and the faces in conflict are rebuilt from the steps, as
+// expand_conflict_region() would have built them
+template<class Gt, class ST, class D_S, class LTag>
+typename Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::Vertex_handle
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+insert_site_in_zone(const Storage_site_2& ss, const Site_zone& z)
+{
+  List l;
+#ifndef CGAL_SDG_NO_FACE_MAP
+  Face_map fm;
+#endif
+
+  initialize_conflict_region(z.start, l);
+#ifdef CGAL_SDG_NO_FACE_MAP
+  z.start->tds_data().mark_in_conflict();
+  fhc_.push_back(z.start);
+#else
+  fm[z.start] = true;
+#endif
+
+  typename std::vector<Edge>::const_iterator it;
+  for (it = z.steps.begin(); it != z.steps.end(); ++it) {
+    Face_handle f = it->first;
+    int i = it->second;
+    Face_handle n = f->neighbor(i);
+
+    Edge e = sym_edge(f, i);
+
+    CGAL_assertion( l.is_in_list(e) );
+    int j = this->_tds.mirror_index(f, i);
+    Edge e_before = sym_edge(n, ccw(j));
+    Edge e_after = sym_edge(n, cw(j));
+    if ( !l.is_in_list(e_before) ) {
+      l.insert_before(e, e_before);
+    }
+    if ( !l.is_in_list(e_after) ) {
+      l.insert_after(e, e_after);
+    }
+    l.remove(e);
+
+#ifdef CGAL_SDG_NO_FACE_MAP
+    n->tds_data().mark_in_conflict();
+    fhc_.push_back(n);
+#else
+    fm[n] = true;
+#endif
+  }
+
+  Vertex_handle v = create_vertex(ss);
+
+#ifdef CGAL_SDG_NO_FACE_MAP
+  retriangulate_conflict_region(v, l);
+#else
+  retriangulate_conflict_region(v, l, fm);
+#endif
+
+  return v;
+}
+
+// The parallel insertion works by passes over the sites, sorted along a
+// Hilbert curve. Each pass is cut into batches of up to
+// CGAL_SDG_PARALLEL_BATCH_SIZE sites: batch b takes every k-th site from
+// the b-th, so that the sites of a batch are spread over the input. The
+// zones of the sites of a batch are computed concurrently on the
+// unmodified diagram, and each zone locks the cells of a
+// Spatial_lock_grid_2 holding the vertices of its faces, of the faces
+// across its boundary and of the faces around the nearest neighbor of
+// the site (the first endpoint of a segment). Two zones that share no
+// vertex share no face, and neither holds a face next to the other, so
+// the sites whose zones got all their cells are then inserted one after
+// the other without changing each other's zone. A site that meets another one, or a point in conflict with
+// no Voronoi vertex, goes through the sequential path, and a site whose
+// zone could not be locked waits for the next pass. Without TBB, or while
+// the diagram is not 2-dimensional, the sites are inserted one by one.
+
+// Inserts the points; vertices[i] is the vertex of points[i]. Every
+// k-th point in the Hilbert order is inserted first, one by one, and the
+// others follow by rounds that fill the gaps between them.
+template<class Gt, class ST, class D_S, class LTag>
+void
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+insert_points_in_parallel(const std::vector<Point_2>& points,
+			  std::vector<Vertex_handle>& vertices)
+{
+  typedef std::vector<std::ptrdiff_t> Vertex_indices;
+
+  vertices.assign(points.size(), Vertex_handle());
+  if ( points.empty() ) { return; }
+
+  Vertex_indices sorted;
+  sorted.reserve(points.size());
+  std::copy(boost::counting_iterator<std::ptrdiff_t>(0),
+	    boost::counting_iterator<std::ptrdiff_t>(points.size()),
+	    std::back_inserter(sorted));
+
+  Spatial_sort_traits_adapter_2<Gt,const Point_2*> sort_traits(&(points[0]));
+  spatial_sort(sorted.begin(), sorted.end(), sort_traits);
+
+  std::ptrdiff_t m = static_cast<std::ptrdiff_t>(sorted.size());
+  std::ptrdiff_t stride = (std::max)(m / CGAL_SDG_PARALLEL_BATCH_SIZE,
+				     std::ptrdiff_t(1));
+#ifndef CGAL_LINKED_WITH_TBB
+  stride = 1;
+#endif
+
+  // the vertices by position in the Hilbert order
+  std::vector<Vertex_handle> sorted_vertices(m);
+
+  Vertex_handle hint;
+  for (std::ptrdiff_t i = 0; i < m; i += stride) {
+    hint = insert(points[sorted[i]], hint);
+    sorted_vertices[i] = hint;
+  }
+
+#ifdef CGAL_LINKED_WITH_TBB
+  if ( stride > 1 && this->dimension() < 2 ) {
+    for (std::ptrdiff_t i = 0; i < m; i++) {
+      if ( i % stride == 0 ) { continue; }
+      hint = insert(points[sorted[i]], hint);
+      sorted_vertices[i] = hint;
+    }
+    stride = 1;
+  }
+
+  if ( stride > 1 ) {
+    Spatial_lock_grid_2 grid(points_bbox(), lock_grid_cells_per_axis(m));
+
+    // round r inserts the points whose offset o from the sample before
+    // them has its lowest set bit at r, from the highest round down: each
+    // round halves the gaps along the curve, so the diagram gets denser
+    // evenly, and the point at o - 2^r is already in
+    std::ptrdiff_t step = 1;
+    while ( 2 * step < stride ) { step *= 2; }
+
+    Vertex_indices pending, deferred;
+    std::vector<Site_candidate> candidates;
+    for ( ; step > 0; step /= 2) {
+      pending.clear();
+      for (std::ptrdiff_t i = 0; i < m; i++) {
+	std::ptrdiff_t o = i % stride;
+	if ( o != 0 && (o & -o) == step ) { pending.push_back(i); }
+      }
+
+      while ( !pending.empty() ) {
+	// a batch much smaller than the diagram, lest the zones of the
+	// first rounds all meet
+	std::size_t n = pending.size();
+	std::size_t size = (std::min)(std::size_t(CGAL_SDG_PARALLEL_BATCH_SIZE),
+				      number_of_vertices() / 16 + 1);
+	std::size_t batches = (n + size - 1) / size;
+	deferred.clear();
+	for (std::size_t b = 0; b < batches; b++) {
+	  candidates.resize( (n - b + batches - 1) / batches );
+	  std::size_t k = 0;
+	  for (std::size_t i = b; i < n; i += batches, k++) {
+	    Site_candidate& c = candidates[k];
+	    c.index = pending[i];
+	    c.t = Site_2::construct_site_2(points[sorted[c.index]]);
+	    c.v0 = sorted_vertices[c.index - step];
+	  }
+	  process_site_batch(candidates, grid, deferred, sorted_vertices);
+	}
+	pending.swap(deferred);
+      }
+    }
+  }
+#endif
+
+  for (std::ptrdiff_t i = 0; i < m; i++) {
+    vertices[sorted[i]] = sorted_vertices[i];
+  }
+}
+
+// Inserts the segments between the given vertices, which are points of
+// the diagram. They are sorted by their first endpoint.
+template<class Gt, class ST, class D_S, class LTag>
+void
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+insert_segments_in_parallel(Vertex_pair_vector& segments)
+{
+#ifdef CGAL_LINKED_WITH_TBB
+  if ( this->dimension() == 2 && !segments.empty() ) {
+    Spatial_lock_grid_2 grid(points_bbox(),
+			     lock_grid_cells_per_axis(number_of_vertices()
+						      + segments.size()));
+
+    std::vector<Point_2> sources;
+    sources.reserve(segments.size());
+    for (std::size_t i = 0; i < segments.size(); i++) {
+      sources.push_back( *segments[i].first->storage_site().point() );
+    }
+
+    std::vector<std::ptrdiff_t> pending, deferred;
+    pending.reserve(segments.size());
+    std::copy(boost::counting_iterator<std::ptrdiff_t>(0),
+	      boost::counting_iterator<std::ptrdiff_t>(segments.size()),
+	      std::back_inserter(pending));
+
+    Spatial_sort_traits_adapter_2<Gt,const Point_2*>
+      sort_traits(&(sources[0]));
+    spatial_sort(pending.begin(), pending.end(), sort_traits);
+
+    std::vector<Vertex_handle> no_vertices;
+    std::vector<Site_candidate> candidates;
+    while ( !pending.empty() ) {
+      std::size_t n = pending.size();
+      std::size_t batches =
+	(n + CGAL_SDG_PARALLEL_BATCH_SIZE - 1) / CGAL_SDG_PARALLEL_BATCH_SIZE;
+      deferred.clear();
+      for (std::size_t b = 0; b < batches; b++) {
+	candidates.resize( (n - b + batches - 1) / batches );
+	std::size_t k = 0;
+	for (std::size_t i = b; i < n; i += batches, k++) {
+	  Site_candidate& c = candidates[k];
+	  c.index = pending[i];
+	  c.v0 = segments[c.index].first;
+	  c.v1 = segments[c.index].second;
+	  c.t = st_.construct_storage_site_2_object()
+	    (c.v0->storage_site().point(), c.v1->storage_site().point()).site();
+	}
+	process_site_batch(candidates, grid, deferred, no_vertices);
+      }
+      pending.swap(deferred);
+    }
+    return;
+  }
+#endif
+
+  for (std::size_t i = 0; i < segments.size(); i++) {
+    insert(segments[i].first, segments[i].second);
+  }
+}
+
+#ifdef CGAL_LINKED_WITH_TBB
+// About one cell per vertex of the diagram once the n sites are in, so
+// that the zones of a batch rarely meet in a cell without sharing a face.
+template<class Gt, class ST, class D_S, class LTag>
+int
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+lock_grid_cells_per_axis(size_type n) const
+{
+  int k = static_cast<int>( std::sqrt(static_cast<double>(n)) );
+  return (std::max)(k, int(CGAL_SDG_LOCK_GRID_CELLS_PER_AXIS));
+}
+
+template<class Gt, class ST, class D_S, class LTag>
+Bbox_2
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+points_bbox() const
+{
+  Bbox_2 bbox;
+  bool first = true;
+  for (Finite_vertices_iterator vit = finite_vertices_begin();
+       vit != finite_vertices_end(); ++vit) {
+    if ( !vit->storage_site().is_point() ) { continue; }
+    Bbox_2 b = vit->storage_site().point()->bbox();
+    bbox = first ? b : bbox + b;
+    first = false;
+  }
+  return bbox;
+}
+
+template<class Gt, class ST, class D_S, class LTag>
+void
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+add_lock_cells(const Face_handle& f, const Spatial_lock_grid_2& grid,
+	       std::vector<int>& cells) const
+{
+  // a segment is locked by the cell of the source of its supporting
+  // segment, so that it has a single cell
+  for (int i = 0; i < 3; i++) {
+    Vertex_handle v = f->vertex(i);
+    if ( is_infinite(v) ) { continue; }
+    const Storage_site_2& ss = v->storage_site();
+    cells.push_back( grid.get_grid_index(ss.is_point() ?
+					 *ss.point() :
+					 *ss.source_of_supporting_site()) );
+  }
+}
+
+// computes the zone of c and locks its cells for owner (> 0); only reads
+// the diagram
+template<class Gt, class ST, class D_S, class LTag>
+void
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+compute_site_candidate(Site_candidate& c, unsigned int owner,
+		       Spatial_lock_grid_2& grid) const
+{
+  c.locked = false;
+  c.cells.clear();
+  c.vnearest = c.t.is_point() ? nearest_neighbor(c.t, c.v0) : c.v0;
+  c.simple = find_site_zone(c.t, c.vnearest, c.zone);
+  if ( !c.simple ) { return; }
+
+  Face_circulator fc_start = incident_faces(c.vnearest);
+  Face_circulator fc = fc_start;
+  do {
+    add_lock_cells(fc, grid, c.cells);
+    ++fc;
+  } while ( fc != fc_start );
+
+  add_lock_cells(c.zone.start, grid, c.cells);
+  typename std::vector<Edge>::const_iterator it;
+  for (it = c.zone.steps.begin(); it != c.zone.steps.end(); ++it) {
+    add_lock_cells(it->first->neighbor(it->second), grid, c.cells);
+  }
+
+  std::sort(c.cells.begin(), c.cells.end());
+  c.cells.erase(std::unique(c.cells.begin(), c.cells.end()), c.cells.end());
+
+  for (std::size_t i = 0; i < c.cells.size(); i++) {
+    if ( !grid.try_lock(c.cells[i], owner) ) {
+      for (std::size_t j = 0; j < i; j++) {
+	grid.unlock(c.cells[j]);
+      }
+      c.cells.clear();
+      return;
+    }
+  }
+  c.locked = true;
+}
+
+// vertices[c.index] gets the vertex of a point c
+template<class Gt, class ST, class D_S, class LTag>
+void
+Segment_Delaunay_graph_2<Gt,ST,D_S,LTag>::
+process_site_batch(std::vector<Site_candidate>& candidates,
+		   Spatial_lock_grid_2& grid,
+		   std::vector<std::ptrdiff_t>& deferred,
+		   std::vector<Vertex_handle>& vertices)
+{
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, candidates.size()),
+		    Compute_site_candidates(*this, candidates, grid));
+
+  bool progress = false;
+  for (std::size_t i = 0; i < candidates.size(); i++) {
+    Site_candidate& c = candidates[i];
+    if ( !c.locked ) { continue; }
+    if ( c.t.is_point() ) {
+      Point_handle ph = register_input_site(c.t.point());
+      Storage_site_2 ss = st_.construct_storage_site_2_object()(ph);
+      vertices[c.index] = insert_site_in_zone(ss, c.zone);
+    } else {
+      Point_handle_pair php =
+	register_input_site(c.v0->storage_site().point(),
+			    c.v1->storage_site().point());
+      Storage_site_2 ss =
+	st_.construct_storage_site_2_object()(php.first, php.second);
+      insert_site_in_zone(ss, c.zone);
+    }
+    progress = true;
+  }
+
+  for (std::size_t i = 0; i < candidates.size(); i++) {
+    for (std::size_t j = 0; j < candidates[i].cells.size(); j++) {
+      grid.unlock(candidates[i].cells[j]);
+    }
+  }
+  CGAL_expensive_assertion( grid.check_if_all_cells_are_unlocked() );
+
+  // the first site that could not be locked is inserted anyway if
+  // nothing else was, so that every batch makes progress
+  for (std::size_t i = 0; i < candidates.size(); i++) {
+    Site_candidate& c = candidates[i];
+    if ( c.locked ) { continue; }
+    if ( !c.simple || !progress ) {
+      if ( c.t.is_point() ) {
+	// c.vnearest was found before the batch; once a site has been
+	// inserted it may be a segment vertex that a split has removed
+	vertices[c.index] = progress ? insert(c.t.point())
+	                             : insert(c.t.point(), c.vnearest);
+      } else {
+	insert(c.v0, c.v1);
+      }
+      progress = true;
+    } else {
+      deferred.push_back(c.index);
+    }
+  }
+}
+#endif // CGAL_LINKED_WITH_TBB
+
 //====================================================================
 //====================================================================
 //                   METHODS FOR REMOVAL
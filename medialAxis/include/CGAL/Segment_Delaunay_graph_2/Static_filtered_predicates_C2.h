@@ -0,0 +1,367 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+
+
+#ifndef CGAL_SEGMENT_DELAUNAY_GRAPH_2_STATIC_FILTERED_PREDICATES_C2_H
+#define CGAL_SEGMENT_DELAUNAY_GRAPH_2_STATIC_FILTERED_PREDICATES_C2_H
+
+#include <CGAL/Profile_counter.h>
+#include <CGAL/Uncertain.h>
+#include <CGAL/determinant.h>
+#include <CGAL/number_utils.h>
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <algorithm>
+
+namespace CGAL {
+
+namespace SegmentDelaunayGraph_2 {
+
+namespace Internal {
+
+//-----------------------------------------------------------------------
+// The semi-static filters of Filtered_kernel (see
+// internal/Static_filters/Orientation_2.h and
+// Side_of_oriented_circle_2.h), on the coordinates of input sites, which
+// are doubles when the construction kernel is a double kernel. The result
+// is indeterminate when the error bound does not give the sign.
+//-----------------------------------------------------------------------
+
+inline Uncertain<Sign>
+static_orientation_C2(double px, double py, double qx, double qy,
+		      double rx, double ry)
+{
+  double pqx = qx - px;
+  double pqy = qy - py;
+  double prx = rx - px;
+  double pry = ry - py;
+
+  double det = CGAL::determinant(pqx, pqy, prx, pry);
+
+  double maxx = CGAL::abs(pqx);
+  double maxy = CGAL::abs(pqy);
+  double aprx = CGAL::abs(prx);
+  double apry = CGAL::abs(pry);
+  if (maxx < aprx) maxx = aprx;
+  if (maxy < apry) maxy = apry;
+  if (maxx > maxy) std::swap(maxx, maxy);
+
+  if ( maxx < 1e-146 ) {
+    if ( maxx == 0 ) { return ZERO; }
+  } else if ( maxy < 1e153 ) {
+    double eps = 8.8872057372592798e-16 * maxx * maxy;
+    if ( det > eps )  { return POSITIVE; }
+    if ( det < -eps ) { return NEGATIVE; }
+  }
+  return Uncertain<Sign>::indeterminate();
+}
+
+// the sign of side_of_oriented_circle(p, q, r, t)
+inline Uncertain<Sign>
+static_side_of_oriented_circle_C2(double px, double py, double qx, double qy,
+				  double rx, double ry, double tx, double ty)
+{
+  double qpx = qx - px;
+  double qpy = qy - py;
+  double rpx = rx - px;
+  double rpy = ry - py;
+  double tpx = tx - px;
+  double tpy = ty - py;
+  double tqx = tx - qx;
+  double tqy = ty - qy;
+  double rqx = rx - qx;
+  double rqy = ry - qy;
+
+  double det = CGAL::determinant(qpx*tpy - qpy*tpx, tpx*tqx + tpy*tqy,
+				 qpx*rpy - qpy*rpx, rpx*rqx + rpy*rqy);
+
+  double maxx = CGAL::abs(qpx);
+  double maxy = CGAL::abs(qpy);
+  double arpx = CGAL::abs(rpx), arpy = CGAL::abs(rpy);
+  double atqx = CGAL::abs(tqx), atqy = CGAL::abs(tqy);
+  double atpx = CGAL::abs(tpx), atpy = CGAL::abs(tpy);
+  double arqx = CGAL::abs(rqx), arqy = CGAL::abs(rqy);
+  if (maxx < arpx) maxx = arpx;
+  if (maxx < atpx) maxx = atpx;
+  if (maxx < atqx) maxx = atqx;
+  if (maxx < arqx) maxx = arqx;
+  if (maxy < arpy) maxy = arpy;
+  if (maxy < atpy) maxy = atpy;
+  if (maxy < atqy) maxy = atqy;
+  if (maxy < arqy) maxy = arqy;
+  if (maxx > maxy) std::swap(maxx, maxy);
+
+  if ( maxx < 1e-73 ) {
+    if ( maxx == 0 ) { return ZERO; }
+  } else if ( maxy < 1e76 ) {
+    double eps = 8.8878565762001373e-15 * maxx * maxy * (maxy*maxy);
+    if ( det > eps )  { return POSITIVE; }
+    if ( det < -eps ) { return NEGATIVE; }
+  }
+  return Uncertain<Sign>::indeterminate();
+}
+
+//-----------------------------------------------------------------------
+// Vertex_conflict_2 with a semi-static fast path before the filtered
+// predicate Base: the conflict of a point, or of the endpoints of a
+// segment, with the Voronoi circle of three points, and the conflicts
+// with an infinite vertex that only depend on orientations. Only input
+// sites are filtered, since their coordinates are the given doubles.
+//-----------------------------------------------------------------------
+
+template<class Base, class K>
+class Static_filtered_vertex_conflict_2
+  : public Base
+{
+private:
+  typedef typename K::Site_2        Site_2;
+  typedef typename K::Point_2       Point_2;
+
+  static bool is_input_point(const Site_2& s) {
+    return s.is_point() && s.is_input();
+  }
+
+  static bool is_input_segment(const Site_2& s) {
+    return s.is_segment() && s.is_input();
+  }
+
+  static bool same(const Point_2& p, const Point_2& q) {
+    return p.x() == q.x() && p.y() == q.y();
+  }
+
+  static bool is_endpoint(const Point_2& p, const Site_2& s) {
+    return same(p, s.source_of_supporting_site()) ||
+      same(p, s.target_of_supporting_site());
+  }
+
+  static Uncertain<Sign>
+  orientation(const Point_2& p, const Point_2& q, const Point_2& r) {
+    return static_orientation_C2(p.x(), p.y(), q.x(), q.y(), r.x(), r.y());
+  }
+
+  // the incircle test of the Voronoi vertex of p, q and r against the
+  // point t: NEGATIVE if t is inside the circle
+  static Uncertain<Sign>
+  incircle(const Point_2& p, const Point_2& q, const Point_2& r,
+	   const Point_2& t) {
+    return -static_side_of_oriented_circle_C2(p.x(), p.y(), q.x(), q.y(),
+					      r.x(), r.y(), t.x(), t.y());
+  }
+
+  // the vertex of p, q and r against the segment t, none of the points
+  // being an endpoint of t: in conflict if an endpoint of t is inside
+  // the circle, otherwise the supporting line of t decides, which is
+  // left to Base
+  static Uncertain<Sign>
+  incircle_s(const Point_2& p, const Point_2& q, const Point_2& r,
+	     const Site_2& t) {
+    Uncertain<Sign> d1 = incircle(p, q, r, t.source_of_supporting_site());
+    if ( certainly(d1 == NEGATIVE) ) { return NEGATIVE; }
+    if ( !is_certain(d1) ) { return d1; }
+    Uncertain<Sign> d2 = incircle(p, q, r, t.target_of_supporting_site());
+    if ( certainly(d2 == NEGATIVE) ) { return NEGATIVE; }
+    return Uncertain<Sign>::indeterminate();
+  }
+
+  // the other endpoint of the segment s, of which p is an endpoint
+  static const Point_2& other_endpoint(const Point_2& p, const Site_2& s) {
+    return same(p, s.source_of_supporting_site()) ?
+      s.target_of_supporting_site() : s.source_of_supporting_site();
+  }
+
+  // the infinite vertex against t is destroyed if t is to the right of
+  // (p, q); see Vertex_conflict_C2::incircle_p()
+  static Uncertain<Sign>
+  infinite_incircle(const Point_2& p, const Point_2& q, const Point_2& t) {
+    Uncertain<Sign> o = orientation(p, q, t);
+    if ( !is_certain(o) || certainly(o == ZERO) ) {
+      return Uncertain<Sign>::indeterminate();
+    }
+    return certainly(o == NEGATIVE) ? NEGATIVE : POSITIVE;
+  }
+
+public:
+  typedef Sign                result_type;
+  typedef Site_2              argument_type;
+
+  using Base::operator();
+
+  Sign operator()(const Site_2& p, const Site_2& q,
+		  const Site_2& r, const Site_2& t) const
+  {
+    CGAL_BRANCH_PROFILER_3("semi-static failures/attempts/calls to   : Sdg Vertex_conflict_2", tmp);
+
+    if ( is_input_point(p) && is_input_point(q) && is_input_point(r) ) {
+      Point_2 pp = p.point(), qp = q.point(), rp = r.point();
+
+      if ( is_input_point(t) ) {
+	CGAL_BRANCH_PROFILER_BRANCH_1(tmp);
+	Uncertain<Sign> s = incircle(pp, qp, rp, t.point());
+	if ( is_certain(s) ) { return get_certain(s); }
+	CGAL_BRANCH_PROFILER_BRANCH_2(tmp);
+      } else if ( is_input_segment(t) &&
+		  !is_endpoint(pp, t) && !is_endpoint(qp, t) &&
+		  !is_endpoint(rp, t) ) {
+	CGAL_BRANCH_PROFILER_BRANCH_1(tmp);
+	Uncertain<Sign> s = incircle_s(pp, qp, rp, t);
+	if ( is_certain(s) ) { return get_certain(s); }
+	CGAL_BRANCH_PROFILER_BRANCH_2(tmp);
+      }
+    }
+
+    return Base::operator()(p, q, r, t);
+  }
+
+  Sign operator()(const Site_2& p, const Site_2& q, const Site_2& t) const
+  {
+    CGAL_BRANCH_PROFILER_3("semi-static failures/attempts/calls to   : Sdg Vertex_conflict_2 (infinite)", tmp);
+
+    // the predicate is evaluated on q, p and t; see Vertex_conflict_C2
+    if ( is_input_point(t) && p.is_input() && q.is_input() &&
+	 ( p.is_point() || q.is_point() ) ) {
+      CGAL_BRANCH_PROFILER_BRANCH_1(tmp);
+      Uncertain<Sign> s;
+      Point_2 tp = t.point();
+
+      if ( p.is_point() && q.is_point() ) {
+	s = infinite_incircle(q.point(), p.point(), tp);
+      } else if ( q.is_point() ) {
+	Point_2 qp = q.point();
+	s = infinite_incircle(qp, other_endpoint(qp, p), tp);
+      } else {
+	Point_2 pp = p.point();
+	s = infinite_incircle(other_endpoint(pp, q), pp, tp);
+      }
+      if ( is_certain(s) ) { return get_certain(s); }
+      CGAL_BRANCH_PROFILER_BRANCH_2(tmp);
+    }
+
+    return Base::operator()(p, q, t);
+  }
+};
+
+//-----------------------------------------------------------------------
+// Finite_edge_interior_conflict_2 with the answers that follow from the
+// types of the sites and the sign given by the caller, and with a
+// semi-static fast path for the edge of two points against a segment
+// crossing it, before the filtered predicate Base.
+//-----------------------------------------------------------------------
+
+template<class Base, class K>
+class Static_filtered_finite_edge_interior_conflict_2
+  : public Base
+{
+private:
+  typedef typename K::Site_2        Site_2;
+  typedef typename K::Point_2       Point_2;
+
+  static bool same(const Point_2& p, const Point_2& q) {
+    return p.x() == q.x() && p.y() == q.y();
+  }
+
+public:
+  typedef bool                result_type;
+  typedef Site_2              argument_type;
+
+  using Base::operator();
+
+  bool operator()(const Site_2& p, const Site_2& q, const Site_2& r,
+		  const Site_2& s, const Site_2& t, Sign sgn) const
+  {
+    CGAL_BRANCH_PROFILER_3("semi-static failures/attempts/calls to   : Sdg Finite_edge_interior_conflict_2", tmp);
+
+    // see Finite_edge_interior_conflict_C2: a segment conflicts with
+    // the interior of an edge only if it conflicts with both its ends,
+    // and a point conflicts with the interior of the edge of two points
+    // exactly when it conflicts with both its ends
+    if ( sgn != NEGATIVE && t.is_segment() ) {
+      CGAL_BRANCH_PROFILER_BRANCH_1(tmp);
+      return false;
+    }
+    if ( sgn != ZERO && t.is_point() && p.is_point() && q.is_point() ) {
+      CGAL_BRANCH_PROFILER_BRANCH_1(tmp);
+      return ( sgn == NEGATIVE );
+    }
+
+    // the edge of the points p and q is in conflict with a segment that
+    // separates them
+    if ( sgn == NEGATIVE && p.is_point() && q.is_point() &&
+	 p.is_input() && q.is_input() && t.is_input() ) {
+      CGAL_BRANCH_PROFILER_BRANCH_1(tmp);
+      Point_2 pp = p.point(), qp = q.point();
+      const Point_2& ts = t.source_of_supporting_site();
+      const Point_2& tt = t.target_of_supporting_site();
+
+      if ( same(pp, ts) || same(pp, tt) || same(qp, ts) || same(qp, tt) ) {
+	return true;
+      }
+
+      Uncertain<Sign> op =
+	static_orientation_C2(ts.x(), ts.y(), tt.x(), tt.y(), pp.x(), pp.y());
+      Uncertain<Sign> oq =
+	static_orientation_C2(ts.x(), ts.y(), tt.x(), tt.y(), qp.x(), qp.y());
+      if ( certainly(op * oq != POSITIVE) ) { return true; }
+      CGAL_BRANCH_PROFILER_BRANCH_2(tmp);
+    }
+
+    return Base::operator()(p, q, r, s, t, sgn);
+  }
+
+  bool operator()(const Site_2& p, const Site_2& q, const Site_2& r,
+		  const Site_2& t, Sign sgn) const
+  {
+    if ( t.is_point() ) { return ( sgn == NEGATIVE ); }
+    if ( sgn != NEGATIVE ) { return false; }
+    if ( p.is_segment() || q.is_segment() ) { return false; }
+    return Base::operator()(p, q, r, t, sgn);
+  }
+};
+
+//-----------------------------------------------------------------------
+// Selects the statically filtered predicates when the construction
+// kernel K has double coordinates, unless CGAL_NO_STATIC_FILTERS is
+// defined.
+//-----------------------------------------------------------------------
+
+template<class K, class Vertex_conflict, class Finite_edge_interior_conflict,
+#ifdef CGAL_NO_STATIC_FILTERS
+	 bool Use_static_filters = false
+#else
+	 bool Use_static_filters = boost::is_same<typename K::FT, double>::value
+#endif
+	 >
+struct Static_filtered_predicates_C2
+{
+  typedef Vertex_conflict                   Vertex_conflict_2;
+  typedef Finite_edge_interior_conflict     Finite_edge_interior_conflict_2;
+};
+
+template<class K, class Vertex_conflict, class Finite_edge_interior_conflict>
+struct Static_filtered_predicates_C2<K, Vertex_conflict,
+				     Finite_edge_interior_conflict, true>
+{
+  typedef Static_filtered_vertex_conflict_2<Vertex_conflict, K>
+  Vertex_conflict_2;
+
+  typedef Static_filtered_finite_edge_interior_conflict_2
+  <Finite_edge_interior_conflict, K>
+  Finite_edge_interior_conflict_2;
+};
+
+} // namespace Internal
+
+} //namespace SegmentDelaunayGraph_2
+
+} //namespace CGAL
+
+#endif // CGAL_SEGMENT_DELAUNAY_GRAPH_2_STATIC_FILTERED_PREDICATES_C2_H
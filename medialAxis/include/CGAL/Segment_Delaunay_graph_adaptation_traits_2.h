@@ -26,6 +26,7 @@
 #include <CGAL/Voronoi_diagram_2/Adaptation_traits_base_2.h>
 #include <CGAL/Voronoi_diagram_2/Site_accessors.h>
 #include <CGAL/Voronoi_diagram_2/Construct_dual_points.h>
+#include <CGAL/Voronoi_diagram_2/Construct_flat_edges.h>
 #include <CGAL/Voronoi_diagram_2/Adaptation_traits_functors.h>
 
 
@@ -43,6 +44,9 @@ struct Segment_Delaunay_graph_adaptation_traits_2
   typedef typename SDG2::Point_2                   Point_2;
   typedef typename SDG2::Site_2                    Site_2;
 
+  typedef CGAL_VORONOI_DIAGRAM_2_INS::Segment_Delaunay_graph_flat_edge_2<SDG2>
+  Flat_edge_2;
+
   typedef Tag_false                                Has_remove;
 };
 
@@ -0,0 +1,132 @@
+// You can redistribute this file and/or modify it under the terms of the
+// GNU Lesser General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+// The 2D counterpart of Spatial_lock_grid_3, for the parallel refinement
+// of Delaunay_mesher_2. A lock is not owned by a thread but by an owner
+// id chosen by the caller (for the mesher, a refinement candidate): the
+// candidates are locked by several threads and then released together,
+// once their points are inserted. Nobody waits for a lock, so only the
+// non blocking variant of Spatial_lock_grid_3 has a counterpart here.
+
+#ifndef CGAL_STL_EXTENSION_SPATIAL_LOCK_GRID_2_H
+#define CGAL_STL_EXTENSION_SPATIAL_LOCK_GRID_2_H
+
+#ifdef CGAL_LINKED_WITH_TBB
+
+#include <CGAL/Bbox_2.h>
+
+#include <tbb/atomic.h>
+
+#include <vector>
+
+namespace CGAL {
+
+class Spatial_lock_grid_2
+{
+public:
+  Spatial_lock_grid_2(const Bbox_2 &bbox, int num_grid_cells_per_axis)
+    : m_num_grid_cells_per_axis(num_grid_cells_per_axis)
+  {
+    set_bbox(bbox);
+    m_grid.resize(num_grid_cells_per_axis*num_grid_cells_per_axis);
+    // Explicitly initialize the atomics
+    std::vector<tbb::atomic<unsigned int> >::iterator it     = m_grid.begin();
+    std::vector<tbb::atomic<unsigned int> >::iterator it_end = m_grid.end();
+    for ( ; it != it_end ; ++it)
+      *it = 0;
+  }
+
+  void set_bbox(const Bbox_2 &bbox)
+  {
+    m_bbox = bbox;
+    double n = static_cast<double>(m_num_grid_cells_per_axis);
+    m_resolution_x = n / (bbox.xmax() - bbox.xmin());
+    m_resolution_y = n / (bbox.ymax() - bbox.ymin());
+  }
+
+  const Bbox_2 &get_bbox() const
+  {
+    return m_bbox;
+  }
+
+  // P2 must provide .x(), .y()
+  template <typename P2>
+  int get_grid_index(const P2& point) const
+  {
+    int index_x = static_cast<int>(
+      (CGAL::to_double(point.x()) - m_bbox.xmin()) * m_resolution_x);
+    index_x = (index_x < 0 ? 0
+               : (index_x >= m_num_grid_cells_per_axis ?
+                  m_num_grid_cells_per_axis - 1 : index_x));
+    int index_y = static_cast<int>(
+      (CGAL::to_double(point.y()) - m_bbox.ymin()) * m_resolution_y);
+    index_y = (index_y < 0 ? 0
+               : (index_y >= m_num_grid_cells_per_axis ?
+                  m_num_grid_cells_per_axis - 1 : index_y));
+    return index_y*m_num_grid_cells_per_axis + index_x;
+  }
+
+  bool is_cell_locked(int cell_index) const
+  {
+    return m_grid[cell_index] != 0;
+  }
+
+  // Succeeds if the cell is free or already locked by owner (> 0).
+  bool try_lock(int cell_index, unsigned int owner)
+  {
+    unsigned int old_value = m_grid[cell_index].compare_and_swap(owner, 0);
+    return old_value == 0 || old_value == owner;
+  }
+
+  template <typename P2>
+  bool try_lock(const P2 &point, unsigned int owner)
+  {
+    return try_lock(get_grid_index(point), owner);
+  }
+
+  void unlock(int cell_index)
+  {
+    m_grid[cell_index] = 0;
+  }
+
+  bool check_if_all_cells_are_unlocked() const
+  {
+    bool unlocked = true;
+    for (std::size_t i = 0 ; unlocked && i < m_grid.size() ; ++i)
+      unlocked = !is_cell_locked(static_cast<int>(i));
+    return unlocked;
+  }
+
+protected:
+  int                                             m_num_grid_cells_per_axis;
+  Bbox_2                                          m_bbox;
+  double                                          m_resolution_x;
+  double                                          m_resolution_y;
+
+  std::vector<tbb::atomic<unsigned int> >         m_grid;
+};
+
+} //namespace CGAL
+
+#else // !CGAL_LINKED_WITH_TBB
+
+namespace CGAL {
+
+class Spatial_lock_grid_2
+{
+};
+
+}
+
+#endif // CGAL_LINKED_WITH_TBB
+
+#endif // CGAL_STL_EXTENSION_SPATIAL_LOCK_GRID_2_H
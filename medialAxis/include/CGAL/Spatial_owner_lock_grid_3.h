@@ -0,0 +1,139 @@
+// You can redistribute this file and/or modify it under the terms of the
+// GNU Lesser General Public License as published by the Free Software
+// Foundation; either version 3 of the License, or (at your option) any later
+// version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+// The lock grid of Spatial_lock_grid_2 in 3D, for the parallel insertion
+// of Periodic_3_Delaunay_triangulation_3. Like there, a lock is owned by
+// an id chosen by the caller rather than by a thread, which the thread
+// local bookkeeping of Spatial_lock_grid_3 cannot do: the cells are
+// locked by several threads and released together by the one that
+// inserts the points.
+
+#ifndef CGAL_STL_EXTENSION_SPATIAL_OWNER_LOCK_GRID_3_H
+#define CGAL_STL_EXTENSION_SPATIAL_OWNER_LOCK_GRID_3_H
+
+#ifdef CGAL_LINKED_WITH_TBB
+
+#include <CGAL/Bbox_3.h>
+
+#include <tbb/atomic.h>
+
+#include <vector>
+
+namespace CGAL {
+
+class Spatial_owner_lock_grid_3
+{
+public:
+  Spatial_owner_lock_grid_3(const Bbox_3 &bbox, int num_grid_cells_per_axis)
+    : m_num_grid_cells_per_axis(num_grid_cells_per_axis)
+  {
+    set_bbox(bbox);
+    m_grid.resize(num_grid_cells_per_axis*num_grid_cells_per_axis
+                  *num_grid_cells_per_axis);
+    // Explicitly initialize the atomics
+    std::vector<tbb::atomic<unsigned int> >::iterator it     = m_grid.begin();
+    std::vector<tbb::atomic<unsigned int> >::iterator it_end = m_grid.end();
+    for ( ; it != it_end ; ++it)
+      *it = 0;
+  }
+
+  void set_bbox(const Bbox_3 &bbox)
+  {
+    m_bbox = bbox;
+    double n = static_cast<double>(m_num_grid_cells_per_axis);
+    m_resolution_x = n / (bbox.xmax() - bbox.xmin());
+    m_resolution_y = n / (bbox.ymax() - bbox.ymin());
+    m_resolution_z = n / (bbox.zmax() - bbox.zmin());
+  }
+
+  const Bbox_3 &get_bbox() const
+  {
+    return m_bbox;
+  }
+
+  // P3 must provide .x(), .y(), .z()
+  template <typename P3>
+  int get_grid_index(const P3& point) const
+  {
+    int index_x = clamp(static_cast<int>(
+      (CGAL::to_double(point.x()) - m_bbox.xmin()) * m_resolution_x));
+    int index_y = clamp(static_cast<int>(
+      (CGAL::to_double(point.y()) - m_bbox.ymin()) * m_resolution_y));
+    int index_z = clamp(static_cast<int>(
+      (CGAL::to_double(point.z()) - m_bbox.zmin()) * m_resolution_z));
+    return (index_z*m_num_grid_cells_per_axis + index_y)
+           *m_num_grid_cells_per_axis + index_x;
+  }
+
+  bool is_cell_locked(int cell_index) const
+  {
+    return m_grid[cell_index] != 0;
+  }
+
+  // Succeeds if the cell is free or already locked by owner (> 0).
+  bool try_lock(int cell_index, unsigned int owner)
+  {
+    unsigned int old_value = m_grid[cell_index].compare_and_swap(owner, 0);
+    return old_value == 0 || old_value == owner;
+  }
+
+  template <typename P3>
+  bool try_lock(const P3 &point, unsigned int owner)
+  {
+    return try_lock(get_grid_index(point), owner);
+  }
+
+  void unlock(int cell_index)
+  {
+    m_grid[cell_index] = 0;
+  }
+
+  bool check_if_all_cells_are_unlocked() const
+  {
+    bool unlocked = true;
+    for (std::size_t i = 0 ; unlocked && i < m_grid.size() ; ++i)
+      unlocked = !is_cell_locked(static_cast<int>(i));
+    return unlocked;
+  }
+
+protected:
+  int clamp(int index) const
+  {
+    return index < 0 ? 0
+      : (index >= m_num_grid_cells_per_axis ?
+         m_num_grid_cells_per_axis - 1 : index);
+  }
+
+  int                                             m_num_grid_cells_per_axis;
+  Bbox_3                                          m_bbox;
+  double                                          m_resolution_x;
+  double                                          m_resolution_y;
+  double                                          m_resolution_z;
+
+  std::vector<tbb::atomic<unsigned int> >         m_grid;
+};
+
+} //namespace CGAL
+
+#else // !CGAL_LINKED_WITH_TBB
+
+namespace CGAL {
+
+class Spatial_owner_lock_grid_3
+{
+};
+
+}
+
+#endif // CGAL_LINKED_WITH_TBB
+
+#endif // CGAL_STL_EXTENSION_SPATIAL_OWNER_LOCK_GRID_3_H
@@ -27,6 +27,7 @@ Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::Polygon_offset_builder_2( Ss const
   :
    mTraits (aTraits)
   ,mVisitor(aVisitor)
+  ,mLevel  (-1)
 {
 
   int lMaxID = -1 ;
@@ -40,6 +41,10 @@ Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::Polygon_offset_builder_2( Ss const
       mBorders.push_back(lHE);
   }
 
+  for ( Vertex_const_handle lV = aSs.vertices_begin() ; lV != aSs.vertices_end() ; ++ lV )
+    if ( lV->is_skeleton() )
+      mNodes.push_back(lV);
+      
   CGAL_POLYOFFSET_TRACE(2, "Border count: " << mBorders.size() ) ;
 
   CGAL_POLYOFFSET_TRACE(2, "Highest Bisector ID: " << lMaxID ) ;
@@ -164,11 +169,20 @@ Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::LocateHook( FT
 template<class Ss, class Gt, class Cont, class Visitor>
 typename Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::Halfedge_const_handle
 Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::LocateSeed( FT aTime, Halfedge_const_handle aBorder )
+{
+  bool lNoHook ;
+  return LocateSeed(aTime,aBorder,lNoHook);
+}
+
+template<class Ss, class Gt, class Cont, class Visitor>
+typename Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::Halfedge_const_handle
+Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::LocateSeed( FT aTime, Halfedge_const_handle aBorder, bool& rNoHook )
 {
   CGAL_POLYOFFSET_TRACE(2,"\nLocating seed for face " << e2str(*aBorder) ) ;
     
   Hook_position lPos ;
   Halfedge_const_handle rSeed = LocateHook(aTime,aBorder->prev(),false,lPos);
+  rNoHook = !handle_assigned(rSeed) ;
   if ( handle_assigned(rSeed) )
   {
     if ( !IsUsedSeed(rSeed) )
@@ -201,11 +215,31 @@ Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::LocateSeed( FT aTime )
 
   Halfedge_const_handle rSeed ;
 
-  for ( typename Halfedge_vector::const_iterator f = mBorders.begin()
-       ; f != mBorders.end() && !handle_assigned(rSeed)
-       ; ++ f
-      )
-    rSeed = LocateSeed(aTime,*f);
+  if ( mLevel >= 0 )
+  {
+    // The visited marks only accumulate at a given time (an incomplete contour only clears those it set), so a face
+    // where no hook is found won't have one later at this time. Such faces are dropped from mSeedBorders, the others
+    // are searched in the order of mBorders as below.
+    std::size_t f = 0, lKept = 0 ;
+    for ( ; f < mSeedBorders.size() && !handle_assigned(rSeed) ; ++ f )
+    {
+      bool lNoHook ;
+      rSeed = LocateSeed(aTime,mBorders[mSeedBorders[f]],lNoHook);
+      if ( !lNoHook )
+        mSeedBorders[lKept ++] = mSeedBorders[f] ;
+    }
+    for ( ; f < mSeedBorders.size() ; ++ f )
+      mSeedBorders[lKept ++] = mSeedBorders[f] ;
+    mSeedBorders.resize(lKept);
+  }
+  else
+  {
+    for ( typename Halfedge_vector::const_iterator f = mBorders.begin()
+         ; f != mBorders.end() && !handle_assigned(rSeed)
+         ; ++ f
+        )
+      rSeed = LocateSeed(aTime,*f);
+  }
   
   CGAL_POLYOFFSET_TRACE(2,"Seed:" << eh2str(rSeed) ) ;
   
@@ -329,6 +363,189 @@ OutputIterator Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::construct_offset_co
   return aOut ;
 }
 
+template<class Ss, class Gt, class Cont, class Visitor>
+template<class InputIterator>
+void Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::SetupLevels( InputIterator aTimesBegin, InputIterator aTimesEnd )
+{
+  mTimes.clear();
+  for ( InputIterator t = aTimesBegin ; t != aTimesEnd ; ++ t )
+    mTimes.push_back( static_cast<FT>(*t) ) ;
+  
+  CGAL_precondition( mTimes.empty() || mTimes.front() > static_cast<FT>(0.0) ) ;
+  CGAL_precondition( std::adjacent_find(mTimes.begin(),mTimes.end(),std::greater<FT>()) == mTimes.end() ) ;
+  
+  int lMaxID = -1 ;
+  for ( typename Vertex_vector::const_iterator v = mNodes.begin() ; v != mNodes.end() ; ++ v )
+    if ( (*v)->id() > lMaxID )
+      lMaxID = (*v)->id() ;
+      
+  mNodeLevels.assign(lMaxID+1,Node_levels());
+  
+  CGAL_POLYOFFSET_TRACE(1,"Constructing offset polygons for " << mTimes.size() << " offsets" ) ;
+}
+
+// Finds the place of the event time of the node among the times by two binary searches, so the exact comparisons
+// are done O(log(times)) times instead of once for each time.
+template<class Ss, class Gt, class Cont, class Visitor>
+void Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::ClassifyNode( std::size_t aIdx )
+{
+  Vertex_const_handle lNode = mNodes[aIdx] ;
+  
+  Node_levels& rL = mNodeLevels[lNode->id()] ;
+  
+  int lCount = static_cast<int>(mTimes.size()) ;
+  
+  if ( lNode->has_infinite_time() )
+  {
+    rL.Lo = rL.Hi = lCount ;
+    return ;
+  }
+  
+  Trisegment_2_ptr lEvent = CreateTrisegment(lNode) ;
+  
+  int lLo = 0, lHi = lCount ;
+  while ( lLo < lHi )
+  {
+    int lMid = ( lLo + lHi ) / 2 ;
+    if ( static_cast<Comparison_result>(Compare_offset_against_event_time_2(mTraits)(mTimes[lMid],lEvent)) == SMALLER )
+         lLo = lMid + 1 ;
+    else lHi = lMid ;
+  }
+  rL.Lo = lLo ;
+  
+  lHi = lCount ;
+  while ( lLo < lHi )
+  {
+    int lMid = ( lLo + lHi ) / 2 ;
+    if ( static_cast<Comparison_result>(Compare_offset_against_event_time_2(mTraits)(mTimes[lMid],lEvent)) != LARGER )
+         lLo = lMid + 1 ;
+    else lHi = lMid ;
+  }
+  rL.Hi = lLo ;
+  
+  CGAL_POLYOFFSET_TRACE(3,"Node " << v2str(*lNode) << " levels [" << rL.Lo << "," << rL.Hi << ")" ) ;
+}
+
+template<class Ss, class Gt, class Cont, class Visitor>
+void Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::ClassifyNodes( Sequential_tag )
+{
+  for ( std::size_t i = 0 ; i < mNodes.size() ; ++ i )
+    ClassifyNode(i);
+}
+
+template<class Ss, class Gt, class Cont, class Visitor>
+void Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::ClassifyNodes( Parallel_tag )
+{
+#ifdef CGAL_LINKED_WITH_TBB
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0,mNodes.size(),256), Classify_nodes(*this));
+#else
+  ClassifyNodes(Sequential_tag());
+#endif
+}
+
+// A face can only hold a hook at the times before the last of its nodes, which are all on the chain of bisectors
+// that LocateSeed() walks back from its border.
+template<class Ss, class Gt, class Cont, class Visitor>
+void Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::SetupBorderLevels()
+{
+  mBorderLevels.assign(mBorders.size(),0);
+  
+  for ( std::size_t i = 0 ; i < mBorders.size() ; ++ i )
+  {
+    int& rLevels = mBorderLevels[i] ;
+    
+    for ( Halfedge_const_handle lBisector = mBorders[i]->prev() ; lBisector->is_bisector() ; lBisector = lBisector->prev() )
+    {
+      Vertex_const_handle lNode = lBisector->vertex() ;
+      if ( lNode->is_skeleton() && mNodeLevels[lNode->id()].Hi > rLevels )
+        rLevels = mNodeLevels[lNode->id()].Hi ;
+    }
+  }
+}
+
+template<class Ss, class Gt, class Cont, class Visitor>
+template<class RandomAccessIterator>
+void Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::TraceLevels( std::size_t aBegin, std::size_t aEnd, RandomAccessIterator aOut )
+{
+  mActiveBorders.clear();
+  for ( std::size_t i = 0 ; i < mBorders.size() ; ++ i )
+    if ( mBorderLevels[i] > static_cast<int>(aBegin) )
+      mActiveBorders.push_back(static_cast<int>(i));
+      
+  for ( std::size_t k = aBegin ; k < aEnd ; ++ k )
+  {
+    mLevel = static_cast<int>(k) ;
+    
+    std::size_t lKept = 0 ;
+    for ( std::size_t i = 0 ; i < mActiveBorders.size() ; ++ i )
+      if ( mBorderLevels[mActiveBorders[i]] > mLevel )
+        mActiveBorders[lKept ++] = mActiveBorders[i] ;
+    mActiveBorders.resize(lKept);
+    
+    mSeedBorders = mActiveBorders ;
+    
+    construct_offset_contours(mTimes[k], std::back_inserter(aOut[k]) ) ;
+  }
+  
+  mLevel = -1 ;
+}
+
+template<class Ss, class Gt, class Cont, class Visitor>
+void Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::ClearLevels()
+{
+  std::vector<FT>         ().swap(mTimes);
+  std::vector<Node_levels>().swap(mNodeLevels);
+  std::vector<int>        ().swap(mBorderLevels);
+  std::vector<int>        ().swap(mActiveBorders);
+  std::vector<int>        ().swap(mSeedBorders);
+}
+
+template<class Ss, class Gt, class Cont, class Visitor>
+template<class InputIterator, class RandomAccessIterator>
+RandomAccessIterator Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::construct_offset_contours( InputIterator        aTimesBegin
+                                                                                             , InputIterator        aTimesEnd
+                                                                                             , RandomAccessIterator aOut
+                                                                                             , Sequential_tag
+                                                                                             )
+{
+  SetupLevels(aTimesBegin,aTimesEnd);
+  ClassifyNodes(Sequential_tag());
+  SetupBorderLevels();
+  
+  TraceLevels(0,mTimes.size(),aOut);
+  
+  RandomAccessIterator rEnd = aOut + mTimes.size() ;
+  
+  ClearLevels();
+  
+  return rEnd ;
+}
+
+template<class Ss, class Gt, class Cont, class Visitor>
+template<class InputIterator, class RandomAccessIterator>
+RandomAccessIterator Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::construct_offset_contours( InputIterator        aTimesBegin
+                                                                                             , InputIterator        aTimesEnd
+                                                                                             , RandomAccessIterator aOut
+                                                                                             , Parallel_tag
+                                                                                             )
+{
+#ifdef CGAL_LINKED_WITH_TBB
+  SetupLevels(aTimesBegin,aTimesEnd);
+  ClassifyNodes(Parallel_tag());
+  SetupBorderLevels();
+  
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0,mTimes.size()), Trace_levels<RandomAccessIterator>(*this,aOut));
+  
+  RandomAccessIterator rEnd = aOut + mTimes.size() ;
+  
+  ClearLevels();
+  
+  return rEnd ;
+#else
+  return construct_offset_contours(aTimesBegin,aTimesEnd,aOut,Sequential_tag());
+#endif
+}
+
 template<class Ss, class Gt, class Cont, class Visitor>
 typename Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::Trisegment_2_ptr
 Polygon_offset_builder_2<Ss,Gt,Cont,Visitor>::CreateTrisegment ( Vertex_const_handle aNode ) const
@@ -73,6 +73,9 @@ template<class Gt, class Ss, class V>
 void Straight_skeleton_builder_2<Gt,Ss,V>::InsertEventInPQ( EventPtr aEvent )
 {
   mPQ.push(aEvent);
+  GetVertexData(aEvent->seed0()).mEventsInMainPQ.push_back(aEvent);
+  if ( aEvent->seed1() != aEvent->seed0() )
+    GetVertexData(aEvent->seed1()).mEventsInMainPQ.push_back(aEvent);
   CGAL_STSKEL_BUILDER_TRACE(4, "Enque: " << *aEvent);
 }
 
@@ -222,22 +225,86 @@ void Straight_skeleton_builder_2<Gt,Ss,V>::CollectSplitEvents( Vertex_handle aNo
                       << " LBorder: E" << lLBorder->id() << " RBorder: E" << lRBorder->id()
                       );
 
-  for ( Halfedge_handle_vector_iterator i = mContourHalfedges.begin(); i != mContourHalfedges.end(); ++ i )
+  // The contour reflex vertices are the first ones in mReflexVertices, so their positions are those in the filter
+  int lReflexIdx = GetVertexData(aNode).mReflexIdx ;
+  
+  if ( aNode->is_contour() && lReflexIdx >= 0 && mSplitEventFilter.has_candidates(lReflexIdx) )
   {
-    Halfedge_handle lOpposite = *i ;
-
-    if ( lOpposite != lLBorder && lOpposite != lRBorder )
+    // The filter kept the edges in the same order as mContourHalfedges
+    std::vector<int> const& lCandidates = mSplitEventFilter.candidates(lReflexIdx) ;
+    
+    CGAL_STSKEL_BUILDER_TRACE(3, lCandidates.size() << " opposite edges left by the filter" ) ;
+    
+    for ( std::vector<int>::const_iterator i = lCandidates.begin(); i != lCandidates.end(); ++ i )
     {
-      Triedge lEventTriedge(lLBorder, lRBorder, lOpposite);
+      Halfedge_handle lOpposite = mContourHalfedges[*i] ;
+
+      if ( lOpposite != lLBorder && lOpposite != lRBorder )
+      {
+        Triedge lEventTriedge(lLBorder, lRBorder, lOpposite);
       
-      if ( lEventTriedge != aPrevEventTriedge )
+        if ( lEventTriedge != aPrevEventTriedge )
+        {
+          CollectSplitEvent(aNode, lEventTriedge ) ;
+        }
+      }
+    }
+    
+    mSplitEventFilter.release(lReflexIdx);
+  }
+  else
+  {
+    for ( Halfedge_handle_vector_iterator i = mContourHalfedges.begin(); i != mContourHalfedges.end(); ++ i )
+    {
+      Halfedge_handle lOpposite = *i ;
+
+      if ( lOpposite != lLBorder && lOpposite != lRBorder )
       {
-        CollectSplitEvent(aNode, lEventTriedge ) ;
+        Triedge lEventTriedge(lLBorder, lRBorder, lOpposite);
+      
+        if ( lEventTriedge != aPrevEventTriedge )
+        {
+          CollectSplitEvent(aNode, lEventTriedge ) ;
+        }
       }
     }
   }
 }
 
+// Runs the split event filter over the contour reflex vertices (see Split_event_filter).
+// Contour vertex k is the target of contour edge k.
+template<class Gt, class Ss, class V>
+void Straight_skeleton_builder_2<Gt,Ss,V>::FilterInitialSplitEvents()
+{
+  std::vector<int> lEdgeIdx(mEdgeID,-1);
+  
+  for ( std::size_t i = 0 ; i < mContourHalfedges.size() ; ++ i )
+  {
+    Halfedge_handle lE = mContourHalfedges[i] ;
+    
+    CGAL_assertion( lE->vertex()->id() == static_cast<int>(i) ) ;
+    
+    lEdgeIdx[lE->id()] = static_cast<int>(i) ;
+    
+    Point_2 const& lS = lE->opposite()->vertex()->point();
+    Point_2 const& lT = lE->vertex()->point();
+    mSplitEventFilter.add_edge( CGAL::to_double(lS.x()), CGAL::to_double(lS.y())
+                              , CGAL::to_double(lT.x()), CGAL::to_double(lT.y())
+                              ) ;
+  }
+  
+  for ( typename Vertex_handle_vector::iterator v = mReflexVertices.begin(), ev = mReflexVertices.end(); v != ev ; ++ v )
+  {
+    Triedge const& lTriedge = GetVertexTriedge(*v);
+    
+    mSplitEventFilter.add_reflex_vertex(lEdgeIdx[lTriedge.e0()->id()],lEdgeIdx[lTriedge.e1()->id()]);
+  }
+  
+  CGAL_STSKEL_BUILDER_TRACE(0, "Filtering the split events of " << mReflexVertices.size() << " reflex vertices...");
+  
+  mSplitEventFilter.run();
+}
+
 
 // Finds and enques all the new potential events produced by the vertex wavefront emerging from 'aNode' (which can be a reflex wavefront).
 // This new events are simply stored in the priority queue, not processed.
@@ -334,8 +401,6 @@ void Straight_skeleton_builder_2<Gt,Ss,V>::HandleSimultaneousEdgeEvent( Vertex_h
 
   SetIsProcessed(aA) ;
   SetIsProcessed(aB) ;
-  mGLAV.remove(aA);
-  mGLAV.remove(aB);
 
   CGAL_STSKEL_BUILDER_TRACE ( 3, 'N' << aA->id() << " processed\nN" << aB->id() << " processed" ) ;
 
@@ -449,6 +514,8 @@ void Straight_skeleton_builder_2<Gt,Ss,V>::CreateInitialEvents()
 {
   Triedge const cNull_triedge ;
   
+  FilterInitialSplitEvents();
+  
   CGAL_STSKEL_BUILDER_TRACE(0, "Creating initial events...");
   for ( Vertex_iterator v = mSSkel->vertices_begin(); v != mSSkel->vertices_end(); ++ v )
   {
@@ -467,7 +534,6 @@ void Straight_skeleton_builder_2<Gt,Ss,V>::CreateContourBisectors()
   CGAL_STSKEL_BUILDER_TRACE(0, "Creating contour bisectors...");
   for ( Vertex_iterator v = mSSkel->vertices_begin(); v != mSSkel->vertices_end(); ++ v )
   {
-    mGLAV.push_back(static_cast<Vertex_handle>(v));
     Vertex_handle lPrev = GetPrevInLAV(v) ;
     Vertex_handle lNext = GetNextInLAV(v) ;
 
@@ -479,7 +545,6 @@ void Straight_skeleton_builder_2<Gt,Ss,V>::CreateContourBisectors()
     }
     else if ( lOrientation == RIGHT_TURN )
     {
-      mReflexVertices.push_back(v);
       SetIsReflex(v);
       CGAL_STSKEL_BUILDER_TRACE(1,"Reflex vertex: N" << v->id() );
     }
@@ -553,7 +618,6 @@ Straight_skeleton_builder_2<Gt,Ss,V>::ConstructEdgeEventNode( EdgeEvent& aEvent
   Vertex_handle lNewNode = mSSkel->SSkel::Base::vertices_push_back( Vertex( mVertexID++, aEvent.point(), aEvent.time(), false, false) ) ;
   InitVertexData(lNewNode);
 
-  mGLAV.push_back(lNewNode);
  
   SetTrisegment(lNewNode,aEvent.trisegment());
  
@@ -565,8 +629,6 @@ Straight_skeleton_builder_2<Gt,Ss,V>::ConstructEdgeEventNode( EdgeEvent& aEvent
 
   SetIsProcessed(lLSeed) ;
   SetIsProcessed(lRSeed) ;
-  mGLAV.remove(lLSeed);
-  mGLAV.remove(lRSeed);
 
   Vertex_handle lLPrev = GetPrevInLAV(lLSeed) ;
   Vertex_handle lRNext = GetNextInLAV(lRSeed) ;
@@ -598,9 +660,24 @@ Straight_skeleton_builder_2<Gt,Ss,V>::LookupOnSLAV ( Halfedge_handle aBorder, Ev
   
   CGAL_STSKEL_BUILDER_TRACE ( 3, "Looking up for E" << aBorder->id() << ". P=" << aEvent->point() ) ;
    
-  for ( typename std::list<Vertex_handle>::const_iterator vi = mGLAV.begin(); vi != mGLAV.end(); ++ vi )
+  // Only the unprocessed vertices filed under aBorder can match, and they are visited in the order they entered
+  // the SLAV. The processed ones are dropped on the way.
+  Vertex_handle_vector* lNodes = static_cast<std::size_t>(aBorder->id()) < mSLAVByBorder.size() ? &mSLAVByBorder[aBorder->id()] : 0 ;
+  
+  std::size_t lKept = 0 ;
+  std::size_t lSize = lNodes ? lNodes->size() : 0 ;
+  
+  for ( std::size_t i = 0 ; i < lSize ; ++ i )
   {
-    Vertex_handle v = *vi;
+    Vertex_handle v = (*lNodes)[i];
+    
+    if ( IsProcessed(v) )
+      continue ;
+      
+    (*lNodes)[lKept ++] = v ;
+      
+    if ( handle_assigned(rResult.first) )
+      continue ;
     
     Triedge const& lTriedge = GetVertexTriedge(v);
       
@@ -634,7 +711,6 @@ Straight_skeleton_builder_2<Gt,Ss,V>::LookupOnSLAV ( Halfedge_handle aBorder, Ev
                                     << ( rSite == AT_SOURCE ? "SOURCE vertex" : ( rSite == AT_TARGET ? "TARGET vertex" : "strict inside" ) )
                                     << " of the offset edge."
                                     ) ;
-          break ;
         }
         else
         {
@@ -644,6 +720,9 @@ Straight_skeleton_builder_2<Gt,Ss,V>::LookupOnSLAV ( Halfedge_handle aBorder, Ev
     }
   }
   
+  if ( lNodes )
+    lNodes->resize(lKept, Vertex_handle());
+  
 #ifdef CGAL_STRAIGHT_SKELETON_ENABLE_TRACE
   if ( !handle_assigned(rResult.first) )
   {
@@ -681,15 +760,12 @@ Straight_skeleton_builder_2<Gt,Ss,V>::ConstructSplitEventNodes( SplitEvent& aEve
   SetTrisegment(lNewNodeA,aEvent.trisegment());
   SetTrisegment(lNewNodeB,aEvent.trisegment());
 
-  mGLAV.push_back(lNewNodeA);
-  mGLAV.push_back(lNewNodeB);
   
   Vertex_handle lSeed = aEvent.seed0() ;
  
   CGAL_STSKEL_BUILDER_TRACE ( 3, "Seed: N" << lSeed->id() << " processed" ) ;
   
   SetIsProcessed(lSeed) ;
-  mGLAV.remove(lSeed);
 
   CGAL_STSKEL_BUILDER_TRACE ( 2, 'N' << lNewNodeA->id() << " and N" << lNewNodeB->id() << " inserted into LAV." ) ;
 
@@ -731,8 +807,6 @@ Straight_skeleton_builder_2<Gt,Ss,V>::ConstructPseudoSplitEventNodes( PseudoSpli
   Vertex_handle lNewNodeA = mSSkel->SSkel::Base::vertices_push_back( Vertex( mVertexID++, aEvent.point(), aEvent.time(), true, false ) ) ;
   Vertex_handle lNewNodeB = mSSkel->SSkel::Base::vertices_push_back( Vertex( mVertexID++, aEvent.point(), aEvent.time(), true, false ) ) ;
 
-  mGLAV.push_back(lNewNodeA);
-  mGLAV.push_back(lNewNodeB);
   
   InitVertexData(lNewNodeA);
   InitVertexData(lNewNodeB);
@@ -749,8 +823,6 @@ Straight_skeleton_builder_2<Gt,Ss,V>::ConstructPseudoSplitEventNodes( PseudoSpli
   
   SetIsProcessed(lLSeed) ;
   SetIsProcessed(lRSeed) ;
-  mGLAV.remove(lLSeed);
-  mGLAV.remove(lRSeed);
 
   Vertex_handle lLPrev = GetPrevInLAV(lLSeed) ;
   Vertex_handle lLNext = GetNextInLAV(lLSeed) ;
@@ -1092,7 +1164,6 @@ void Straight_skeleton_builder_2<Gt,Ss,V>::SetupNewNode( Vertex_handle aNode )
     }
     else if ( lOrientation == RIGHT_TURN )
     {
-      mReflexVertices.push_back(aNode);
       SetIsReflex(aNode);
       CGAL_STSKEL_BUILDER_TRACE(1, "Reflex *NEW* vertex: N" << aNode->id()  << " (E" << lLE->id() << ",E" << lRE->id() << ")" );
     }
@@ -1301,9 +1372,22 @@ void Straight_skeleton_builder_2<Gt,Ss,V>::InsertNextSplitEventInPQ( Vertex_hand
 template<class Gt, class Ss, class V>
 void Straight_skeleton_builder_2<Gt,Ss,V>::InsertNextSplitEventsInPQ()
 {
-  for ( typename Vertex_handle_vector::iterator v = mReflexVertices.begin(), ev = mReflexVertices.end(); v != ev ; ++ v )
-    if ( !IsProcessed(*v) )
-      InsertNextSplitEventInPQ(*v);
+  // Only the reflex vertices that are new or whose split event left the main PQ can have one to put in it.
+  // They are taken in the order of mReflexVertices.
+  if ( mReflexVerticesToUpdate.size() > 1 )
+  {
+    std::sort(mReflexVerticesToUpdate.begin(),mReflexVerticesToUpdate.end());
+    mReflexVerticesToUpdate.erase(std::unique(mReflexVerticesToUpdate.begin(),mReflexVerticesToUpdate.end()),mReflexVerticesToUpdate.end());
+  }
+  
+  for ( std::vector<int>::const_iterator i = mReflexVerticesToUpdate.begin(), ei = mReflexVerticesToUpdate.end(); i != ei ; ++ i )
+  {
+    Vertex_handle v = mReflexVertices[*i] ;
+    if ( !IsProcessed(v) )
+      InsertNextSplitEventInPQ(v);
+  }
+  
+  mReflexVerticesToUpdate.clear();
 }
 
 template<class Gt, class Ss, class V>
@@ -20,14 +20,102 @@
 #define CGAL_STRAIGHT_SKELETON_BUILDER_EVENTS_2_H 1
 
 #include<ostream>
+#include<new>
+#include<vector>
 
 #include <CGAL/Straight_skeleton_2/Straight_skeleton_aux.h>
 
+// The events are allocated from per-thread free lists of blocks (see Event_allocator) unless this is defined.
+// Without C++11 thread_local, the lists are only used when CGAL_HAS_THREADS is not defined.
+#if !defined(CGAL_STSKEL_NO_EVENT_POOL)
+#  if !defined(CGAL_HAS_THREADS)
+#    define CGAL_STSKEL_EVENT_POOL_TLS
+#  elif defined(__GNUC__) && ( __GNUC__ * 100 + __GNUC_MINOR__ ) >= 408 && __cplusplus >= 201103L
+#    define CGAL_STSKEL_EVENT_POOL_TLS thread_local
+#  else
+#    define CGAL_STSKEL_NO_EVENT_POOL
+#  endif
+#endif
+
 namespace CGAL {
 
 namespace CGAL_SS_i
 {
 
+// A construction creates and releases lots of events of three sizes, so each event class gets its
+// operator new/delete from a free list of blocks of its size.
+// A block goes back to the list of the thread that releases it; the lists are freed at thread exit.
+template<class Event_>
+class Event_allocator
+{
+  struct Block { Block* mNext ; } ;
+  
+  struct Free_list
+  {
+    Free_list() : mHead(0) {}
+    
+    ~Free_list()
+    {
+      while ( mHead )
+      {
+        Block* lBlock = mHead ;
+        mHead = mHead->mNext ;
+        ::operator delete(lBlock);
+      }
+    }
+      
+    Block* mHead ;
+  } ;
+  
+#if !defined(CGAL_STSKEL_NO_EVENT_POOL)
+  static Free_list& GetFreeList()
+  {
+    static CGAL_STSKEL_EVENT_POOL_TLS Free_list sFreeList ;
+    return sFreeList ;
+  }
+#endif
+
+public:
+
+  static void* allocate( std::size_t aSize )
+  {
+#if !defined(CGAL_STSKEL_NO_EVENT_POOL)
+    if ( aSize == sizeof(Event_) )
+    {
+      Free_list& lList = GetFreeList();
+      if ( lList.mHead )
+      {
+        Block* rBlock = lList.mHead ;
+        lList.mHead = rBlock->mNext ;
+        return rBlock ;
+      }
+    }
+#endif
+    return ::operator new(aSize);
+  }
+  
+  static void deallocate( void* aP, std::size_t aSize )
+  {
+#if !defined(CGAL_STSKEL_NO_EVENT_POOL)
+    if ( aP && aSize == sizeof(Event_) )
+    {
+      Free_list& lList = GetFreeList();
+      Block* lBlock = static_cast<Block*>(aP);
+      lBlock->mNext = lList.mHead ;
+      lList.mHead = lBlock ;
+      return ;
+    }
+#else
+    (void)aSize;
+#endif
+    ::operator delete(aP);
+  }
+} ;
+
+#define CGAL_STSKEL_POOLED_EVENT(Event_) \
+  static void* operator new   ( std::size_t aSize )            { return Event_allocator<Event_>::allocate(aSize) ; } \
+  static void  operator delete( void* aP, std::size_t aSize )  { Event_allocator<Event_>::deallocate(aP,aSize) ; }
+
 template<class SSkel_, class Traits_>
 class Event_2 : public Ref_counted_base
 {
@@ -59,6 +147,7 @@ public:
     :
      mTriedge   (aTriedge)
     ,mTrisegment(aTrisegment)
+    ,mPQIndex   (-1)
   {}
 
   virtual ~ Event_2() {}
@@ -75,6 +164,10 @@ public:
 
   void SetTimeAndPoint( FT aTime, Point_2 const& aP ) { mTime = aTime ; mP = aP ; }
 
+  // Position in the builder's main event queue, -1 if not in it
+  int  pq_index() const { return mPQIndex ; }
+  void SetPQIndex( int aIdx ) { mPQIndex = aIdx ; }
+
   friend std::ostream& operator<< ( std::ostream& ss, Self const& e )
   {
     ss << "[" ;
@@ -94,6 +187,7 @@ private :
   Trisegment_2_ptr mTrisegment ;
   Point_2          mP ;
   FT               mTime ;
+  int              mPQIndex ;
 } ;
 
 template<class SSkel_, class Traits_>
@@ -124,6 +218,8 @@ public:
     , mRSeed(aRSeed)
   {}
 
+  CGAL_STSKEL_POOLED_EVENT(Edge_event_2)
+
   virtual Type type() const { return this->cEdgeEvent ; }
 
   virtual Vertex_handle seed0() const { return mLSeed ; }
@@ -169,6 +265,8 @@ public:
     , mSeed(aSeed)
   {}
 
+  CGAL_STSKEL_POOLED_EVENT(Split_event_2)
+
   virtual Type type() const { return this->cSplitEvent ; }
 
   virtual Vertex_handle seed0() const { return mSeed ; }
@@ -222,6 +320,8 @@ public:
     , mOppositeIs0(aOppositeIs0)
   {}
 
+  CGAL_STSKEL_POOLED_EVENT(Pseudo_split_event_2)
+
   virtual Type type() const { return this->cPseudoSplitEvent ; }
 
   virtual Vertex_handle seed0() const { return mSeed0 ; }
@@ -252,6 +352,96 @@ private :
   bool          mOppositeIs0 ;
 } ;
 
+// The builder's main event queue: a binary heap whose events know their position in it (Event_2::pq_index()),
+// so that an event that can no longer happen is erased from it at once instead of being popped and skipped later.
+// 'Compare' is the strict order of std::priority_queue: the top is the event no other event compares less than.
+template<class EventPtr_, class Compare_>
+class Event_queue
+{
+  typedef EventPtr_ EventPtr ;
+  typedef Compare_  Compare ;
+  
+public:
+
+  Event_queue( Compare const& aCompare ) : mCompare(aCompare) {}
+
+  bool        empty() const { return mHeap.empty() ; }
+  std::size_t size () const { return mHeap.size () ; }
+  
+  EventPtr const& top() const { return mHeap.front() ; }
+
+  void push( EventPtr const& aEvent )
+  {
+    CGAL_precondition( aEvent->pq_index() < 0 ) ;
+    mHeap.push_back(aEvent);
+    SiftUp(mHeap.size() - 1, aEvent);
+  }
+  
+  void pop() { Erase(0) ; }
+  
+  // Does nothing if aEvent is not in the queue
+  void erase( EventPtr const& aEvent )
+  {
+    if ( aEvent->pq_index() >= 0 )
+      Erase( static_cast<std::size_t>(aEvent->pq_index()) ) ;
+  }
+
+private:
+
+  void Place( std::size_t aIdx, EventPtr const& aEvent )
+  {
+    mHeap[aIdx] = aEvent ;
+    aEvent->SetPQIndex( static_cast<int>(aIdx) ) ;
+  }
+  
+  void Erase( std::size_t aIdx )
+  {
+    mHeap[aIdx]->SetPQIndex(-1);
+    EventPtr lLast = mHeap.back() ;
+    mHeap.pop_back();
+    if ( aIdx < mHeap.size() )
+    {
+      if ( aIdx > 0 && mCompare(mHeap[(aIdx - 1) / 2],lLast) )
+           SiftUp  (aIdx, lLast);
+      else SiftDown(aIdx, lLast);
+    }
+  }
+  
+  void SiftUp( std::size_t aIdx, EventPtr aEvent )
+  {
+    while ( aIdx > 0 )
+    {
+      std::size_t lParent = ( aIdx - 1 ) / 2 ;
+      if ( !mCompare(mHeap[lParent],aEvent) )
+        break ;
+      Place(aIdx, mHeap[lParent]);
+      aIdx = lParent ;
+    }
+    Place(aIdx, aEvent);
+  }
+  
+  void SiftDown( std::size_t aIdx, EventPtr aEvent )
+  {
+    std::size_t lSize = mHeap.size();
+    for ( ;; )
+    {
+      std::size_t lChild = 2 * aIdx + 1 ;
+      if ( lChild >= lSize )
+        break ;
+      if ( lChild + 1 < lSize && mCompare(mHeap[lChild],mHeap[lChild + 1]) )
+        ++ lChild ;
+      if ( !mCompare(aEvent,mHeap[lChild]) )
+        break ;
+      Place(aIdx, mHeap[lChild]);
+      aIdx = lChild ;
+    }
+    Place(aIdx, aEvent);
+  }
+  
+  Compare               mCompare ;
+  std::vector<EventPtr> mHeap ;
+} ;
+
 }
 
 } // end namespace CGAL
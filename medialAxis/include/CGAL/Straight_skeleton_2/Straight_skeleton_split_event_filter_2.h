@@ -0,0 +1,357 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+#ifndef CGAL_STRAIGHT_SKELETON_SPLIT_EVENT_FILTER_2_H
+#define CGAL_STRAIGHT_SKELETON_SPLIT_EVENT_FILTER_2_H 1
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+// Number of reflex vertices below which Split_event_filter does not bother with several threads.
+#ifndef CGAL_STSKEL_PARALLEL_SPLIT_FILTER_MIN_REFLEX
+#  define CGAL_STSKEL_PARALLEL_SPLIT_FILTER_MIN_REFLEX 256
+#endif
+
+namespace CGAL {
+
+namespace CGAL_SS_i
+{
+
+//
+// Each reflex contour vertex must be tested against every other contour edge for a split event, and each of these
+// tests constructs a trisegment and runs exact predicates on it.
+// This filter throws away, in double precision but conservatively, the opposite edges whose split event would
+// happen after the reflex vertex is necessarily gone:
+//
+//   Until its event, the vertex moves along its bisector as q + t*w and stays inside the offset polygon at time t,
+//   which is at distance >= t from every contour edge. If the ray from q hits some contour edge at time T, the vertex
+//   is thus gone before T. The split event against the edge with line n.x = c happens when n.(q + t*w) - c = t,
+//   that is at t = (n.q - c) / (1 - n.w), and the edge is discarded if that time is after T.
+//
+// The ray is shot across a uniform grid of the contour edges. The bounds are checked against the actual distance
+// at T and all the comparisons have generous error margins, so the surviving edges are a superset of those that
+// produce a split event. Nothing is discarded for a vertex whose bound is unknown.
+//
+// The vertices are independent, so they are filtered by several threads when CGAL is linked with TBB.
+//
+class Split_event_filter
+{
+  struct Edge
+  {
+    double sx, sy, tx, ty ; // source and target
+    double nx, ny, c ;      // unit normal pointing inside, and n.source
+  } ;
+
+  struct Reflex_vertex
+  {
+    int mIn, mOut ; // the edge ending at the vertex and the edge starting at it
+  } ;
+
+  struct Filter_range
+  {
+    Filter_range( Split_event_filter* aFilter ) : mFilter(aFilter) {}
+
+#ifdef CGAL_LINKED_WITH_TBB
+    void operator() ( tbb::blocked_range<std::size_t> const& aRange ) const
+    {
+      for ( std::size_t i = aRange.begin() ; i != aRange.end() ; ++ i )
+        mFilter->FilterVertex(i);
+    }
+#endif
+
+    Split_event_filter* mFilter ;
+  } ;
+
+public:
+
+  Split_event_filter() : mScale(0.0) {}
+
+  // Contour edge number size() goes from (aSX,aSY) to (aTX,aTY) with the polygon on its left
+  void add_edge( double aSX, double aSY, double aTX, double aTY )
+  {
+    Edge lE ;
+    lE.sx = aSX ; lE.sy = aSY ; lE.tx = aTX ; lE.ty = aTY ;
+    double lDX = aTX - aSX, lDY = aTY - aSY ;
+    double lL  = std::sqrt(lDX*lDX + lDY*lDY) ;
+    if ( lL > 0 )
+    {
+      lE.nx = -lDY / lL ;
+      lE.ny =  lDX / lL ;
+    }
+    else lE.nx = lE.ny = 0 ;
+    lE.c = lE.nx * aSX + lE.ny * aSY ;
+    mEdges.push_back(lE);
+    mScale = (std::max)( mScale, (std::max)( (std::max)(std::fabs(aSX),std::fabs(aSY))
+                                           , (std::max)(std::fabs(aTX),std::fabs(aTY))
+                                           )
+                       ) ;
+  }
+
+  // Reflex vertex number reflex_vertices_size(), where edge aIn ends and edge aOut starts
+  void add_reflex_vertex( int aIn, int aOut )
+  {
+    Reflex_vertex lV ;
+    lV.mIn  = aIn ;
+    lV.mOut = aOut ;
+    mReflexVertices.push_back(lV);
+  }
+
+  std::size_t size() const { return mEdges.size() ; }
+
+  std::size_t reflex_vertices_size() const { return mReflexVertices.size() ; }
+
+  void run()
+  {
+    mCandidates.assign(mReflexVertices.size(), std::vector<int>());
+    mReleased  .assign(mReflexVertices.size(), false);
+
+    BuildGrid();
+
+#ifdef CGAL_LINKED_WITH_TBB
+    if ( mReflexVertices.size() >= CGAL_STSKEL_PARALLEL_SPLIT_FILTER_MIN_REFLEX )
+    {
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0,mReflexVertices.size()), Filter_range(this));
+      return ;
+    }
+#endif
+    for ( std::size_t i = 0 ; i < mReflexVertices.size() ; ++ i )
+      FilterVertex(i);
+  }
+
+  // True if run() gave the candidates of reflex vertex aIdx and they were not released
+  bool has_candidates( std::size_t aIdx ) const { return aIdx < mCandidates.size() && !mReleased[aIdx] ; }
+
+  // The edges that can produce a split event with reflex vertex aIdx, in increasing order
+  std::vector<int> const& candidates( std::size_t aIdx ) const { return mCandidates[aIdx] ; }
+
+  // Frees the candidates of reflex vertex aIdx once they are used
+  void release( std::size_t aIdx )
+  {
+    std::vector<int>().swap(mCandidates[aIdx]) ;
+    mReleased[aIdx] = true ;
+  }
+
+private:
+
+  double Tolerance() const { return 1e-9 * mScale ; }
+
+  void BuildGrid()
+  {
+    mCellStart.clear();
+    mCellEdges.clear();
+
+    if ( mEdges.empty() )
+      return ;
+
+    mMinX = mMaxX = mEdges[0].sx ;
+    mMinY = mMaxY = mEdges[0].sy ;
+    for ( std::size_t i = 0 ; i < mEdges.size() ; ++ i )
+    {
+      mMinX = (std::min)(mMinX,mEdges[i].sx) ; mMaxX = (std::max)(mMaxX,mEdges[i].sx) ;
+      mMinY = (std::min)(mMinY,mEdges[i].sy) ; mMaxY = (std::max)(mMaxY,mEdges[i].sy) ;
+    }
+
+    // About one edge per cell for a square domain
+    double lW = mMaxX - mMinX, lH = mMaxY - mMinY ;
+    double lCell = std::sqrt( (std::max)(lW * lH, 0.0) / double(mEdges.size()) ) ;
+    if ( !( lCell > 0 ) )
+      lCell = (std::max)( (std::max)(lW,lH), 1.0 ) ;
+    mNX = (std::min)( int(lW / lCell) + 1, 4096 ) ;
+    mNY = (std::min)( int(lH / lCell) + 1, 4096 ) ;
+    mCellW = lW > 0 ? lW / mNX : 1.0 ;
+    mCellH = lH > 0 ? lH / mNY : 1.0 ;
+
+    // Counting pass then filling pass, each edge going to the cells its bounding box overlaps
+    mCellStart.assign(std::size_t(mNX) * mNY + 1, 0);
+    for ( int lPass = 0 ; lPass < 2 ; ++ lPass )
+    {
+      for ( std::size_t i = 0 ; i < mEdges.size() ; ++ i )
+      {
+        Edge const& lE = mEdges[i] ;
+        int lX0 = CellX((std::min)(lE.sx,lE.tx)), lX1 = CellX((std::max)(lE.sx,lE.tx)) ;
+        int lY0 = CellY((std::min)(lE.sy,lE.ty)), lY1 = CellY((std::max)(lE.sy,lE.ty)) ;
+        for ( int y = lY0 ; y <= lY1 ; ++ y )
+          for ( int x = lX0 ; x <= lX1 ; ++ x )
+          {
+            std::size_t lCell = std::size_t(y) * mNX + x ;
+            if ( lPass == 0 )
+                 ++ mCellStart[lCell + 1] ;
+            else mCellEdges[mCellFill[lCell] ++] = int(i) ;
+          }
+      }
+      if ( lPass == 0 )
+      {
+        for ( std::size_t c = 1 ; c < mCellStart.size() ; ++ c )
+          mCellStart[c] += mCellStart[c - 1] ;
+        mCellEdges.resize(mCellStart.back());
+        mCellFill.assign(mCellStart.begin(), mCellStart.end() - 1);
+      }
+    }
+    std::vector<std::size_t>().swap(mCellFill);
+  }
+
+  int CellX( double aX ) const { return (std::max)( 0, (std::min)( mNX - 1, int( (aX - mMinX) / mCellW ) ) ) ; }
+  int CellY( double aY ) const { return (std::max)( 0, (std::min)( mNY - 1, int( (aY - mMinY) / mCellH ) ) ) ; }
+
+  // Distance from (aX,aY) to edge aE
+  double Distance( Edge const& aE, double aX, double aY ) const
+  {
+    double lDX = aE.tx - aE.sx, lDY = aE.ty - aE.sy ;
+    double lL2 = lDX*lDX + lDY*lDY ;
+    double lS  = lL2 > 0 ? ( (aX - aE.sx) * lDX + (aY - aE.sy) * lDY ) / lL2 : 0.0 ;
+    lS = (std::max)( 0.0, (std::min)( 1.0, lS ) ) ;
+    double lPX = aE.sx + lS * lDX - aX, lPY = aE.sy + lS * lDY - aY ;
+    return std::sqrt(lPX*lPX + lPY*lPY) ;
+  }
+
+  // Time at which the ray q + t*w hits edge aE, if it does and the bound it gives is safe; infinity otherwise
+  double HitTime( Edge const& aE, double aQX, double aQY, double aWX, double aWY ) const
+  {
+    double const cInf = std::numeric_limits<double>::infinity() ;
+
+    double lDX = aE.tx - aE.sx, lDY = aE.ty - aE.sy ;
+    double lDen = aWX * lDY - aWY * lDX ;
+    if ( lDen == 0 )
+      return cInf ;
+
+    double lAX = aE.sx - aQX, lAY = aE.sy - aQY ;
+    double lT = ( lAX * lDY - lAY * lDX ) / lDen ;
+    double lS = ( lAX * aWY - lAY * aWX ) / lDen ;
+    if ( !( lT > 0 ) || lS < 0 || lS > 1 )
+      return cInf ;
+
+    // The vertex must be at distance < t from the edge at time t for t to bound its lifetime
+    if ( Distance(aE, aQX + lT * aWX, aQY + lT * aWY) + Tolerance() < lT )
+         return lT ;
+    else return cInf ;
+  }
+
+  // An upper bound of the time at which the reflex vertex at aQ with velocity aW is gone, infinity if none is found.
+  // The cells crossed by the ray are visited in order (Amanatides and Woo) until one is left after the first hit.
+  double LifetimeBound( double aQX, double aQY, double aWX, double aWY, int aIn, int aOut ) const
+  {
+    double const cInf = std::numeric_limits<double>::infinity() ;
+
+    double rBound = cInf ;
+
+    if ( mCellStart.empty() )
+      return rBound ;
+
+    int x = CellX(aQX), y = CellY(aQY) ;
+
+    int    lStepX  = aWX > 0 ? 1 : -1 ;
+    int    lStepY  = aWY > 0 ? 1 : -1 ;
+    double lNextX  = mMinX + ( x + ( aWX > 0 ? 1 : 0 ) ) * mCellW ;
+    double lNextY  = mMinY + ( y + ( aWY > 0 ? 1 : 0 ) ) * mCellH ;
+    double lTMaxX  = aWX != 0 ? ( lNextX - aQX ) / aWX : cInf ;
+    double lTMaxY  = aWY != 0 ? ( lNextY - aQY ) / aWY : cInf ;
+    double lDeltaX = aWX != 0 ? mCellW / std::fabs(aWX) : cInf ;
+    double lDeltaY = aWY != 0 ? mCellH / std::fabs(aWY) : cInf ;
+
+    for ( ;; )
+    {
+      std::size_t lCell = std::size_t(y) * mNX + x ;
+      for ( std::size_t k = mCellStart[lCell] ; k < mCellStart[lCell + 1] ; ++ k )
+      {
+        int lE = mCellEdges[k] ;
+        if ( lE != aIn && lE != aOut )
+          rBound = (std::min)( rBound, HitTime(mEdges[lE], aQX, aQY, aWX, aWY) ) ;
+      }
+
+      double lExit = (std::min)(lTMaxX,lTMaxY) ;
+      if ( rBound <= lExit )
+        break ;
+
+      if ( lTMaxX < lTMaxY )
+      {
+        x += lStepX ;
+        lTMaxX += lDeltaX ;
+      }
+      else
+      {
+        y += lStepY ;
+        lTMaxY += lDeltaY ;
+      }
+      if ( x < 0 || x >= mNX || y < 0 || y >= mNY )
+        break ;
+    }
+
+    return rBound ;
+  }
+
+  void FilterVertex( std::size_t aIdx )
+  {
+    Reflex_vertex const& lV   = mReflexVertices[aIdx] ;
+    Edge          const& lIn  = mEdges[lV.mIn ] ;
+    Edge          const& lOut = mEdges[lV.mOut] ;
+
+    std::vector<int>& rCandidates = mCandidates[aIdx] ;
+
+    double lQX = lOut.sx, lQY = lOut.sy ;
+
+    // The velocity w solves nin.w = 1 and nout.w = 1
+    double lDet = lIn.nx * lOut.ny - lIn.ny * lOut.nx ;
+    double lBound = std::numeric_limits<double>::infinity() ;
+    double lWX = 0, lWY = 0 ;
+    if ( std::fabs(lDet) > 1e-6 )
+    {
+      lWX = ( lOut.ny - lIn.ny ) / lDet ;
+      lWY = ( lIn.nx - lOut.nx ) / lDet ;
+      lBound = LifetimeBound(lQX, lQY, lWX, lWY, lV.mIn, lV.mOut) ;
+    }
+
+    double lTolD = Tolerance() ;
+    double lTolW = 1e-9 * ( 1.0 + std::fabs(lWX) + std::fabs(lWY) ) ;
+
+    for ( std::size_t i = 0 ; i < mEdges.size() ; ++ i )
+    {
+      if ( int(i) == lV.mIn || int(i) == lV.mOut )
+        continue ;
+
+      if ( lBound < std::numeric_limits<double>::infinity() )
+      {
+        Edge const& lE = mEdges[i] ;
+        double lD0  = lE.nx * lQX + lE.ny * lQY - lE.c - lTolD ;
+        double lDen = 1.0 - ( lE.nx * lWX + lE.ny * lWY ) + lTolW ;
+        if ( lD0 > 0 && lD0 > (std::max)(lDen,0.0) * lBound )
+          continue ;
+      }
+      rCandidates.push_back(int(i));
+    }
+  }
+
+  std::vector<Edge>          mEdges ;
+  std::vector<Reflex_vertex> mReflexVertices ;
+  double                     mScale ;
+
+  // The grid
+  double                   mMinX, mMinY, mMaxX, mMaxY, mCellW, mCellH ;
+  int                      mNX, mNY ;
+  std::vector<std::size_t> mCellStart ;
+  std::vector<int>         mCellEdges ;
+  std::vector<std::size_t> mCellFill ;
+
+  std::vector< std::vector<int> > mCandidates ;
+  std::vector<bool>               mReleased ;
+} ;
+
+} // namespace CGAL_SS_i
+
+} // end namespace CGAL
+
+#endif // CGAL_STRAIGHT_SKELETON_SPLIT_EVENT_FILTER_2_H //
+// EOF //
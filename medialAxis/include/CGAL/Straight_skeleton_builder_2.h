@@ -34,6 +34,7 @@
 #include <CGAL/algorithm.h>
 #include <CGAL/Straight_skeleton_2/Straight_skeleton_aux.h>
 #include <CGAL/Straight_skeleton_2/Straight_skeleton_builder_events_2.h>
+#include <CGAL/Straight_skeleton_2/Straight_skeleton_split_event_filter_2.h>
 #include <CGAL/Straight_skeleton_2.h>
 #include <CGAL/Straight_skeleton_builder_traits_2.h>
 #include <CGAL/HalfedgeDS_const_decorator.h>
@@ -217,6 +218,14 @@ private :
     }
   } ;
   
+  struct Vertex_ID_compare : std::binary_function<bool,Vertex_handle,Vertex_handle>
+  {
+    bool operator() ( Vertex_handle const& aA, Vertex_handle const& aB ) const
+    {
+      return aA->id() < aB->id() ;
+    }
+  } ;
+  
 public:
 
   Straight_skeleton_builder_2 ( boost::optional<FT> aMaxTime = boost::none, Traits const& = Traits(), Visitor const& aVisitor = Visitor() ) ;
@@ -244,6 +253,8 @@ private :
 
   typedef std::priority_queue<EventPtr,std::vector<EventPtr>,Event_compare> PQ ;
 
+  typedef CGAL_SS_i::Event_queue<EventPtr,Event_compare> Event_queue ;
+
 
   struct Vertex_data : public Ref_counted_base
   {
@@ -256,6 +267,7 @@ private :
       , mIsExcluded(false)
       , mPrevInLAV(-1)
       , mNextInLAV(-1)
+      , mReflexIdx(-1)
       , mNextSplitEventInMainPQ(false)
       , mSplitEvents(aComparer)
     {}
@@ -267,8 +279,10 @@ private :
     bool              mIsExcluded ;
     int               mPrevInLAV ;
     int               mNextInLAV ;
+    int               mReflexIdx ; // Position in mReflexVertices, -1 if not reflex
     bool              mNextSplitEventInMainPQ;
     PQ                mSplitEvents ;
+    EventPtr_Vector   mEventsInMainPQ ; // The events of the main PQ seeded by this vertex (some may have left it)
     Triedge           mTriedge ; // Here, E0,E1 corresponds to the vertex (unlike *event* triedges)
     Trisegment_2_ptr  mTrisegment ; // Skeleton nodes cache the full trisegment tree that defines the originating event
   } ;
@@ -320,9 +334,21 @@ private :
     return GetVertexData(aV).mTriedge ;
   }
   
+  // Also files aV under the edge E0 of aTriedge for LookupOnSLAV()
   void SetVertexTriedge ( Vertex_handle aV, Triedge const& aTriedge )
   {
     GetVertexData(aV).mTriedge = aTriedge ;
+    
+    if ( handle_assigned(aTriedge.e0()) )
+    {
+      std::size_t lIdx = static_cast<std::size_t>(aTriedge.e0()->id()) ;
+      if ( lIdx >= mSLAVByBorder.size() )
+        mSLAVByBorder.resize(lIdx + 1);
+      Vertex_handle_vector& lNodes = mSLAVByBorder[lIdx] ;
+      if ( lNodes.empty() || lNodes.back()->id() < aV->id() )
+           lNodes.push_back(aV);
+      else lNodes.insert(std::upper_bound(lNodes.begin(),lNodes.end(),aV,Vertex_ID_compare()),aV);
+    }
   }
   
   Segment_2 CreateSegment ( Halfedge_const_handle aH ) const
@@ -416,7 +442,11 @@ private :
 
   void SetIsReflex ( Vertex_handle aV )
   {
-    GetVertexData(aV).mIsReflex = true ;
+    Vertex_data& lData = GetVertexData(aV) ;
+    lData.mIsReflex  = true ;
+    lData.mReflexIdx = static_cast<int>(mReflexVertices.size()) ;
+    mReflexVertices.push_back(aV);
+    mReflexVerticesToUpdate.push_back(lData.mReflexIdx);
   }
 
   bool IsReflex ( Vertex_handle aV )
@@ -434,9 +464,16 @@ private :
     return GetVertexData(aV).mIsDegenerate ;
   }
   
+  // The events of a processed vertex can't happen anymore so they are taken out of the main PQ right away
   void SetIsProcessed ( Vertex_handle aV )
   {
-    GetVertexData(aV).mIsProcessed = true ;
+    Vertex_data& lData = GetVertexData(aV) ;
+    
+    lData.mIsProcessed = true ;
+    
+    for ( typename EventPtr_Vector::iterator i = lData.mEventsInMainPQ.begin(), ei = lData.mEventsInMainPQ.end() ; i != ei ; ++ i )
+      mPQ.erase(*i);
+    EventPtr_Vector().swap(lData.mEventsInMainPQ);
 
     mVisitor.on_vertex_processed(aV);
   }
@@ -477,7 +514,10 @@ private :
 
   void AllowNextSplitEvent ( Vertex_handle aV )
   {
-    GetVertexData(aV).mNextSplitEventInMainPQ = false ;
+    Vertex_data& lData = GetVertexData(aV) ;
+    lData.mNextSplitEventInMainPQ = false ;
+    if ( lData.mReflexIdx >= 0 )
+      mReflexVerticesToUpdate.push_back(lData.mReflexIdx);
   }  
   
   void InsertEventInPQ( EventPtr aEvent ) ;
@@ -680,6 +720,8 @@ private :
 
   void CollectSplitEvents( Vertex_handle aNode, Triedge const& aPrevEventTriedge  ) ;
 
+  void FilterInitialSplitEvents() ;
+
   EventPtr FindEdgeEvent( Vertex_handle aLNode, Vertex_handle aRNode, Triedge const& aPrevEventTriedge  ) ;
 
   void HandleSimultaneousEdgeEvent( Vertex_handle aA, Vertex_handle aB ) ;
@@ -742,10 +784,16 @@ private:
   std::vector<Vertex_data_ptr> mVertexData ;
   
   Vertex_handle_vector   mReflexVertices ;
+  std::vector<int>       mReflexVerticesToUpdate ; // Those that may have a split event to put in the main PQ
   Halfedge_handle_vector mDanglingBisectors ;
   Halfedge_handle_vector mContourHalfedges ;
 
-  std::list<Vertex_handle> mGLAV ;
+  // The opposite edges of the initial split events of the contour reflex vertices, see FilterInitialSplitEvents()
+  CGAL_SS_i::Split_event_filter mSplitEventFilter ;
+
+  // The vertices of the current polygons (the SLAV) by the contour edge E0 of their triedge, in increasing ID order.
+  // Processed vertices left the SLAV: LookupOnSLAV() skips and drops them.
+  std::vector<Vertex_handle_vector> mSLAVByBorder ;
 
   Vertex_handle_pair_vector mSplitNodes ;
 
@@ -759,7 +807,7 @@ private:
 
   boost::optional<FT> mMaxTime ;
    
-  PQ mPQ ;
+  Event_queue mPQ ;
 
   //Output
   SSkelPtr mSSkel ;
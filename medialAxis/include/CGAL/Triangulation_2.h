@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <utility>
 #include <iostream>
+#include <cstring>
 
 #include <CGAL/iterator.h>
 #include <CGAL/Iterator_project.h>
@@ -40,11 +41,19 @@
 #include <CGAL/Triangulation_face_base_2.h>
 #include <CGAL/Triangulation_line_face_circulator_2.h>
 #include <CGAL/spatial_sort.h>
+#include <CGAL/Spatial_sort_traits_adapter_2.h>
+#include <CGAL/IO/io.h>
 
+#include <boost/cstdint.hpp>
 #include <boost/random/linear_congruential.hpp>
 #include <boost/random/uniform_smallint.hpp>
 #include <boost/random/variate_generator.hpp>
 
+#ifdef CGAL_LINKED_WITH_TBB
+# include <tbb/parallel_for.h>
+# include <tbb/enumerable_thread_specific.h>
+#endif
+
 #ifndef CGAL_NO_STRUCTURAL_FILTERING
 #include <CGAL/internal/Static_filters/tools.h>
 #include <CGAL/Triangulation_structural_filtering_traits.h>
@@ -76,6 +85,12 @@ struct Structural_filtering_selector_2<true> {
 }
 #endif // no CGAL_NO_STRUCTURAL_FILTERING
 
+// Removing more than this fraction of the vertices with remove(first,
+// beyond) rebuilds the triangulation of the remaining vertices.
+#ifndef CGAL_T2_BULK_REMOVE_REBUILD_FRACTION
+#  define CGAL_T2_BULK_REMOVE_REBUILD_FRACTION 0.55
+#endif
+
 template < class Gt, 
            class Tds = Triangulation_data_structure_2 <
                              Triangulation_vertex_base_2<Gt>,
@@ -232,6 +247,8 @@ public:
   void copy_triangulation(const Triangulation_2 &tr);
   void swap(Triangulation_2 &tr);
   void clear();
+  // same as clear(), keeping the memory of the faces and vertices
+  void reset();
 
 
   //ACCESS FUNCTION
@@ -592,6 +609,358 @@ std::ptrdiff_t insert(InputIterator first, InputIterator last)
   return number_of_vertices() - n;
 }
 
+// Locates every point of [first, last) and writes one face per point to
+// out, in the order of the input. The points are located in Hilbert
+// order, each walk starting from the face found for the previous point.
+// With Parallel_tag (when linked with TBB) the sorted points are shared
+// among threads, each walking from its own last face: the triangulation
+// is only read.
+template < class InputIterator, class OutputIterator >
+OutputIterator
+locate(InputIterator first, InputIterator last, OutputIterator out,
+       Face_handle start = Face_handle()) const
+{
+  return locate(first, last, out, start, Sequential_tag());
+}
+
+template < class InputIterator, class OutputIterator, class Concurrency_tag >
+OutputIterator
+locate(InputIterator first, InputIterator last, OutputIterator out,
+       Face_handle start, Concurrency_tag) const
+{
+  std::vector<Point> points (first, last);
+  if (points.empty()) return out;
+  std::vector<std::ptrdiff_t> indices (points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+    indices[i] = i;
+
+  typedef Spatial_sort_traits_adapter_2<Geom_traits,Point*> Search_traits;
+  spatial_sort(indices.begin(), indices.end(),
+               Search_traits(&(points[0]), geom_traits()));
+
+  std::vector<Face_handle> faces (points.size());
+  locate_sorted(points, indices, faces, start, Concurrency_tag());
+  return std::copy(faces.begin(), faces.end(), out);
+}
+
+private:
+void locate_sorted(const std::vector<Point>& points,
+                   const std::vector<std::ptrdiff_t>& indices,
+                   std::vector<Face_handle>& faces,
+                   Face_handle start, Sequential_tag) const
+{
+  for (typename std::vector<std::ptrdiff_t>::const_iterator
+         it = indices.begin(), end = indices.end(); it != end; ++it)
+    start = faces[*it] = locate(points[*it], start);
+}
+
+#ifdef CGAL_LINKED_WITH_TBB
+// Functor for the parallel locate: the range is a range of indices
+class Locate_point
+{
+  const Triangulation_2                            & m_tr;
+  const std::vector<Point>                         & m_points;
+  const std::vector<std::ptrdiff_t>                & m_indices;
+  std::vector<Face_handle>                         & m_faces;
+  tbb::enumerable_thread_specific<Face_handle>     & m_tls_hint;
+
+public:
+  Locate_point(const Triangulation_2 & tr,
+               const std::vector<Point> & points,
+               const std::vector<std::ptrdiff_t> & indices,
+               std::vector<Face_handle> & faces,
+               tbb::enumerable_thread_specific<Face_handle> & tls_hint)
+  : m_tr(tr), m_points(points), m_indices(indices), m_faces(faces),
+    m_tls_hint(tls_hint)
+  {}
+
+  void operator()(const tbb::blocked_range<std::size_t>& r) const
+  {
+    Face_handle &hint = m_tls_hint.local();
+    for (std::size_t i = r.begin(); i != r.end(); ++i)
+      hint = m_faces[m_indices[i]] = m_tr.locate(m_points[m_indices[i]], hint);
+  }
+};
+#endif // CGAL_LINKED_WITH_TBB
+
+void locate_sorted(const std::vector<Point>& points,
+                   const std::vector<std::ptrdiff_t>& indices,
+                   std::vector<Face_handle>& faces,
+                   Face_handle start, Parallel_tag) const
+{
+#ifdef CGAL_LINKED_WITH_TBB
+  tbb::enumerable_thread_specific<Face_handle> tls_hint(start);
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, indices.size()),
+                    Locate_point(*this, points, indices, faces, tls_hint));
+#else
+  locate_sorted(points, indices, faces, start, Sequential_tag());
+#endif
+}
+
+public:
+// Binary format (version 1), in the byte order of the machine:
+//   char[8]  "CGAL_T2B"
+//   uint32   version, uint32 0x01020304 to detect the byte order
+//   uint32   flags (1: vertex infos at the end)
+//   int32    dimension
+//   uint64   n, the number of vertices with the infinite one (index 0)
+//   uint64   m, the number of faces
+//   double   x and y of the vertices 1 to n-1
+//   uint32   vertex indices of the faces, dimension()+1 per face (1 in
+//            dimension -1)
+//   uint32   neighbor indices of the faces, dimension()+1 per face
+// followed by the infos of the vertices 1 to n-1 when written by an
+// InfoWriter. The blocks are contiguous and the coordinates start at
+// offset 40, so that a file mapped in memory can be read in place. The
+// points are stored as doubles, exactly for kernels whose FT is double.
+//
+// info_writer(os, v) and info_reader(is, v) are called for the finite
+// vertices, in the same order.
+// Only the data structure is stored: Regular_triangulation_2, the
+// constrained triangulations, Triangulation_hierarchy_2 and Alpha_shape_2
+// make these functions private.
+void binary_output(std::ostream& os) const
+{
+  binary_output(os, No_binary_info(), false);
+}
+
+template < class InfoWriter >
+void binary_output(std::ostream& os, InfoWriter info_writer) const
+{
+  binary_output(os, info_writer, true);
+}
+
+// Reads a triangulation written by binary_output(). Nothing is computed:
+// the vertices and faces are created as they were stored, and
+// Triangulation_2::is_valid() (not the Delaunay property) is checked only
+// if check is true. Returns false, leaving an empty
+// triangulation and failbit set, if the stream is not in the format.
+bool binary_input(std::istream& is, bool check = false)
+{
+  return binary_input(is, No_binary_info(), false, check);
+}
+
+template < class InfoReader >
+bool binary_input(std::istream& is, InfoReader info_reader,
+                  bool check = false)
+{
+  return binary_input(is, info_reader, true, check);
+}
+
+private:
+struct No_binary_info
+{
+  template <class Stream>
+  void operator()(Stream&, Vertex_handle) const {}
+};
+
+template < class InfoWriter >
+void binary_output(std::ostream& os, InfoWriter info_writer,
+                   bool with_info) const
+{
+  os.write("CGAL_T2B", 8);
+  CGAL::write(os, boost::uint32_t(1));
+  CGAL::write(os, boost::uint32_t(0x01020304));
+  CGAL::write(os, boost::uint32_t(with_info ? 1 : 0));
+  _tds.binary_file_output(os, infinite_vertex());
+
+  if (with_info)
+    for (Finite_vertices_iterator vit = finite_vertices_begin();
+         vit != finite_vertices_end(); ++vit)
+      info_writer(os, Vertex_handle(vit));
+}
+
+template < class InfoReader >
+bool binary_input(std::istream& is, InfoReader info_reader,
+                  bool with_info, bool check)
+{
+  char magic[8];
+  boost::uint32_t version = 0, order = 0, flags = 0;
+  is.read(magic, 8);
+  CGAL::read(is, version);
+  CGAL::read(is, order);
+  CGAL::read(is, flags);
+  std::vector<Vertex_handle> vertices;
+  if (!is || std::memcmp(magic, "CGAL_T2B", 8) != 0 || version != 1 ||
+      order != 0x01020304 || (with_info && !(flags & 1)) ||
+      !_tds.binary_file_input(is, vertices))
+    return binary_input_failed(is);
+  set_infinite_vertex(vertices[0]);
+
+  if (with_info) {
+    for (std::size_t i = 1; i < vertices.size(); ++i)
+      info_reader(is, vertices[i]);
+    if (!is) return binary_input_failed(is);
+  }
+  if (check && !is_valid())
+    return binary_input_failed(is);
+  return true;
+}
+
+bool binary_input_failed(std::istream& is)
+{
+  clear();
+  is.setstate(std::ios::failbit);
+  return false;
+}
+
+protected:
+// Helpers of the bulk removals of the derived classes.
+
+// the handles of [first, beyond), sorted by handle without duplicates
+template < class InputIterator >
+void sorted_vertices(InputIterator first, InputIterator beyond,
+                     std::vector<Vertex_handle>& vertices) const
+{
+  vertices.assign(first, beyond);
+  std::sort(vertices.begin(), vertices.end());
+  vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                 vertices.end());
+}
+
+// reorders vertices along a Hilbert curve of their points: removing them
+// in that order works on faces close to each other
+void spatial_sort_vertices(std::vector<Vertex_handle>& vertices) const
+{
+  if (vertices.empty()) return;
+  std::vector<Point> points;
+  std::vector<std::ptrdiff_t> indices;
+  points.reserve(vertices.size());
+  indices.reserve(vertices.size());
+  for (std::size_t i = 0; i < vertices.size(); ++i) {
+    points.push_back(vertices[i]->point());
+    indices.push_back(i);
+  }
+  typedef Spatial_sort_traits_adapter_2<Geom_traits,Point*> Search_traits;
+  spatial_sort(indices.begin(), indices.end(),
+               Search_traits(&(points[0]), geom_traits()));
+  std::vector<Vertex_handle> sorted;
+  sorted.reserve(vertices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i)
+    sorted.push_back(vertices[indices[i]]);
+  vertices.swap(sorted);
+}
+
+// the finite vertices that are not in removed (sorted by handle)
+void kept_vertices(const std::vector<Vertex_handle>& removed,
+                   std::vector<Vertex_handle>& kept) const
+{
+  kept.clear();
+  kept.reserve(number_of_vertices());
+  for (Finite_vertices_iterator v = finite_vertices_begin();
+       v != finite_vertices_end(); ++v) {
+    Vertex_handle vh = v;
+    if (!std::binary_search(removed.begin(), removed.end(), vh))
+      kept.push_back(vh);
+  }
+}
+
+// inserts the points of vertices in tr, spatially sorted, tr_vertices[i]
+// being the vertex of tr at the point of vertices[i]. Returns false if
+// tr is not 2D or some points were equal.
+template < class Tr >
+bool insert_points_of(const std::vector<Vertex_handle>& vertices, Tr& tr,
+                      std::vector<Vertex_handle>& tr_vertices) const
+{
+  if (vertices.empty()) return false;
+  std::vector<Point> points;
+  std::vector<std::ptrdiff_t> indices;
+  points.reserve(vertices.size());
+  indices.reserve(vertices.size());
+  for (std::size_t i = 0; i < vertices.size(); ++i) {
+    points.push_back(vertices[i]->point());
+    indices.push_back(i);
+  }
+  typedef Spatial_sort_traits_adapter_2<Geom_traits,Point*> Search_traits;
+  spatial_sort(indices.begin(), indices.end(),
+               Search_traits(&(points[0]), geom_traits()));
+
+  tr_vertices.resize(vertices.size());
+  Face_handle hint;
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    Vertex_handle v = tr.insert(points[indices[i]], hint);
+    tr_vertices[indices[i]] = v;
+    hint = v->face();
+  }
+  return tr.dimension() == 2 && tr.number_of_vertices() == vertices.size();
+}
+
+// Replaces the faces of *this by the faces of tr, a 2D triangulation of
+// the points of vertices (see insert_points_of()) with the same data
+// structure, and deletes the removed vertices. The kept vertices and
+// their handles stay, attached to the new faces. tr is used as scratch
+// space and must only be destroyed afterwards. copy_face(f, g) copies
+// what the derived class needs from the face f of tr to its copy g.
+template < class Tr, class CopyFace >
+void take_faces_of(Tr& tr, const std::vector<Vertex_handle>& tr_vertices,
+                   const std::vector<Vertex_handle>& vertices,
+                   const std::vector<Vertex_handle>& removed,
+                   CopyFace copy_face)
+{
+  std::vector<Face_handle> old_faces;
+  old_faces.reserve(_tds.number_of_faces());
+  for (All_faces_iterator f = all_faces_begin(); f != all_faces_end(); ++f)
+    old_faces.push_back(f);
+  for (std::size_t i = 0; i < old_faces.size(); ++i)
+    _tds.delete_face(old_faces[i]);
+  for (std::size_t i = 0; i < removed.size(); ++i)
+    _tds.delete_vertex(removed[i]);
+
+  // the faces of tr get the vertices of *this, found by circulating around
+  // each vertex of tr rather than by looking every corner up. The corners
+  // are all found before any is rewritten: handles of an indexed data
+  // structure only compare their indices.
+  typedef std::pair<Face_handle, int> Corner;
+  std::vector<Corner> corners;
+  std::vector<std::size_t> stars(1, 0);
+  corners.reserve(3 * tr.tds().number_of_faces());
+  stars.reserve(vertices.size() + 2);
+  for (std::size_t i = 0; i <= vertices.size(); ++i) {
+    Vertex_handle tv = i < vertices.size() ? tr_vertices[i]
+                                           : tr.infinite_vertex();
+    typename Tr::Face_circulator fc = tr.incident_faces(tv), done(fc);
+    do { corners.push_back(Corner(fc, fc->index(tv))); } while (++fc != done);
+    stars.push_back(corners.size());
+  }
+  for (std::size_t i = 0; i <= vertices.size(); ++i) {
+    Vertex_handle v = i < vertices.size() ? vertices[i] : infinite_vertex();
+    for (std::size_t j = stars[i]; j < stars[i+1]; ++j)
+      corners[j].first->set_vertex(corners[j].second, v);
+  }
+
+  // each face of tr keeps its copy as neighbor 0, once its neighbors are
+  // saved
+  std::vector<Face_handle> faces, neighbors;
+  faces.reserve(tr.tds().number_of_faces());
+  neighbors.reserve(3 * tr.tds().number_of_faces());
+  for (typename Tr::All_faces_iterator f = tr.all_faces_begin();
+       f != tr.all_faces_end(); ++f) {
+    Face_handle g = _tds.create_face(f->vertex(0), f->vertex(1), f->vertex(2));
+    copy_face(f, g);
+    for (int j = 0; j < 3; ++j)
+      neighbors.push_back(f->neighbor(j));
+    f->set_neighbor(0, g);
+    faces.push_back(g);
+  }
+  for (std::size_t i = 0; i < faces.size(); ++i)
+    for (int j = 0; j < 3; ++j)
+      faces[i]->set_neighbor(j, neighbors[3*i+j]->neighbor(0));
+  for (std::size_t i = 0; i <= vertices.size(); ++i) {
+    Vertex_handle tv = i < vertices.size() ? tr_vertices[i]
+                                           : tr.infinite_vertex();
+    Vertex_handle v = i < vertices.size() ? vertices[i] : infinite_vertex();
+    v->set_face(tv->face()->neighbor(0));
+  }
+  _tds.set_dimension(2);
+}
+
+// copy_face of take_faces_of() for faces with nothing to copy
+struct Copy_nothing {
+  template < class F, class G >
+  void operator()(const F&, const G&) const {}
+};
+
+public:
 bool well_oriented(Vertex_handle v) const
 {
   Face_circulator fc = incident_faces(v), done(fc);
@@ -707,6 +1076,15 @@ clear()
   _infinite_vertex = _tds.insert_first();
 }
 
+template <class Gt, class Tds >
+void
+Triangulation_2<Gt, Tds>::
+reset()
+{
+  _tds.reset();
+  _infinite_vertex = _tds.insert_first();
+}
+
 template <class Gt, class Tds >
 typename Triangulation_2<Gt, Tds>::size_type
 Triangulation_2<Gt, Tds>::
@@ -694,6 +694,13 @@ public:
       init_tds();
     }
 
+  // same as clear(), keeping the memory of the cells and vertices
+  void reset()
+    {
+      _tds.reset();
+      init_tds();
+    }
+
   Triangulation_3 & operator=(Triangulation_3 tr)
     {
       // The triangulation passed as argument has been copied,
@@ -42,8 +42,10 @@
 #include <CGAL/Triangulation_ds_iterators_2.h>
 #include <CGAL/Triangulation_ds_circulators_2.h>
 
+#include <CGAL/IO/io.h>
 #include <CGAL/IO/File_header_OFF.h>
 #include <CGAL/IO/File_scanner_OFF.h>
+#include <CGAL/internal/Tds_2_binary_io.h>
 
 namespace CGAL { 
 
@@ -350,6 +352,11 @@ private:
 
 public:
   void clear();
+  // like clear(), but the containers keep their memory for the next
+  // triangulation
+  void reset();
+  // makes room for n vertices and the 2n faces of their triangulation
+  void reserve(size_type n);
 
   template <class TDS_src>
   Vertex_handle copy_tds(const TDS_src &tds, typename TDS_src::Vertex_handle);
@@ -369,6 +376,9 @@ public:
 		   Vertex_handle v = Vertex_handle(),
 		   bool skip_first=false) const;
   Vertex_handle off_file_input(std::istream& is, bool verbose=false);
+  // the blocks of Triangulation_2::binary_output(), v is the vertex 0
+  void binary_file_output(std::ostream& os, Vertex_handle v) const;
+  bool binary_file_input(std::istream& is, std::vector<Vertex_handle>& V);
   void  vrml_output(std::ostream& os,
 		    Vertex_handle v = Vertex_handle(),
 		    bool skip_first=false) const;
@@ -552,6 +562,25 @@ clear()
   return;
 }
 
+template <  class Vb, class Fb>
+void
+Triangulation_data_structure_2<Vb,Fb>::
+reset()
+{
+  faces().reset();
+  vertices().reset();
+  set_dimension(-2);
+}
+
+template <  class Vb, class Fb>
+void
+Triangulation_data_structure_2<Vb,Fb>::
+reserve(size_type n)
+{
+  vertices().reserve(n + 1);
+  faces().reserve(2 * n + 2);
+}
+
 template <  class Vb, class Fb>
 void
 Triangulation_data_structure_2<Vb,Fb>::
@@ -2031,6 +2060,27 @@ file_input( std::istream& is, bool skip_first)
 }
 
 
+template < class Vb, class Fb>
+void
+Triangulation_data_structure_2<Vb,Fb>::
+binary_file_output( std::ostream& os, Vertex_handle v) const
+{
+  CGAL_triangulation_precondition( v != Vertex_handle());
+  typedef internal::Tds_2_binary_io::Index Index;
+  Unique_hash_map<Vertex_handle,Index> V;
+  Unique_hash_map<Face_handle,Index> F;
+  internal::Tds_2_binary_io::binary_output(os, *this, v, V, F);
+}
+
+template < class Vb, class Fb>
+bool
+Triangulation_data_structure_2<Vb,Fb>::
+binary_file_input( std::istream& is, std::vector<Vertex_handle>& V)
+{
+  return internal::Tds_2_binary_io::binary_input(is, *this, V);
+}
+
+
 template < class Vb, class Fb>
 void
 Triangulation_data_structure_2<Vb,Fb>::
@@ -1349,6 +1349,9 @@ public:
   void swap(Tds & tds);
 
   void clear();
+  // like clear(), but the containers keep their memory for the next
+  // triangulation
+  void reset();
 
   void set_adjacency(Cell_handle c0, int i0,
                      Cell_handle c1, int i1) const
@@ -3894,6 +3897,16 @@ clear()
   set_dimension(-2);
 }
 
+template <class Vb, class Cb, class Ct>
+void
+Triangulation_data_structure_3<Vb,Cb,Ct>::
+reset()
+{
+  cells().reset();
+  vertices().reset();
+  set_dimension(-2);
+}
+
 template <class Vb, class Cb, class Ct>
 bool
 Triangulation_data_structure_3<Vb,Cb,Ct>::
@@ -0,0 +1,446 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+// Jump and walk point location for a Delaunay_triangulation_2, used like
+// Triangulation_hierarchy_2:
+//
+//   typedef Triangulation_grid_locator_2<Delaunay_triangulation_2<K> > Dt;
+//
+// A uniform grid over the bounding box of the vertices keeps one vertex
+// per cell, lying in that cell. A locate without start face jumps to the
+// vertex of the query's cell (or of a close cell) and walks from there.
+// The grid has about one cell per
+// Triangulation_grid_locator_2__vertices_per_cell vertices, that is one
+// handle per few vertices, where the hierarchy adds whole triangulations
+// and up/down pointers on every vertex. It is kept up to date by insert()
+// and remove(), and rebuilt on the next locate when the number of
+// vertices has changed by more than Triangulation_grid_locator_2__ratio
+// or too many points fell outside of its box. Vertices must be inserted,
+// moved and removed through this class.
+// The grid fits well distributed points; for very clustered ones most
+// cells are empty and the walks get longer.
+
+#ifndef CGAL_TRIANGULATION_GRID_LOCATOR_2_H
+#define CGAL_TRIANGULATION_GRID_LOCATOR_2_H
+
+#include <CGAL/basic.h>
+#include <CGAL/triangulation_assertions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace CGAL {
+
+// parameterization of the grid
+const int Triangulation_grid_locator_2__vertices_per_cell = 4;
+const int Triangulation_grid_locator_2__ratio             = 2;
+const int Triangulation_grid_locator_2__minsize           = 64;
+// empty cells around the query's cell that are looked at
+const int Triangulation_grid_locator_2__search_rings      = 2;
+
+template < class Tr >
+class Triangulation_grid_locator_2
+  : public Tr
+{
+ public:
+  typedef Tr                                   Tr_Base;
+  typedef typename Tr_Base::Geom_traits        Geom_traits;
+  typedef typename Tr_Base::Point              Point;
+  typedef typename Tr_Base::size_type          size_type;
+  typedef typename Tr_Base::Vertex_handle      Vertex_handle;
+  typedef typename Tr_Base::Face_handle        Face_handle;
+  typedef typename Tr_Base::Vertex             Vertex;
+  typedef typename Tr_Base::Locate_type        Locate_type;
+  typedef typename Tr_Base::Finite_vertices_iterator  Finite_vertices_iterator;
+  typedef typename Tr_Base::Vertex_circulator  Vertex_circulator;
+
+#ifndef CGAL_CFG_USING_BASE_MEMBER_BUG_2
+  using Tr_Base::geom_traits;
+#endif
+
+ private:
+  // grid[iy * nx + ix] is a vertex of the cell (ix, iy), or a null handle
+  mutable std::vector<Vertex_handle> grid;
+  mutable int       nx, ny;
+  mutable double    xmin, ymin, inv_cell_size;
+  // number of vertices when the grid was built, and of vertices inserted
+  // outside of its box since
+  mutable size_type built_size;
+  mutable size_type outside;
+  mutable bool      dirty;
+
+public:
+  Triangulation_grid_locator_2(const Geom_traits& traits = Geom_traits())
+    : Tr_Base(traits)
+  { reset_grid(); }
+
+  Triangulation_grid_locator_2(const Triangulation_grid_locator_2& tr)
+    : Tr_Base(tr)
+  { reset_grid(); }
+
+  template<class InputIterator>
+  Triangulation_grid_locator_2(InputIterator first, InputIterator beyond,
+                               const Geom_traits& traits = Geom_traits())
+    : Tr_Base(traits)
+  {
+    reset_grid();
+    insert(first, beyond);
+  }
+
+  Triangulation_grid_locator_2 &
+  operator=(const Triangulation_grid_locator_2& tr)
+  {
+    Tr_Base::operator=(tr);
+    reset_grid();
+    return *this;
+  }
+
+  //Helping
+  void swap(Triangulation_grid_locator_2 &tr);
+  void clear()
+  {
+    Tr_Base::clear();
+    reset_grid();
+  }
+
+  void reset()
+  {
+    Tr_Base::reset();
+    reset_grid();
+  }
+
+  // INPUT, the grid is rebuilt from the vertices read
+  bool binary_input(std::istream& is, bool check = false)
+  {
+    bool read = Tr_Base::binary_input(is, check);
+    reset_grid();
+    return read;
+  }
+  template < class InfoReader >
+  bool binary_input(std::istream& is, InfoReader info_reader,
+                    bool check = false)
+  {
+    bool read = Tr_Base::binary_input(is, info_reader, check);
+    reset_grid();
+    return read;
+  }
+
+  // CHECKING
+  bool is_valid(bool verbose = false, int level = 0) const;
+
+  // INSERT REMOVE MOVE
+  Vertex_handle insert(const Point &p, Face_handle start = Face_handle());
+  Vertex_handle insert(const Point& p,
+                       Locate_type lt,
+                       Face_handle loc, int li);
+  Vertex_handle push_back(const Point &p)
+  {
+    return insert(p);
+  }
+
+  // the range is inserted by the triangulation (spatially sorted, each
+  // point located from the previous one) and the grid is rebuilt later
+  template < class InputIterator >
+  std::ptrdiff_t insert(InputIterator first, InputIterator last)
+  {
+    std::ptrdiff_t n = Tr_Base::insert(first, last);
+    dirty = true;
+    return n;
+  }
+
+  void remove(Vertex_handle v);
+
+  // the grid is rebuilt later, as after inserting a range
+  template < class InputIterator >
+  size_type remove(InputIterator first, InputIterator beyond)
+  {
+    size_type n = Tr_Base::remove(first, beyond);
+    dirty = true;
+    return n;
+  }
+
+  Vertex_handle move_if_no_collision(Vertex_handle v, const Point &p);
+  Vertex_handle move(Vertex_handle v, const Point &p);
+
+  //LOCATE
+  Face_handle
+  locate(const Point& p,
+         Locate_type& lt,
+         int& li,
+         Face_handle start = Face_handle()) const
+  {
+    if (start == Face_handle())
+      start = start_face(p);
+    return Tr_Base::locate(p, lt, li, start);
+  }
+
+  Face_handle
+  locate(const Point &p, Face_handle start = Face_handle()) const
+  {
+    Locate_type lt;
+    int li;
+    return locate(p, lt, li, start);
+  }
+
+  Vertex_handle
+  nearest_vertex(const Point& p, Face_handle start = Face_handle()) const
+  {
+    return Tr_Base::nearest_vertex(p, start != Face_handle() ? start : locate(p));
+  }
+
+  // face incident to the grid vertex closest to p's cell, a null handle
+  // if there is none
+  Face_handle start_face(const Point& p) const;
+
+  // number of cells of the grid, 0 when it is not built
+  size_type number_of_grid_cells() const
+  {
+    return grid.size();
+  }
+
+private:
+  void reset_grid()
+  {
+    std::vector<Vertex_handle>().swap(grid);
+    nx = ny = 0;
+    xmin = ymin = inv_cell_size = 0;
+    built_size = outside = 0;
+    dirty = true;
+  }
+
+  bool needs_rebuild() const
+  {
+    size_type n = this->number_of_vertices();
+    if (dirty) return true;
+    if (grid.empty())
+      return n >= size_type(Triangulation_grid_locator_2__minsize);
+    return n > Triangulation_grid_locator_2__ratio * built_size
+        || n * Triangulation_grid_locator_2__ratio < built_size
+        || outside * Triangulation_grid_locator_2__ratio > n;
+  }
+
+  void rebuild() const;
+
+  bool in_box(const Point& p) const
+  {
+    double x = (to_double(p.x()) - xmin) * inv_cell_size;
+    double y = (to_double(p.y()) - ymin) * inv_cell_size;
+    return x >= 0 && y >= 0 && x <= nx && y <= ny;
+  }
+
+  // cell of p, points outside of the box go to the closest border cell
+  int cell(const Point& p) const
+  {
+    // clamped as doubles, a far point would overflow an int
+    double x = (to_double(p.x()) - xmin) * inv_cell_size;
+    double y = (to_double(p.y()) - ymin) * inv_cell_size;
+    int ix = int((std::max)(0.0, (std::min)(double(nx - 1), x)));
+    int iy = int((std::max)(0.0, (std::min)(double(ny - 1), y)));
+    return iy * nx + ix;
+  }
+
+  // keeps v if its cell has no vertex yet
+  void add_to_grid(Vertex_handle v)
+  {
+    if (dirty || grid.empty() || this->is_infinite(v)) return;
+    if (!in_box(v->point())) ++outside;
+    Vertex_handle& w = grid[cell(v->point())];
+    if (w == Vertex_handle()) w = v;
+  }
+
+  // before v goes away (or moves): a neighbor of v in the same cell
+  // takes its place
+  void remove_from_grid(Vertex_handle v);
+};
+
+
+template <class Tr>
+void
+Triangulation_grid_locator_2<Tr>::
+swap(Triangulation_grid_locator_2<Tr> &tr)
+{
+  // the handles stay valid, they follow their data structure
+  Tr_Base::swap(tr);
+  grid.swap(tr.grid);
+  std::swap(nx, tr.nx);
+  std::swap(ny, tr.ny);
+  std::swap(xmin, tr.xmin);
+  std::swap(ymin, tr.ymin);
+  std::swap(inv_cell_size, tr.inv_cell_size);
+  std::swap(built_size, tr.built_size);
+  std::swap(outside, tr.outside);
+  std::swap(dirty, tr.dirty);
+}
+
+template <class Tr>
+bool
+Triangulation_grid_locator_2<Tr>::
+is_valid(bool verbose, int level) const
+{
+  bool result = Tr_Base::is_valid(verbose, level);
+  if (dirty) return result;
+  // every vertex of the grid is a vertex of the triangulation, in its cell
+  for (int c = 0; c < int(grid.size()); ++c) {
+    if (grid[c] == Vertex_handle()) continue;
+    result = result && this->tds().is_vertex(grid[c])
+                    && !this->is_infinite(grid[c])
+                    && cell(grid[c]->point()) == c;
+  }
+  if (verbose && !result)
+    std::cerr << "invalid grid locator" << std::endl;
+  return result;
+}
+
+template <class Tr>
+void
+Triangulation_grid_locator_2<Tr>::
+rebuild() const
+{
+  dirty = false;
+  outside = 0;
+  built_size = this->number_of_vertices();
+  std::vector<Vertex_handle>().swap(grid);
+  nx = ny = 0;
+  if (built_size < size_type(Triangulation_grid_locator_2__minsize)
+      || this->dimension() < 2)
+    return;
+
+  Finite_vertices_iterator vit = this->finite_vertices_begin();
+  Bbox_2 box = vit->point().bbox();
+  for (++vit; vit != this->finite_vertices_end(); ++vit)
+    box = box + vit->point().bbox();
+
+  // square cells, about vertices_per_cell vertices in each
+  double w = box.xmax() - box.xmin(), h = box.ymax() - box.ymin();
+  double cells = double(built_size) / Triangulation_grid_locator_2__vertices_per_cell;
+  double size = std::sqrt(w * h / cells);
+  if (!(size > 0))
+    size = (std::max)(w, h) / cells;
+  if (!(size > 0)) return;
+  nx = (std::max)(1, (std::min)(int(std::ceil(w / size)), int(cells)));
+  ny = (std::max)(1, (std::min)(int(std::ceil(h / size)), int(cells)));
+  xmin = box.xmin();
+  ymin = box.ymin();
+  inv_cell_size = 1 / size;
+  grid.assign(size_type(nx) * ny, Vertex_handle());
+
+  for (vit = this->finite_vertices_begin(); vit != this->finite_vertices_end(); ++vit) {
+    Vertex_handle& v = grid[cell(vit->point())];
+    if (v == Vertex_handle()) v = vit;
+  }
+}
+
+template <class Tr>
+typename Triangulation_grid_locator_2<Tr>::Face_handle
+Triangulation_grid_locator_2<Tr>::
+start_face(const Point& p) const
+{
+  if (needs_rebuild()) rebuild();
+  if (grid.empty()) return Face_handle();
+
+  int c = cell(p);
+  if (grid[c] != Vertex_handle()) return grid[c]->face();
+  int ix = c % nx, iy = c / nx;
+  for (int r = 1; r <= Triangulation_grid_locator_2__search_rings; ++r) {
+    for (int y = (std::max)(0, iy - r); y <= (std::min)(ny - 1, iy + r); ++y) {
+      // the whole first and last rows of the ring, both ends of the others
+      int step = (y == iy - r || y == iy + r) ? 1 : 2 * r;
+      for (int x = ix - r; x <= ix + r; x += step) {
+        if (x < 0 || x >= nx) continue;
+        Vertex_handle v = grid[y * nx + x];
+        if (v != Vertex_handle()) return v->face();
+      }
+    }
+  }
+  return Face_handle();
+}
+
+template <class Tr>
+void
+Triangulation_grid_locator_2<Tr>::
+remove_from_grid(Vertex_handle v)
+{
+  if (dirty || grid.empty()) return;
+  int c = cell(v->point());
+  if (grid[c] != v) return;
+  grid[c] = Vertex_handle();
+  if (this->dimension() < 1) return;
+  Vertex_circulator vc = this->incident_vertices(v), done(vc);
+  do {
+    if (!this->is_infinite(vc) && cell(vc->point()) == c) {
+      grid[c] = vc;
+      return;
+    }
+  } while (++vc != done);
+}
+
+template <class Tr>
+typename Triangulation_grid_locator_2<Tr>::Vertex_handle
+Triangulation_grid_locator_2<Tr>::
+insert(const Point &p, Face_handle start)
+{
+  if (start == Face_handle())
+    start = start_face(p);
+  Vertex_handle v = Tr_Base::insert(p, start);
+  add_to_grid(v);
+  return v;
+}
+
+template <class Tr>
+typename Triangulation_grid_locator_2<Tr>::Vertex_handle
+Triangulation_grid_locator_2<Tr>::
+insert(const Point& p, Locate_type lt, Face_handle loc, int li)
+{
+  Vertex_handle v = Tr_Base::insert(p, lt, loc, li);
+  add_to_grid(v);
+  return v;
+}
+
+template <class Tr>
+void
+Triangulation_grid_locator_2<Tr>::
+remove(Vertex_handle v)
+{
+  remove_from_grid(v);
+  Tr_Base::remove(v);
+}
+
+template <class Tr>
+typename Triangulation_grid_locator_2<Tr>::Vertex_handle
+Triangulation_grid_locator_2<Tr>::
+move_if_no_collision(Vertex_handle v, const Point &p)
+{
+  remove_from_grid(v);
+  Vertex_handle w = Tr_Base::move_if_no_collision(v, p);
+  // on a collision v did not move and w is the vertex at p
+  add_to_grid(v);
+  return w;
+}
+
+template <class Tr>
+typename Triangulation_grid_locator_2<Tr>::Vertex_handle
+Triangulation_grid_locator_2<Tr>::
+move(Vertex_handle v, const Point &p)
+{
+  CGAL_triangulation_precondition(!this->is_infinite(v));
+  if (v->point() == p) return v;
+  Vertex_handle w = move_if_no_collision(v, p);
+  if (w != v) {
+    remove(v);
+    return w;
+  }
+  return v;
+}
+
+} //namespace CGAL
+
+#endif // CGAL_TRIANGULATION_GRID_LOCATOR_2_H
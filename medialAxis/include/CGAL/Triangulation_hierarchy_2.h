@@ -92,6 +92,7 @@ public:
   void copy_triangulation(const Triangulation_hierarchy_2 &tr);
   void swap(Triangulation_hierarchy_2 &tr);
   void clear();
+  void reset();
 
   // CHECKING
   bool is_valid(bool verbose = false, int level = 0) const;
@@ -190,6 +191,9 @@ public:
   }
 
 private:
+  //made private as the Triangulation_2 versions read the lowest level only
+  void binary_output(std::ostream& os) const;
+  bool binary_input(std::istream& is, bool check = false);
 
   template < typename T >
   Vertex_handle
@@ -368,6 +372,15 @@ clear()
 	hierarchy[i]->clear();
 }
 
+template <class Tr>
+void
+Triangulation_hierarchy_2<Tr>:: 
+reset()
+{
+        for(int i=0;i<Triangulation_hierarchy_2__maxlevel;++i)
+	hierarchy[i]->reset();
+}
+
 
 template <class Tr>
 bool
@@ -119,6 +119,7 @@ public:
   void swap(Triangulation_hierarchy_3 &tr);
 
   void clear();
+  void reset();
 
   // CHECKING
   bool is_valid(bool verbose = false, int level = 0) const;
@@ -447,6 +448,15 @@ clear()
     hierarchy[i]->clear();
 }
 
+template <class Tr>
+void
+Triangulation_hierarchy_3<Tr>::
+reset()
+{
+  for(int i=0;i<maxlevel;++i)
+    hierarchy[i]->reset();
+}
+
 template <class Tr>
 bool
 Triangulation_hierarchy_3<Tr>::
@@ -42,6 +42,7 @@
 #include <CGAL/Voronoi_diagram_2/Degeneracy_tester_binders.h>
 #include <CGAL/Voronoi_diagram_2/Connected_components.h>
 #include <CGAL/Voronoi_diagram_2/Accessor.h>
+#include <CGAL/Voronoi_diagram_2/Flat_diagram_builder.h>
 
 #include <CGAL/Identity_policy_2.h>
 
@@ -675,6 +676,22 @@ public:
     return locate(p, Has_nearest_site_2());
   }
 
+  // FLAT EXPORT
+  //------------
+  // fills flat with the diagram clipped to bbox, each Voronoi vertex
+  // constructed once (see Flat_voronoi_diagram_2.h); the Voronoi vertices
+  // and the clipping are computed in parallel with Parallel_tag
+  void materialize(Flat_voronoi_diagram_2& flat, const Bbox_2& bbox) const {
+    materialize(flat, bbox, Sequential_tag());
+  }
+
+  template<class Concurrency_tag>
+  void materialize(Flat_voronoi_diagram_2& flat, const Bbox_2& bbox,
+		   Concurrency_tag tag) const {
+    CGAL_VORONOI_DIAGRAM_2_INS::Flat_diagram_builder<Self> builder(*this, flat);
+    builder(bbox, tag);
+  }
+
 
   // VALIDITY TESTING
   //-----------------
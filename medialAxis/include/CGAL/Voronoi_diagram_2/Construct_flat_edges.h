@@ -0,0 +1,221 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+#ifndef CGAL_VORONOI_DIAGRAM_2_CONSTRUCT_FLAT_EDGES_H
+#define CGAL_VORONOI_DIAGRAM_2_CONSTRUCT_FLAT_EDGES_H 1
+
+#include <cmath>
+#include <CGAL/Voronoi_diagram_2/basic.h>
+
+namespace CGAL {
+
+namespace VoronoiDiagram_2 { namespace Internal {
+
+//=========================================================================
+// The Voronoi edges that do not end at two Voronoi vertices, in doubles,
+// for Voronoi_diagram_2::materialize(). direction(p, q, vx, vy, dx, dy)
+// gives the direction (dx, dy) in which the unbounded edge between p and q
+// leaves its Voronoi vertex (vx, vy); p and q are consecutive on the
+// convex hull, the infinite face being (infinite vertex, p, q).
+// bisector(p, q, x, y, dx, dy) gives the line (x, y) + t (dx, dy) used
+// for the edge between p and q when the Delaunay graph has dimension 1,
+// with p on its left.
+//
+// The edges of the Delaunay and regular triangulations are straight. The
+// edges of the Apollonius and segment Delaunay graphs are conic arcs: the
+// rays follow the asymptote of the hyperbola (Apollonius) or the tangent
+// at the Voronoi vertex (segment Delaunay), and the lines are the
+// perpendiculars through the point of the bisector between the sites.
+//=========================================================================
+
+inline void flat_perpendicular(double px, double py, double qx, double qy,
+			       double& dx, double& dy)
+{
+  dx = py - qy;
+  dy = qx - px;
+}
+
+//=========================================================================
+
+template<class DT2>
+class Delaunay_triangulation_flat_edge_2
+{
+private:
+  typedef typename DT2::Vertex_handle    Vertex_handle;
+
+public:
+  void direction(const Vertex_handle& p, const Vertex_handle& q,
+		 double, double, double& dx, double& dy) const {
+    flat_perpendicular(to_double(p->point().x()), to_double(p->point().y()),
+		       to_double(q->point().x()), to_double(q->point().y()),
+		       dx, dy);
+  }
+
+  void bisector(const Vertex_handle& p, const Vertex_handle& q,
+		double& x, double& y, double& dx, double& dy) const {
+    double px = to_double(p->point().x()), py = to_double(p->point().y());
+    double qx = to_double(q->point().x()), qy = to_double(q->point().y());
+    x = (px + qx) / 2;
+    y = (py + qy) / 2;
+    flat_perpendicular(px, py, qx, qy, dx, dy);
+  }
+};
+
+//=========================================================================
+
+template<class RT2>
+class Regular_triangulation_flat_edge_2
+{
+private:
+  typedef typename RT2::Vertex_handle    Vertex_handle;
+
+public:
+  // the power bisector is perpendicular to pq
+  void direction(const Vertex_handle& p, const Vertex_handle& q,
+		 double, double, double& dx, double& dy) const {
+    flat_perpendicular(to_double(p->point().x()), to_double(p->point().y()),
+		       to_double(q->point().x()), to_double(q->point().y()),
+		       dx, dy);
+  }
+
+  void bisector(const Vertex_handle& p, const Vertex_handle& q,
+		double& x, double& y, double& dx, double& dy) const {
+    double px = to_double(p->point().x()), py = to_double(p->point().y());
+    double qx = to_double(q->point().x()), qy = to_double(q->point().y());
+    double l2 = (qx - px) * (qx - px) + (qy - py) * (qy - py);
+    double t = 0.5 + (to_double(p->point().weight()) -
+		      to_double(q->point().weight())) / (2 * l2);
+    x = px + t * (qx - px);
+    y = py + t * (qy - py);
+    flat_perpendicular(px, py, qx, qy, dx, dy);
+  }
+};
+
+//=========================================================================
+
+template<class AG2>
+class Apollonius_graph_flat_edge_2
+{
+private:
+  typedef typename AG2::Vertex_handle    Vertex_handle;
+
+public:
+  // far from the sites |x - c_p| - |x - c_q| tends to u . (c_q - c_p)
+  // along the unit direction u, and the bisector keeps it at w_p - w_q
+  void direction(const Vertex_handle& p, const Vertex_handle& q,
+		 double, double, double& dx, double& dy) const {
+    double px = to_double(p->site().x()), py = to_double(p->site().y());
+    double qx = to_double(q->site().x()), qy = to_double(q->site().y());
+    double l = std::sqrt((qx - px) * (qx - px) + (qy - py) * (qy - py));
+    double ex = (qx - px) / l, ey = (qy - py) / l;
+    double a = (to_double(p->site().weight()) -
+		to_double(q->site().weight())) / l;
+    double b = ( a < -1 || a > 1 ) ? 0 : std::sqrt(1 - a * a);
+    dx = a * ex - b * ey;
+    dy = a * ey + b * ex;
+  }
+
+  void bisector(const Vertex_handle& p, const Vertex_handle& q,
+		double& x, double& y, double& dx, double& dy) const {
+    double px = to_double(p->site().x()), py = to_double(p->site().y());
+    double qx = to_double(q->site().x()), qy = to_double(q->site().y());
+    double l = std::sqrt((qx - px) * (qx - px) + (qy - py) * (qy - py));
+    double t = (l + to_double(p->site().weight()) -
+		to_double(q->site().weight())) / (2 * l);
+    x = px + t * (qx - px);
+    y = py + t * (qy - py);
+    flat_perpendicular(px, py, qx, qy, dx, dy);
+  }
+};
+
+//=========================================================================
+
+template<class SDG2>
+class Segment_Delaunay_graph_flat_edge_2
+{
+private:
+  typedef typename SDG2::Vertex_handle   Vertex_handle;
+  typedef typename SDG2::Site_2          Site_2;
+
+  // the point of s nearest to (x, y)
+  static void nearest(const Site_2& s, double x, double y,
+		      double& nx, double& ny) {
+    if ( s.is_point() ) {
+      nx = to_double(s.point().x());
+      ny = to_double(s.point().y());
+      return;
+    }
+    double ax = to_double(s.source().x()), ay = to_double(s.source().y());
+    double bx = to_double(s.target().x()), by = to_double(s.target().y());
+    double l2 = (bx - ax) * (bx - ax) + (by - ay) * (by - ay);
+    double t = ( l2 > 0 ) ? ((x - ax) * (bx - ax) + (y - ay) * (by - ay)) / l2
+                          : 0;
+    t = (t < 0) ? 0 : ((t > 1) ? 1 : t);
+    nx = ax + t * (bx - ax);
+    ny = ay + t * (by - ay);
+  }
+
+  static void center(const Site_2& s, double& x, double& y) {
+    if ( s.is_point() ) {
+      x = to_double(s.point().x());
+      y = to_double(s.point().y());
+    } else {
+      x = (to_double(s.source().x()) + to_double(s.target().x())) / 2;
+      y = (to_double(s.source().y()) + to_double(s.target().y())) / 2;
+    }
+  }
+
+public:
+  // the tangent at (vx, vy) is orthogonal to the difference of the
+  // gradients of the distances to p and q; it vanishes when both sites
+  // are nearest at the same point (a segment and its endpoint), whose
+  // bisector is orthogonal to the segment
+  void direction(const Vertex_handle& p, const Vertex_handle& q,
+		 double vx, double vy, double& dx, double& dy) const {
+    double px, py, qx, qy;
+    nearest(p->site(), vx, vy, px, py);
+    nearest(q->site(), vx, vy, qx, qy);
+    double lp = std::sqrt((vx - px) * (vx - px) + (vy - py) * (vy - py));
+    double lq = std::sqrt((vx - qx) * (vx - qx) + (vy - qy) * (vy - qy));
+    if ( lp > 0 && lq > 0 ) {
+      double gx = (vx - px) / lp - (vx - qx) / lq;
+      double gy = (vy - py) / lp - (vy - qy) / lq;
+      if ( gx * gx + gy * gy > 1e-24 ) {
+	dx = -gy;
+	dy = gx;
+	return;
+      }
+    }
+    center(p->site(), px, py);
+    center(q->site(), qx, qy);
+    flat_perpendicular(px, py, qx, qy, dx, dy);
+  }
+
+  void bisector(const Vertex_handle& p, const Vertex_handle& q,
+		double& x, double& y, double& dx, double& dy) const {
+    double cx, cy, px, py, qx, qy;
+    center(q->site(), cx, cy);
+    nearest(p->site(), cx, cy, px, py);
+    nearest(q->site(), px, py, qx, qy);
+    x = (px + qx) / 2;
+    y = (py + qy) / 2;
+    center(p->site(), px, py);
+    flat_perpendicular(px, py, cx, cy, dx, dy);
+  }
+};
+
+//=========================================================================
+
+} } //namespace VoronoiDiagram_2::Internal
+
+} //namespace CGAL
+
+#endif // CGAL_VORONOI_DIAGRAM_2_CONSTRUCT_FLAT_EDGES_H
@@ -0,0 +1,673 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+#ifndef CGAL_VORONOI_DIAGRAM_2_FLAT_DIAGRAM_BUILDER_H
+#define CGAL_VORONOI_DIAGRAM_2_FLAT_DIAGRAM_BUILDER_H 1
+
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <vector>
+#include <boost/variant.hpp>
+#include <CGAL/Voronoi_diagram_2/basic.h>
+#include <CGAL/Flat_voronoi_diagram_2.h>
+#include <CGAL/Unique_hash_map.h>
+#include <CGAL/tags.h>
+
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#endif
+
+namespace CGAL {
+
+namespace VoronoiDiagram_2 { namespace Internal {
+
+//=========================================================================
+//=========================================================================
+
+// Fills a Flat_voronoi_diagram_2 from a Voronoi_diagram_2, for
+// Voronoi_diagram_2::materialize().
+//
+// The Voronoi vertex of each finite face of the Delaunay graph is
+// constructed once, and the faces joined by a degenerate edge (for the
+// edge rejector of the adaptation policy) share one vertex. Each other
+// edge is clipped to the box. The Voronoi points and the clipping are
+// computed in parallel with Parallel_tag; the degeneracy tests (which a
+// caching policy records) and the assembly are sequential.
+//
+// The cell of a Delaunay vertex v is walked around v: its Voronoi edges
+// come counterclockwise, and where one leaves the box the cell follows the
+// boundary counterclockwise up to the next one that comes back in. The
+// Voronoi edges that are not straight are clipped as the segments between
+// their vertices and the rays of the adaptation traits' Flat_edge_2.
+//
+// An edge lying on a side of the box, or clipped to a single point, is
+// left out: the boundary stands for it. The Voronoi vertices on the
+// boundary then start and end its runs like the points where the edges
+// are cut, and edges that meet the boundary at the same point share a
+// vertex there, so that no face or run has zero length.
+template<class VDA>
+class Flat_diagram_builder
+{
+ private:
+  typedef VDA                                      Voronoi_diagram_2;
+  typedef typename VDA::Delaunay_graph             Delaunay_graph;
+  typedef typename VDA::Adaptation_traits          Adaptation_traits;
+  typedef typename Adaptation_traits::Flat_edge_2  Flat_edge_2;
+  typedef typename VDA::Delaunay_vertex_handle     Delaunay_vertex_handle;
+  typedef typename VDA::Delaunay_face_handle       Delaunay_face_handle;
+  typedef typename VDA::Point_2                    Point_2;
+  typedef typename VDA::Locate_result              Locate_result;
+  typedef typename VDA::Face_handle                Face_handle;
+  typedef typename VDA::Halfedge_handle            Halfedge_handle;
+  typedef typename VDA::Vertex_handle              Vertex_handle;
+
+  typedef typename Delaunay_graph::Finite_vertices_iterator
+  Finite_vertices_iterator;
+  typedef typename Delaunay_graph::Finite_edges_iterator
+  Finite_edges_iterator;
+  typedef typename Delaunay_graph::All_faces_iterator  All_faces_iterator;
+  typedef typename Delaunay_graph::Face_circulator     Face_circulator;
+
+  typedef Triangulation_cw_ccw_2                   CW_CCW_2;
+
+  // A Voronoi edge, the points (px, py) + t (dx, dy) for t in [t0, t1],
+  // its half-edge 2k going with t. source and target are the faces of the
+  // Delaunay graph dual to its ends (-1 at infinity). Once clipped, side0
+  // and side1 are the sides of the box (0 to 3 counterclockwise from the
+  // bottom) where the ends were cut, or -1, and (x0, y0), (x1, y1) the
+  // clipped ends.
+  struct Edge
+  {
+    int     face, index;
+    int     source, target;
+    double  px, py, dx, dy, t0, t1;
+    int     side0, side1;
+    double  x0, y0, x1, y1;
+    bool    empty;
+  };
+
+  // Calls a member of the builder on the indices of a range
+  class Step
+  {
+    Flat_diagram_builder&  b_;
+    void (Flat_diagram_builder::*m_)(std::size_t);
+
+  public:
+    Step(Flat_diagram_builder& b, void (Flat_diagram_builder::*m)(std::size_t))
+      : b_(b), m_(m) {}
+
+#ifdef CGAL_LINKED_WITH_TBB
+    void operator()(const tbb::blocked_range<std::size_t>& r) const {
+      for (std::size_t i = r.begin(); i != r.end(); ++i) { (b_.*m_)(i); }
+    }
+#endif
+  };
+
+ public:
+  Flat_diagram_builder(const Voronoi_diagram_2& vd,
+		       Flat_voronoi_diagram_2& flat)
+    : vd_(vd), dg_(vd.dual()), flat_(flat) {}
+
+  template<class Concurrency_tag>
+  void operator()(const Bbox_2& bbox, Concurrency_tag tag)
+  {
+    flat_.clear();
+    flat_.bbox = bbox;
+    xmin_ = bbox.xmin(); ymin_ = bbox.ymin();
+    xmax_ = bbox.xmax(); ymax_ = bbox.ymax();
+    if ( dg_.number_of_vertices() == 0 ) { return; }
+
+    if ( dg_.dimension() == 2 ) {
+      number_faces();
+      for_each(faces_.size(), &Flat_diagram_builder::construct_point, tag);
+      collect_edges();
+    } else if ( dg_.dimension() == 1 ) {
+      collect_lines();
+    }
+    for_each(edges_.size(), &Flat_diagram_builder::clip, tag);
+
+    output_edges();
+    walk_cells();
+    close_boundary();
+  }
+
+ private:
+  void for_each(std::size_t n, void (Flat_diagram_builder::*m)(std::size_t),
+		Sequential_tag)
+  {
+    for (std::size_t i = 0; i < n; ++i) { (this->*m)(i); }
+  }
+
+  void for_each(std::size_t n, void (Flat_diagram_builder::*m)(std::size_t),
+		Parallel_tag)
+  {
+#ifdef CGAL_LINKED_WITH_TBB
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, n, 1024),
+		      Step(*this, m));
+#else
+    for_each(n, m, Sequential_tag());
+#endif
+  }
+
+  //------------------------------------------------------------------
+  // Voronoi vertices
+  //------------------------------------------------------------------
+
+  void number_faces()
+  {
+    faces_.clear();
+    for (All_faces_iterator fit = dg_.all_faces_begin();
+	 fit != dg_.all_faces_end(); ++fit) {
+      Delaunay_face_handle f = fit;
+      face_index_[f] = static_cast<int>(faces_.size());
+      faces_.push_back(f);
+    }
+    face_points_.resize(2 * faces_.size());
+    parent_.resize(faces_.size());
+    for (std::size_t i = 0; i < faces_.size(); ++i) {
+      parent_[i] = static_cast<int>(i);
+    }
+  }
+
+  void construct_point(std::size_t i)
+  {
+    if ( dg_.is_infinite(faces_[i]) ) { return; }
+    Point_2 p =
+      vd_.adaptation_traits().construct_Voronoi_point_2_object()(faces_[i]);
+    face_points_[2 * i]     = to_double(p.x());
+    face_points_[2 * i + 1] = to_double(p.y());
+  }
+
+  int find(int i)
+  {
+    while ( parent_[i] != i ) {
+      parent_[i] = parent_[parent_[i]];
+      i = parent_[i];
+    }
+    return i;
+  }
+
+  //------------------------------------------------------------------
+  // Voronoi edges
+  //------------------------------------------------------------------
+
+  // halfedge_of_[3 f + i] is the half-edge dual to the edge (f, i), whose
+  // cell on the left is the one of f->vertex(ccw(i)): 2k or 2k + 1 for
+  // edges_[k], or -1 for an infinite or degenerate edge
+  void collect_edges()
+  {
+    halfedge_of_.assign(3 * faces_.size(), -2);
+    for (std::size_t fi = 0; fi < faces_.size(); ++fi) {
+      Delaunay_face_handle f = faces_[fi];
+      for (int i = 0; i < 3; ++i) {
+	if ( halfedge_of_[3 * fi + i] != -2 ) { continue; }
+	Delaunay_face_handle g = f->neighbor(i);
+	int gi = face_index_[g];
+	// not g->index(f): two faces of an Apollonius graph may share two
+	// edges
+	int j = CW_CCW_2::ccw(g->index(f->vertex(CW_CCW_2::ccw(i))));
+	if ( dg_.is_infinite(f, i) ) {
+	  halfedge_of_[3 * fi + i] = halfedge_of_[3 * gi + j] = -1;
+	} else if ( vd_.edge_rejector()(dg_, f, i) ) {
+	  halfedge_of_[3 * fi + i] = halfedge_of_[3 * gi + j] = -1;
+	  parent_[find(static_cast<int>(fi))] = find(gi);
+	} else {
+	  int k = static_cast<int>(edges_.size());
+	  halfedge_of_[3 * fi + i] = 2 * k;
+	  halfedge_of_[3 * gi + j] = 2 * k + 1;
+	  Edge e;
+	  e.face = static_cast<int>(fi);
+	  e.index = i;
+	  edges_.push_back(e);
+	}
+      }
+    }
+    for (std::size_t fi = 0; fi < faces_.size(); ++fi) {
+      find(static_cast<int>(fi));
+    }
+  }
+
+  // with dimension 1, the edge between f->vertex(0) and f->vertex(1) is a
+  // line with f->vertex(0) on its left
+  void collect_lines()
+  {
+    Flat_edge_2 flat_edge;
+    int c = 0;
+    for (Finite_vertices_iterator vit = dg_.finite_vertices_begin();
+	 vit != dg_.finite_vertices_end(); ++vit, ++c) {
+      cell_index_[vit] = c;
+    }
+    line_halfedges_.assign(2 * c, -1);
+    for (Finite_edges_iterator eit = dg_.finite_edges_begin();
+	 eit != dg_.finite_edges_end(); ++eit) {
+      if ( vd_.edge_rejector()(dg_, *eit) ) { continue; }
+      Delaunay_vertex_handle p = eit->first->vertex(0);
+      Delaunay_vertex_handle q = eit->first->vertex(1);
+      int k = static_cast<int>(edges_.size());
+      Edge e;
+      e.source = e.target = -1;
+      flat_edge.bisector(p, q, e.px, e.py, e.dx, e.dy);
+      e.t0 = -std::numeric_limits<double>::infinity();
+      e.t1 = std::numeric_limits<double>::infinity();
+      edges_.push_back(e);
+      int cp = cell_index_[p], cq = cell_index_[q];
+      line_halfedges_[2 * cp + (line_halfedges_[2 * cp] < 0 ? 0 : 1)] = 2 * k;
+      line_halfedges_[2 * cq + (line_halfedges_[2 * cq] < 0 ? 0 : 1)] =
+	2 * k + 1;
+    }
+  }
+
+  bool is_inside(int face) const
+  {
+    double x = face_points_[2 * face], y = face_points_[2 * face + 1];
+    return xmin_ <= x && x <= xmax_ && ymin_ <= y && y <= ymax_;
+  }
+
+  // the side of the box that (x, y) is out of, or -1
+  int side_out(double x, double y) const
+  {
+    if ( y < ymin_ ) { return 0; }
+    if ( x > xmax_ ) { return 1; }
+    if ( y > ymax_ ) { return 2; }
+    if ( x < xmin_ ) { return 3; }
+    return -1;
+  }
+
+  // Geometry of the edge from the Voronoi points of its faces, then
+  // Liang-Barsky clipping. An end at a Voronoi vertex in the closed box
+  // is never cut, whatever the rounding, so that all the edges of a vertex
+  // agree on it.
+  void clip(std::size_t k)
+  {
+    Edge& e = edges_[k];
+    if ( dg_.dimension() == 2 ) { set_geometry(e); }
+
+    double t0 = e.t0, t1 = e.t1;
+    e.side0 = e.side1 = -1;
+    const double p[4] = { -e.dy, e.dx, e.dy, -e.dx };
+    const double q[4] = { e.py - ymin_, xmax_ - e.px, ymax_ - e.py,
+			  e.px - xmin_ };
+    e.empty = false;
+    for (int s = 0; s < 4; ++s) {
+      // parallel to side s, and out of the box or along it
+      if ( p[s] == 0 ) {
+	if ( q[s] <= 0 ) { e.empty = true; }
+	continue;
+      }
+      double r = q[s] / p[s];
+      if ( p[s] < 0 ) {
+	if ( r > t0 ) { t0 = r; e.side0 = s; }
+      } else if ( r < t1 ) {
+	t1 = r; e.side1 = s;
+      }
+    }
+    if ( e.source >= 0 && is_inside(e.source) ) {
+      t0 = e.t0;
+      e.side0 = -1;
+    }
+    if ( e.target >= 0 ) {
+      if ( is_inside(e.target) ) {
+	t1 = e.t1;
+	e.side1 = -1;
+      } else if ( e.side1 < 0 ) {
+	e.side1 = side_out(face_points_[2 * e.target],
+			   face_points_[2 * e.target + 1]);
+      }
+    }
+    if ( e.empty || t0 > t1 || t0 == -std::numeric_limits<double>::infinity()
+	 || t1 == std::numeric_limits<double>::infinity() ) {
+      e.empty = true;
+      return;
+    }
+    if ( e.side0 >= 0 ) {
+      point_on_side(e, t0, e.side0, e.x0, e.y0);
+    } else {
+      e.x0 = face_points_[2 * e.source];
+      e.y0 = face_points_[2 * e.source + 1];
+    }
+    if ( e.side1 >= 0 ) {
+      point_on_side(e, t1, e.side1, e.x1, e.y1);
+    } else {
+      e.x1 = face_points_[2 * e.target];
+      e.y1 = face_points_[2 * e.target + 1];
+    }
+    // cut to a point of the boundary
+    if ( (e.side0 >= 0 || e.side1 >= 0) && e.x0 == e.x1 && e.y0 == e.y1 ) {
+      e.empty = true;
+    }
+  }
+
+  void set_geometry(Edge& e) const
+  {
+    Flat_edge_2 flat_edge;
+    Delaunay_face_handle f = faces_[e.face];
+    Delaunay_face_handle g = f->neighbor(e.index);
+    Delaunay_vertex_handle a = f->vertex(CW_CCW_2::ccw(e.index));
+    Delaunay_vertex_handle b = f->vertex(CW_CCW_2::cw(e.index));
+    int fi = dg_.is_infinite(f) ? -1 : parent_[e.face];
+    int gi = dg_.is_infinite(g) ? -1 : parent_[face_index_[g]];
+    e.source = gi;
+    e.target = fi;
+    if ( fi >= 0 && gi >= 0 ) {
+      e.px = face_points_[2 * gi];
+      e.py = face_points_[2 * gi + 1];
+      e.dx = face_points_[2 * fi] - e.px;
+      e.dy = face_points_[2 * fi + 1] - e.py;
+      e.t0 = 0;
+      e.t1 = 1;
+    } else if ( gi >= 0 ) {
+      // f is the infinite face (infinite vertex, a, b)
+      e.px = face_points_[2 * gi];
+      e.py = face_points_[2 * gi + 1];
+      flat_edge.direction(a, b, e.px, e.py, e.dx, e.dy);
+      e.t0 = 0;
+      e.t1 = std::numeric_limits<double>::infinity();
+    } else {
+      // g is the infinite face (infinite vertex, b, a)
+      e.px = face_points_[2 * fi];
+      e.py = face_points_[2 * fi + 1];
+      flat_edge.direction(b, a, e.px, e.py, e.dx, e.dy);
+      e.dx = -e.dx;
+      e.dy = -e.dy;
+      e.t0 = -std::numeric_limits<double>::infinity();
+      e.t1 = 0;
+    }
+  }
+
+  void point_on_side(const Edge& e, double t, int side,
+		     double& x, double& y) const
+  {
+    if ( t == 1 && e.target >= 0 ) {
+      x = face_points_[2 * e.target];
+      y = face_points_[2 * e.target + 1];
+    } else {
+      x = e.px + t * e.dx;
+      y = e.py + t * e.dy;
+    }
+    x = (x < xmin_) ? xmin_ : ((x > xmax_) ? xmax_ : x);
+    y = (y < ymin_) ? ymin_ : ((y > ymax_) ? ymax_ : y);
+    switch ( side ) {
+    case 0: y = ymin_; break;
+    case 1: x = xmax_; break;
+    case 2: y = ymax_; break;
+    default: x = xmin_; break;
+    }
+  }
+
+  //------------------------------------------------------------------
+  // Assembly
+  //------------------------------------------------------------------
+
+  // position of (x, y) along the boundary, counterclockwise from
+  // (xmin, ymin), in [0, perimeter)
+  double boundary_position(int side, double x, double y) const
+  {
+    double w = xmax_ - xmin_, h = ymax_ - ymin_;
+    switch ( side ) {
+    case 0: return x - xmin_;
+    case 1: return w + (y - ymin_);
+    case 2: return w + h + (xmax_ - x);
+    default: return (y == ymin_) ? 0 : 2 * w + h + (ymax_ - y);
+    }
+  }
+
+  // the side of the box that (x, y) lies on, or -1
+  int side_on(double x, double y) const
+  {
+    if ( y == ymin_ ) { return 0; }
+    if ( x == xmax_ ) { return 1; }
+    if ( y == ymax_ ) { return 2; }
+    if ( x == xmin_ ) { return 3; }
+    return -1;
+  }
+
+  int new_vertex(double x, double y, double position)
+  {
+    int v = static_cast<int>(flat_.points.size() / 2);
+    flat_.points.push_back(x);
+    flat_.points.push_back(y);
+    position_.push_back(position);
+    boundary_in_.push_back(-1);
+    return v;
+  }
+
+  // the vertex at position along the boundary, created at (x, y) first
+  int boundary_vertex(double x, double y, double position)
+  {
+    std::map<double,int>::iterator it = boundary_vertices_.find(position);
+    if ( it == boundary_vertices_.end() ) {
+      it = boundary_vertices_.insert(
+	std::make_pair(position, new_vertex(x, y, position))).first;
+    }
+    return it->second;
+  }
+
+  int face_vertex(int face)
+  {
+    if ( vertex_of_face_[face] < 0 ) {
+      double x = face_points_[2 * face], y = face_points_[2 * face + 1];
+      int side = side_on(x, y);
+      vertex_of_face_[face] = (side < 0) ? new_vertex(x, y, -1)
+	: boundary_vertex(x, y, boundary_position(side, x, y));
+    }
+    return vertex_of_face_[face];
+  }
+
+  int new_edge(int source, int target)
+  {
+    int h = static_cast<int>(flat_.halfedge_source.size());
+    flat_.halfedge_source.push_back(source);
+    flat_.halfedge_source.push_back(target);
+    flat_.halfedge_next.push_back(-1);
+    flat_.halfedge_next.push_back(-1);
+    flat_.halfedge_face.push_back(-1);
+    flat_.halfedge_face.push_back(-1);
+    return h;
+  }
+
+  // the clipped edges in the order of edges_; flat_edge_[k] is the
+  // half-edge of the flat diagram for the half-edge 2k, or -1
+  void output_edges()
+  {
+    vertex_of_face_.assign(faces_.size(), -1);
+    flat_edge_.assign(edges_.size(), -1);
+    boundary_vertices_.clear();
+    for (std::size_t k = 0; k < edges_.size(); ++k) {
+      const Edge& e = edges_[k];
+      if ( e.empty ) { continue; }
+      int s = (e.side0 < 0) ? face_vertex(e.source)
+	: boundary_vertex(e.x0, e.y0, boundary_position(e.side0, e.x0, e.y0));
+      int t = (e.side1 < 0) ? face_vertex(e.target)
+	: boundary_vertex(e.x1, e.y1, boundary_position(e.side1, e.x1, e.y1));
+      flat_edge_[k] = new_edge(s, t);
+    }
+    voronoi_halfedges_ = flat_.halfedge_source.size();
+  }
+
+  int flat_halfedge(int h) const
+  {
+    if ( h < 0 || flat_edge_[h >> 1] < 0 ) { return -1; }
+    return flat_edge_[h >> 1] + (h & 1);
+  }
+
+  void walk_cells()
+  {
+    std::vector<int> halfedges;
+    int c = 0;
+    bool any = false;
+    for (Finite_vertices_iterator vit = dg_.finite_vertices_begin();
+	 vit != dg_.finite_vertices_end(); ++vit, ++c) {
+      flat_.face_halfedge.push_back(-1);
+      if ( vd_.face_rejector()(dg_, vit) ) { continue; }
+
+      halfedges.clear();
+      if ( dg_.dimension() == 2 ) {
+	Delaunay_vertex_handle v = vit;
+	Face_circulator fc = dg_.incident_faces(v), done(fc);
+	do {
+	  Delaunay_face_handle f = fc;
+	  int i = CW_CCW_2::cw(f->index(v));
+	  int h = flat_halfedge(halfedge_of_[3 * face_index_[f] + i]);
+	  if ( h >= 0 ) { halfedges.push_back(h); }
+	} while ( ++fc != done );
+      } else if ( dg_.dimension() == 1 ) {
+	for (int j = 0; j < 2; ++j) {
+	  int h = flat_halfedge(line_halfedges_[2 * c + j]);
+	  if ( h >= 0 ) { halfedges.push_back(h); }
+	}
+      }
+      any = any || !halfedges.empty();
+      link_cell(c, halfedges);
+    }
+
+    // no edge meets the box: it is in a single cell
+    if ( !any ) {
+      int cell = enclosing_cell();
+      if ( cell >= 0 ) {
+	int v = new_vertex(xmin_, ymin_, 0);
+	int h = boundary(v, v, cell, true);
+	flat_.halfedge_next[last_boundary_] = h;
+	flat_.face_halfedge[cell] = h;
+      }
+    }
+  }
+
+  void link_cell(int c, const std::vector<int>& halfedges)
+  {
+    if ( halfedges.empty() ) { return; }
+    flat_.face_halfedge[c] = halfedges[0];
+    for (std::size_t j = 0; j < halfedges.size(); ++j) {
+      int h = halfedges[j];
+      int h2 = halfedges[(j + 1) % halfedges.size()];
+      flat_.halfedge_face[h] = c;
+      int t = flat_.target(h);
+      if ( t == flat_.source(h2) ) {
+	flat_.halfedge_next[h] = h2;
+      } else {
+	CGAL_assertion( position_[t] >= 0 );
+	CGAL_assertion( position_[flat_.source(h2)] >= 0 );
+	int first = boundary(t, flat_.source(h2), c, false);
+	flat_.halfedge_next[h] = first;
+	flat_.halfedge_next[last_boundary_] = h2;
+      }
+    }
+  }
+
+  // Adds the half-edges from u to v counterclockwise along the boundary,
+  // through the corners between them, with the cell c on their left (all
+  // around when full). Returns the first; last_boundary_ is the last.
+  int boundary(int u, int v, int c, bool full)
+  {
+    double w = xmax_ - xmin_, h = ymax_ - ymin_;
+    const double corners[4] = { w, w + h, 2 * w + h, 2 * w + 2 * h };
+    const double cx[4] = { xmax_, xmax_, xmin_, xmin_ };
+    const double cy[4] = { ymin_, ymax_, ymax_, ymin_ };
+    double from = position_[u], to = position_[v];
+    if ( full || to < from ) { to += 2 * w + 2 * h; }
+
+    int first = -1, previous = -1, source = u;
+    for (int turn = 0; turn < 2; ++turn) {
+      double offset = turn * (2 * w + 2 * h);
+      for (int i = 0; i < 4; ++i) {
+	double position = corners[i] + offset;
+	if ( position <= from || position >= to ) { continue; }
+	int corner = boundary_vertex(cx[i], cy[i], corners[i] == 2 * w + 2 * h
+				     ? 0 : corners[i]);
+	previous = boundary_edge(source, corner, c, previous, first);
+	source = corner;
+      }
+    }
+    last_boundary_ = boundary_edge(source, v, c, previous, first);
+    return first;
+  }
+
+  int boundary_edge(int source, int target, int c, int previous, int& first)
+  {
+    int e = new_edge(source, target);
+    flat_.halfedge_face[e] = c;
+    boundary_in_[target] = e;
+    if ( previous >= 0 ) { flat_.halfedge_next[previous] = e; }
+    if ( first < 0 ) { first = e; }
+    return e;
+  }
+
+  // the cell containing the box when no edge meets it
+  int enclosing_cell()
+  {
+    int count = 0, cell = -1, c = 0;
+    for (Finite_vertices_iterator vit = dg_.finite_vertices_begin();
+	 vit != dg_.finite_vertices_end(); ++vit, ++c) {
+      if ( !vd_.face_rejector()(dg_, vit) ) { ++count; cell = c; }
+    }
+    if ( count <= 1 ) { return cell; }
+
+    Locate_result lr = vd_.locate(Point_2((xmin_ + xmax_) / 2,
+					  (ymin_ + ymax_) / 2));
+    Face_handle face;
+    if ( Face_handle* f = boost::get<Face_handle>(&lr) ) {
+      face = *f;
+    } else if ( Halfedge_handle* e = boost::get<Halfedge_handle>(&lr) ) {
+      face = (*e)->face();
+    } else {
+      face = boost::get<Vertex_handle>(lr)->halfedge()->face();
+    }
+    Delaunay_vertex_handle v = face->dual();
+    c = 0;
+    for (Finite_vertices_iterator vit = dg_.finite_vertices_begin();
+	 vit != dg_.finite_vertices_end(); ++vit, ++c) {
+      if ( Delaunay_vertex_handle(vit) == v ) { return c; }
+    }
+    return -1;
+  }
+
+  // the half-edges out of the box go clockwise around it
+  void close_boundary()
+  {
+    for (std::size_t h = voronoi_halfedges_;
+	 h < flat_.halfedge_source.size(); h += 2) {
+      flat_.halfedge_next[h + 1] =
+	boundary_in_[flat_.halfedge_source[h]] ^ 1;
+    }
+  }
+
+  const Voronoi_diagram_2&                        vd_;
+  const Delaunay_graph&                           dg_;
+  Flat_voronoi_diagram_2&                         flat_;
+  double                                          xmin_, ymin_, xmax_, ymax_;
+
+  std::vector<Delaunay_face_handle>               faces_;
+  Unique_hash_map<Delaunay_face_handle,int>       face_index_;
+  std::vector<double>                             face_points_;
+  std::vector<int>                                parent_;
+  std::vector<int>                                halfedge_of_;
+  Unique_hash_map<Delaunay_vertex_handle,int>     cell_index_;
+  std::vector<int>                                line_halfedges_;
+  std::vector<Edge>                               edges_;
+
+  std::vector<int>                                vertex_of_face_;
+  std::vector<int>                                flat_edge_;
+  std::vector<double>                             position_;
+  std::vector<int>                                boundary_in_;
+  std::map<double,int>                            boundary_vertices_;
+  std::size_t                                     voronoi_halfedges_;
+  int                                             last_boundary_;
+};
+
+//=========================================================================
+//=========================================================================
+
+} } //namespace VoronoiDiagram_2::Internal
+
+} //namespace CGAL
+
+#endif // CGAL_VORONOI_DIAGRAM_2_FLAT_DIAGRAM_BUILDER_H
@@ -167,6 +167,57 @@ create_offset_polygons_2 ( FT const& aOffset, Skeleton const& aSs, K const& /*k*
   return rR ;
 }
 
+//
+// Kernel != Skeleton::kernel. The skeleton is converted to Straight_skeleton_2<Kernel>
+//
+template<class OffsetIterator, class Skeleton, class PolygonPtrVectorIterator, class K, class Concurrency_tag>
+PolygonPtrVectorIterator
+create_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                  , OffsetIterator           aOffsetsEnd
+                                  , Skeleton const&          aSs
+                                  , PolygonPtrVectorIterator aOut
+                                  , K const&
+                                  , Concurrency_tag          aTag
+                                  , Tag_false
+                                  )
+{
+  typedef typename std::iterator_traits<PolygonPtrVectorIterator>::value_type OutPolygonPtrVector ;
+  typedef typename OutPolygonPtrVector::value_type::element_type              OutPolygon ;
+   
+  typedef Straight_skeleton_2<K> OfSkeleton ;
+   
+  typedef Polygon_offset_builder_traits_2<K>                                  OffsetBuilderTraits;
+  typedef Polygon_offset_builder_2<OfSkeleton,OffsetBuilderTraits,OutPolygon> OffsetBuilder;
+  
+  boost::shared_ptr<OfSkeleton> lConvertedSs = convert_straight_skeleton_2<OfSkeleton>(aSs);
+  OffsetBuilder ob( *lConvertedSs );
+  return ob.construct_offset_contours(aOffsetsBegin, aOffsetsEnd, aOut, aTag ) ;
+}
+
+//
+// Kernel == Skeleton::kernel, no convertion
+//
+template<class OffsetIterator, class Skeleton, class PolygonPtrVectorIterator, class K, class Concurrency_tag>
+PolygonPtrVectorIterator
+create_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                  , OffsetIterator           aOffsetsEnd
+                                  , Skeleton const&          aSs
+                                  , PolygonPtrVectorIterator aOut
+                                  , K const&
+                                  , Concurrency_tag          aTag
+                                  , Tag_true
+                                  )
+{
+  typedef typename std::iterator_traits<PolygonPtrVectorIterator>::value_type OutPolygonPtrVector ;
+  typedef typename OutPolygonPtrVector::value_type::element_type              OutPolygon ;
+   
+  typedef Polygon_offset_builder_traits_2<K>                                OffsetBuilderTraits;
+  typedef Polygon_offset_builder_2<Skeleton,OffsetBuilderTraits,OutPolygon> OffsetBuilder;
+  
+  OffsetBuilder ob(aSs);
+  return ob.construct_offset_contours(aOffsetsBegin, aOffsetsEnd, aOut, aTag ) ;
+}
+
 // Allow failure due to invalid straight skeletons to go through the users
 template<class Skeleton>
 Skeleton const& dereference ( boost::shared_ptr<Skeleton> const& ss )
@@ -212,6 +263,41 @@ create_offset_polygons_2 ( FT const& aOffset, Skeleton const& aSs )
 }
 #endif
 
+//
+// The offset polygons at each of the offsets in [aOffsetsBegin,aOffsetsEnd), which must be sorted in increasing order,
+// are appended to aOut[i], a std::vector< boost::shared_ptr<Polygon> > for instance. See Polygon_offset_builder_2.
+//
+template<class OffsetIterator, class Skeleton, class PolygonPtrVectorIterator, class K, class Concurrency_tag>
+PolygonPtrVectorIterator
+inline
+create_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                  , OffsetIterator           aOffsetsEnd
+                                  , Skeleton const&          aSs
+                                  , PolygonPtrVectorIterator aOut
+                                  , K const&                 k
+                                  , Concurrency_tag          aTag
+                                  )
+{
+  typedef typename Skeleton::Traits SsKernel ;
+  
+  typename CGAL_SS_i::Is_same_type<K,SsKernel>::type same_kernel ;
+  
+  return CGAL_SS_i::create_multiple_offset_polygons_2(aOffsetsBegin,aOffsetsEnd,aSs,aOut,k,aTag,same_kernel);
+}
+
+template<class OffsetIterator, class Skeleton, class PolygonPtrVectorIterator, class K>
+PolygonPtrVectorIterator
+inline
+create_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                  , OffsetIterator           aOffsetsEnd
+                                  , Skeleton const&          aSs
+                                  , PolygonPtrVectorIterator aOut
+                                  , K const&                 k
+                                  )
+{
+  return create_multiple_offset_polygons_2(aOffsetsBegin,aOffsetsEnd,aSs,aOut,k,Sequential_tag());
+}
+
 template<class Polygon, class FT, class Skeleton>
 std::vector< boost::shared_ptr<Polygon> > 
 inline
@@ -304,6 +390,129 @@ create_interior_skeleton_and_offset_polygons_2 ( FT const& aOffset, Polygon cons
   return create_interior_skeleton_and_offset_polygons_2(aOffset, aPoly, typename Polygon::Traits() );
 }
 
+//
+// Builds the interior skeleton once, up to the largest offset, for all the offsets in [aOffsetsBegin,aOffsetsEnd)
+//
+template<class OffsetIterator, class Polygon, class HoleIterator, class PolygonPtrVectorIterator, class OfK, class SsK, class Concurrency_tag>
+PolygonPtrVectorIterator
+create_interior_skeleton_and_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                                        , OffsetIterator           aOffsetsEnd
+                                                        , Polygon const&           aOuterBoundary
+                                                        , HoleIterator             aHolesBegin
+                                                        , HoleIterator             aHolesEnd
+                                                        , PolygonPtrVectorIterator aOut
+                                                        , OfK const&               ofk
+                                                        , SsK const&               ssk
+                                                        , Concurrency_tag          aTag
+                                                        )
+{
+  if ( aOffsetsBegin == aOffsetsEnd )
+    return aOut ;
+    
+  OffsetIterator lLast = aOffsetsBegin ;
+  for ( OffsetIterator i = aOffsetsBegin ; i != aOffsetsEnd ; ++ i )
+    lLast = i ;
+    
+  return create_multiple_offset_polygons_2
+          (aOffsetsBegin
+          ,aOffsetsEnd
+          ,CGAL_SS_i::dereference
+            ( CGAL_SS_i::create_partial_interior_straight_skeleton_2(*lLast
+                                                                    ,CGAL_SS_i::vertices_begin(aOuterBoundary)
+                                                                    ,CGAL_SS_i::vertices_end  (aOuterBoundary)
+                                                                    ,aHolesBegin
+                                                                    ,aHolesEnd
+                                                                    ,ssk
+                                                                    ) 
+            )
+          ,aOut
+          ,ofk
+          ,aTag
+          );
+}
+
+template<class OffsetIterator, class Polygon, class HoleIterator, class PolygonPtrVectorIterator, class OfK, class SsK>
+PolygonPtrVectorIterator
+inline
+create_interior_skeleton_and_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                                        , OffsetIterator           aOffsetsEnd
+                                                        , Polygon const&           aOuterBoundary
+                                                        , HoleIterator             aHolesBegin
+                                                        , HoleIterator             aHolesEnd
+                                                        , PolygonPtrVectorIterator aOut
+                                                        , OfK const&               ofk
+                                                        , SsK const&               ssk
+                                                        )
+{
+  return create_interior_skeleton_and_multiple_offset_polygons_2(aOffsetsBegin
+                                                                ,aOffsetsEnd
+                                                                ,aOuterBoundary
+                                                                ,aHolesBegin
+                                                                ,aHolesEnd
+                                                                ,aOut
+                                                                ,ofk
+                                                                ,ssk
+                                                                ,Sequential_tag()
+                                                                );
+}
+
+template<class OffsetIterator, class Polygon, class HoleIterator, class PolygonPtrVectorIterator>
+PolygonPtrVectorIterator
+inline
+create_interior_skeleton_and_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                                        , OffsetIterator           aOffsetsEnd
+                                                        , Polygon const&           aOuterBoundary
+                                                        , HoleIterator             aHolesBegin
+                                                        , HoleIterator             aHolesEnd
+                                                        , PolygonPtrVectorIterator aOut
+                                                        )
+{
+  return create_interior_skeleton_and_multiple_offset_polygons_2(aOffsetsBegin
+                                                                ,aOffsetsEnd
+                                                                ,aOuterBoundary
+                                                                ,aHolesBegin
+                                                                ,aHolesEnd
+                                                                ,aOut
+                                                                ,typename Polygon::Traits()
+                                                                ,Exact_predicates_inexact_constructions_kernel()
+                                                                );
+}
+
+template<class OffsetIterator, class Polygon, class PolygonPtrVectorIterator, class Concurrency_tag>
+PolygonPtrVectorIterator
+inline
+create_interior_skeleton_and_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                                        , OffsetIterator           aOffsetsEnd
+                                                        , Polygon const&           aPoly
+                                                        , PolygonPtrVectorIterator aOut
+                                                        , Concurrency_tag          aTag
+                                                        )
+{
+  std::vector<Polygon> no_holes ;
+  return create_interior_skeleton_and_multiple_offset_polygons_2(aOffsetsBegin
+                                                                ,aOffsetsEnd
+                                                                ,aPoly
+                                                                ,no_holes.begin()
+                                                                ,no_holes.end()
+                                                                ,aOut
+                                                                ,typename Polygon::Traits()
+                                                                ,Exact_predicates_inexact_constructions_kernel()
+                                                                ,aTag
+                                                                );
+}
+
+template<class OffsetIterator, class Polygon, class PolygonPtrVectorIterator>
+PolygonPtrVectorIterator
+inline
+create_interior_skeleton_and_multiple_offset_polygons_2 ( OffsetIterator           aOffsetsBegin
+                                                        , OffsetIterator           aOffsetsEnd
+                                                        , Polygon const&           aPoly
+                                                        , PolygonPtrVectorIterator aOut
+                                                        )
+{
+  return create_interior_skeleton_and_multiple_offset_polygons_2(aOffsetsBegin,aOffsetsEnd,aPoly,aOut,Sequential_tag());
+}
+
 template<class FT, class Polygon, class OfK, class SsK>
 std::vector< boost::shared_ptr<Polygon> >
 inline
@@ -0,0 +1,45 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+#ifndef CGAL_INTERNAL_CONSTRAINT_ENDPOINTS_2_H
+#define CGAL_INTERNAL_CONSTRAINT_ENDPOINTS_2_H
+
+#include <utility>
+
+namespace CGAL {
+
+namespace internal {
+
+// The endpoints of a constraint given to the range insert_constraints() of
+// the constrained triangulations, either a segment or a pair of points.
+template <class Point, class Segment_2>
+inline const Point& constraint_source(const Segment_2& segment){
+  return segment.source();
+}
+template <class Point, class Segment_2>
+inline const Point& constraint_target(const Segment_2& segment){
+  return segment.target();
+}
+
+template <class Point>
+inline const Point& constraint_source(const std::pair<Point, Point>& cst){
+  return cst.first;
+}
+template <class Point>
+inline const Point& constraint_target(const std::pair<Point, Point>& cst){
+  return cst.second;
+}
+
+} // namespace internal
+
+} // namespace CGAL
+
+#endif // CGAL_INTERNAL_CONSTRAINT_ENDPOINTS_2_H
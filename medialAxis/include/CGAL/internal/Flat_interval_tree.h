@@ -0,0 +1,178 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+#ifndef CGAL_INTERNAL_FLAT_INTERVAL_TREE_H
+#define CGAL_INTERNAL_FLAT_INTERVAL_TREE_H
+
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace CGAL {
+
+namespace internal {
+
+// A static set of half-open intervals [lo, hi) of ints, numbered in the
+// order they were added, that reports the intervals containing a given
+// int in O(log n + k). It is a centered interval tree stored in arrays:
+// each node keeps the intervals containing its center twice, sorted by
+// increasing lo and by decreasing hi, and the intervals entirely on
+// either side go to its children. Empty intervals are kept for their
+// number but never reported.
+class Flat_interval_tree
+{
+  struct Node
+  {
+    int center;
+    int begin, end;   // the intervals of the node, in by_lo and by_hi
+    int left, right;  // -1 for none
+  };
+
+  struct Less_lo
+  {
+    const std::vector<int>* lo;
+    Less_lo(const std::vector<int>* l) : lo(l) {}
+    bool operator()(int i, int j) const { return (*lo)[i] < (*lo)[j]; }
+  };
+
+  struct Greater_hi
+  {
+    const std::vector<int>* hi;
+    Greater_hi(const std::vector<int>* h) : hi(h) {}
+    bool operator()(int i, int j) const { return (*hi)[j] < (*hi)[i]; }
+  };
+
+  struct Is_left
+  {
+    const std::vector<int>* hi;
+    int c;
+    Is_left(const std::vector<int>* h, int cc) : hi(h), c(cc) {}
+    bool operator()(int i) const { return (*hi)[i] <= c; }
+  };
+
+  struct Is_not_right
+  {
+    const std::vector<int>* lo;
+    int c;
+    Is_not_right(const std::vector<int>* l, int cc) : lo(l), c(cc) {}
+    bool operator()(int i) const { return (*lo)[i] <= c; }
+  };
+
+  std::vector<int>  lo_, hi_;
+  std::vector<Node> nodes;
+  std::vector<int>  by_lo, by_hi;
+  int root;
+
+public:
+  Flat_interval_tree() : root(-1) {}
+
+  std::size_t size() const { return lo_.size(); }
+  int lo(int i) const { return lo_[i]; }
+  int hi(int i) const { return hi_[i]; }
+
+  void reserve(std::size_t n)
+  {
+    lo_.reserve(n);
+    hi_.reserve(n);
+  }
+
+  // adds the interval number size()
+  void push_back(int l, int h)
+  {
+    lo_.push_back(l);
+    hi_.push_back(h);
+  }
+
+  // to be called once all the intervals are added
+  void build()
+  {
+    nodes.clear();
+    by_lo.clear();
+    by_hi.clear();
+    std::vector<int> ids;
+    for (int i = 0; i < int(lo_.size()); ++i)
+      if (lo_[i] < hi_[i])
+	ids.push_back(i);
+    by_lo.reserve(ids.size());
+    by_hi.reserve(ids.size());
+    root = build(ids.begin(), ids.end());
+  }
+
+  // writes the numbers of the intervals containing r
+  template <class OutputIterator>
+  OutputIterator stab(int r, OutputIterator out) const
+  {
+    int n = root;
+    while (n >= 0) {
+      const Node& node = nodes[n];
+      if (r < node.center) {
+	for (int k = node.begin; k < node.end && lo_[by_lo[k]] <= r; ++k)
+	  *out++ = by_lo[k];
+	n = node.left;
+      } else {
+	for (int k = node.begin; k < node.end && hi_[by_hi[k]] > r; ++k)
+	  *out++ = by_hi[k];
+	n = node.right;
+      }
+    }
+    return out;
+  }
+
+  void clear()
+  {
+    lo_.clear();
+    hi_.clear();
+    nodes.clear();
+    by_lo.clear();
+    by_hi.clear();
+    root = -1;
+  }
+
+private:
+  // the center is the median lo, so that the node holds at least one
+  // interval and each child at most half of them
+  int build(std::vector<int>::iterator first, std::vector<int>::iterator last)
+  {
+    if (first == last)
+      return -1;
+    std::vector<int>::iterator mid = first + (last - first) / 2;
+    std::nth_element(first, mid, last, Less_lo(&lo_));
+    int c = lo_[*mid];
+
+    std::vector<int>::iterator left_end =
+      std::partition(first, last, Is_left(&hi_, c));
+    std::vector<int>::iterator right_begin =
+      std::partition(left_end, last, Is_not_right(&lo_, c));
+
+    int n = int(nodes.size());
+    Node node;
+    node.center = c;
+    node.begin = int(by_lo.size());
+    by_lo.insert(by_lo.end(), left_end, right_begin);
+    by_hi.insert(by_hi.end(), left_end, right_begin);
+    node.end = int(by_lo.size());
+    std::sort(by_lo.begin() + node.begin, by_lo.end(), Less_lo(&lo_));
+    std::sort(by_hi.begin() + node.begin, by_hi.end(), Greater_hi(&hi_));
+    nodes.push_back(node);
+
+    int l = build(first, left_end);
+    int r = build(right_begin, last);
+    nodes[n].left = l;
+    nodes[n].right = r;
+    return n;
+  }
+};
+
+} // namespace internal
+
+} // namespace CGAL
+
+#endif // CGAL_INTERNAL_FLAT_INTERVAL_TREE_H
@@ -0,0 +1,185 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+#ifndef CGAL_INTERNAL_TDS_2_BINARY_IO_H
+#define CGAL_INTERNAL_TDS_2_BINARY_IO_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+
+#include <CGAL/IO/io.h>
+
+namespace CGAL {
+
+namespace internal { namespace Tds_2_binary_io {
+
+typedef boost::uint32_t Index;
+
+// Reads count values of type T into v. A count larger than what is left
+// in the stream fails without allocating it: it is checked against the
+// stream size when the stream can seek, otherwise v grows by blocks.
+template <class T>
+bool read_binary_array(std::istream& is, std::vector<T>& v,
+                       boost::uint64_t count)
+{
+  v.clear();
+  std::streampos here = is.tellg();
+  if (here != std::streampos(-1)) {
+    is.seekg(0, std::ios::end);
+    std::streampos end = is.tellg();
+    is.seekg(here);
+    if (! is || boost::uint64_t(end - here) / sizeof(T) < count)
+      return false;
+    v.resize(static_cast<std::size_t>(count));
+    if (count != 0)
+      is.read(reinterpret_cast<char*>(&v[0]), count * sizeof(T));
+    return bool(is);
+  }
+
+  const boost::uint64_t block = 1 << 16;
+  while (v.size() < count) {
+    std::size_t first = v.size();
+    std::size_t size =
+      static_cast<std::size_t>((std::min)(block, count - first));
+    v.resize(first + size);
+    is.read(reinterpret_cast<char*>(&v[first]), size * sizeof(T));
+    if (! is) return false;
+  }
+  return true;
+}
+
+// The blocks of Triangulation_2::binary_output() for the data structure
+// tds, v being the vertex 0. V and F number the vertices and the faces:
+// V[h] and F[h] must accept the handles and iterators of tds.
+template <class Tds, class Vertex_numbers, class Face_numbers>
+void binary_output(std::ostream& os, const Tds& tds,
+                   typename Tds::Vertex_handle v,
+                   Vertex_numbers& V, Face_numbers& F)
+{
+  // the point of v is not output (it is the infinite vertex of the
+  // triangulation)
+  typedef typename Tds::Vertex_iterator Vertex_iterator;
+  typedef typename Tds::Face_iterator   Face_iterator;
+
+  const boost::uint64_t n = tds.number_of_vertices();
+  const boost::uint64_t m = tds.number_of_full_dim_faces();
+  const int dv = (tds.dimension() == -1 ? 1 :  tds.dimension() + 1);
+  const int dn = tds.dimension() + 1;
+  CGAL::write(os, boost::int32_t(tds.dimension()));
+  CGAL::write(os, n);
+  CGAL::write(os, m);
+
+  std::vector<double> coordinates;
+  std::vector<Index> vertices, neighbors;
+  coordinates.reserve(2 * n);
+  vertices.reserve(m * dv);
+  neighbors.reserve(m * dn);
+
+  Index inum = 0;
+  V[v] = inum++;
+  for( Vertex_iterator vit= tds.vertices_begin();
+       vit != tds.vertices_end() ; ++vit) {
+    if ( v != vit ) {
+      V[vit] = inum++;
+      coordinates.push_back(CGAL::to_double(vit->point().x()));
+      coordinates.push_back(CGAL::to_double(vit->point().y()));
+    }
+  }
+  inum = 0;
+  for( Face_iterator ib = tds.face_iterator_base_begin();
+       ib != tds.face_iterator_base_end(); ++ib) {
+    F[ib] = inum++;
+    for(int j = 0; j < dv ; ++j)
+      vertices.push_back(V[ib->vertex(j)]);
+  }
+  for( Face_iterator ib = tds.face_iterator_base_begin();
+       ib != tds.face_iterator_base_end(); ++ib)
+    for(int j = 0; j < dn; ++j)
+      neighbors.push_back(F[ib->neighbor(j)]);
+
+  if (! coordinates.empty())
+    os.write(reinterpret_cast<const char*>(&coordinates[0]),
+             coordinates.size() * sizeof(double));
+  if (! vertices.empty())
+    os.write(reinterpret_cast<const char*>(&vertices[0]),
+             vertices.size() * sizeof(Index));
+  if (! neighbors.empty())
+    os.write(reinterpret_cast<const char*>(&neighbors[0]),
+             neighbors.size() * sizeof(Index));
+}
+
+// Reads the blocks written by binary_output() into tds, which is reset
+// first. V gets the vertices in the order of the input, V[0] having no
+// point. Returns false if the input is truncated or an index is out of
+// range.
+template <class Tds>
+bool binary_input(std::istream& is, Tds& tds,
+                  std::vector<typename Tds::Vertex_handle>& V)
+{
+  typedef typename Tds::Vertex::Point Point;
+  typedef typename Tds::Face_handle   Face_handle;
+  typedef typename Tds::size_type     size_type;
+
+  boost::int32_t d = -2;
+  boost::uint64_t n = 0, m = 0;
+  CGAL::read(is, d);
+  CGAL::read(is, n);
+  CGAL::read(is, m);
+  // the indices are 32 bits wide, which also bounds n and m
+  if (! is || d < -1 || d > 2 || n == 0 ||
+      n > 0xFFFFFFFFu || m > 0xFFFFFFFFu) return false;
+
+  const int dv = (d == -1 ? 1 :  d + 1);
+  const int dn = d + 1;
+  std::vector<double> coordinates;
+  std::vector<Index> vertices, neighbors;
+  if (! read_binary_array(is, coordinates, 2 * (n - 1)) ||
+      ! read_binary_array(is, vertices, m * dv) ||
+      ! read_binary_array(is, neighbors, m * dn))
+    return false;
+
+  tds.reset();
+  tds.reserve(n - 1);
+  tds.set_dimension(d);
+  V.resize(n);
+  std::vector<Face_handle> F(m);
+
+  V[0] = tds.create_vertex();
+  for(size_type i = 1; i < n; ++i) {
+    V[i] = tds.create_vertex();
+    V[i]->set_point(Point(coordinates[2*i-2], coordinates[2*i-1]));
+  }
+  for(size_type i = 0; i < m; ++i) {
+    F[i] = tds.create_face();
+    for(int j = 0; j < dv ; ++j) {
+      Index index = vertices[i*dv + j];
+      if (index >= n) return false;
+      F[i]->set_vertex(j, V[index]);
+      V[index]->set_face(F[i]);
+    }
+  }
+  for(size_type i = 0; i < m; ++i) {
+    for(int j = 0; j < dn; ++j) {
+      Index index = neighbors[i*dn + j];
+      if (index >= m || index == i) return false;
+      F[i]->set_neighbor(j, F[index]);
+    }
+  }
+  return true;
+}
+
+} } // namespace internal::Tds_2_binary_io
+
+} // namespace CGAL
+
+#endif // CGAL_INTERNAL_TDS_2_BINARY_IO_H
@@ -0,0 +1,53 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+//******************************************************************************
+// File Description : lloyd_optimize_mesh_2 function definition.
+//******************************************************************************
+
+#ifndef CGAL_LLOYD_OPTIMIZE_MESH_2_H
+#define CGAL_LLOYD_OPTIMIZE_MESH_2_H
+
+#include <CGAL/Mesh_3/global_parameters.h>
+#include <CGAL/Mesh_2/Mesh_global_optimizer_2.h>
+#include <CGAL/Mesh_2/Lloyd_move_2.h>
+#include <CGAL/Mesh_optimization_return_code.h>
+#include <CGAL/Mesh_3/parameters_defaults.h>
+#include <CGAL/tags.h>
+
+namespace CGAL {
+
+// The mesh is a Constrained_Delaunay_triangulation_2 with a
+// Delaunay_mesh_face_base_2, and its domain the faces marked in_domain,
+// as Delaunay_mesher_2 leaves them.
+BOOST_PARAMETER_FUNCTION(
+  (Mesh_optimization_return_code),
+  lloyd_optimize_mesh_2,
+  parameters::tag,
+  (required (in_out(cdt),*) )
+  (optional
+    (time_limit_, *, 0 )
+    (max_iteration_number_, *, 0 )
+    (convergence_, *, parameters::default_values::lloyd_convergence_ratio )
+    (freeze_bound_, *, parameters::default_values::lloyd_freeze_ratio )
+    (do_freeze_, *, parameters::default_values::do_freeze )
+    (concurrency_tag_, *, Sequential_tag() ))
+)
+{
+  return Mesh_2::optimize_mesh_2_impl<Mesh_2::Lloyd_move_2>(
+    cdt, time_limit_, max_iteration_number_,
+    convergence_, freeze_bound_, do_freeze_, concurrency_tag_);
+} 
+  
+  
+}  // end namespace CGAL
+
+
+#endif // CGAL_LLOYD_OPTIMIZE_MESH_2_H
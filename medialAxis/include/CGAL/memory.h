@@ -36,8 +36,16 @@
 // For debugging with GCC, the following allocator can be useful :
 // std::__allocator<T, std::__debug_alloc<std::__malloc_alloc_template<0> > >
 
+// Defining CGAL_USE_HUGE_PAGES makes it Huge_page_allocator, which asks for
+// transparent huge pages for large blocks.
+
 #ifndef CGAL_ALLOCATOR
-#  define CGAL_ALLOCATOR(T) std::allocator< T >
+#  ifdef CGAL_USE_HUGE_PAGES
+#    include <CGAL/Huge_page_allocator.h>
+#    define CGAL_ALLOCATOR(T) CGAL::Huge_page_allocator< T >
+#  else
+#    define CGAL_ALLOCATOR(T) std::allocator< T >
+#  endif
 #endif
 
 #ifndef CGAL_MEMORY
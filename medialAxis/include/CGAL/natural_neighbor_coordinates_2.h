@@ -22,6 +22,7 @@
 #define CGAL_NATURAL_NEIGHBOR_COORDINATES_2_H
 
 #include <utility>
+#include <vector>
 #include <CGAL/Iterator_project.h>
 #include <CGAL/Polygon_2.h>
 #include <CGAL/number_utils_classes.h>
@@ -153,7 +154,7 @@ natural_neighbor_coordinates_vertex_2(const Dt& dt,
     return make_triple(out, Coord_type(1), true);
   }
 
-  std::list<Edge> hole;
+  std::vector<Edge> hole;
 
   dt.get_boundary_of_conflicts(p, std::back_inserter(hole), fh, false);
 
@@ -182,7 +183,7 @@ natural_neighbor_coordinates_vertex_2(const Dt& dt,
   typedef typename Dt::Face_circulator   Face_circulator;
 
 
-  std::vector<Point_2> vor(3);
+  Point_2 vor[3];
 
   Coord_type area_sum(0);
   EdgeIterator hit = hole_end;
@@ -211,14 +212,14 @@ natural_neighbor_coordinates_vertex_2(const Dt& dt,
 	 ++fc;
 	 vor[2] = dt.dual(fc);
 	
-	 area += polygon_area_2(vor.begin(), vor.end(), dt.geom_traits());
+	 area += polygon_area_2(vor, vor+3, dt.geom_traits());
          
 	 vor[1] = vor[2];
        };
      vor[2] =
        dt.geom_traits().construct_circumcenter_2_object()(prev->point(),
 							  current->point(),p);
-     area += polygon_area_2(vor.begin(), vor.end(), dt.geom_traits());
+     area += polygon_area_2(vor, vor+3, dt.geom_traits());
 
      
 	 *out++= std::make_pair(current,area);
@@ -0,0 +1,269 @@
+// You can redistribute this file and/or modify it under the terms of the GNU
+// General Public License as published by the Free Software Foundation,
+// either version 3 of the License, or (at your option) any later version.
+//
+// This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+// WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+//
+// $URL$
+// $Id$
+//
+
+#ifndef CGAL_NATURAL_NEIGHBOR_INTERPOLATION_2_H
+#define CGAL_NATURAL_NEIGHBOR_INTERPOLATION_2_H
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <CGAL/natural_neighbor_coordinates_2.h>
+#include <CGAL/interpolation_functions.h>
+#include <CGAL/Spatial_sort_traits_adapter_2.h>
+#include <CGAL/property_map.h>
+#include <CGAL/hilbert_sort.h>
+#include <CGAL/tags.h>
+
+#ifdef CGAL_LINKED_WITH_TBB
+#  include <tbb/parallel_for.h>
+#  include <tbb/blocked_range.h>
+#  include <tbb/enumerable_thread_specific.h>
+#endif
+
+// Number of queries sorted and interpolated together by
+// natural_neighbor_interpolation_2(): the unit of work of the threads.
+#ifndef CGAL_NATURAL_NEIGHBOR_INTERPOLATION_CHUNK_SIZE
+#  define CGAL_NATURAL_NEIGHBOR_INTERPOLATION_CHUNK_SIZE 4096
+#endif
+
+namespace CGAL {
+
+namespace internal {
+
+// Interpolates chunks of queries one after another. The hole and the
+// coordinates of a query are collected in vectors kept from one query to
+// the next, and each locate starts from the face of the previous query.
+// The triangulation is only read: each thread has its own interpolator.
+template <class Dt, class RandomAccessIterator, class OutputGrid,
+          class Functor>
+class Natural_neighbor_interpolator_2
+{
+  typedef typename Dt::Geom_traits                        Traits;
+  typedef typename Traits::FT                             Coord_type;
+  typedef typename Traits::Point_2                        Point_2;
+  typedef typename Dt::Face_handle                        Face_handle;
+  typedef typename Dt::Vertex_handle                      Vertex_handle;
+  typedef typename Dt::Edge                               Edge;
+  typedef typename Dt::Locate_type                        Locate_type;
+  typedef std::pair<Vertex_handle, Coord_type>            Coordinate;
+
+  typedef Input_iterator_property_map<RandomAccessIterator>  Point_map;
+  typedef Spatial_sort_traits_adapter_2<Traits, Point_map>   Search_traits;
+
+public:
+  typedef typename Functor::result_type::first_type       Value_type;
+
+  Natural_neighbor_interpolator_2(const Dt& dt,
+                                  RandomAccessIterator first,
+                                  OutputGrid result,
+                                  Functor function_value,
+                                  const Value_type& outside_value)
+    : dt_(dt), first_(first), result_(result),
+      function_value_(function_value), outside_value_(outside_value),
+      interpolated_(0), value_()
+  {}
+
+  // interpolates the queries [first+begin, first+end) in Hilbert order
+  void operator()(std::ptrdiff_t begin, std::ptrdiff_t end)
+  {
+    queries_.clear();
+    for (std::ptrdiff_t i = begin; i != end; ++i)
+      queries_.push_back(first_ + i);
+    hilbert_sort(queries_.begin(), queries_.end(),
+                 Search_traits(Point_map(), dt_.geom_traits()));
+
+    for (typename std::vector<RandomAccessIterator>::const_iterator
+           qit = queries_.begin(); qit != queries_.end(); ++qit)
+    {
+      if (interpolate(**qit)) {
+        result_[*qit - first_] = value_;
+        ++interpolated_;
+      } else {
+        result_[*qit - first_] = outside_value_;
+      }
+    }
+  }
+
+  // the number of queries in the convex hull so far
+  std::size_t interpolated() const { return interpolated_; }
+
+private:
+  // Same cases as natural_neighbor_coordinates_vertex_2(), in value_
+  bool interpolate(const Point_2& p)
+  {
+    Locate_type lt;
+    int li;
+    hint_ = dt_.locate(p, lt, li, hint_);
+
+    if (lt == Dt::OUTSIDE_AFFINE_HULL || lt == Dt::OUTSIDE_CONVEX_HULL)
+      return false;
+
+    if (lt == Dt::VERTEX) {
+      value_ = function_value_(hint_->vertex(li)).first;
+      return true;
+    }
+
+    coordinates_.clear();
+    Coord_type norm;
+    if (lt == Dt::EDGE &&
+        (dt_.is_infinite(hint_) || dt_.is_infinite(hint_->neighbor(li))))
+    {
+      norm = natural_neighbor_coordinates_vertex_2
+        (dt_, p, std::back_inserter(coordinates_), hint_).second;
+    } else {
+      hole_.clear();
+      dt_.get_boundary_of_conflicts(p, std::back_inserter(hole_),
+                                    hint_, false);
+      norm = natural_neighbor_coordinates_vertex_2
+        (dt_, p, std::back_inserter(coordinates_),
+         hole_.begin(), hole_.end()).second;
+    }
+    value_ = linear_interpolation(coordinates_.begin(), coordinates_.end(),
+                                  norm, function_value_);
+    return true;
+  }
+
+  const Dt&                           dt_;
+  RandomAccessIterator                first_;
+  OutputGrid                          result_;
+  Functor                             function_value_;
+  Value_type                          outside_value_;
+  std::size_t                         interpolated_;
+
+  Face_handle                         hint_;
+  std::vector<RandomAccessIterator>   queries_;
+  std::vector<Edge>                   hole_;
+  std::vector<Coordinate>             coordinates_;
+  Value_type                          value_;
+};
+
+template <class Interpolator>
+std::size_t
+natural_neighbor_interpolation_2(Interpolator interpolator,
+                                 std::ptrdiff_t size, Sequential_tag)
+{
+  const std::ptrdiff_t chunk = CGAL_NATURAL_NEIGHBOR_INTERPOLATION_CHUNK_SIZE;
+  for (std::ptrdiff_t begin = 0; begin < size; begin += chunk)
+    interpolator(begin, (std::min)(begin + chunk, size));
+  return interpolator.interpolated();
+}
+
+#ifdef CGAL_LINKED_WITH_TBB
+// Functor for the parallel interpolation: the range is a range of chunks
+template <class Interpolator>
+class Interpolate_chunks
+{
+  tbb::enumerable_thread_specific<Interpolator>  & m_interpolators;
+  std::ptrdiff_t                                   m_size;
+
+public:
+  Interpolate_chunks(tbb::enumerable_thread_specific<Interpolator>& i,
+                     std::ptrdiff_t size)
+    : m_interpolators(i), m_size(size)
+  {}
+
+  void operator()(const tbb::blocked_range<std::ptrdiff_t>& r) const
+  {
+    const std::ptrdiff_t chunk =
+      CGAL_NATURAL_NEIGHBOR_INTERPOLATION_CHUNK_SIZE;
+    Interpolator& interpolator = m_interpolators.local();
+    for (std::ptrdiff_t c = r.begin(); c != r.end(); ++c)
+      interpolator(c * chunk, (std::min)((c + 1) * chunk, m_size));
+  }
+};
+#endif // CGAL_LINKED_WITH_TBB
+
+template <class Interpolator>
+std::size_t
+natural_neighbor_interpolation_2(Interpolator interpolator,
+                                 std::ptrdiff_t size, Parallel_tag)
+{
+#ifdef CGAL_LINKED_WITH_TBB
+  const std::ptrdiff_t chunk = CGAL_NATURAL_NEIGHBOR_INTERPOLATION_CHUNK_SIZE;
+  const std::ptrdiff_t chunks = (size + chunk - 1) / chunk;
+  tbb::enumerable_thread_specific<Interpolator> interpolators(interpolator);
+  tbb::parallel_for(tbb::blocked_range<std::ptrdiff_t>(0, chunks, 1),
+                    Interpolate_chunks<Interpolator>(interpolators, size));
+  std::size_t interpolated = 0;
+  for (typename tbb::enumerable_thread_specific<Interpolator>::iterator
+         it = interpolators.begin(); it != interpolators.end(); ++it)
+    interpolated += it->interpolated();
+  return interpolated;
+#else
+  return natural_neighbor_interpolation_2(interpolator, size,
+                                          Sequential_tag());
+#endif
+}
+
+} // namespace internal
+
+// Linear interpolation of the function given at the vertices of dt, at
+// each point of [first, beyond) from its natural neighbor coordinates:
+// result[i] is the value at first[i], or outside_value when first[i] is
+// out of the convex hull of dt. Returns the number of points in the
+// convex hull.
+//
+// function_value is called with a Dt::Vertex_handle and returns a pair
+// (value, bool) as for linear_interpolation(). result is a random access
+// iterator (or any type with operator[]) into the caller's grid.
+//
+// The points are cut into chunks of
+// CGAL_NATURAL_NEIGHBOR_INTERPOLATION_CHUNK_SIZE points, each sorted
+// along a Hilbert curve and walked from one point to the next. Sorting
+// each chunk by itself keeps the sort parallel: a chunk of a grid given
+// row by row is a band of rows, crossed cell by cell. With Parallel_tag
+// (when linked with TBB) the chunks are shared among threads, each with
+// its own hint and buffers; the triangulation is only read, and distinct
+// threads write distinct elements of result.
+template <class Dt, class RandomAccessIterator, class OutputGrid,
+          class Functor>
+std::size_t
+natural_neighbor_interpolation_2(const Dt& dt,
+                                 RandomAccessIterator first,
+                                 RandomAccessIterator beyond,
+                                 OutputGrid result,
+                                 Functor function_value,
+                                 const typename
+                                 Functor::result_type::first_type&
+                                 outside_value)
+{
+  return natural_neighbor_interpolation_2(dt, first, beyond, result,
+                                          function_value, outside_value,
+                                          Sequential_tag());
+}
+
+template <class Dt, class RandomAccessIterator, class OutputGrid,
+          class Functor, class Concurrency_tag>
+std::size_t
+natural_neighbor_interpolation_2(const Dt& dt,
+                                 RandomAccessIterator first,
+                                 RandomAccessIterator beyond,
+                                 OutputGrid result,
+                                 Functor function_value,
+                                 const typename
+                                 Functor::result_type::first_type&
+                                 outside_value,
+                                 Concurrency_tag)
+{
+  CGAL_precondition(dt.dimension() == 2);
+  typedef internal::Natural_neighbor_interpolator_2<Dt, RandomAccessIterator,
+                                                    OutputGrid, Functor>
+    Interpolator;
+
+  return internal::natural_neighbor_interpolation_2
+    (Interpolator(dt, first, result, function_value, outside_value),
+     beyond - first, Concurrency_tag());
+}
+
+} //namespace CGAL
+
+#endif // CGAL_NATURAL_NEIGHBOR_INTERPOLATION_2_H